@@ -2269,6 +2269,108 @@ struct activity pwr_bat_act = {
 	.bitmap		= NULL
 };
 
+/* Cgroups activity. Switch: --cgroup */
+struct activity cgroup_act = {
+	.id		= A_CGROUP,
+	.options	= AO_COUNTED + AO_GRAPH_PER_ITEM,
+	.magic		= ACTIVITY_MAGIC_BASE,
+	.group		= G_CGROUP,
+#ifdef SOURCE_SADC
+	.f_count_index	= 14,	/* wrap_get_cgroup_nr() */
+	.f_count2_index	= -1,
+	.f_read		= wrap_read_cgroup,
+#endif
+#ifdef SOURCE_SAR
+	.f_print	= print_cgroup_stats,
+	.f_print_avg	= print_cgroup_stats,
+#endif
+#if defined(SOURCE_SAR) || defined(SOURCE_SADF)
+	.hdr_line	= "CGROUP;%usr;%system;%cpu;%throttled;kbmem;rkB/s;wkB/s;rd/s;wr/s",
+#endif
+	.gtypes_nr	= {STATS_CGROUP_ULL, STATS_CGROUP_UL, STATS_CGROUP_U},
+	.ftypes_nr	= {0, 0, 0},
+#ifdef SOURCE_SADF
+	.f_render	= render_cgroup_stats,
+	.f_xml_print	= xml_print_cgroup_stats,
+	.f_json_print	= json_print_cgroup_stats,
+	.f_svg_print	= svg_print_cgroup_stats,
+	.f_raw_print	= raw_print_cgroup_stats,
+	.f_pcp_print	= pcp_print_cgroup_stats,
+	.f_count_new	= count_new_cgroup,
+	.desc		= "Cgroups statistics",
+#endif
+	.name		= "A_CGROUP",
+	.item_list	= NULL,
+	.item_list_sz	= 0,
+	.g_nr		= 4,
+	.nr_ini		= -1,
+	.nr2		= 1,
+	.nr_max		= MAX_NR_CGROUPS,
+	.nr		= {-1, -1, -1},
+	.nr_allocated	= 0,
+	.xnr		= STATS_CGROUP_XNR,
+	.xdev_list	= NULL,
+	.fsize		= STATS_CGROUP_SIZE,
+	.msize		= STATS_CGROUP_SIZE,
+	.opt_flags	= 0,
+	.buf		= {NULL, NULL, NULL},
+	.spmin		= NULL,
+	.spmax		= NULL,
+	.nr_spalloc	= 0,
+	.bitmap		= NULL
+};
+
+/* Cgroups pressure-stall activity. Switch: --cgroup-psi */
+struct activity psi_cgroup_act = {
+	.id		= A_PSI_CGROUP,
+	.options	= AO_COUNTED + AO_GRAPH_PER_ITEM,
+	.magic		= ACTIVITY_MAGIC_BASE,
+	.group		= G_CGROUP,
+#ifdef SOURCE_SADC
+	.f_count_index	= 15,	/* wrap_get_psi_cgroup_nr() */
+	.f_count2_index	= -1,
+	.f_read		= wrap_read_psi_cgroup,
+#endif
+#ifdef SOURCE_SAR
+	.f_print	= print_psi_cgroup_stats,
+	.f_print_avg	= print_psi_cgroup_stats,
+#endif
+#if defined(SOURCE_SAR) || defined(SOURCE_SADF)
+	.hdr_line	= "CGROUP;%scpu;%fcpu;%sio;%fio;%smem;%fmem",
+#endif
+	.gtypes_nr	= {STATS_PSI_CGROUP_ULL, STATS_PSI_CGROUP_UL, STATS_PSI_CGROUP_U},
+	.ftypes_nr	= {0, 0, 0},
+#ifdef SOURCE_SADF
+	.f_render	= render_psi_cgroup_stats,
+	.f_xml_print	= xml_print_psi_cgroup_stats,
+	.f_json_print	= json_print_psi_cgroup_stats,
+	.f_svg_print	= svg_print_psi_cgroup_stats,
+	.f_raw_print	= raw_print_psi_cgroup_stats,
+	.f_pcp_print	= pcp_print_psi_cgroup_stats,
+	.f_count_new	= count_new_psi_cgroup,
+	.desc		= "Cgroups pressure-stall statistics",
+#endif
+	.name		= "A_PSI_CGROUP",
+	.item_list	= NULL,
+	.item_list_sz	= 0,
+	.g_nr		= 3,
+	.nr_ini		= -1,
+	.nr2		= 1,
+	.nr_max		= MAX_NR_CGROUPS,
+	.nr		= {-1, -1, -1},
+	.nr_allocated	= 0,
+	.xnr		= STATS_PSI_CGROUP_XNR,
+	.xdev_list	= NULL,
+	.fsize		= STATS_PSI_CGROUP_SIZE,
+	.msize		= STATS_PSI_CGROUP_SIZE,
+	.opt_flags	= 0,
+	.buf		= {NULL, NULL, NULL},
+	.spmin		= NULL,
+	.spmax		= NULL,
+	.nr_spalloc	= 0,
+	.bitmap		= NULL
+};
+
 #ifdef SOURCE_SADC
 /*
  * Array of functions used to count number of items.
@@ -2287,7 +2389,9 @@ __nr_t (*f_count[NR_F_COUNT]) (struct activity *) = {
 	wrap_get_fchost_nr,	/* 10 */
 	wrap_detect_psi,	/* 11 */
 	wrap_get_freq_nr,	/* 12 */
-	wrap_get_bat_nr		/* 13 */
+	wrap_get_bat_nr,	/* 13 */
+	wrap_get_cgroup_nr,	/* 14 */
+	wrap_get_psi_cgroup_nr	/* 15 */
 };
 #endif
 
@@ -2343,6 +2447,8 @@ struct activity *act[NR_ACT] = {
 	/* <psi> */
 	&psi_cpu_act,
 	&psi_io_act,
-	&psi_mem_act	/* AO_CLOSE_MARKUP */
+	&psi_mem_act,	/* AO_CLOSE_MARKUP */
 	/* </psi> */
+	&cgroup_act,
+	&psi_cgroup_act
 };
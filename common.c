@@ -29,6 +29,7 @@
 #include <unistd.h>	/* For STDOUT_FILENO, among others */
 #include <sys/ioctl.h>
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <dirent.h>
 #include <ctype.h>
 #include <limits.h>
@@ -509,6 +510,158 @@ size_t mul_check_overflow4(size_t val1, size_t val2, size_t val3, size_t val4)
 	return (val1 * val2 * val3 * val4);
 }
 
+/*
+ ***************************************************************************
+ * Parse an interval of time entered on the command line. The interval is
+ * given in seconds and may contain up to three decimal places, so that
+ * sub-second intervals (e.g. 0.1 or 0.250) can be used. Non-zero intervals
+ * shorter than MIN_INTERVAL_MS are rejected, since rates are computed with
+ * intervals expressed in 1/100th of a second.
+ *
+ * IN:
+ * @arg		String containing the interval.
+ *
+ * RETURNS:
+ * Interval in milliseconds, or -1 if the string is not a valid interval.
+ ***************************************************************************
+ */
+long parse_interval(const char *arg)
+{
+	const char *c = arg;
+	long ms = 0;
+	int dec = -1;
+
+	if (!*c)
+		return -1;
+
+	for (; *c; c++) {
+		if (*c == '.') {
+			if (dec >= 0)
+				return -1;
+			dec = 0;
+			continue;
+		}
+		if (!isdigit((unsigned char) *c) || (dec == 3))
+			return -1;
+		if (ms > (LONG_MAX - 9) / 10)
+			return -1;
+		ms = ms * 10 + (*c - '0');
+		if (dec >= 0) {
+			dec++;
+		}
+	}
+	if (dec == 0)
+		/* Trailing dot without decimals */
+		return -1;
+
+	/* Scale value to milliseconds */
+	for (dec = (dec < 0 ? 0 : dec); dec < 3; dec++) {
+		if (ms > LONG_MAX / 10)
+			return -1;
+		ms *= 10;
+	}
+
+	if (ms && (ms < MIN_INTERVAL_MS))
+		/* Interval too short */
+		return -1;
+
+	return ms;
+}
+
+/*
+ ***************************************************************************
+ * Get the time elapsed since a deadline on the CLOCK_MONOTONIC clock.
+ *
+ * IN:
+ * @deadline	Deadline.
+ *
+ * RETURNS:
+ * Number of nanoseconds elapsed since the deadline (negative if the
+ * deadline has not been reached yet), or 0 if the clock is not available.
+ ***************************************************************************
+ */
+long long get_deadline_delay(const struct timespec *deadline)
+{
+	struct timespec now;
+
+	if (__clock_gettime(CLOCK_MONOTONIC, &now) < 0)
+		return 0;
+
+	return (long long) (now.tv_sec - deadline->tv_sec) * 1000000000LL +
+	       (now.tv_nsec - deadline->tv_nsec);
+}
+
+/*
+ ***************************************************************************
+ * Compute next sampling deadline. Deadlines are absolute times on the
+ * CLOCK_MONOTONIC clock, each one being exactly one interval after the
+ * previous one, so that time spent reading and displaying statistics
+ * doesn't make the sampling period drift. If the next deadline has already
+ * expired (e.g. collecting statistics took longer than the interval, or
+ * the process was stopped), the deadlines that have been missed are
+ * skipped, so that the phase of the deadlines is preserved and no burst
+ * of samples is taken to catch up.
+ *
+ * IN:
+ * @deadline	Previous sampling deadline.
+ * @interval_ms	Interval of time in milliseconds (> 0).
+ *
+ * OUT:
+ * @deadline	Next sampling deadline.
+ *
+ * RETURNS:
+ * Number of deadlines that have been skipped.
+ ***************************************************************************
+ */
+unsigned int next_deadline(struct timespec *deadline, long interval_ms)
+{
+	long long late_ns, itv_ns = (long long) interval_ms * 1000000LL;
+	unsigned long long ns;
+	unsigned int skipped = 0;
+
+	ns = (unsigned long long) deadline->tv_sec * 1000000000ULL + deadline->tv_nsec + itv_ns;
+	deadline->tv_sec = ns / 1000000000ULL;
+	deadline->tv_nsec = ns % 1000000000ULL;
+
+	late_ns = get_deadline_delay(deadline);
+	if (late_ns > 0) {
+		skipped = late_ns / itv_ns + 1;
+		ns += (unsigned long long) skipped * itv_ns;
+		deadline->tv_sec = ns / 1000000000ULL;
+		deadline->tv_nsec = ns % 1000000000ULL;
+	}
+
+	return skipped;
+}
+
+/*
+ ***************************************************************************
+ * Wait until next sampling deadline (see next_deadline() above). As with
+ * pause(), the function returns early if a signal is caught.
+ *
+ * IN:
+ * @deadline	Previous sampling deadline (initialized by the caller with
+ *		the time of the first sample).
+ * @interval_ms	Interval of time in milliseconds. A value of 0 means that
+ *		we should wait for a signal.
+ *
+ * OUT:
+ * @deadline	Next sampling deadline.
+ ***************************************************************************
+ */
+void wait_deadline(struct timespec *deadline, long interval_ms)
+{
+	if (!interval_ms) {
+		pause();
+		return;
+	}
+
+	next_deadline(deadline, interval_ms);
+
+	/* Returns immediately if deadline has already been reached */
+	clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, deadline, NULL);
+}
+
 #ifndef SOURCE_SADC
 /*
  ***************************************************************************
@@ -878,6 +1031,35 @@ unsigned long long get_interval(unsigned long long prev_uptime,
 	return itv;
 }
 
+/*
+ ***************************************************************************
+ * Compute time interval from two uptime values expressed in nanoseconds.
+ * The interval is rounded to the nearest 1/100th of a second, which is the
+ * unit expected by the S_VALUE() macro.
+ *
+ * IN:
+ * @prev_uptime	Previous uptime value (in nanoseconds).
+ * @curr_uptime	Current uptime value (in nanoseconds).
+ *
+ * RETURNS:
+ * Interval of time in 1/100th of a second.
+ ***************************************************************************
+ */
+unsigned long long get_interval_ns(unsigned long long prev_uptime,
+				   unsigned long long curr_uptime)
+{
+	unsigned long long itv;
+
+	/* prev_time=0 when displaying stats since system startup */
+	itv = (curr_uptime - prev_uptime + NSEC_PER_CS / 2) / NSEC_PER_CS;
+
+	if (!itv) {	/* Paranoia checking */
+		itv = 1;
+	}
+
+	return itv;
+}
+
 /*
  ***************************************************************************
  * Count number of bits set in an array.
@@ -934,6 +1116,197 @@ char *strtolower(char *str)
 	return(str);
 }
 
+/*
+ ***************************************************************************
+ * Check that a device name cache is up to date, i.e. that the directory
+ * its names have been read from has not been modified since. If it has
+ * been, the cache is emptied and must be filled again by the caller.
+ *
+ * IN:
+ * @nc		Device name cache.
+ * @dir		Directory the names are read from.
+ *
+ * RETURNS:
+ * TRUE if the cache can be used as is, FALSE if it has to be filled again.
+ ***************************************************************************
+ */
+int check_name_cache(struct name_cache *nc, char *dir)
+{
+	struct stat st;
+	int i, rc;
+
+	rc = stat(dir, &st);
+
+	if (!rc && nc->dir[0] && !strcmp(nc->dir, dir) &&
+	    (nc->dir_dev == st.st_dev) && (nc->dir_ino == st.st_ino) &&
+	    (nc->dir_mtim.tv_sec == st.st_mtim.tv_sec) &&
+	    (nc->dir_mtim.tv_nsec == st.st_mtim.tv_nsec))
+		/* Directory unchanged */
+		return TRUE;
+
+	for (i = 0; i < nc->nr; i++) {
+		free(nc->tab[i].key);
+		free(nc->tab[i].name);
+	}
+	nc->nr = 0;
+
+	if (rc < 0) {
+		/* Directory not accessible: Try again next time */
+		nc->dir[0] = '\0';
+	}
+	else {
+		snprintf(nc->dir, sizeof(nc->dir), "%s", dir);
+		nc->dir_dev = st.st_dev;
+		nc->dir_ino = st.st_ino;
+		nc->dir_mtim = st.st_mtim;
+	}
+
+	return FALSE;
+}
+
+/*
+ ***************************************************************************
+ * Add an entry to a device name cache. Function sort_name_cache() must be
+ * called once all the entries have been added.
+ *
+ * IN:
+ * @nc		Device name cache.
+ * @major	Major number of the device.
+ * @minor	Minor number of the device.
+ * @key		Name used to look up the entry, or NULL if the entry is
+ *		looked up by major and minor numbers.
+ * @name	Name to cache.
+ ***************************************************************************
+ */
+void add_name_cache_entry(struct name_cache *nc, unsigned int major, unsigned int minor,
+			  char *key, char *name)
+{
+	struct name_cache_entry *e;
+
+	if (nc->nr >= nc->sz) {
+		nc->sz += NR_NAME_CACHE_PREALLOC;
+		SREALLOC(nc->tab, struct name_cache_entry,
+			 (size_t) nc->sz * sizeof(struct name_cache_entry));
+	}
+
+	e = &(nc->tab[nc->nr]);
+	e->major = major;
+	e->minor = minor;
+	e->key = NULL;
+	if (((key != NULL) && ((e->key = strdup(key)) == NULL)) ||
+	    ((e->name = strdup(name)) == NULL)) {
+		perror("strdup");
+		exit(4);
+	}
+	e->seq = (nc->nr)++;
+}
+
+/*
+ ***************************************************************************
+ * Compare the lookup keys of two device name cache entries.
+ *
+ * IN:
+ * @a		First entry.
+ * @b		Second entry.
+ *
+ * RETURNS:
+ * Result of the comparison.
+ ***************************************************************************
+ */
+int cmp_name_cache_key(const void *a, const void *b)
+{
+	const struct name_cache_entry *e1 = a, *e2 = b;
+
+	if (e1->key && e2->key)
+		return strcmp(e1->key, e2->key);
+
+	if (e1->major != e2->major)
+		return (e1->major > e2->major) - (e1->major < e2->major);
+
+	return (e1->minor > e2->minor) - (e1->minor < e2->minor);
+}
+
+/*
+ ***************************************************************************
+ * Compare two device name cache entries. Entries with the same key are
+ * kept in the order they have been added.
+ *
+ * IN:
+ * @a		First entry.
+ * @b		Second entry.
+ *
+ * RETURNS:
+ * Result of the comparison.
+ ***************************************************************************
+ */
+int cmp_name_cache_entry(const void *a, const void *b)
+{
+	const struct name_cache_entry *e1 = a, *e2 = b;
+	int rc;
+
+	if ((rc = cmp_name_cache_key(a, b)) != 0)
+		return rc;
+
+	return (e1->seq > e2->seq) - (e1->seq < e2->seq);
+}
+
+/*
+ ***************************************************************************
+ * Sort the entries of a device name cache so that they can be looked up.
+ *
+ * IN:
+ * @nc		Device name cache.
+ ***************************************************************************
+ */
+void sort_name_cache(struct name_cache *nc)
+{
+	if (nc->nr > 1) {
+		qsort(nc->tab, nc->nr, sizeof(struct name_cache_entry), cmp_name_cache_entry);
+	}
+}
+
+/*
+ ***************************************************************************
+ * Look up an entry in a device name cache. If several entries have the
+ * same key, the first one added to the cache is returned.
+ *
+ * IN:
+ * @nc		Device name cache.
+ * @major	Major number of the device.
+ * @minor	Minor number of the device.
+ * @key		Name to look up, or NULL to look up major and minor numbers.
+ *
+ * RETURNS:
+ * Entry found, or NULL.
+ ***************************************************************************
+ */
+struct name_cache_entry *lookup_name_cache(struct name_cache *nc, unsigned int major,
+					   unsigned int minor, char *key)
+{
+	struct name_cache_entry probe;
+	int lo = 0, hi = nc->nr, mid;
+
+	probe.major = major;
+	probe.minor = minor;
+	probe.key = key;
+
+	/* Find first entry which is not lower than the one searched */
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		if (cmp_name_cache_key(&(nc->tab[mid]), &probe) < 0) {
+			lo = mid + 1;
+		}
+		else {
+			hi = mid;
+		}
+	}
+
+	if ((lo < nc->nr) && !cmp_name_cache_key(&(nc->tab[lo]), &probe))
+		return &(nc->tab[lo]);
+
+	return NULL;
+}
+
 /*
  ***************************************************************************
  * Get persistent type name directory from type.
@@ -1050,7 +1423,8 @@ free_list:
 
 /*
  ***************************************************************************
- * Get persistent name from pretty name.
+ * Get persistent name from pretty name. Persistent names are read only
+ * once, then each time the persistent type name directory is modified.
  *
  * IN:
  * @pretty	Pretty name (e.g. sda, sda1, ..).
@@ -1061,52 +1435,70 @@ free_list:
 */
 char *get_persistent_name_from_pretty(char *pretty)
 {
+	static struct name_cache persist_cache;
 	int i;
 	ssize_t r;
-	char *link, *name;
+	char *dir, *link, *name;
 	char **persist_names;
 	char target[PATH_MAX];
 	static char persist_name[FILENAME_MAX];
+	struct name_cache_entry *e;
 
-	persist_name[0] = '\0';
-
-	/* Get list of files from persistent type name directory */
-	persist_names = get_persistent_names();
-	if (!persist_names)
+	/* Get directory name for selected persistent type */
+	dir = get_persistent_type_dir(persistent_name_type);
+	if (!dir)
 		return (NULL);
 
-	for (i = 0; persist_names[i]; i++) {
+	/*
+	 * Read all the persistent names once, and only read them again
+	 * when the directory has been modified.
+	 */
+	if (!check_name_cache(&persist_cache, dir)) {
+
+		/* Get list of files from persistent type name directory */
+		persist_names = get_persistent_names();
+		if (!persist_names) {
+			/* Cache is empty: Read the names again next time */
+			persist_cache.dir[0] = '\0';
+			return (NULL);
+		}
 
-		/* Get absolute path for current persistent name */
-		link = get_persistent_name_path(persist_names[i]);
-		if (!link)
-			continue;
+		for (i = 0; persist_names[i]; i++) {
 
-		/* Persistent name is usually a symlink: Read it... */
-		r = readlink(link, target, sizeof(target));
-		if ((r <= 0) || (r >= sizeof(target)))
-			continue;
+			/* Get absolute path for current persistent name */
+			link = get_persistent_name_path(persist_names[i]);
+			if (!link)
+				continue;
 
-		target[r] = '\0';
+			/* Persistent name is usually a symlink: Read it... */
+			r = readlink(link, target, sizeof(target));
+			if ((r <= 0) || (r >= sizeof(target)))
+				continue;
 
-		/* ... and get device pretty name it points at */
-		name = basename(target);
-		if (!name || (name[0] == '\0'))
-			continue;
+			target[r] = '\0';
 
-		if (strncmp(name, pretty, FILENAME_MAX) == 0) {
-			/* We have found pretty name for current persistent one */
-			snprintf(persist_name, sizeof(persist_name), "%s", persist_names[i]);
-			break;
+			/* ... and get device pretty name it points at */
+			name = basename(target);
+			if (!name || (name[0] == '\0'))
+				continue;
+
+			/* Names are in alphabetical order: First one wins for a given device */
+			add_name_cache_entry(&persist_cache, 0, 0, name, persist_names[i]);
 		}
-	}
+		sort_name_cache(&persist_cache);
 
-	for (i = 0; persist_names[i]; i++) {
-		free(persist_names[i]);
+		for (i = 0; persist_names[i]; i++) {
+			free(persist_names[i]);
+		}
+		free(persist_names);
 	}
-	free(persist_names);
 
-	return persist_name[0] ? persist_name : NULL;
+	if ((e = lookup_name_cache(&persist_cache, 0, 0, pretty)) == NULL)
+		return (NULL);
+
+	snprintf(persist_name, sizeof(persist_name), "%s", e->name);
+
+	return persist_name;
 }
 
 /*
@@ -15,6 +15,7 @@
 #include <limits.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <sys/types.h>
 #include "systest.h"
 
 #ifdef HAVE_SYS_SYSMACROS_H
@@ -246,6 +247,14 @@ enum {
 
 #define PANIC(m)	sysstat_panic(__FUNCTION__, m)
 
+/* Number of nanoseconds in 1/100th of a second */
+#define NSEC_PER_CS	10000000ULL
+/*
+ * Shortest interval (in milliseconds) accepted on the command line.
+ * Rates are computed with intervals expressed in 1/100th of a second.
+ */
+#define MIN_INTERVAL_MS	10
+
 /* Number of ticks per second */
 #define HZ		hz
 extern unsigned long hz;
@@ -319,6 +328,38 @@ struct ext_disk_stats {
 	double arqsz;
 };
 
+/* Allocation step for device name caches */
+#define NR_NAME_CACHE_PREALLOC	64
+
+/* Entry of a device name cache */
+struct name_cache_entry {
+	/* Major and minor numbers of the device (entries looked up by number) */
+	unsigned int major;
+	unsigned int minor;
+	/* Lookup key (entries looked up by name), NULL otherwise */
+	char *key;
+	/* Cached name */
+	char *name;
+	/* Position of the entry in the directory scan */
+	unsigned int seq;
+};
+
+/*
+ * Device names read from a directory (e.g. /dev/mapper). The cache is
+ * built only once, and rebuilt when the directory has been modified.
+ */
+struct name_cache {
+	/* Directory the names have been read from */
+	char dir[PATH_MAX];
+	/* Identity and modification time of the directory when it was read */
+	dev_t dir_dev;
+	ino_t dir_ino;
+	struct timespec dir_mtim;
+	int nr;
+	int sz;
+	struct name_cache_entry *tab;
+};
+
 /*
  ***************************************************************************
  * Functions prototypes
@@ -350,8 +391,20 @@ size_t mul_check_overflow3
 	(size_t, size_t, size_t);
 size_t mul_check_overflow4
 	(size_t, size_t, size_t, size_t);
+long long get_deadline_delay
+	(const struct timespec *);
+unsigned int next_deadline
+	(struct timespec *, long);
+long parse_interval
+	(const char *);
+void wait_deadline
+	(struct timespec *, long);
 
 #ifndef SOURCE_SADC
+void add_name_cache_entry
+	(struct name_cache *, unsigned int, unsigned int, char *, char *);
+int check_name_cache
+	(struct name_cache *, char *);
 int count_bits
 	(void *, int);
 int count_csvalues
@@ -381,6 +434,8 @@ unsigned int get_devmap_major
 	(void);
 unsigned long long get_interval
 	(unsigned long long, unsigned long long);
+unsigned long long get_interval_ns
+	(unsigned long long, unsigned long long);
 char *get_persistent_name_from_pretty
 	(char *);
 char *get_persistent_type_dir
@@ -395,6 +450,8 @@ void init_colors
 	(void);
 double ll_sp_value
 	(unsigned long long, unsigned long long, unsigned long long);
+struct name_cache_entry *lookup_name_cache
+	(struct name_cache *, unsigned int, unsigned int, char *);
 int is_iso_time_fmt
 	(void);
 int parse_range_values
@@ -405,6 +462,8 @@ int print_gal_header
 	(struct tm *, char *, char *, char *, char *, int, int);
 int set_report_date
 	(struct tm *, char[], int);
+void sort_name_cache
+	(struct name_cache *);
 char *strtolower
 	(char *);
 void write_sample_timestamp
@@ -566,5 +566,55 @@ __nr_t get_bat_nr(void)
 	return bat;
 }
 
+/*
+ ***************************************************************************
+ * Count a cgroup found while walking the cgroup hierarchy.
+ *
+ * IN:
+ * @dirname	Unused here.
+ * @cgname	Unused here.
+ * @depth	Unused here.
+ * @arg		Number of cgroups already counted.
+ *
+ * OUT:
+ * @arg		Number of cgroups counted.
+ *
+ * RETURNS:
+ * 0 so that the child cgroups are counted too.
+ ***************************************************************************
+ */
+int count_cgroup(const char *dirname, const char *cgname, int depth, void *arg)
+{
+	(*((__nr_t *) arg))++;
+
+	return 0;
+}
+
+/*
+ ***************************************************************************
+ * Find number of cgroups in cgroup v2 hierarchy up to the max depth.
+ *
+ * IN:
+ * @max_depth	Max depth of the cgroups to count (1 for top-level cgroups).
+ *
+ * RETURNS:
+ * Number of cgroups.
+ * Return -1 if no cgroup v2 hierarchy has been found.
+ ***************************************************************************
+ */
+__nr_t get_cgroup_nr(int max_depth)
+{
+	char *root;
+	__nr_t cg = 0;
+
+	if ((root = get_cgroup_root()) == NULL)
+		return -1;
+
+	/* Walk the hierarchy the same way as read_cgroup() does */
+	walk_cgroup_dir(root, "", 1, max_depth, count_cgroup, &cg);
+
+	return cg;
+}
+
 /*------------------ END: FUNCTIONS USED BY SADC ONLY ---------------------*/
 #endif /* SOURCE_SADC */
@@ -37,5 +37,7 @@ __nr_t get_fchost_nr
 	(void);
 __nr_t get_bat_nr
 	(void);
+__nr_t get_cgroup_nr
+	(int);
 
 #endif /* _COUNT_H */
@@ -165,6 +165,21 @@ struct report_format pcp_fmt = {
 	.f_display	= logic1_display_loop
 };
 
+/*
+ * OpenMetrics output.
+ * Metrics are the same as those defined for PCP output.
+ */
+struct report_format om_fmt = {
+	.id		= F_OM_OUTPUT,
+	.options	= FO_LC_NUMERIC_C + FO_ITEM_LIST + FO_FULL_ORDER,
+	.f_header	= print_om_header,
+	.f_statistics	= print_pcp_statistics,
+	.f_timestamp	= print_om_timestamp,
+	.f_restart	= NULL,
+	.f_comment	= NULL,
+	.f_display	= logic1_display_loop
+};
+
 /*
  * Array of output formats.
  */
@@ -177,7 +192,8 @@ struct report_format *fmt[NR_FMT] = {
 	&conv_fmt,
 	&svg_fmt,
 	&raw_fmt,
-	&pcp_fmt
+	&pcp_fmt,
+	&om_fmt
 };
 #endif
 
@@ -41,8 +41,15 @@
 #endif
 
 static unsigned int ioc_parsed = 0;
+/* Number of records read from ioconf file */
+static unsigned int ioc_nr = 0;
 static struct ioc_entry *ioconf[MAX_BLKDEV + 1];
 static unsigned int ioc_refnr[MAX_BLKDEV + 1];
+/*
+ * Names already generated by ioc_name() for the first minor numbers of each
+ * major number (allocated when the major number is first looked up).
+ */
+static char (*ioc_names[MAX_BLKDEV + 1])[IOC_DEVLEN];
 
 /*
  ***************************************************************************
@@ -75,6 +82,13 @@ static void ioc_free(void)
 		free(*p);
 		*p = NULL;
 	}
+
+	/* And the names generated so far */
+	for (i = 0; i <= MAX_BLKDEV; ++i) {
+		free(ioc_names[i]);
+		ioc_names[i] = NULL;
+	}
+	ioc_nr = 0;
 }
 
 /*
@@ -152,6 +166,12 @@ int ioc_init(void)
 	struct blk_config *blkp = NULL;
 	char ioconf_name[64];
 
+	/*
+	 * The file is read only once, even if it cannot be opened:
+	 * Don't try again for each device name looked up.
+	 */
+	ioc_parsed = 1;
+
 	if ((fp = fopen(IOCONF, "r")) == NULL) {
 		if ((fp = fopen(LOCAL_IOCONF, "r")) == NULL)
 			return 0;
@@ -350,8 +370,7 @@ int ioc_init(void)
 	free(blkp);
 	free(iocp);
 
-	/* Indicate that ioconf file has been parsed */
-	ioc_parsed = 1;
+	ioc_nr = count;
 
 	return (count);
 
@@ -386,6 +405,7 @@ free_and_return:
 char *ioc_name(unsigned int major, unsigned int minor)
 {
 	static char name[IOC_DEVLEN];
+	char *dname = name;
 	struct ioc_entry *p;
 	int base, offset;
 
@@ -393,7 +413,10 @@ char *ioc_name(unsigned int major, unsigned int minor)
 		return (NULL);
 	}
 
-	if (!ioc_parsed && !ioc_init())
+	if (!ioc_parsed) {
+		ioc_init();
+	}
+	if (!ioc_nr)
 		return (NULL);
 
 	p = ioconf[major];
@@ -416,6 +439,18 @@ char *ioc_name(unsigned int major, unsigned int minor)
 
 	/* OK.  we're doing an actual device name... */
 
+	if (minor < IOC_NAMES_MINOR_NR) {
+		/* Has this name already been generated? */
+		if (ioc_names[major] == NULL) {
+			ioc_names[major] = calloc(IOC_NAMES_MINOR_NR, IOC_DEVLEN);
+		}
+		if (ioc_names[major] != NULL) {
+			dname = ioc_names[major][minor];
+			if (*dname)
+				return (dname);
+		}
+	}
+
 	/*
 	 * Assemble base + optional controller info
 	 * this is of course too clever by half
@@ -436,23 +471,26 @@ char *ioc_name(unsigned int major, unsigned int minor)
 	 * These sprintfs can't be coalesced because the first might
 	 * ignore its first arg
 	 */
-	sprintf(name, p->blkp->cfmt, p->ctrlno);
-	sprintf(name + strlen(name), p->blkp->dfmt, p->blkp->cconv(offset));
+	snprintf(dname, IOC_DEVLEN, p->blkp->cfmt, p->ctrlno);
+	snprintf(dname + strlen(dname), IOC_DEVLEN - strlen(dname),
+		 p->blkp->dfmt, p->blkp->cconv(offset));
 
 	if (!IS_WHOLE(major, minor)) {
 		/*
 		 * Tack on partition info, format string cooked (curried?) by
 		 * the parser
 		 */
-		sprintf(name + strlen(name), p->blkp->pfmt, minor % p->blkp->pcount);
+		snprintf(dname + strlen(dname), IOC_DEVLEN - strlen(dname),
+			 p->blkp->pfmt, minor % p->blkp->pcount);
 	}
-	return (name);
+	return (dname);
 }
 
 /*
  ***************************************************************************
  * Transform device mapper name: Get the user assigned name of the logical
  * device instead of the internal device mapper numbering.
+ * Names are read only once, then each time DEVMAP_DIR is modified.
  *
  * IN:
  * @major	Device major number.
@@ -464,38 +502,45 @@ char *ioc_name(unsigned int major, unsigned int minor)
  */
 char *transform_devmapname(unsigned int major, unsigned int minor)
 {
+	static struct name_cache dm_cache;
 	DIR *dm_dir;
 	struct dirent *dp;
 	char filen[MAX_FILE_LEN];
-	char *dm_name = NULL;
 	static char name[MAX_NAME_LEN];
 	struct stat aux;
-	unsigned int dm_major, dm_minor;
+	struct name_cache_entry *e;
 
-	if ((dm_dir = opendir(DEVMAP_DIR)) == NULL) {
-		fprintf(stderr, _("Cannot open %s: %s\n"), DEVMAP_DIR, strerror(errno));
-		exit(4);
-	}
-
-	while ((dp = readdir(dm_dir)) != NULL) {
-		/* For each file in DEVMAP_DIR */
+	/*
+	 * Read device mapper names once, and only read them again
+	 * when DEVMAP_DIR has been modified.
+	 */
+	if (!check_name_cache(&dm_cache, DEVMAP_DIR)) {
 
-		snprintf(filen, sizeof(filen), "%s/%s", DEVMAP_DIR, dp->d_name);
+		if ((dm_dir = opendir(DEVMAP_DIR)) == NULL) {
+			fprintf(stderr, _("Cannot open %s: %s\n"), DEVMAP_DIR, strerror(errno));
+			exit(4);
+		}
 
-		if (__stat(filen, &aux) == 0) {
-			/* Get its minor and major numbers */
+		while ((dp = readdir(dm_dir)) != NULL) {
+			/* For each file in DEVMAP_DIR */
 
-			dm_major = __major(aux.st_rdev);
-			dm_minor = __minor(aux.st_rdev);
+			snprintf(filen, sizeof(filen), "%s/%s", DEVMAP_DIR, dp->d_name);
 
-			if ((dm_minor == minor) && (dm_major == major)) {
-				snprintf(name, sizeof(name), "%s", dp->d_name);
-				dm_name = name;
-				break;
+			if (__stat(filen, &aux) == 0) {
+				/* Save its minor and major numbers */
+				add_name_cache_entry(&dm_cache, __major(aux.st_rdev),
+						     __minor(aux.st_rdev), NULL, dp->d_name);
 			}
 		}
+		closedir(dm_dir);
+
+		sort_name_cache(&dm_cache);
 	}
-	closedir(dm_dir);
 
-	return dm_name;
+	if ((e = lookup_name_cache(&dm_cache, major, minor, NULL)) == NULL)
+		return NULL;
+
+	snprintf(name, sizeof(name), "%s", e->name);
+
+	return name;
 }
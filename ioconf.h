@@ -29,6 +29,9 @@
 
 #define K_NODEV	"nodev"
 
+/* Names are generated only once for minor numbers lower than this value */
+#define IOC_NAMES_MINOR_NR	256
+
 #define IS_WHOLE(maj,min)	((min % ioconf[maj]->blkp->pcount) == 0)
 
 /*
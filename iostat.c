@@ -57,22 +57,43 @@ extern int __env;
 #endif
 
 struct stats_cpu *st_cpu[2];
-unsigned long long uptime_cs[2] = {0, 0};
+unsigned long long uptime_ns[2] = {0, 0};
 unsigned long long tot_jiffies[2] = {0, 0};
 struct io_device *dev_list = NULL;
 
+/*
+ * Devices of the linked list are also looked up by name with a hash table,
+ * since the same devices are found again at each sample.
+ */
+struct io_device **dev_hash = NULL, *dev_last = NULL;
+unsigned int dev_hash_sz = 0, dev_nr = 0;
+
+/* Block devices and partitions read from diskstats, in file order */
+struct dstat_entry *dstat_tab = NULL;
+/* Same entries sorted by major:minor numbers */
+struct dstat_entry **dstat_idx = NULL;
+int dstat_nr = 0, dstat_sz = 0;
+
 /* Number of decimal places */
 int dplaces_nr = -1;
 
+/*
+ * Devices selected with option --top, kept as a min-heap on the sort key
+ * so that only the top_nr busiest devices have to be displayed.
+ */
+struct top_entry *top_heap = NULL;
+int top_nr = 0, top_cnt = 0, top_key = TOP_UTIL;
+
 int group_nr = 0;	/* Nb of device groups */
 int cpu_nr = 0;		/* Nb of processors on the machine */
 uint64_t flags = 0;	/* Flag for common options and system state */
 uint64_t xflags = 0;	/* Extended flag for options used by multiple commands */
 
-long interval = 0;
+/* Interval in seconds (rounded up) and in milliseconds */
+long interval = 0, interval_ms = 0;
 char alt_dir[MAX_FILE_LEN];
 
-struct sigaction alrm_act, int_act;
+struct sigaction int_act;
 int sigint_caught = 0;
 
 /*
@@ -91,14 +112,16 @@ void usage(char *progname)
 	fprintf(stderr, _("Options are:\n"
 			  "[ -c ] [ -d ] [ -h ] [ -k | -m | -G ] [ -N ] [ -s ] [ -t ] [ -U ] [ -V ] [ -x ] [ -y ] [ -z ]\n"
 			  "[ { -f | +f } <directory> ] [ -j { ID | LABEL | PATH | UUID | ... } ]\n"
-			  "[ --compact ] [ --dec={ 0 | 1 | 2 } ] [ --human ] [ --pretty ] [ -o JSON ]\n"
+			  "[ --compact ] [ --dec={ 0 | 1 | 2 } ] [ --hctx ] [ --human ] [ --pretty ] [ -o JSON ]\n"
+			  "[ --top=<N>[,{ util | await | tps | tput }] ]\n"
 			  "[ [ -H ] -g <group_name> ] [ -p [ <device> [,...] | ALL ] ]\n"
 			  "[ <device> [...] | ALL ] [ --debuginfo ]\n"));
 #else
 	fprintf(stderr, _("Options are:\n"
 			  "[ -c ] [ -d ] [ -h ] [ -k | -m | -G ] [ -N ] [ -s ] [ -t ] [ -U ] [ -V ] [ -x ] [ -y ] [ -z ]\n"
 			  "[ { -f | +f } <directory> ] [ -j { ID | LABEL | PATH | UUID | ... } ]\n"
-			  "[ --compact ] [ --dec={ 0 | 1 | 2 } ] [ --human ] [ --pretty ] [ -o JSON ]\n"
+			  "[ --compact ] [ --dec={ 0 | 1 | 2 } ] [ --hctx ] [ --human ] [ --pretty ] [ -o JSON ]\n"
+			  "[ --top=<N>[,{ util | await | tps | tput }] ]\n"
 			  "[ [ -H ] -g <group_name> ] [ -p [ <device> [,...] | ALL ] ]\n"
 			  "[ <device> [...] | ALL ]\n"));
 #endif
@@ -162,19 +185,6 @@ char *get_dm_name_from_registered_name(char *registered_name)
 	return basename(target);
 }
 
-/*
- ***************************************************************************
- * SIGALRM signal handler. No need to reset the handler here.
- *
- * IN:
- * @sig	Signal number.
- ***************************************************************************
- */
-void alarm_handler(int sig)
-{
-	alarm(interval);
-}
-
 /*
  ***************************************************************************
  * SIGINT and SIGTERM signals handler.
@@ -263,13 +273,103 @@ int get_major_minor_nr(char filename[], int *major, int *minor)
 	return 0;
 }
 
+/*
+ ***************************************************************************
+ * Compute hash value of a device name (FNV-1a).
+ *
+ * IN:
+ * @name	Device name.
+ *
+ * RETURNS:
+ * Hash value.
+ ***************************************************************************
+ */
+unsigned int hash_devname(const char *name)
+{
+	unsigned int hash = 2166136261U;
+
+	while (*name) {
+		hash ^= (unsigned char) *name++;
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+/*
+ ***************************************************************************
+ * Look for a device in the linked list using the hash table.
+ *
+ * IN:
+ * @name	Device name.
+ * @hash	Hash value of device name.
+ *
+ * RETURNS:
+ * Pointer on the io_device structure, or NULL if device not found.
+ ***************************************************************************
+ */
+struct io_device *get_list_device(const char *name, unsigned int hash)
+{
+	struct io_device *d;
+
+	if (!dev_hash)
+		return NULL;
+
+	for (d = dev_hash[hash & (dev_hash_sz - 1)]; d != NULL; d = d->hnext) {
+		if ((d->hash == hash) && !strcmp(d->name, name))
+			return d;
+	}
+
+	return NULL;
+}
+
+/*
+ ***************************************************************************
+ * Insert a new device in the hash table, enlarging it if needed.
+ *
+ * IN:
+ * @d		Device structure. Its name has already been saved.
+ ***************************************************************************
+ */
+void hash_list_device(struct io_device *d)
+{
+	struct io_device **tab, *dh;
+	unsigned int i, sz;
+
+	if (dev_nr >= dev_hash_sz * 2) {
+		/* Double the size of the hash table */
+		sz = dev_hash_sz ? dev_hash_sz * 2 : DEV_HASH_SIZE;
+		if ((tab = (struct io_device **) calloc(sz, sizeof(struct io_device *))) == NULL) {
+			perror("calloc");
+			exit(4);
+		}
+
+		for (i = 0; i < dev_hash_sz; i++) {
+			while ((dh = dev_hash[i]) != NULL) {
+				dev_hash[i] = dh->hnext;
+				dh->hnext = tab[dh->hash & (sz - 1)];
+				tab[dh->hash & (sz - 1)] = dh;
+			}
+		}
+		free(dev_hash);
+		dev_hash = tab;
+		dev_hash_sz = sz;
+	}
+
+	d->hash = hash_devname(d->name);
+	d->hnext = dev_hash[d->hash & (dev_hash_sz - 1)];
+	dev_hash[d->hash & (dev_hash_sz - 1)] = d;
+	dev_nr++;
+}
+
 /*
  ***************************************************************************
  * Check if a device is present in the list, and add it if requested.
  * Also look for its type (device or partition) and save it.
  *
  * IN:
- * @dlist	Address of pointer on the start of the linked list.
+ * @dlist	Address of pointer on the start of the linked list
+ *		(&dev_list).
  * @name	Device name.
  * @dtype	T_PART_DEV (=2) if the device and all its partitions should
  *		also be read (option -p used), T_GROUP (=3) if it's a group
@@ -296,27 +396,29 @@ struct io_device *add_list_device(struct io_device **dlist, char *name, int dtyp
 		/* Device name is too long */
 		return NULL;
 
-	while (*dlist != NULL) {
-
-		d = *dlist;
-		if ((i = strcmp(d->name, name)) == 0) {
-			/* Device found in list */
-			if ((dtype == T_PART_DEV) && (d->dev_tp == T_DEV)) {
-				d->dev_tp = dtype;
-			}
-			d->exist = TRUE;
-			return d;
+	if ((d = get_list_device(name, hash_devname(name))) != NULL) {
+		/* Device found in list */
+		if ((dtype == T_PART_DEV) && (d->dev_tp == T_DEV)) {
+			d->dev_tp = dtype;
 		}
-		if (!GROUP_DEFINED(flags) && !DISPLAY_EVERYTHING(flags) && (i > 0))
-			/*
-			 * If no group defined and we don't use /proc/diskstats,
-			 * insert current device in alphabetical order.
-			 * NB: Using /proc/diskstats ("iostat -p ALL") is a bit better than
-			 * using alphabetical order because sda10 comes after sda9...
-			 */
-			break;
+		d->exist = TRUE;
+		return d;
+	}
 
-		dlist = &(d->next);
+	if (!GROUP_DEFINED(flags) && !DISPLAY_EVERYTHING(flags)) {
+		/*
+		 * If no group defined and we don't use /proc/diskstats,
+		 * insert current device in alphabetical order.
+		 * NB: Using /proc/diskstats ("iostat -p ALL") is a bit better than
+		 * using alphabetical order because sda10 comes after sda9...
+		 */
+		while ((*dlist != NULL) && (strcmp((*dlist)->name, name) < 0)) {
+			dlist = &((*dlist)->next);
+		}
+	}
+	else if (dev_last != NULL) {
+		/* Append current device to the list */
+		dlist = &(dev_last->next);
 	}
 
 	/* Device not found */
@@ -358,6 +460,10 @@ struct io_device *add_list_device(struct io_device **dlist, char *name, int dtyp
 	}
 	d->exist = TRUE;
 	d->next = ds;
+	if (ds == NULL) {
+		dev_last = d;
+	}
+	hash_list_device(d);
 
 	if (dtype == T_GROUP) {
 		d->dev_tp = dtype;
@@ -520,24 +626,111 @@ int read_sysfs_file_stat(char *devname, struct io_stats *ios)
 
 /*
  ***************************************************************************
- * Read sysfs stats for all the partitions of a whole device. Devices are
- * saved in the linked list.
+ * Compare two device names. A slash in one name matches a bang character
+ * in the other one (e.g. "cciss/c0d0" and "cciss!c0d0").
+ *
+ * IN:
+ * @name1	First device name.
+ * @name2	Second device name.
+ *
+ * RETURNS:
+ * TRUE if both names designate the same device.
+ ***************************************************************************
+ */
+int same_device_name(const char *name1, const char *name2)
+{
+	for (; *name1 && *name2; name1++, name2++) {
+		if ((*name1 != *name2) &&
+		    !(((*name1 == '/') || (*name1 == '!')) &&
+		      ((*name2 == '/') || (*name2 == '!'))))
+			return FALSE;
+	}
+
+	return (*name1 == *name2);
+}
+
+/*
+ ***************************************************************************
+ * Tell if a name is that of a partition of a given whole device. The kernel
+ * names partitions after their device, adding a 'p' before the partition
+ * number when the device name already ends with a digit (e.g. "sda1",
+ * "nvme0n1p1").
+ *
+ * IN:
+ * @dname	Whole device name.
+ * @pname	Name to test.
+ *
+ * RETURNS:
+ * TRUE if @pname is a partition name for device @dname.
+ ***************************************************************************
+ */
+int is_partition_name(const char *dname, const char *pname)
+{
+	size_t len = strlen(dname);
+
+	if (!len || (strncmp(dname, pname, len) != 0))
+		return FALSE;
+
+	pname += len;
+	if (isdigit(dname[len - 1])) {
+		if (*pname++ != 'p')
+			return FALSE;
+	}
+
+	return (*pname && (strspn(pname, DIGITS) == strlen(pname)));
+}
+
+/*
+ ***************************************************************************
+ * Look for a partition among the diskstats table entries which follow its
+ * whole device.
+ *
+ * IN:
+ * @e		Diskstats table entry of the whole device (may be NULL).
+ * @pname	Partition name.
+ *
+ * RETURNS:
+ * Pointer on the diskstats table entry, or NULL if partition not found.
+ ***************************************************************************
+ */
+struct dstat_entry *get_dstat_part(struct dstat_entry *e, const char *pname)
+{
+	if (e == NULL)
+		return NULL;
+
+	for (e++; (e < dstat_tab + dstat_nr) && e->part; e++) {
+		if (same_device_name(e->name, pname))
+			return e;
+	}
+
+	return NULL;
+}
+
+/*
+ ***************************************************************************
+ * Read stats for all the partitions of a whole device. Partitions are
+ * those found in the device directory in sysfs. Their stats are taken from
+ * the diskstats table when they are listed there, and else read from
+ * sysfs. Devices are saved in the linked list.
  *
  * IN:
  * @curr	Index in array for current sample statistics.
  * @dname	Whole device name.
  * @sysdev	sysfs location.
+ * @e		Diskstats table entry of the whole device (NULL if none).
  *
  * RETURNS:
  * 0 on success, -1 otherwise.
  ***************************************************************************
  */
-int read_sysfs_device_part_stat_work(int curr, char *dname, char *sysdev)
+int read_sysfs_device_part_stat_work(int curr, char *dname, char *sysdev,
+				     struct dstat_entry *e)
 {
 	DIR *dir;
 	struct dirent *drd;
 	struct io_stats sdev;
 	struct io_device *d;
+	struct dstat_entry *p;
 	char dfile[MAX_PF_NAME], filename[MAX_PF_NAME + 512];
 
 	snprintf(dfile, sizeof(dfile), "%s/%s/%s", sysdev, __BLOCK, dname);
@@ -549,8 +742,19 @@ int read_sysfs_device_part_stat_work(int curr, char *dname, char *sysdev)
 	/* Get current entry */
 	while ((drd = __readdir(dir)) != NULL) {
 
-		if (!strcmp(drd->d_name, ".") || !strcmp(drd->d_name, ".."))
+		if (!is_partition_name(dname, drd->d_name))
+			/* Not a partition (e.g. "queue" or "holders" directory) */
 			continue;
+
+		if ((p = get_dstat_part(e, drd->d_name)) != NULL) {
+			/* Partition listed in diskstats */
+			d = add_list_device(&dev_list, drd->d_name, 0, p->major, p->minor);
+			if (d != NULL) {
+				*(d->dev_stats[curr]) = p->ios;
+			}
+			continue;
+		}
+
 		snprintf(filename, sizeof(filename), "%s/%s/%s", dfile, drd->d_name, S_STAT);
 
 		/* Read current partition stats */
@@ -571,29 +775,30 @@ int read_sysfs_device_part_stat_work(int curr, char *dname, char *sysdev)
 
 /*
  ***************************************************************************
- * Read sysfs stats for all the partitions of a whole device.
- * Stats are from /sys or an alternate directory.
+ * Read stats for all the partitions of a whole device.
+ * Partitions are looked for in /sys or an alternate directory.
  *
  * IN:
  * @curr	Index in array for current sample statistics.
  * @dname	Whole device name.
+ * @e		Diskstats table entry of the whole device (NULL if none).
  *
  * RETURNS:
  * 0 on success, -1 otherwise.
  ***************************************************************************
  */
-int read_sysfs_device_part_stat(int curr, char *dname)
+int read_sysfs_device_part_stat(int curr, char *dname, struct dstat_entry *e)
 {
 	int rc = 0;
 
 	if (!alt_dir[0] || USE_ALL_DIR(flags)) {
 		/* Read partition stats from /sys */
-		rc = read_sysfs_device_part_stat_work(curr, dname, SLASH_SYS);
+		rc = read_sysfs_device_part_stat_work(curr, dname, SLASH_SYS, e);
 	}
 
 	if (alt_dir[0] && (!USE_ALL_DIR(flags) || (USE_ALL_DIR(flags) && (rc < 0)))) {
 		/* Read partition stats from an alternate /sys directory */
-		rc = read_sysfs_device_part_stat_work(curr, dname, alt_dir);
+		rc = read_sysfs_device_part_stat_work(curr, dname, alt_dir, e);
 	}
 
 	return rc;
@@ -733,10 +938,45 @@ int read_sysfs_part_stat(int curr, struct io_device *d)
 	return rc;
 }
 
+/*
+ ***************************************************************************
+ * Read stats from the sysfs filesystem for a device entered on the command
+ * line.
+ *
+ * IN:
+ * @curr	Index in array for current sample statistics.
+ * @d		Device structure.
+ ***************************************************************************
+ */
+void read_sysfs_dev_stat(int curr, struct io_device *d)
+{
+	if (d->dev_tp == T_PART) {
+		/*
+		 * This is a partition.
+		 * Read its stats using /sys/dev/block/M:n/ directory.
+		 */
+		if (read_sysfs_part_stat(curr, d) == 0) {
+			d->exist = TRUE;
+		}
+	}
+
+	else if ((d->dev_tp == T_PART_DEV) || (d->dev_tp == T_DEV)) {
+		/* Read stats for current whole device using /sys/block/ directory */
+		if (read_sysfs_file_stat(d->name, d->dev_stats[curr]) == 0) {
+			d->exist = TRUE;
+		}
+
+		if (d->dev_tp == T_PART_DEV) {
+			/* Also read all its partitions now */
+			read_sysfs_device_part_stat(curr, d->name, NULL);
+		}
+	}
+}
+
 /*
  ***************************************************************************
  * Read stats from the sysfs filesystem for the devices entered on the
- * command line.
+ * command line. Only used when no diskstats file is available.
  *
  * IN:
  * @curr	Index in array for current sample statistics.
@@ -751,27 +991,7 @@ void read_sysfs_dlist_stat(int curr)
 			/* Device stats already read */
 			continue;
 
-		else if (dlist->dev_tp == T_PART) {
-			/*
-			 * This is a partition.
-			 * Read its stats using /sys/dev/block/M:n/ directory.
-			 */
-			if (read_sysfs_part_stat(curr, dlist) == 0) {
-				dlist->exist = TRUE;
-			}
-		}
-
-		else if ((dlist->dev_tp == T_PART_DEV) || (dlist->dev_tp == T_DEV)) {
-			/* Read stats for current whole device using /sys/block/ directory */
-			if (read_sysfs_file_stat(dlist->name, dlist->dev_stats[curr]) == 0) {
-				dlist->exist = TRUE;
-			}
-
-			if (dlist->dev_tp == T_PART_DEV) {
-				/* Also read all its partitions now */
-				read_sysfs_device_part_stat(curr, dlist->name);
-			}
-		}
+		read_sysfs_dev_stat(curr, dlist);
 	}
 
 	/* Read all whole devices stats if requested ("iostat ALL ...") */
@@ -782,21 +1002,49 @@ void read_sysfs_dlist_stat(int curr)
 
 /*
  ***************************************************************************
- * Read stats from the diskstats file. Only used when "-p ALL" has been
- * entered on the command line.
+ * Compare major and minor numbers of two diskstats table entries.
+ * Used by qsort() and bsearch().
+ *
+ * IN:
+ * @a	Pointer on first entry pointer.
+ * @b	Pointer on second entry pointer.
+ *
+ * RETURNS:
+ * A negative, zero or positive value as for strcmp().
+ ***************************************************************************
+ */
+int cmp_dstat_devt(const void *a, const void *b)
+{
+	const struct dstat_entry *ea = *((struct dstat_entry * const *) a);
+	const struct dstat_entry *eb = *((struct dstat_entry * const *) b);
+
+	if (ea->major != eb->major)
+		return (ea->major < eb->major ? -1 : 1);
+	if (ea->minor != eb->minor)
+		return (ea->minor < eb->minor ? -1 : 1);
+
+	return 0;
+}
+
+/*
+ ***************************************************************************
+ * Read a diskstats file and append its entries to the diskstats table.
+ * In diskstats, the partitions of a device immediately follow it.
  *
  * IN:
- * @curr	Index in array for current sample statistics.
  * @diskstats	Path to diskstats file (e.g. "/proc/diskstats").
+ *
+ * RETURNS:
+ * 0 on success, -1 if the file couldn't be read.
  ***************************************************************************
  */
-void read_diskstats_stat_work(int curr, char *diskstats)
+int read_diskstats_table_work(char *diskstats)
 {
 	FILE *fp;
 	char line[1024], dev_name[MAX_NAME_LEN], aux[128];
-	struct io_device *d;
+	struct dstat_entry *e;
 	struct io_stats sdev;
-	int i;
+	int i, disk = -1;
 	unsigned int ios_pgr, tot_ticks, rq_ticks, wr_ticks, dc_ticks, fl_ticks;
 	unsigned long rd_ios, rd_merges_or_rd_sec, rd_ticks_or_wr_sec, wr_ios;
 	unsigned long wr_merges, rd_sec_or_wr_ios, wr_sec;
@@ -804,7 +1052,7 @@ void read_diskstats_stat_work(int curr, char *diskstats)
 	unsigned int major, minor;
 
 	if ((fp = fopen(diskstats, "r")) == NULL)
-		return;
+		return -1;
 
 	sprintf(aux, "%%u %%u %%%ds %%lu %%lu %%lu %%lu %%lu %%lu "
 		     "%%lu %%u %%u %%u %%u %%lu %%lu %%lu %%u %%lu %%u",
@@ -851,9 +1099,6 @@ void read_diskstats_stat_work(int curr, char *diskstats)
 		}
 		else if (i == 7) {
 			/* Partition without extended statistics */
-			if (DISPLAY_EXTENDED(flags))
-				continue;
-
 			sdev.rd_ios     = rd_ios;
 			sdev.rd_sectors = rd_merges_or_rd_sec;
 			sdev.wr_ios     = rd_sec_or_wr_ios;
@@ -863,36 +1108,462 @@ void read_diskstats_stat_work(int curr, char *diskstats)
 			/* Unknown entry: Ignore it */
 			continue;
 
-		d = add_list_device(&dev_list, dev_name, 0, major, minor);
-		if (d != NULL) {
-			*d->dev_stats[curr] = sdev;
+		if (dstat_nr >= dstat_sz) {
+			/* Enlarge the table */
+			dstat_sz += NR_DSTAT_PREALLOC;
+			if ((dstat_tab = (struct dstat_entry *) realloc(dstat_tab,
+						dstat_sz * sizeof(struct dstat_entry))) == NULL) {
+				perror("realloc");
+				exit(4);
+			}
+		}
+
+		e = dstat_tab + dstat_nr;
+		snprintf(e->name, sizeof(e->name), "%s", dev_name);
+		e->major = major;
+		e->minor = minor;
+		e->basic = (i == 7);
+		e->part = e->basic ||
+			  ((disk >= 0) && is_partition_name(dstat_tab[disk].name, dev_name));
+		e->ios = sdev;
+
+		if (!e->part) {
+			/* Following partitions will belong to this device */
+			disk = dstat_nr;
+		}
+		dstat_nr++;
+	}
+	fclose(fp);
+
+	return 0;
+}
+
+/*
+ ***************************************************************************
+ * Fill the diskstats table from /proc/diskstats and/or an alternate
+ * diskstats file, then index its entries by major:minor numbers.
+ * This is the single read made for block devices statistics during a
+ * sample.
+ *
+ * RETURNS:
+ * 0 on success, -1 if no diskstats file could be read.
+ ***************************************************************************
+ */
+int read_diskstats_table(void)
+{
+	int i, rc = -1;
+
+	dstat_nr = 0;
+
+	if (!alt_dir[0] || USE_ALL_DIR(flags)) {
+		/* Read stats from /proc/diskstats */
+		rc = read_diskstats_table_work(DISKSTATS);
+	}
+
+	if (alt_dir[0]) {
+		char diskstats[MAX_PF_NAME];
+
+		snprintf(diskstats, sizeof(diskstats), "%s/%s", alt_dir, __DISKSTATS);
+		/* Read stats from an alternate diskstats file */
+		if (read_diskstats_table_work(diskstats) == 0) {
+			rc = 0;
+		}
+	}
+
+	/* (Re)build index sorted by major:minor numbers */
+	if ((dstat_idx = (struct dstat_entry **) realloc(dstat_idx,
+				(dstat_sz ? dstat_sz : 1) * sizeof(struct dstat_entry *))) == NULL) {
+		perror("realloc");
+		exit(4);
+	}
+	for (i = 0; i < dstat_nr; i++) {
+		dstat_idx[i] = dstat_tab + i;
+	}
+	qsort(dstat_idx, dstat_nr, sizeof(struct dstat_entry *), cmp_dstat_devt);
+
+	return rc;
+}
+
+/*
+ ***************************************************************************
+ * Look for a device in the diskstats table, using its major and minor
+ * numbers if they are known, or else its name. Major and minor numbers of
+ * a device found by name are saved so that the next lookups are indexed.
+ *
+ * IN:
+ * @d		Device structure.
+ *
+ * RETURNS:
+ * Pointer on the diskstats table entry, or NULL if device not found.
+ ***************************************************************************
+ */
+struct dstat_entry *get_dstat_entry(struct io_device *d)
+{
+	struct dstat_entry key, *pkey = &key, **pe;
+	int i;
+
+	if (d->major || d->minor) {
+		key.major = d->major;
+		key.minor = d->minor;
+		pe = bsearch(&pkey, dstat_idx, dstat_nr, sizeof(struct dstat_entry *),
+			     cmp_dstat_devt);
+		if (pe != NULL)
+			return *pe;
+	}
+
+	for (i = 0; i < dstat_nr; i++) {
+		if (same_device_name(dstat_tab[i].name, d->name)) {
+			d->major = dstat_tab[i].major;
+			d->minor = dstat_tab[i].minor;
+			return dstat_tab + i;
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ ***************************************************************************
+ * Save stats from the diskstats table for a device, adding it to the
+ * linked list if needed.
+ *
+ * IN:
+ * @curr	Index in array for current sample statistics.
+ * @e		Diskstats table entry.
+ ***************************************************************************
+ */
+void add_dstat_entry(int curr, struct dstat_entry *e)
+{
+	struct io_device *d;
+	char dev_name[MAX_NAME_LEN];
+
+	/* add_list_device() may alter the name it is given */
+	snprintf(dev_name, sizeof(dev_name), "%s", e->name);
+
+	d = add_list_device(&dev_list, dev_name, 0, e->major, e->minor);
+	if (d != NULL) {
+		*d->dev_stats[curr] = e->ios;
+	}
+}
+
+/*
+ ***************************************************************************
+ * Tell if a partition belongs to a whole device entered with option -p.
+ * Such partitions are read (or found missing) along with their device.
+ *
+ * IN:
+ * @d		Partition in the linked list.
+ *
+ * RETURNS:
+ * TRUE if the partition is read along with its whole device.
+ ***************************************************************************
+ */
+int is_dlist_dev_part(struct io_device *d)
+{
+	struct io_device *dlist;
+
+	for (dlist = dev_list; dlist != NULL; dlist = dlist->next) {
+		if ((dlist->dev_tp == T_PART_DEV) && is_partition_name(dlist->name, d->name))
+			return TRUE;
+	}
+
+	return FALSE;
+}
+
+/*
+ ***************************************************************************
+ * Read stats for the devices entered on the command line from the
+ * diskstats table. Partitions of devices entered with option -p are those
+ * found in sysfs, and their stats are also taken from the table. sysfs stat
+ * files are only read for devices (or partitions) which are not listed in
+ * diskstats, and if no diskstats file is available. Whole devices for
+ * "iostat ALL" are still those found in sysfs.
+ *
+ * IN:
+ * @curr	Index in array for current sample statistics.
+ ***************************************************************************
+ */
+void read_dlist_stat(int curr)
+{
+	struct io_device *dlist;
+	struct dstat_entry *e;
+
+	if (read_diskstats_table() < 0) {
+		read_sysfs_dlist_stat(curr);
+		return;
+	}
+
+	for (dlist = dev_list; dlist != NULL; dlist = dlist->next) {
+		if (dlist->exist || (dlist->dev_tp >= T_GROUP))
+			/* Device stats already read, or group name */
+			continue;
+
+		if (DISPLAY_ALL_DEVICES(flags) && (dlist->dev_tp == T_DEV))
+			/* Whole devices are all read from sysfs below */
+			continue;
+
+		if ((dlist->dev_tp == T_PART) && is_dlist_dev_part(dlist))
+			/* Partition no longer found with its whole device */
+			continue;
+
+		if ((e = get_dstat_entry(dlist)) == NULL) {
+			/* Device not found in diskstats: Read its stats from sysfs */
+			read_sysfs_dev_stat(curr, dlist);
+			continue;
+		}
+
+		*(dlist->dev_stats[curr]) = e->ios;
+		dlist->exist = TRUE;
+
+		if (dlist->dev_tp == T_PART_DEV) {
+			/* Also save all its partitions now */
+			read_sysfs_device_part_stat(curr, dlist->name, e);
+		}
+	}
+
+	/* Read all whole devices stats if requested ("iostat ALL ...") */
+	if (DISPLAY_ALL_DEVICES(flags)) {
+		read_sysfs_all_devices_stat(curr);
+	}
+}
+
+/*
+ ***************************************************************************
+ * Read stats from /proc/diskstats or an alternate diskstats file.
+ * Only used when "-p ALL" has been entered on the command line.
+ *
+ * IN:
+ * @curr	Index in array for current sample statistics.
+ ***************************************************************************
+ */
+void read_diskstats_stat(int curr)
+{
+	int i;
+
+	read_diskstats_table();
+
+	for (i = 0; i < dstat_nr; i++) {
+		if (dstat_tab[i].basic && DISPLAY_EXTENDED(flags))
+			/* Partition without extended statistics */
+			continue;
+
+		add_dstat_entry(curr, dstat_tab + i);
+	}
+}
+
+/*
+ ***************************************************************************
+ * Read a single counter from a file.
+ *
+ * IN:
+ * @filename	Name of the file to read.
+ *
+ * RETURNS:
+ * Value of the counter (0 if the file cannot be read).
+ ***************************************************************************
+ */
+unsigned long read_hctx_counter(char *filename)
+{
+	FILE *fp;
+	unsigned long val = 0;
+
+	if ((fp = fopen(filename, "r")) == NULL)
+		return 0;
+
+	if (fscanf(fp, "%lu", &val) != 1) {
+		val = 0;
+	}
+	fclose(fp);
+
+	return val;
+}
+
+/*
+ ***************************************************************************
+ * Read the number of dispatches done for a hardware queue. The "dispatched"
+ * file is a histogram of the number of requests sent to the driver at each
+ * dispatch: The first bucket counts the dispatches which sent nothing.
+ *
+ * IN:
+ * @filename	Name of the file to read.
+ *
+ * RETURNS:
+ * Number of dispatches which sent at least one request.
+ ***************************************************************************
+ */
+unsigned long read_hctx_dispatched(char *filename)
+{
+	FILE *fp;
+	char line[128];
+	unsigned long order, count, disp = 0;
+
+	if ((fp = fopen(filename, "r")) == NULL)
+		return 0;
+
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		if ((sscanf(line, "%lu %lu", &order, &count) == 2) && order) {
+			disp += count;
+		}
+	}
+	fclose(fp);
+
+	return disp;
+}
+
+/*
+ ***************************************************************************
+ * Compare two hardware queues by number (used to sort them).
+ *
+ * IN:
+ * @a		First hardware queue.
+ * @b		Second hardware queue.
+ *
+ * RETURNS:
+ * Result of the comparison.
+ ***************************************************************************
+ */
+int cmp_hctx_id(const void *a, const void *b)
+{
+	const struct hctx_stats *h1 = a, *h2 = b;
+
+	return (h1->id > h2->id) - (h1->id < h2->id);
+}
+
+/*
+ ***************************************************************************
+ * Read statistics for the hardware queues of a blk-mq device.
+ * The list of hardware queues and the CPUs mapped to them come from
+ * sysfs. The counters come from debugfs and are 0 if it is not mounted or
+ * readable.
+ *
+ * IN:
+ * @curr	Index in array for current sample statistics.
+ * @d		Device whose hardware queues are to be read.
+ * @sysdir	sysfs directory (e.g. "/sys").
+ * @dname	Device name, as found in sysfs.
+ *
+ * RETURNS:
+ * -1 if the device is not a blk-mq one, or if the mq directory couldn't
+ * be opened, 0 otherwise.
+ ***************************************************************************
+ */
+int read_hctx_stat_work(int curr, struct io_device *d, char *sysdir, char *dname)
+{
+	DIR *dir;
+	FILE *fp;
+	struct dirent *drd;
+	struct hctx_stats *hs;
+	char dfile[MAX_PF_NAME], filename[MAX_PF_NAME + 512];
+	int i, nr = 0;
+
+	snprintf(dfile, sizeof(dfile), "%s/%s/%s/%s", sysdir, __BLOCK, dname, __MQ);
+
+	/* Open mq directory of the device in /sys/block */
+	if ((dir = __opendir(dfile)) == NULL)
+		return -1;
+
+	/* One sub-directory per hardware queue, named after its number */
+	while ((drd = __readdir(dir)) != NULL) {
+
+		if (!drd->d_name[0] || (strspn(drd->d_name, DIGITS) != strlen(drd->d_name)))
+			continue;
+
+		if (nr >= d->hctx_sz) {
+			d->hctx_sz = d->hctx_sz ? d->hctx_sz * 2 : 8;
+			for (i = 0; i < 2; i++) {
+				SREALLOC(d->hctx[i], struct hctx_stats,
+					 sizeof(struct hctx_stats) * (size_t) d->hctx_sz);
+			}
+		}
+		hs = &(d->hctx[curr][nr++]);
+		memset(hs, 0, sizeof(struct hctx_stats));
+		hs->id = (unsigned int) atoi(drd->d_name);
+
+		snprintf(filename, sizeof(filename), "%s/%s/%s", dfile, drd->d_name, S_CPU_LIST);
+		if ((fp = fopen(filename, "r")) != NULL) {
+			if (fgets(hs->cpu_list, sizeof(hs->cpu_list), fp) != NULL) {
+				hs->cpu_list[strcspn(hs->cpu_list, "\n")] = '\0';
+			}
+			fclose(fp);
+		}
+
+		snprintf(filename, sizeof(filename), "%s/%s/%s/hctx%u/%s",
+			 sysdir, __DEBUG_BLOCK, dname, hs->id, S_HCTX_QUEUED);
+		hs->queued = read_hctx_counter(filename);
+
+		snprintf(filename, sizeof(filename), "%s/%s/%s/hctx%u/%s",
+			 sysdir, __DEBUG_BLOCK, dname, hs->id, S_HCTX_RUN);
+		hs->run = read_hctx_counter(filename);
+
+		snprintf(filename, sizeof(filename), "%s/%s/%s/hctx%u/%s",
+			 sysdir, __DEBUG_BLOCK, dname, hs->id, S_HCTX_DISP);
+		hs->dispatched = read_hctx_dispatched(filename);
+	}
+
+	/* Close mq directory */
+	__closedir(dir);
+
+	if (nr > 1) {
+		/* Directory entries are not sorted */
+		qsort(d->hctx[curr], nr, sizeof(struct hctx_stats), cmp_hctx_id);
+	}
+	d->hctx_nr[curr] = nr;
+
+	return 0;
+}
+
+/*
+ ***************************************************************************
+ * Read statistics for the hardware queues of a device, either from /sys
+ * or from an alternate directory given with option -f or +f.
+ *
+ * IN:
+ * @curr	Index in array for current sample statistics.
+ * @d		Device whose hardware queues are to be read.
+ ***************************************************************************
+ */
+void read_hctx_stat(int curr, struct io_device *d)
+{
+	char dname[MAX_NAME_LEN], *c;
+	int rc = 0;
+
+	d->hctx_nr[curr] = 0;
+
+	/* Name of the device in sysfs (e.g. "cciss!c0d0") */
+	snprintf(dname, sizeof(dname), "%s", d->name);
+	for (c = dname; *c; c++) {
+		if (*c == '/') {
+			*c = '!';
 		}
 	}
-	fclose(fp);
+
+	if (!alt_dir[0] || USE_ALL_DIR(flags)) {
+		/* Read stats from /sys */
+		rc = read_hctx_stat_work(curr, d, SLASH_SYS, dname);
+	}
+
+	if (alt_dir[0] && (!USE_ALL_DIR(flags) || (USE_ALL_DIR(flags) && (rc < 0)))) {
+		/* Read stats from an alternate /sys directory */
+		read_hctx_stat_work(curr, d, alt_dir, dname);
+	}
 }
 
 /*
  ***************************************************************************
- * Read stats from /proc/diskstats or an alternate diskstats file.
- * Only used when "-p ALL" has been entered on the command line.
+ * Read statistics for the hardware queues of the devices in the list.
  *
  * IN:
  * @curr	Index in array for current sample statistics.
  ***************************************************************************
  */
-void read_diskstats_stat(int curr)
+void read_dlist_hctx_stat(int curr)
 {
-	if (!alt_dir[0] || USE_ALL_DIR(flags)) {
-		/* Read stats from /proc/diskstats */
-		read_diskstats_stat_work(curr, DISKSTATS);
-	}
-
-	if (alt_dir[0]) {
-		char diskstats[MAX_PF_NAME];
+	struct io_device *dlist;
 
-		snprintf(diskstats, sizeof(diskstats), "%s/%s", alt_dir, __DISKSTATS);
-		/* Read stats from an alternate diskstats file */
-		read_diskstats_stat_work(curr, diskstats);
+	for (dlist = dev_list; dlist != NULL; dlist = dlist->next) {
+		if (dlist->exist && (dlist->dev_tp < T_GROUP)) {
+			read_hctx_stat(curr, dlist);
+		}
 	}
 }
 
@@ -1755,6 +2426,415 @@ void write_basic_stat(unsigned long long itv, int fctr,
 	}
 }
 
+/*
+ ***************************************************************************
+ * Compute the value of the key used to sort devices with option --top.
+ *
+ * IN:
+ * @itv		Interval of time.
+ * @d		Structure containing device description.
+ * @ioi		Current sample statistics.
+ * @ioj		Previous sample statistics.
+ *
+ * RETURNS:
+ * Value of the sort key for this device.
+ ***************************************************************************
+ */
+double get_top_key(unsigned long long itv, struct io_device *d,
+		   struct io_stats *ioi, struct io_stats *ioj)
+{
+	unsigned long nr_ios;
+	int dev_in_grp;
+
+	switch (top_key) {
+
+	case TOP_AWAIT:
+		/* Origin (unmerged) flush operations are counted as writes */
+		nr_ios = (ioi->rd_ios + ioi->wr_ios + ioi->dc_ios) -
+			 (ioj->rd_ios + ioj->wr_ios + ioj->dc_ios);
+		if (!nr_ios || ((ioi->rd_ios + ioi->wr_ios + ioi->dc_ios) <
+				(ioj->rd_ios + ioj->wr_ios + ioj->dc_ios)))
+			return 0.0;
+		return ((ioi->rd_ticks - ioj->rd_ticks) + (ioi->wr_ticks - ioj->wr_ticks) +
+			(ioi->dc_ticks - ioj->dc_ticks)) / (double) nr_ios;
+
+	case TOP_TPS:
+		return S_VALUE(ioj->rd_ios + ioj->wr_ios + ioj->dc_ios,
+			       ioi->rd_ios + ioi->wr_ios + ioi->dc_ios, itv);
+
+	case TOP_TPUT:
+		return (ioi->rd_sectors < ioj->rd_sectors ? 0.0 :
+			S_VALUE(ioj->rd_sectors, ioi->rd_sectors, itv)) +
+		       (ioi->wr_sectors < ioj->wr_sectors ? 0.0 :
+			S_VALUE(ioj->wr_sectors, ioi->wr_sectors, itv)) +
+		       (ioi->dc_sectors < ioj->dc_sectors ? 0.0 :
+			S_VALUE(ioj->dc_sectors, ioi->dc_sectors, itv));
+
+	default:	/* TOP_UTIL */
+		if (ioi->tot_ticks < ioj->tot_ticks)
+			return 0.0;
+		dev_in_grp = (d->dev_tp > T_GROUP) ? d->dev_tp - T_GROUP : 1;
+		return S_VALUE(ioj->tot_ticks, ioi->tot_ticks, itv) / (double) dev_in_grp;
+	}
+}
+
+/*
+ ***************************************************************************
+ * Tell if an entry of the top heap ranks lower than another one. Devices
+ * with the same key value are ranked in the order of the device list.
+ *
+ * IN:
+ * @e1		First entry.
+ * @e2		Second entry.
+ *
+ * RETURNS:
+ * TRUE if @e1 ranks lower than @e2.
+ ***************************************************************************
+ */
+int top_lower(struct top_entry *e1, struct top_entry *e2)
+{
+	if (e1->key != e2->key)
+		return e1->key < e2->key;
+
+	return e1->seq > e2->seq;
+}
+
+/*
+ ***************************************************************************
+ * Move down an entry of the top heap until the heap property is restored.
+ *
+ * IN:
+ * @i		Index of the entry in the heap.
+ * @nr		Number of entries in the heap.
+ ***************************************************************************
+ */
+void top_sift_down(int i, int nr)
+{
+	struct top_entry tmp;
+	int j;
+
+	while ((j = 2 * i + 1) < nr) {
+		if ((j + 1 < nr) && top_lower(&top_heap[j + 1], &top_heap[j])) {
+			j++;
+		}
+		if (!top_lower(&top_heap[j], &top_heap[i]))
+			break;
+
+		tmp = top_heap[i];
+		top_heap[i] = top_heap[j];
+		top_heap[j] = tmp;
+		i = j;
+	}
+}
+
+/*
+ ***************************************************************************
+ * Offer a device to the top heap. The device is kept only if it ranks
+ * higher than the lowest device already selected.
+ *
+ * IN:
+ * @itv		Interval of time.
+ * @seq		Position of the device in the list.
+ * @d		Structure containing device description.
+ * @ioi		Current sample statistics.
+ * @ioj		Previous sample statistics.
+ ***************************************************************************
+ */
+void add_top_device(unsigned long long itv, unsigned int seq, struct io_device *d,
+		    struct io_stats *ioi, struct io_stats *ioj)
+{
+	struct top_entry e, tmp;
+	int i, p;
+
+	e.key = get_top_key(itv, d, ioi, ioj);
+	e.seq = seq;
+	e.d = d;
+	e.ioj = ioj;
+
+	if (top_cnt < top_nr) {
+		/* Heap not full yet: Move new entry up to its place */
+		i = top_cnt++;
+		top_heap[i] = e;
+		while (i > 0) {
+			p = (i - 1) / 2;
+			if (!top_lower(&top_heap[i], &top_heap[p]))
+				break;
+			tmp = top_heap[i];
+			top_heap[i] = top_heap[p];
+			top_heap[p] = tmp;
+			i = p;
+		}
+	}
+	else if (top_lower(&top_heap[0], &e)) {
+		/* Replace lowest device selected so far */
+		top_heap[0] = e;
+		top_sift_down(0, top_cnt);
+	}
+}
+
+/*
+ ***************************************************************************
+ * Sort the devices selected in the top heap, highest ranking first.
+ * The heap is no longer valid after this call.
+ ***************************************************************************
+ */
+void sort_top_devices(void)
+{
+	struct top_entry tmp;
+	int i;
+
+	/* Heapsort: Lowest entries are moved to the end of the array */
+	for (i = top_cnt - 1; i > 0; i--) {
+		tmp = top_heap[0];
+		top_heap[0] = top_heap[i];
+		top_heap[i] = tmp;
+		top_sift_down(0, i);
+	}
+}
+
+/*
+ ***************************************************************************
+ * Display hardware queues statistics header.
+ *
+ * IN:
+ * @tab		Number of tabs to print (JSON output only).
+ ***************************************************************************
+ */
+void write_hctx_stat_header(int *tab)
+{
+	if (DISPLAY_JSON_OUTPUT(xflags)) {
+		xprintf((*tab)++, "\"hctx\": [");
+		return;
+	}
+
+	if (!DISPLAY_PRETTY(flags)) {
+		printf("\nDevice       ");
+	}
+	else {
+		printf("\n");
+	}
+	printf("  hctx   queued/s      run/s     disp/s   %%share CPUs");
+	if (DISPLAY_PRETTY(flags)) {
+		printf(" Device");
+	}
+	printf("\n");
+}
+
+/*
+ ***************************************************************************
+ * Display statistics for the hardware queues of a device, in plain or
+ * JSON format.
+ *
+ * IN:
+ * @curr	Index in array for current sample statistics.
+ * @itv		Interval of time.
+ * @d		Device whose hardware queues are to be displayed.
+ * @tab		Number of tabs to print (JSON output only).
+ * @dname	Name to be used for display for current device.
+ *
+ * OUT:
+ * @next	Set to TRUE once a hardware queue has been displayed (JSON
+ *		output needs a separator before the next one).
+ ***************************************************************************
+ */
+void write_hctx_stat(int curr, unsigned long long itv, struct io_device *d,
+		     int tab, char *dname, int *next)
+{
+	struct hctx_stats *hc, *hp, hzero;
+	unsigned long tot_queued = 0;
+	double queued, run, disp, share;
+	int i, prev;
+
+	memset(&hzero, 0, sizeof(struct hctx_stats));
+
+	/* Use previous sample only if the hardware queues are the same */
+	prev = (d->hctx_nr[!curr] == d->hctx_nr[curr]);
+	for (i = 0; i < d->hctx_nr[curr]; i++) {
+		hc = &(d->hctx[curr][i]);
+		hp = &(d->hctx[!curr][i]);
+		if (prev && ((hp->id != hc->id) || (hc->queued < hp->queued))) {
+			prev = FALSE;
+		}
+	}
+	for (i = 0; i < d->hctx_nr[curr]; i++) {
+		hc = &(d->hctx[curr][i]);
+		tot_queued += hc->queued - (prev ? d->hctx[!curr][i].queued : 0);
+	}
+
+	for (i = 0; i < d->hctx_nr[curr]; i++) {
+		hc = &(d->hctx[curr][i]);
+		hp = prev ? &(d->hctx[!curr][i]) : &hzero;
+
+		if (DISPLAY_ZERO_OMIT(flags) && (hc->queued == hp->queued))
+			/* No activity: Ignore it */
+			continue;
+
+		queued = S_VALUE(hp->queued, hc->queued, itv);
+		run = hc->run < hp->run ? 0.0 : S_VALUE(hp->run, hc->run, itv);
+		disp = hc->dispatched < hp->dispatched ? 0.0 :
+		       S_VALUE(hp->dispatched, hc->dispatched, itv);
+		share = tot_queued ?
+			(double) (hc->queued - hp->queued) / tot_queued * 100 : 0.0;
+
+		if (DISPLAY_JSON_OUTPUT(xflags)) {
+			if (*next) {
+				printf(",\n");
+			}
+			xprintf0(tab,
+				 "{\"disk_device\": \"%s\", \"hctx\": %u, "
+				 "\"queued/s\": %.2f, \"run/s\": %.2f, \"disp/s\": %.2f, "
+				 "\"share\": %.2f, \"cpus\": \"%s\"}",
+				 dname, hc->id, queued, run, disp, share, hc->cpu_list);
+		}
+		else {
+			if (!DISPLAY_PRETTY(flags)) {
+				cprintf_in(IS_STR, "%-13s", dname, 0);
+			}
+			cprintf_in(IS_INT, " %5d", "", (int) hc->id);
+			cprintf_f(NO_UNIT, FALSE, 3, 10, 2, queued, run, disp);
+			cprintf_xpc(DISPLAY_UNIT(flags), XHIGH, 1, 7, 2, share);
+			cprintf_s(IS_STR, " %s", hc->cpu_list[0] ? hc->cpu_list : "-");
+			if (DISPLAY_PRETTY(flags)) {
+				cprintf_in(IS_STR, " %s", dname, 0);
+			}
+			printf("\n");
+		}
+		*next = TRUE;
+	}
+}
+
+/*
+ ***************************************************************************
+ * Display statistics for the hardware queues of the devices. With option
+ * --top, only the devices selected are displayed.
+ *
+ * IN:
+ * @curr	Index in array for current sample statistics.
+ * @itv		Interval of time.
+ * @tab		Number of tabs to print (JSON output only).
+ ***************************************************************************
+ */
+void write_dlist_hctx_stat(int curr, unsigned long long itv, int tab)
+{
+	struct io_device *d;
+	struct io_stats *ioi;
+	char *dev_name;
+	int i = 0, next = FALSE;
+
+	write_hctx_stat_header(&tab);
+
+	for (d = DISPLAY_TOP(flags) ? NULL : dev_list; ; d = d->next) {
+		if (DISPLAY_TOP(flags)) {
+			if (i >= top_cnt)
+				break;
+			d = top_heap[i++].d;
+		}
+		else if (d == NULL)
+			break;
+
+		if (!d->exist || (d->dev_tp >= T_GROUP) || !d->hctx_nr[curr])
+			continue;
+
+		ioi = d->dev_stats[curr];
+		if (!DISPLAY_UNFILTERED(flags) &&
+		    !ioi->rd_ios && !ioi->wr_ios && !ioi->dc_ios && !ioi->fl_ios)
+			/* Device not displayed in the Device Utilization Report */
+			continue;
+
+		dev_name = get_device_name(d->major, d->minor, NULL, 0,
+					   DISPLAY_DEVMAP_NAME(flags),
+					   DISPLAY_PERSIST_NAME_I(flags),
+					   FALSE, d->name);
+		write_hctx_stat(curr, itv, d, tab, dev_name, &next);
+	}
+
+	if (DISPLAY_JSON_OUTPUT(xflags)) {
+		printf("\n");
+		xprintf(--tab, "]");
+	}
+}
+
+/*
+ ***************************************************************************
+ * Display statistics for a device (or a group of devices).
+ *
+ * IN:
+ * @curr	Index in array for current sample statistics.
+ * @itv		Interval of time.
+ * @fctr	Conversion factor.
+ * @hpart	Indicate which part of the report should be displayed in
+ *		human mode.
+ * @d		Structure containing device description.
+ * @ioi		Current sample statistics.
+ * @ioj		Previous sample statistics.
+ * @tab		Number of tabs to print (JSON output only).
+ * @skip	TRUE if nothing should be displayed (option -y).
+ *
+ * OUT:
+ * @next	Set to TRUE once a device has been displayed (JSON output
+ *		needs a separator before the next one).
+ ***************************************************************************
+ */
+void write_dev_stat(int curr, unsigned long long itv, int fctr, int hpart,
+		    struct io_device *d, struct io_stats *ioi, struct io_stats *ioj,
+		    int tab, int skip, int *next)
+{
+	char *dev_name;
+
+	dev_name = get_device_name(d->major, d->minor, NULL, 0,
+				   DISPLAY_DEVMAP_NAME(flags),
+				   DISPLAY_PERSIST_NAME_I(flags),
+				   FALSE, d->name);
+#ifdef DEBUG
+	if (DISPLAY_DEBUG(xflags)) {
+		/* Debug output */
+		fprintf(stderr,
+			"name=%s itv=%llu fctr=%d ioi{ rd_sectors=%lu "
+			"wr_sectors=%lu dc_sectors=%lu "
+			"rd_ios=%lu rd_merges=%lu rd_ticks=%u "
+			"wr_ios=%lu wr_merges=%lu wr_ticks=%u "
+			"dc_ios=%lu dc_merges=%lu dc_ticks=%u "
+			"fl_ios=%lu fl_ticks=%u "
+			"ios_pgr=%u tot_ticks=%u "
+			"rq_ticks=%u }\n",
+			dev_name,
+			itv,
+			fctr,
+			ioi->rd_sectors,
+			ioi->wr_sectors,
+			ioi->dc_sectors,
+			ioi->rd_ios,
+			ioi->rd_merges,
+			ioi->rd_ticks,
+			ioi->wr_ios,
+			ioi->wr_merges,
+			ioi->wr_ticks,
+			ioi->dc_ios,
+			ioi->dc_merges,
+			ioi->dc_ticks,
+			ioi->fl_ios,
+			ioi->fl_ticks,
+			ioi->ios_pgr,
+			ioi->tot_ticks,
+			ioi->rq_ticks);
+	}
+#endif
+
+	if (!skip) {
+		if (DISPLAY_JSON_OUTPUT(xflags) && *next) {
+			printf(",\n");
+		}
+		*next = TRUE;
+
+		if (DISPLAY_EXTENDED(flags)) {
+			write_ext_stat(itv, fctr, hpart, d, ioi, ioj, tab, dev_name);
+		}
+		else {
+			write_basic_stat(itv, fctr, d, ioi, ioj, tab, dev_name);
+		}
+	}
+}
+
 /*
  ***************************************************************************
  * Print everything now (stats and uptime).
@@ -1768,10 +2848,10 @@ void write_basic_stat(unsigned long long itv, int fctr,
  */
 void write_stats(int curr, struct tm *rectime, int skip)
 {
-	int h, hl = 0, hh = 0, fctr = 1, tab = 4, next = FALSE;
+	int h, i, hl = 0, hh = 0, fctr = 1, tab = 4, next = FALSE;
 	unsigned long long itv;
+	unsigned int seq = 0;
 	struct io_device *d, *dtmp, *g = NULL, *dnext = NULL;
-	char *dev_name;
 
 	/* Test stdout */
 	TEST_STDOUT(STDOUT_FILENO);
@@ -1798,7 +2878,7 @@ void write_stats(int curr, struct tm *rectime, int skip)
 	}
 
 	/* Calculate time interval in 1/100th of a second */
-	itv = get_interval(uptime_cs[!curr], uptime_cs[curr]);
+	itv = get_interval_ns(uptime_ns[!curr], uptime_ns[curr]);
 
 	if (DISPLAY_DISK(flags)) {
 		struct io_stats *ioi, *ioj, iozero;
@@ -1813,6 +2893,8 @@ void write_stats(int curr, struct tm *rectime, int skip)
 			hl = 1; hh = 4;
 		}
 
+		top_cnt = 0;
+
 		for (h = hl; h <= hh; h++) {
 
 			if (!skip) {
@@ -1820,7 +2902,11 @@ void write_stats(int curr, struct tm *rectime, int skip)
 				write_disk_stat_header(&fctr, &tab, h);
 			}
 
-			for (d = dev_list; ; d = dnext) {
+			/*
+			 * With option --top, devices are ranked during the first pass only.
+			 * The next parts of the report display the same devices.
+			 */
+			for (d = (DISPLAY_TOP(flags) && (h > hl)) ? NULL : dev_list; ; d = dnext) {
 
 				if (d == NULL) {
 					if (g == NULL)
@@ -1893,57 +2979,25 @@ void write_stats(int curr, struct tm *rectime, int skip)
 					    ioj = &iozero;
 				}
 
-				dev_name = get_device_name(d->major, d->minor, NULL, 0,
-							   DISPLAY_DEVMAP_NAME(flags),
-							   DISPLAY_PERSIST_NAME_I(flags),
-							   FALSE, d->name);
-#ifdef DEBUG
-				if (DISPLAY_DEBUG(xflags)) {
-					/* Debug output */
-					fprintf(stderr,
-						"name=%s itv=%llu fctr=%d ioi{ rd_sectors=%lu "
-						"wr_sectors=%lu dc_sectors=%lu "
-						"rd_ios=%lu rd_merges=%lu rd_ticks=%u "
-						"wr_ios=%lu wr_merges=%lu wr_ticks=%u "
-						"dc_ios=%lu dc_merges=%lu dc_ticks=%u "
-						"fl_ios=%lu fl_ticks=%u "
-						"ios_pgr=%u tot_ticks=%u "
-						"rq_ticks=%u }\n",
-						dev_name,
-						itv,
-						fctr,
-						ioi->rd_sectors,
-						ioi->wr_sectors,
-						ioi->dc_sectors,
-						ioi->rd_ios,
-						ioi->rd_merges,
-						ioi->rd_ticks,
-						ioi->wr_ios,
-						ioi->wr_merges,
-						ioi->wr_ticks,
-						ioi->dc_ios,
-						ioi->dc_merges,
-						ioi->dc_ticks,
-						ioi->fl_ios,
-						ioi->fl_ticks,
-						ioi->ios_pgr,
-						ioi->tot_ticks,
-						ioi->rq_ticks);
+				if (DISPLAY_TOP(flags)) {
+					/* Devices are displayed once they have all been ranked */
+					if (!skip) {
+						add_top_device(itv, seq++, d, ioi, ioj);
+					}
+					continue;
 				}
-#endif
 
-				if (!skip) {
-					if (DISPLAY_JSON_OUTPUT(xflags) && next) {
-						printf(",\n");
-					}
-					next = TRUE;
+				write_dev_stat(curr, itv, fctr, h, d, ioi, ioj, tab, skip, &next);
+			}
 
-					if (DISPLAY_EXTENDED(flags)) {
-						write_ext_stat(itv, fctr, h, d, ioi, ioj, tab, dev_name);
-					}
-					else {
-						write_basic_stat(itv, fctr, d, ioi, ioj, tab, dev_name);
-					}
+			if (DISPLAY_TOP(flags) && !skip) {
+				if (h == hl) {
+					sort_top_devices();
+				}
+				for (i = 0; i < top_cnt; i++) {
+					write_dev_stat(curr, itv, fctr, h, top_heap[i].d,
+						       top_heap[i].d->dev_stats[curr], top_heap[i].ioj,
+						       tab, skip, &next);
 				}
 			}
 
@@ -1953,7 +3007,13 @@ void write_stats(int curr, struct tm *rectime, int skip)
 		}
 		if (DISPLAY_JSON_OUTPUT(xflags) && !skip) {
 			printf("\n");
-			xprintf(--tab, "]");
+			xprintf0(--tab, "]");
+			printf("%s\n", DISPLAY_HCTX(flags) ? "," : "");
+		}
+
+		if (DISPLAY_HCTX(flags) && !skip) {
+			/* Display hardware queues statistics */
+			write_dlist_hctx_stat(curr, itv, tab);
 		}
 	}
 
@@ -1980,17 +3040,15 @@ void rw_io_stat_loop(long int count, struct tm *rectime)
 {
 	int curr = 1;
 	int skip = 0;
+	struct timespec deadline;
 
 	/* Should we skip first report? */
 	if (DISPLAY_OMIT_SINCE_BOOT(flags) && interval > 0) {
 		skip = 1;
 	}
 
-	/* Set a handler for SIGALRM */
-	memset(&alrm_act, 0, sizeof(alrm_act));
-	alrm_act.sa_handler = alarm_handler;
-	sigaction(SIGALRM, &alrm_act, NULL);
-	alarm(interval);
+	/* Sampling deadlines are computed from the time of the first sample */
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
 
 	/* Set a handler for SIGINT and SIGTERM */
 	memset(&int_act, 0, sizeof(int_act));
@@ -2003,7 +3061,7 @@ void rw_io_stat_loop(long int count, struct tm *rectime)
 		set_devices_nonexistent(dev_list);
 
 		/* Read system uptime */
-		read_uptime(&(uptime_cs[curr]));
+		read_uptime_ns(&(uptime_ns[curr]));
 
 		/* Read stats for CPU "all" */
 		read_stat_cpu(st_cpu[curr], 1);
@@ -2022,7 +3080,12 @@ void rw_io_stat_loop(long int count, struct tm *rectime)
 			read_diskstats_stat(curr);
 		}
 		else {
-			read_sysfs_dlist_stat(curr);
+			read_dlist_stat(curr);
+		}
+
+		if (DISPLAY_HCTX(flags)) {
+			/* Read hardware queues statistics */
+			read_dlist_hctx_stat(curr);
 		}
 
 		/* Get time */
@@ -2039,7 +3102,7 @@ void rw_io_stat_loop(long int count, struct tm *rectime)
 
 		if (count) {
 			curr ^= 1;
-			__pause();
+			__wait_deadline(&deadline, interval_ms);
 
 			if (sigint_caught) {
 				/*
@@ -2138,6 +3201,43 @@ int main(int argc, char **argv)
 			opt++;
 		}
 
+		else if (!strncmp(argv[opt], "--top=", 6)) {
+			/* Display only the N busiest devices */
+			top_nr = strtol(argv[opt] + 6, &t, 10);
+			if ((top_nr <= 0) || (t == argv[opt] + 6)) {
+				usage(argv[0]);
+			}
+			if (*t == ',') {
+				t++;
+				if (!strcmp(t, K_TOP_UTIL)) {
+					top_key = TOP_UTIL;
+				}
+				else if (!strcmp(t, K_TOP_AWAIT)) {
+					top_key = TOP_AWAIT;
+				}
+				else if (!strcmp(t, K_TOP_TPS)) {
+					top_key = TOP_TPS;
+				}
+				else if (!strcmp(t, K_TOP_TPUT)) {
+					top_key = TOP_TPUT;
+				}
+				else {
+					usage(argv[0]);
+				}
+			}
+			else if (*t != '\0') {
+				usage(argv[0]);
+			}
+			flags |= I_D_TOP;
+			opt++;
+		}
+
+		else if (!strcmp(argv[opt], "--hctx")) {
+			/* Display blk-mq hardware queues statistics */
+			flags |= I_D_HCTX;
+			opt++;
+		}
+
 		else if (!strcmp(argv[opt], "--pretty")) {
 			/* Display an easy-to-read CIFS report */
 			flags |= I_D_PRETTY;
@@ -2332,7 +3432,7 @@ int main(int argc, char **argv)
 			opt++;
 		}
 
-		else if (strspn(argv[opt], DIGITS) != strlen(argv[opt])) {
+		else if (strspn(argv[opt], DIGITS ".") != strlen(argv[opt])) {
 			/*
 			 * By default iostat doesn't display unused devices.
 			 * If some devices are explicitly entered on the command line
@@ -2358,15 +3458,19 @@ int main(int argc, char **argv)
 		}
 
 		else if (!it) {
-			interval = atol(argv[opt++]);
-			if (interval < 0) {
+			interval_ms = parse_interval(argv[opt++]);
+			if (interval_ms < 0) {
 				usage(argv[0]);
 			}
+			interval = (interval_ms + 999) / 1000;
 			count = -1;
 			it = 1;
 		}
 
 		else if (it > 0) {
+			if (strspn(argv[opt], DIGITS) != strlen(argv[opt])) {
+				usage(argv[0]);
+			}
 			count = atol(argv[opt++]);
 			if ((count < 1) || !interval) {
 				usage(argv[0]);
@@ -2390,11 +3494,11 @@ int main(int argc, char **argv)
 		flags |= I_D_CPU + I_D_DISK;
 	}
 	/*
-	 * Also display DISK reports if options -p, -x or a device has been entered
-	 * on the command line.
+	 * Also display DISK reports if options -p, -x, --top, --hctx or a device
+	 * has been entered on the command line.
 	 */
 	if (DISPLAY_EVERYTHING(flags) || DISPLAY_EXTENDED(flags) ||
-	    DISPLAY_UNFILTERED(flags)) {
+	    DISPLAY_UNFILTERED(flags) || DISPLAY_TOP(flags) || DISPLAY_HCTX(flags)) {
 		flags |= I_D_DISK;
 	}
 
@@ -2417,6 +3521,11 @@ int main(int argc, char **argv)
 	/* Allocate and init stat common counters */
 	init_stats();
 
+	if (DISPLAY_TOP(flags)) {
+		/* Allocate heap used to select the busiest devices */
+		SREALLOC(top_heap, struct top_entry, sizeof(struct top_entry) * (size_t) top_nr);
+	}
+
 	/* How many processors on this machine? */
 	cpu_nr = get_cpu_nr(~0, FALSE);
 
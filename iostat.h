@@ -24,7 +24,7 @@
 #define I_D_PRETTY		0x001000
 #define I_D_PERSIST_NAME	0x002000
 #define I_D_OMIT_SINCE_BOOT	0x004000
-/* Unused			0x008000 */
+#define I_D_TOP			0x008000
 #define I_D_DEVMAP_NAME		0x010000
 /* Unused			0x020000 */
 #define I_D_GROUP_TOTAL_ONLY	0x040000
@@ -32,6 +32,7 @@
 #define I_D_UNIT		0x100000
 #define I_D_SHORT_OUTPUT	0x200000
 #define I_D_COMPACT		0x400000
+#define I_D_HCTX		0x800000
 
 #define DISPLAY_CPU(m)			(((m) & I_D_CPU)              == I_D_CPU)
 #define DISPLAY_DISK(m)			(((m) & I_D_DISK)             == I_D_DISK)
@@ -54,6 +55,8 @@
 #define DISPLAY_SHORT_OUTPUT(m)		(((m) & I_D_SHORT_OUTPUT)     == I_D_SHORT_OUTPUT)
 #define USE_ALL_DIR(m)			(((m) & I_D_ALL_DIR)          == I_D_ALL_DIR)
 #define DISPLAY_COMPACT(m)		(((m) & I_D_COMPACT)          == I_D_COMPACT)
+#define DISPLAY_TOP(m)			(((m) & I_D_TOP)              == I_D_TOP)
+#define DISPLAY_HCTX(m)			(((m) & I_D_HCTX)             == I_D_HCTX)
 
 enum {
 	T_PART		= 0,
@@ -64,6 +67,31 @@ enum {
 
 #define UKWN_MAJ_NR	0
 
+/* Keys used to sort devices with option --top */
+enum {
+	TOP_UTIL	= 0,
+	TOP_AWAIT	= 1,
+	TOP_TPS		= 2,
+	TOP_TPUT	= 3
+};
+
+#define K_TOP_UTIL	"util"
+#define K_TOP_AWAIT	"await"
+#define K_TOP_TPS	"tps"
+#define K_TOP_TPUT	"tput"
+
+/*
+ * blk-mq hardware queues: Directory with one sub-directory per hardware
+ * queue in __sys/block/<device>/, and files read in each of them.
+ */
+#define __MQ		"mq"
+#define S_CPU_LIST	"cpu_list"
+/* Per hardware queue counters, located in debugfs */
+#define __DEBUG_BLOCK	"kernel/debug/block"
+#define S_HCTX_QUEUED	"queued"
+#define S_HCTX_RUN	"run"
+#define S_HCTX_DISP	"dispatched"
+
 /* Environment variable */
 #define ENV_POSIXLY_CORRECT	"POSIXLY_CORRECT"
 
@@ -110,6 +138,38 @@ struct io_stats {
 
 #define IO_STATS_SIZE	(sizeof(struct io_stats))
 
+/* Maximum length of the list of CPUs mapped to a hardware queue */
+#define HCTX_CPU_LIST_LEN	64
+
+/* Statistics for a blk-mq hardware queue */
+struct hctx_stats {
+	/* Hardware queue number */
+	unsigned int id;
+	/* # of requests queued to the hardware queue */
+	unsigned long queued;
+	/* # of times the hardware queue has been run */
+	unsigned long run;
+	/* # of dispatches which sent at least one request to the driver */
+	unsigned long dispatched;
+	/* CPUs mapped to the hardware queue (e.g. "0-3,8") */
+	char cpu_list[HCTX_CPU_LIST_LEN];
+};
+
+/* Entry of the table filled from a single diskstats read */
+struct dstat_entry {
+	char name[MAX_NAME_LEN];
+	unsigned int major;
+	unsigned int minor;
+	/* TRUE if this is a partition */
+	int part;
+	/* TRUE if this is a partition without extended statistics */
+	int basic;
+	struct io_stats ios;
+};
+
+/* Allocation step for the diskstats table */
+#define NR_DSTAT_PREALLOC	64
+
 struct io_device {
 	char name[MAX_NAME_LEN];
 	/*
@@ -125,9 +185,31 @@ struct io_device {
 	int major;
 	int minor;
 	struct io_stats *dev_stats[2];
+	/* Hardware queues statistics (only read when option --hctx is used) */
+	struct hctx_stats *hctx[2];
+	/* Number of hardware queues in each sample, and size of hctx[] arrays */
+	int hctx_nr[2];
+	int hctx_sz;
 	struct io_device *next;
+	/* Next device in hash chain, and hash value of its name */
+	struct io_device *hnext;
+	unsigned int hash;
+};
+
+/* Device selected with option --top */
+struct top_entry {
+	/* Value of the sort key for this device */
+	double key;
+	/* Position of the device in the list (used to break ties) */
+	unsigned int seq;
+	struct io_device *d;
+	/* Previous sample statistics (may not be d->dev_stats[!curr]) */
+	struct io_stats *ioj;
 };
 
+/* Initial number of hash buckets for devices (doubled as needed) */
+#define DEV_HASH_SIZE	256
+
 struct ext_io_stats {
 	/* r_await */
 	double r_await;
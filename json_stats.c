@@ -138,7 +138,7 @@ __print_funct_t json_print_cpu_stats(struct activity *a, int curr, int tab,
 	int i;
 	int sep = FALSE;
 	unsigned long long deltot_jiffies = 1;
-	struct stats_cpu *scc, *scp;
+	struct cpu_pc_values *cpc;
 	unsigned char offline_cpu_bitmap[BITMAP_SIZE(NR_CPUS)] = {0};
 	char cpuno[16];
 
@@ -158,6 +158,10 @@ __print_funct_t json_print_cpu_stats(struct activity *a, int curr, int tab,
 							   flags, offline_cpu_bitmap);
 	}
 
+	/* Compute interval and percentages for every CPU to display */
+	cpc = get_cpu_pc_statistics(a, !curr, curr, deltot_jiffies,
+				    offline_cpu_bitmap);
+
 	for (i = 0; (i < a->nr_ini) && (i < a->bitmap->b_size + 1); i++) {
 
 		/* Should current CPU (including CPU "all") be displayed? */
@@ -166,9 +170,6 @@ __print_funct_t json_print_cpu_stats(struct activity *a, int curr, int tab,
 			/* Don't display CPU */
 			continue;
 
-		scc = (struct stats_cpu *) ((char *) a->buf[curr]  + i * a->msize);
-		scp = (struct stats_cpu *) ((char *) a->buf[!curr] + i * a->msize);
-
 		if (sep) {
 			printf(",\n");
 		}
@@ -177,29 +178,11 @@ __print_funct_t json_print_cpu_stats(struct activity *a, int curr, int tab,
 		if (!i) {
 			/* This is CPU "all" */
 			strcpy(cpuno, K_LOWERALL);
-
-			if (a->nr_ini == 1) {
-				/*
-				 * This is a UP machine. In this case
-				 * interval has still not been calculated.
-				 */
-				deltot_jiffies = get_per_cpu_interval(scc, scp);
-			}
-			if (!deltot_jiffies) {
-				/* CPU "all" cannot be tickless */
-				deltot_jiffies = 1;
-			}
 		}
 		else {
 			sprintf(cpuno, "%d", i - 1);
 
-			/*
-			 * Recalculate interval for current proc.
-			 * If result is 0 then current CPU is a tickless one.
-			 */
-			deltot_jiffies = get_per_cpu_interval(scc, scp);
-
-			if (!deltot_jiffies) {
+			if (!cpc->itv[i]) {
 				/* Current CPU is tickless */
 				if (DISPLAY_CPU_DEF(a->opt_flags)) {
 					xprintf0(tab, "{\"cpu\": \"%d\", "
@@ -239,16 +222,12 @@ __print_funct_t json_print_cpu_stats(struct activity *a, int curr, int tab,
 				 "\"steal\": %.2f, "
 				 "\"idle\": %.2f}",
 				 cpuno,
-				 ll_sp_value(scp->cpu_user, scc->cpu_user, deltot_jiffies),
-				 ll_sp_value(scp->cpu_nice, scc->cpu_nice, deltot_jiffies),
-				 ll_sp_value(scp->cpu_sys + scp->cpu_hardirq + scp->cpu_softirq,
-					     scc->cpu_sys + scc->cpu_hardirq + scc->cpu_softirq,
-					     deltot_jiffies),
-				 ll_sp_value(scp->cpu_iowait, scc->cpu_iowait, deltot_jiffies),
-				 ll_sp_value(scp->cpu_steal, scc->cpu_steal, deltot_jiffies),
-				 scc->cpu_idle < scp->cpu_idle ?
-				 0.0 :
-				 ll_sp_value(scp->cpu_idle, scc->cpu_idle, deltot_jiffies));
+				 CPU_PC(cpc, CPU_PC_USER, i),
+				 CPU_PC(cpc, CPU_PC_NICE_TOT, i),
+				 CPU_PC(cpc, CPU_PC_SYS_TOT, i),
+				 CPU_PC(cpc, CPU_PC_IOWAIT, i),
+				 CPU_PC(cpc, CPU_PC_STEAL, i),
+				 CPU_PC(cpc, CPU_PC_IDLE, i));
 		}
 		else if (DISPLAY_CPU_ALL(a->opt_flags)) {
 			xprintf0(tab, "{\"cpu\": \"%s\", "
@@ -263,24 +242,16 @@ __print_funct_t json_print_cpu_stats(struct activity *a, int curr, int tab,
 				 "\"gnice\": %.2f, "
 				 "\"idle\": %.2f}",
 				 cpuno,
-				 (scc->cpu_user - scc->cpu_guest) < (scp->cpu_user - scp->cpu_guest) ?
-				 0.0 :
-				 ll_sp_value(scp->cpu_user - scp->cpu_guest,
-					     scc->cpu_user - scc->cpu_guest, deltot_jiffies),
-				 (scc->cpu_nice - scc->cpu_guest_nice) < (scp->cpu_nice - scp->cpu_guest_nice) ?
-				 0.0 :
-				 ll_sp_value(scp->cpu_nice - scp->cpu_guest_nice,
-					     scc->cpu_nice - scc->cpu_guest_nice, deltot_jiffies),
-				 ll_sp_value(scp->cpu_sys, scc->cpu_sys, deltot_jiffies),
-				 ll_sp_value(scp->cpu_iowait, scc->cpu_iowait, deltot_jiffies),
-				 ll_sp_value(scp->cpu_steal, scc->cpu_steal, deltot_jiffies),
-				 ll_sp_value(scp->cpu_hardirq, scc->cpu_hardirq, deltot_jiffies),
-				 ll_sp_value(scp->cpu_softirq, scc->cpu_softirq, deltot_jiffies),
-				 ll_sp_value(scp->cpu_guest, scc->cpu_guest, deltot_jiffies),
-				 ll_sp_value(scp->cpu_guest_nice, scc->cpu_guest_nice, deltot_jiffies),
-				 scc->cpu_idle < scp->cpu_idle ?
-				 0.0 :
-				 ll_sp_value(scp->cpu_idle, scc->cpu_idle, deltot_jiffies));
+				 CPU_PC(cpc, CPU_PC_USR, i),
+				 CPU_PC(cpc, CPU_PC_NICE, i),
+				 CPU_PC(cpc, CPU_PC_SYS, i),
+				 CPU_PC(cpc, CPU_PC_IOWAIT, i),
+				 CPU_PC(cpc, CPU_PC_STEAL, i),
+				 CPU_PC(cpc, CPU_PC_IRQ, i),
+				 CPU_PC(cpc, CPU_PC_SOFT, i),
+				 CPU_PC(cpc, CPU_PC_GUEST, i),
+				 CPU_PC(cpc, CPU_PC_GNICE, i),
+				 CPU_PC(cpc, CPU_PC_IDLE, i));
 		}
 	}
 
@@ -328,10 +299,11 @@ __print_funct_t json_print_pcsw_stats(struct activity *a, int curr, int tab,
 __print_funct_t json_print_irq_stats(struct activity *a, int curr, int tab,
 				     unsigned long long itv)
 {
-	int i, c;
-	struct stats_irq *stc_cpu_irq, *stp_cpu_irq, *stc_cpuall_irq;
+	int i, c, nr;
+	struct stats_irq *stc_cpuall_irq;
 	unsigned char masked_cpu_bitmap[BITMAP_SIZE(NR_CPUS)] = {0};
 	int sep = FALSE, first;
+	double *rates;
 
 	xprintf(tab++, "\"interrupts\": [");
 
@@ -343,6 +315,10 @@ __print_funct_t json_print_irq_stats(struct activity *a, int curr, int tab,
 	/* Identify offline and unselected CPU, and keep persistent statistics values */
 	get_global_int_statistics(a, !curr, curr, flags, masked_cpu_bitmap);
 
+	/* Compute all the values in one pass over the buffers */
+	nr = MINIMUM(a->nr[curr], a->bitmap->b_size + 1);
+	rates = get_irq_rates(a, !curr, curr, itv, nr);
+
 	for (i = 0; i < a->nr2; i++) {
 
 		stc_cpuall_irq = (struct stats_irq *) ((char *) a->buf[curr] + i * a->msize);
@@ -359,12 +335,7 @@ __print_funct_t json_print_irq_stats(struct activity *a, int curr, int tab,
 			printf(",\n");
 		}
 
-		for (c = 0; (c < a->nr[curr]) && (c < a->bitmap->b_size + 1); c++) {
-
-			stc_cpu_irq = (struct stats_irq *) ((char *) a->buf[curr] + c * a->msize * a->nr2
-										  + i * a->msize);
-			stp_cpu_irq = (struct stats_irq *) ((char *) a->buf[!curr] + c * a->msize * a->nr2
-										  + i * a->msize);
+		for (c = 0; c < nr; c++) {
 
 			/* Should current CPU (including CPU "all") be displayed? */
 			if (IS_CPU_SET(masked_cpu_bitmap, c))
@@ -378,13 +349,10 @@ __print_funct_t json_print_irq_stats(struct activity *a, int curr, int tab,
 			}
 
 			if (!c) {
-				printf(", \"all\": %.2f",
-				       (stc_cpu_irq->irq_nr < stp_cpu_irq->irq_nr) ? 0.0 :
-				       S_VALUE(stp_cpu_irq->irq_nr, stc_cpu_irq->irq_nr, itv));
+				printf(", \"all\": %.2f", rates[i * nr]);
 			}
 			else {
-				printf(", \"CPU%d\": %.2f", c - 1,
-				       S_VALUE(stp_cpu_irq->irq_nr, stc_cpu_irq->irq_nr, itv));
+				printf(", \"CPU%d\": %.2f", c - 1, rates[i * nr + c]);
 			}
 		}
 		if (!first) {
@@ -2681,3 +2649,177 @@ __print_funct_t json_print_pwr_bat_stats(struct activity *a, int curr, int tab,
 		json_markup_power_management(tab, CLOSE_JSON_MARKUP);
 	}
 }
+
+/*
+ ***************************************************************************
+ * Display cgroups statistics in JSON.
+ *
+ * IN:
+ * @a		Activity structure with statistics.
+ * @curr	Index in array for current sample statistics.
+ * @tab		Indentation in output.
+ * @itv		Interval of time in 1/100th of a second.
+ ***************************************************************************
+ */
+__print_funct_t json_print_cgroup_stats(struct activity *a, int curr, int tab,
+					unsigned long long itv)
+{
+	int i, j;
+	struct stats_cgroup *scc, *scp, sczero;
+	int sep = FALSE;
+
+	memset(&sczero, 0, STATS_CGROUP_SIZE);
+
+	xprintf(tab++, "\"cgroups\": [");
+
+	for (i = 0; i < a->nr[curr]; i++) {
+		scc = (struct stats_cgroup *) ((char *) a->buf[curr] + i * a->msize);
+
+		if (a->item_list != NULL) {
+			/* A list of cgroups has been entered on the command line */
+			if (!search_list_item(a->item_list, scc->cgroup_name))
+				/* Cgroup not found */
+				continue;
+		}
+
+		j = check_cgroup_reg(a, curr, !curr, i);
+		if (j < 0) {
+			/* This is a newly created cgroup. Previous stats are zero */
+			scp = &sczero;
+		}
+		else {
+			scp = (struct stats_cgroup *) ((char *) a->buf[!curr] + j * a->msize);
+		}
+
+		if (sep) {
+			printf(",\n");
+		}
+		sep = TRUE;
+
+		xprintf0(tab, "{\"cgroup\": \"%s\", "
+			 "\"%%usr\": %.2f, "
+			 "\"%%system\": %.2f, "
+			 "\"%%cpu\": %.2f, "
+			 "\"%%throttled\": %.2f, "
+			 "\"kbmem\": %llu, "
+			 "\"rkB\": %.2f, "
+			 "\"wkB\": %.2f, "
+			 "\"rd\": %.2f, "
+			 "\"wr\": %.2f}",
+			 scc->cgroup_name,
+			 S_VALUE(scp->user_usec,      scc->user_usec,      itv) / 10000,
+			 S_VALUE(scp->system_usec,    scc->system_usec,    itv) / 10000,
+			 S_VALUE(scp->usage_usec,     scc->usage_usec,     itv) / 10000,
+			 S_VALUE(scp->throttled_usec, scc->throttled_usec, itv) / 10000,
+			 scc->mem_current,
+			 S_VALUE(scp->rbytes, scc->rbytes, itv) / 1024,
+			 S_VALUE(scp->wbytes, scc->wbytes, itv) / 1024,
+			 S_VALUE(scp->rios,   scc->rios,   itv),
+			 S_VALUE(scp->wios,   scc->wios,   itv));
+	}
+
+	printf("\n");
+	xprintf0(--tab, "]");
+}
+
+/*
+ ***************************************************************************
+ * Display cgroups pressure-stall statistics in JSON.
+ *
+ * IN:
+ * @a		Activity structure with statistics.
+ * @curr	Index in array for current sample statistics.
+ * @tab		Indentation in output.
+ * @itv		Interval of time in 1/100th of a second.
+ ***************************************************************************
+ */
+__print_funct_t json_print_psi_cgroup_stats(struct activity *a, int curr, int tab,
+					    unsigned long long itv)
+{
+	int i, j;
+	struct stats_psi_cgroup *spcc, *spcp, spczero;
+	int sep = FALSE;
+
+	memset(&spczero, 0, STATS_PSI_CGROUP_SIZE);
+
+	xprintf(tab++, "\"cgroups-psi\": [");
+
+	for (i = 0; i < a->nr[curr]; i++) {
+		spcc = (struct stats_psi_cgroup *) ((char *) a->buf[curr] + i * a->msize);
+
+		if (a->item_list != NULL) {
+			/* A list of cgroups has been entered on the command line */
+			if (!search_list_item(a->item_list, spcc->cgroup_name))
+				/* Cgroup not found */
+				continue;
+		}
+
+		j = check_psi_cgroup_reg(a, curr, !curr, i);
+		if (j < 0) {
+			/* This is a newly created cgroup. Previous stats are zero */
+			spcp = &spczero;
+		}
+		else {
+			spcp = (struct stats_psi_cgroup *) ((char *) a->buf[!curr] + j * a->msize);
+		}
+
+		if (sep) {
+			printf(",\n");
+		}
+		sep = TRUE;
+
+		xprintf0(tab, "{\"cgroup\": \"%s\", "
+			 "\"some_cpu_avg10\": %.2f, "
+			 "\"some_cpu_avg60\": %.2f, "
+			 "\"some_cpu_avg300\": %.2f, "
+			 "\"some_cpu_avg\": %.2f, "
+			 "\"full_cpu_avg10\": %.2f, "
+			 "\"full_cpu_avg60\": %.2f, "
+			 "\"full_cpu_avg300\": %.2f, "
+			 "\"full_cpu_avg\": %.2f, "
+			 "\"some_io_avg10\": %.2f, "
+			 "\"some_io_avg60\": %.2f, "
+			 "\"some_io_avg300\": %.2f, "
+			 "\"some_io_avg\": %.2f, "
+			 "\"full_io_avg10\": %.2f, "
+			 "\"full_io_avg60\": %.2f, "
+			 "\"full_io_avg300\": %.2f, "
+			 "\"full_io_avg\": %.2f, "
+			 "\"some_mem_avg10\": %.2f, "
+			 "\"some_mem_avg60\": %.2f, "
+			 "\"some_mem_avg300\": %.2f, "
+			 "\"some_mem_avg\": %.2f, "
+			 "\"full_mem_avg10\": %.2f, "
+			 "\"full_mem_avg60\": %.2f, "
+			 "\"full_mem_avg300\": %.2f, "
+			 "\"full_mem_avg\": %.2f}",
+			 spcc->cgroup_name,
+			 (double) spcc->some_acpu_10  / 100,
+			 (double) spcc->some_acpu_60  / 100,
+			 (double) spcc->some_acpu_300 / 100,
+			 S_VALUE(spcp->some_cpu_total, spcc->some_cpu_total, itv) / 10000,
+			 (double) spcc->full_acpu_10  / 100,
+			 (double) spcc->full_acpu_60  / 100,
+			 (double) spcc->full_acpu_300 / 100,
+			 S_VALUE(spcp->full_cpu_total, spcc->full_cpu_total, itv) / 10000,
+			 (double) spcc->some_aio_10  / 100,
+			 (double) spcc->some_aio_60  / 100,
+			 (double) spcc->some_aio_300 / 100,
+			 S_VALUE(spcp->some_io_total, spcc->some_io_total, itv) / 10000,
+			 (double) spcc->full_aio_10  / 100,
+			 (double) spcc->full_aio_60  / 100,
+			 (double) spcc->full_aio_300 / 100,
+			 S_VALUE(spcp->full_io_total, spcc->full_io_total, itv) / 10000,
+			 (double) spcc->some_amem_10  / 100,
+			 (double) spcc->some_amem_60  / 100,
+			 (double) spcc->some_amem_300 / 100,
+			 S_VALUE(spcp->some_mem_total, spcc->some_mem_total, itv) / 10000,
+			 (double) spcc->full_amem_10  / 100,
+			 (double) spcc->full_amem_60  / 100,
+			 (double) spcc->full_amem_300 / 100,
+			 S_VALUE(spcp->full_mem_total, spcc->full_mem_total, itv) / 10000);
+	}
+
+	printf("\n");
+	xprintf0(--tab, "]");
+}
@@ -101,5 +101,9 @@ __print_funct_t json_print_psimem_stats
 	(struct activity *, int, int, unsigned long long);
 __print_funct_t json_print_pwr_bat_stats
 	(struct activity *, int, int, unsigned long long);
+__print_funct_t json_print_cgroup_stats
+	(struct activity *, int, int, unsigned long long);
+__print_funct_t json_print_psi_cgroup_stats
+	(struct activity *, int, int, unsigned long long);
 
 #endif /* _JSON_STATS_H */
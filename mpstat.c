@@ -50,7 +50,7 @@ char *sccsid(void) { return (SCCSID); }
 extern int __env;
 #endif
 
-unsigned long long uptime_cs[3] = {0, 0, 0};
+unsigned long long uptime_ns[3] = {0, 0, 0};
 
 /* NOTE: Use array of _char_ for bitmaps to avoid endianness problems...*/
 unsigned char *cpu_bitmap = NULL;	/* Bit 0: Global; Bit 1: 1st proc; etc. */
@@ -98,8 +98,8 @@ uint64_t actflags = 0;
 uint64_t flags = 0;
 uint64_t xflags = 0;	/* Extended flag for options used by multiple commands */
 
-/* Interval and count parameters */
-long interval = -1, count = 0;
+/* Interval (in seconds, rounded up, and in milliseconds) and count parameters */
+long interval = -1, interval_ms = 0, count = 0;
 /* Number of decimal places */
 int dplaces_nr = -1;
 
@@ -122,7 +122,7 @@ int irqcpu_nr = 0;
 /* Nb of soft interrupts per processor */
 int softirqcpu_nr = 0;
 
-struct sigaction alrm_act, int_act;
+struct sigaction int_act;
 int sigint_caught = 0;
 
 /*
@@ -145,19 +145,6 @@ void usage(char *progname)
 	exit(1);
 }
 
-/*
- ***************************************************************************
- * SIGALRM signal handler. No need to reset the handler here.
- *
- * IN:
- * @sig	Signal number.
- ***************************************************************************
- */
-void alarm_handler(int sig)
-{
-	alarm(interval);
-}
-
 /*
  ***************************************************************************
  * SIGINT and SIGTERM signals handler.
@@ -607,12 +594,8 @@ unsigned long long get_global_cpu_mpstats(int prev, int curr,
  *
  * IN:
  * @dis		TRUE if a header line must be printed.
- * @deltot_jiffies
- *		Number of jiffies spent on the interval by all processors.
- * @prev	Position in array where statistics used	as reference are.
- *		Stats used as reference may be the previous ones read, or
- *		the very first ones when calculating the average.
- * @curr	Position in array where current statistics will be saved.
+ * @cpc		Per-CPU intervals and percentages computed for current
+ *		sample.
  * @prev_string	String displayed at the beginning of a header line. This is
  * 		the timestamp of the previous sample, or "Average" when
  * 		displaying average stats.
@@ -623,12 +606,11 @@ unsigned long long get_global_cpu_mpstats(int prev, int curr,
  *		CPU bitmap for offline CPU.
  ***************************************************************************
  */
-void write_plain_cpu_stats(int dis, unsigned long long deltot_jiffies, int prev, int curr,
+void write_plain_cpu_stats(int dis, struct cpu_pc_values *cpc,
 			   char *prev_string, char *curr_string,
 			   const unsigned char offline_cpu_bitmap[])
 {
 	int i;
-	struct stats_cpu *scc, *scp;
 	struct cpu_topology *cpu_topo_i;
 
 	if (dis) {
@@ -651,9 +633,6 @@ void write_plain_cpu_stats(int dis, unsigned long long deltot_jiffies, int prev,
 		    IS_CPU_OFFLINE(offline_cpu_bitmap, i))
 			continue;
 
-		scc = st_cpu[curr] + i;
-		scp = st_cpu[prev] + i;
-
 		printf("%-11s", curr_string);
 
 		if (i == 0) {
@@ -674,10 +653,7 @@ void write_plain_cpu_stats(int dis, unsigned long long deltot_jiffies, int prev,
 				cprintf_in(IS_INT, " %4d", "", cpu2node[i - 1]);
 			}
 
-			/* Recalculate itv for current proc */
-			deltot_jiffies = get_per_cpu_interval(scc, scp);
-
-			if (!deltot_jiffies) {
+			if (!cpc->itv[i]) {
 				/*
 				 * If the CPU is tickless then there is no change in CPU values
 				 * but the sum of values is not zero.
@@ -691,33 +667,17 @@ void write_plain_cpu_stats(int dis, unsigned long long deltot_jiffies, int prev,
 		}
 
 		cprintf_xpc(NO_UNIT, XHIGH, 9, 7, 2,
-			   (scc->cpu_user - scc->cpu_guest) < (scp->cpu_user - scp->cpu_guest) ?
-			   0.0 :
-			   ll_sp_value(scp->cpu_user - scp->cpu_guest,
-				       scc->cpu_user - scc->cpu_guest, deltot_jiffies),
-			   (scc->cpu_nice - scc->cpu_guest_nice) < (scp->cpu_nice - scp->cpu_guest_nice) ?
-			   0.0 :
-			   ll_sp_value(scp->cpu_nice - scp->cpu_guest_nice,
-				       scc->cpu_nice - scc->cpu_guest_nice, deltot_jiffies),
-			   ll_sp_value(scp->cpu_sys,
-				       scc->cpu_sys, deltot_jiffies),
-			   ll_sp_value(scp->cpu_iowait,
-				       scc->cpu_iowait, deltot_jiffies),
-			   ll_sp_value(scp->cpu_hardirq,
-				       scc->cpu_hardirq, deltot_jiffies),
-			   ll_sp_value(scp->cpu_softirq,
-				       scc->cpu_softirq, deltot_jiffies),
-			   ll_sp_value(scp->cpu_steal,
-				       scc->cpu_steal, deltot_jiffies),
-			   ll_sp_value(scp->cpu_guest,
-				       scc->cpu_guest, deltot_jiffies),
-			   ll_sp_value(scp->cpu_guest_nice,
-				       scc->cpu_guest_nice, deltot_jiffies));
+			   CPU_PC(cpc, CPU_PC_USR, i),
+			   CPU_PC(cpc, CPU_PC_NICE, i),
+			   CPU_PC(cpc, CPU_PC_SYS, i),
+			   CPU_PC(cpc, CPU_PC_IOWAIT, i),
+			   CPU_PC(cpc, CPU_PC_IRQ, i),
+			   CPU_PC(cpc, CPU_PC_SOFT, i),
+			   CPU_PC(cpc, CPU_PC_STEAL, i),
+			   CPU_PC(cpc, CPU_PC_GUEST, i),
+			   CPU_PC(cpc, CPU_PC_GNICE, i));
 		cprintf_xpc(NO_UNIT, XLOW, 1, 7, 2,
-			    (scc->cpu_idle < scp->cpu_idle) ?
-			    0.0 :
-			    ll_sp_value(scp->cpu_idle,
-					scc->cpu_idle, deltot_jiffies));
+			    CPU_PC(cpc, CPU_PC_IDLE, i));
 		printf("\n");
 	}
 }
@@ -728,22 +688,17 @@ void write_plain_cpu_stats(int dis, unsigned long long deltot_jiffies, int prev,
  *
  * IN:
  * @tab		Number of tabs to print.
- * @deltot_jiffies
- *		Number of jiffies spent on the interval by all processors.
- * @prev	Position in array where statistics used	as reference are.
- *		Stats used as reference may be the previous ones read, or
- *		the very first ones when calculating the average.
- * @curr	Position in array where current statistics will be saved.
+ * @cpc		Per-CPU intervals and percentages computed for current
+ *		sample.
  * @offline_cpu_bitmap
  *		CPU bitmap for offline CPU.
  ***************************************************************************
  */
-void write_json_cpu_stats(int tab, unsigned long long deltot_jiffies, int prev, int curr,
+void write_json_cpu_stats(int tab, struct cpu_pc_values *cpc,
 			  const unsigned char offline_cpu_bitmap[])
 {
 	int i, next = FALSE;
 	char cpu_name[16], topology[1024] = "";
-	struct stats_cpu *scc, *scp;
 	struct cpu_topology *cpu_topo_i;
 
 	xprintf(tab++, "\"cpu-load\": [");
@@ -759,9 +714,6 @@ void write_json_cpu_stats(int tab, unsigned long long deltot_jiffies, int prev,
 		    IS_CPU_OFFLINE(offline_cpu_bitmap, i))
 			continue;
 
-		scc = st_cpu[curr] + i;
-		scp = st_cpu[prev] + i;
-
 		if (next) {
 			printf(",\n");
 		}
@@ -787,10 +739,7 @@ void write_json_cpu_stats(int tab, unsigned long long deltot_jiffies, int prev,
 					 cpu_topo_i->logical_core_id, cpu_topo_i->phys_package_id, cpu2node[i - 1]);
 			}
 
-			/* Recalculate itv for current proc */
-			deltot_jiffies = get_per_cpu_interval(scc, scp);
-
-			if (!deltot_jiffies) {
+			if (!cpc->itv[i]) {
 				/*
 				 * If the CPU is tickless then there is no change in CPU values
 				 * but the sum of values is not zero.
@@ -809,32 +758,16 @@ void write_json_cpu_stats(int tab, unsigned long long deltot_jiffies, int prev,
 			 "\"iowait\": %.2f, \"irq\": %.2f, \"soft\": %.2f, \"steal\": %.2f, "
 			 "\"guest\": %.2f, \"gnice\": %.2f, \"idle\": %.2f}",
 			 cpu_name, topology,
-			 (scc->cpu_user - scc->cpu_guest) < (scp->cpu_user - scp->cpu_guest) ?
-			 0.0 :
-			 ll_sp_value(scp->cpu_user - scp->cpu_guest,
-				     scc->cpu_user - scc->cpu_guest, deltot_jiffies),
-			 (scc->cpu_nice - scc->cpu_guest_nice) < (scp->cpu_nice - scp->cpu_guest_nice) ?
-			 0.0 :
-			 ll_sp_value(scp->cpu_nice - scp->cpu_guest_nice,
-				     scc->cpu_nice - scc->cpu_guest_nice, deltot_jiffies),
-			 ll_sp_value(scp->cpu_sys,
-				     scc->cpu_sys, deltot_jiffies),
-			 ll_sp_value(scp->cpu_iowait,
-				     scc->cpu_iowait, deltot_jiffies),
-			 ll_sp_value(scp->cpu_hardirq,
-				     scc->cpu_hardirq, deltot_jiffies),
-			 ll_sp_value(scp->cpu_softirq,
-				     scc->cpu_softirq, deltot_jiffies),
-			 ll_sp_value(scp->cpu_steal,
-				     scc->cpu_steal, deltot_jiffies),
-			 ll_sp_value(scp->cpu_guest,
-				     scc->cpu_guest, deltot_jiffies),
-			 ll_sp_value(scp->cpu_guest_nice,
-				     scc->cpu_guest_nice, deltot_jiffies),
-			 (scc->cpu_idle < scp->cpu_idle) ?
-			 0.0 :
-			 ll_sp_value(scp->cpu_idle,
-				     scc->cpu_idle, deltot_jiffies));
+			 CPU_PC(cpc, CPU_PC_USR, i),
+			 CPU_PC(cpc, CPU_PC_NICE, i),
+			 CPU_PC(cpc, CPU_PC_SYS, i),
+			 CPU_PC(cpc, CPU_PC_IOWAIT, i),
+			 CPU_PC(cpc, CPU_PC_IRQ, i),
+			 CPU_PC(cpc, CPU_PC_SOFT, i),
+			 CPU_PC(cpc, CPU_PC_STEAL, i),
+			 CPU_PC(cpc, CPU_PC_GUEST, i),
+			 CPU_PC(cpc, CPU_PC_GNICE, i),
+			 CPU_PC(cpc, CPU_PC_IDLE, i));
 	}
 
 	printf("\n");
@@ -870,22 +803,31 @@ void write_cpu_stats(int dis, unsigned long long deltot_jiffies, int prev, int c
 		     char *prev_string, char *curr_string, int tab, int *next,
 		     unsigned char offline_cpu_bitmap[])
 {
+	static struct cpu_pc_values cpc;
+
 	if (!deltot_jiffies) {
 		/* CPU "all" cannot be tickless */
 		deltot_jiffies = 1;
 	}
 
+	/*
+	 * Compute interval and percentages for every CPU to display.
+	 * Note: Previous idle and iowait values (saved in st_cpu[prev])
+	 * may be modified here.
+	 */
+	compute_cpu_pc_values(&cpc, st_cpu[curr], st_cpu[prev], sizeof(struct stats_cpu),
+			      cpu_nr + 1, deltot_jiffies, cpu_bitmap, offline_cpu_bitmap);
+
 	if (DISPLAY_JSON_OUTPUT(xflags)) {
 		if (*next) {
 			printf(",\n");
 		}
 		*next = TRUE;
-		write_json_cpu_stats(tab, deltot_jiffies, prev, curr,
-				     offline_cpu_bitmap);
+		write_json_cpu_stats(tab, &cpc, offline_cpu_bitmap);
 	}
 	else {
-		write_plain_cpu_stats(dis, deltot_jiffies, prev, curr,
-				      prev_string, curr_string, offline_cpu_bitmap);
+		write_plain_cpu_stats(dis, &cpc, prev_string, curr_string,
+				      offline_cpu_bitmap);
 	}
 }
 
@@ -1680,7 +1622,7 @@ void write_stats_core(int prev, int curr, int dis,
 	}
 
 	/* Get time interval */
-	itv = get_interval(uptime_cs[prev], uptime_cs[curr]);
+	itv = get_interval_ns(uptime_ns[prev], uptime_ns[curr]);
 
 	/* Print CPU stats */
 	if (DISPLAY_CPU(actflags)) {
@@ -1946,9 +1888,11 @@ void rw_mpstat_loop(int dis_hdr, int rows)
 	int new_cpu_nr;
 	int curr = 1, dis = 1;
 	unsigned long lines = rows;
+	struct timespec deadline;
 
 	/* Read system uptime and CPU stats */
-	read_uptime(&(uptime_cs[0]));
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+	read_uptime_ns(&(uptime_ns[0]));
 	read_stat_cpu(st_cpu[0], cpu_nr + 1);
 
 	/*
@@ -2019,15 +1963,9 @@ void rw_mpstat_loop(int dis_hdr, int rows)
 		exit(0);
 	}
 
-	/* Set a handler for SIGALRM */
-	memset(&alrm_act, 0, sizeof(alrm_act));
-	alrm_act.sa_handler = alarm_handler;
-	sigaction(SIGALRM, &alrm_act, NULL);
-	alarm(interval);
-
 	/* Save the first stats collected. Will be used to compute the average */
 	mp_tstamp[2] = mp_tstamp[0];
-	uptime_cs[2] = uptime_cs[0];
+	uptime_ns[2] = uptime_ns[0];
 	memcpy(st_cpu[2], st_cpu[0], STATS_CPU_SIZE * (cpu_nr + 1));
 	memcpy(st_node[2], st_node[0], STATS_CPU_SIZE * (cpu_nr + 1));
 	memcpy(st_irq[2], st_irq[0], STATS_GLOBAL_IRQ_SIZE * (cpu_nr + 1));
@@ -2043,7 +1981,7 @@ void rw_mpstat_loop(int dis_hdr, int rows)
 	sigaction(SIGINT, &int_act, NULL);
 	sigaction(SIGTERM, &int_act, NULL);
 
-	__pause();
+	__wait_deadline(&deadline, interval_ms);
 
 	if (sigint_caught)
 		/*
@@ -2065,7 +2003,7 @@ void rw_mpstat_loop(int dis_hdr, int rows)
 		get_xtime(&(mp_tstamp[curr]), 0, LOCAL_TIME);
 
 		/* Read uptime and CPU stats */
-		read_uptime(&(uptime_cs[curr]));
+		read_uptime_ns(&(uptime_ns[curr]));
 		read_stat_cpu(st_cpu[curr], cpu_nr + 1);
 
 		/* Read system topology */
@@ -2105,7 +2043,7 @@ void rw_mpstat_loop(int dis_hdr, int rows)
 
 		if (count) {
 
-			__pause();
+			__wait_deadline(&deadline, interval_ms);
 
 			if (sigint_caught) {
 				/*
@@ -2347,13 +2285,11 @@ int main(int argc, char **argv)
 
 		else if (interval < 0) {
 			/* Get interval */
-			if (strspn(argv[opt], DIGITS) != strlen(argv[opt])) {
-				usage(argv[0]);
-			}
-			interval = atol(argv[opt]);
-			if (interval < 0) {
+			interval_ms = parse_interval(argv[opt]);
+			if (interval_ms < 0) {
 				usage(argv[0]);
 			}
+			interval = (interval_ms + 999) / 1000;
 			count = -1;
 		}
 
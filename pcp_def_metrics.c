@@ -19,6 +19,9 @@
  ***************************************************************************
  */
 
+#include <stdio.h>
+#include <string.h>
+
 #include "sa.h"
 
 #ifdef HAVE_PCP
@@ -29,6 +32,8 @@
 #endif
 #endif /* HAVE_PCP */
 
+#include "pcp_def_metrics.h"
+
 /*
  ***************************************************************************
  * Define PCP metrics for per-CPU interrupts statistics.
@@ -40,7 +45,6 @@
  */
 void pcp_def_percpu_int_metrics(struct activity *a, int cpu)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct sa_item *list = a->item_list;
 	static pmInDom indom = PM_INDOM_NULL;
@@ -51,9 +55,9 @@ void pcp_def_percpu_int_metrics(struct activity *a, int cpu)
 		indom = pmInDom_build(60, 40);
 
 		/* Create metric */
-		pmiAddMetric("kernel.percpu.interrupts",
-			     pmiID(60, 4, 1), PM_TYPE_U32, indom, PM_SEM_COUNTER,
-			     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+		pcp_add_metric("kernel.percpu.interrupts",
+			       pmiID(60, 4, 1), PM_TYPE_U32, indom, PM_SEM_COUNTER,
+			       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 	}
 
 	/* Create instance for each interrupt for the current CPU */
@@ -61,10 +65,9 @@ void pcp_def_percpu_int_metrics(struct activity *a, int cpu)
 
 		snprintf(buf, sizeof(buf), "%s::cpu%d", list->item_name, cpu);
 
-		pmiAddInstance(indom, buf, inst++);
+		pcp_add_instance(indom, buf, inst++);
 		list = list->next;
 	}
-#endif /* HAVE_PCP */
 }
 
 /*
@@ -74,54 +77,51 @@ void pcp_def_percpu_int_metrics(struct activity *a, int cpu)
  */
 void pcp_def_global_cpu_metrics(void)
 {
-#ifdef HAVE_PCP
-	pmiAddMetric("kernel.all.cpu.user",
-		     pmiID(60, 0, 20), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("kernel.all.cpu.user",
+		       pmiID(60, 0, 20), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("kernel.all.cpu.nice",
-		     pmiID(60, 0, 21), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("kernel.all.cpu.nice",
+		       pmiID(60, 0, 21), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("kernel.all.cpu.sys",
-		     pmiID(60, 0, 22), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("kernel.all.cpu.sys",
+		       pmiID(60, 0, 22), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("kernel.all.cpu.idle",
-		     pmiID(60, 0, 23), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("kernel.all.cpu.idle",
+		       pmiID(60, 0, 23), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("kernel.all.cpu.iowait",
-		     pmiID(60, 0, 25), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("kernel.all.cpu.iowait",
+		       pmiID(60, 0, 25), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("kernel.all.cpu.steal",
-		     pmiID(60, 0, 55), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("kernel.all.cpu.steal",
+		       pmiID(60, 0, 55), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("kernel.all.cpu.irq.hard",
-		     pmiID(60, 0, 54), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("kernel.all.cpu.irq.hard",
+		       pmiID(60, 0, 54), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("kernel.all.cpu.irq.soft",
-		     pmiID(60, 0, 53), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("kernel.all.cpu.irq.soft",
+		       pmiID(60, 0, 53), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("kernel.all.cpu.irq.total",
-		     pmiID(60, 0, 34), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("kernel.all.cpu.irq.total",
+		       pmiID(60, 0, 34), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("kernel.all.cpu.guest",
-		     pmiID(60, 0, 60), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("kernel.all.cpu.guest",
+		       pmiID(60, 0, 60), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("kernel.all.cpu.guest_nice",
-		     pmiID(60, 0, 81), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
-#endif /* HAVE_PCP */
+	pcp_add_metric("kernel.all.cpu.guest_nice",
+		       pmiID(60, 0, 81), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 }
 
-#ifdef HAVE_PCP
 /*
  * **************************************************************************
  * Define PCP metrics for per-CPU statistics.
@@ -132,51 +132,50 @@ void pcp_def_global_cpu_metrics(void)
  */
 void pcp_def_percpu_metrics(pmInDom indom)
 {
-	pmiAddMetric("kernel.percpu.cpu.user",
-		     pmiID(60, 0, 0), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("kernel.percpu.cpu.user",
+		       pmiID(60, 0, 0), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("kernel.percpu.cpu.nice",
-		     pmiID(60, 0, 1), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("kernel.percpu.cpu.nice",
+		       pmiID(60, 0, 1), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("kernel.percpu.cpu.sys",
-		     pmiID(60, 0, 2), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("kernel.percpu.cpu.sys",
+		       pmiID(60, 0, 2), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("kernel.percpu.cpu.idle",
-		     pmiID(60, 0, 3), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("kernel.percpu.cpu.idle",
+		       pmiID(60, 0, 3), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("kernel.percpu.cpu.iowait",
-		     pmiID(60, 0, 30), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("kernel.percpu.cpu.iowait",
+		       pmiID(60, 0, 30), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("kernel.percpu.cpu.steal",
-		     pmiID(60, 0, 58), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("kernel.percpu.cpu.steal",
+		       pmiID(60, 0, 58), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("kernel.percpu.cpu.irq.hard",
-		     pmiID(60, 0, 57), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("kernel.percpu.cpu.irq.hard",
+		       pmiID(60, 0, 57), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("kernel.percpu.cpu.irq.soft",
-		     pmiID(60, 0, 56), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("kernel.percpu.cpu.irq.soft",
+		       pmiID(60, 0, 56), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("kernel.percpu.cpu.irq.total",
-		     pmiID(60, 0, 35), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("kernel.percpu.cpu.irq.total",
+		       pmiID(60, 0, 35), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("kernel.percpu.cpu.guest",
-		     pmiID(60, 0, 61), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("kernel.percpu.cpu.guest",
+		       pmiID(60, 0, 61), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("kernel.percpu.cpu.guest_nice",
-		     pmiID(60, 0, 83), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("kernel.percpu.cpu.guest_nice",
+		       pmiID(60, 0, 83), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 }
-#endif /* HAVE_PCP */
 
 /*
  * **************************************************************************
@@ -185,34 +184,31 @@ void pcp_def_percpu_metrics(pmInDom indom)
  */
 void pcp_def_global_softnet_metrics(void)
 {
-#ifdef HAVE_PCP
-	pmiAddMetric("network.softnet.processed",
-		     pmiID(60, 57, 0), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.softnet.processed",
+		       pmiID(60, 57, 0), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.softnet.dropped",
-		     pmiID(60, 57, 1), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.softnet.dropped",
+		       pmiID(60, 57, 1), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.softnet.time_squeeze",
-		     pmiID(60, 57, 2), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.softnet.time_squeeze",
+		       pmiID(60, 57, 2), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.softnet.received_rps",
-		     pmiID(60, 57, 4), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.softnet.received_rps",
+		       pmiID(60, 57, 4), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.softnet.flow_limit",
-		     pmiID(60, 57, 5), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.softnet.flow_limit",
+		       pmiID(60, 57, 5), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.softnet.backlog_length",
-		     pmiID(60, 57, 12), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
-#endif /* HAVE_PCP */
+	pcp_add_metric("network.softnet.backlog_length",
+		       pmiID(60, 57, 12), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 }
 
-#ifdef HAVE_PCP
 /*
  * **************************************************************************
  * Define PCP metrics for per-CPU softnet statistics.
@@ -223,33 +219,31 @@ void pcp_def_global_softnet_metrics(void)
  */
 void pcp_def_percpu_softnet_metrics(pmInDom indom)
 {
-	pmiAddMetric("network.softnet.percpu.processed",
-		     pmiID(60, 57, 6), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.softnet.percpu.processed",
+		       pmiID(60, 57, 6), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.softnet.percpu.dropped",
-		     pmiID(60, 57, 7), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.softnet.percpu.dropped",
+		       pmiID(60, 57, 7), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.softnet.percpu.time_squeeze",
-		     pmiID(60, 57, 8), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.softnet.percpu.time_squeeze",
+		       pmiID(60, 57, 8), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.softnet.percpu.received_rps",
-		     pmiID(60, 57, 10), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.softnet.percpu.received_rps",
+		       pmiID(60, 57, 10), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.softnet.percpu.flow_limit",
-		     pmiID(60, 57, 11), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.softnet.percpu.flow_limit",
+		       pmiID(60, 57, 11), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.softnet.percpu.backlog_length",
-		     pmiID(60, 57, 13), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.softnet.percpu.backlog_length",
+		       pmiID(60, 57, 13), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 }
-#endif /* HAVE_PCP */
 
-#ifdef HAVE_PCP
 /*
  * **************************************************************************
  * Define PCP metrics for CPU frequency statistics.
@@ -260,11 +254,10 @@ void pcp_def_percpu_softnet_metrics(pmInDom indom)
  */
 void pcp_def_pwr_cpufreq_metrics(pmInDom indom)
 {
-	pmiAddMetric("hinv.cpu.clock",
-		     pmiID(60, 18, 0), PM_TYPE_FLOAT, indom, PM_SEM_DISCRETE,
-		     pmiUnits(0, -1, 0, 0, PM_TIME_USEC, 0));
+	pcp_add_metric("hinv.cpu.clock",
+		       pmiID(60, 18, 0), PM_TYPE_FLOAT, indom, PM_SEM_DISCRETE,
+		       pmiUnits(0, -1, 0, 0, PM_TIME_USEC, 0));
 }
-#endif /* HAVE_PCP */
 
 /*
  ***************************************************************************
@@ -276,7 +269,6 @@ void pcp_def_pwr_cpufreq_metrics(pmInDom indom)
  */
 void pcp_def_cpu_metrics(struct activity *a)
 {
-#ifdef HAVE_PCP
 	int i, first = TRUE, create = FALSE;
 	char buf[64];
 	static pmInDom indom = PM_INDOM_NULL;
@@ -313,7 +305,7 @@ void pcp_def_cpu_metrics(struct activity *a)
 			if (create) {
 				/* Create instance for current CPU */
 				sprintf(buf, "cpu%d", i - 1);
-				pmiAddInstance(indom, buf, i - 1);
+				pcp_add_instance(indom, buf, i - 1);
 			}
 
 			if (a->id == A_IRQ) {
@@ -341,7 +333,6 @@ void pcp_def_cpu_metrics(struct activity *a)
 			}
 		}
 	}
-#endif /* HAVE_PCP */
 }
 
 /*
@@ -351,15 +342,13 @@ void pcp_def_cpu_metrics(struct activity *a)
  */
 void pcp_def_pcsw_metrics(void)
 {
-#ifdef HAVE_PCP
-	pmiAddMetric("kernel.all.pswitch",
-		     pmiID(60, 0, 13), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("kernel.all.pswitch",
+		       pmiID(60, 0, 13), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("kernel.all.sysfork",
-		     pmiID(60, 0, 14), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
-#endif /* HAVE_PCP */
+	pcp_add_metric("kernel.all.sysfork",
+		       pmiID(60, 0, 14), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 }
 
 /*
@@ -372,7 +361,6 @@ void pcp_def_pcsw_metrics(void)
  */
 void pcp_def_irq_metrics(struct activity *a)
 {
-#ifdef HAVE_PCP
 	int first = TRUE, inst = 0;
 	struct sa_item *list = a->item_list;
 	pmInDom indom;
@@ -393,24 +381,23 @@ void pcp_def_irq_metrics(struct activity *a)
 			 * Interrupt "sum" appears at most once in list.
 			 * No need to create an instance for it: It has a specific metric name.
 			 */
-			pmiAddMetric("kernel.all.intr",
-				     pmiID(60, 0, 12), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-				     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+			pcp_add_metric("kernel.all.intr",
+				       pmiID(60, 0, 12), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+				       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 		}
 		else {
 			if (first) {
 				/* Create metric for a common interrupt for CPU "all" if not already done */
-				pmiAddMetric("kernel.all.interrupts.total",
-					     pmiID(60, 4, 0), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-					     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+				pcp_add_metric("kernel.all.interrupts.total",
+					       pmiID(60, 4, 0), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+					       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 				first = FALSE;
 			}
 			/* Create instance */
-			pmiAddInstance(indom, list->item_name, inst++);
+			pcp_add_instance(indom, list->item_name, inst++);
 		}
 		list = list->next;
 	}
-#endif /* HAVE_PCP */
 }
 
 /*
@@ -420,15 +407,13 @@ void pcp_def_irq_metrics(struct activity *a)
  */
 void pcp_def_swap_metrics(void)
 {
-#ifdef HAVE_PCP
-	pmiAddMetric("swap.pagesin",
-		     pmiID(60, 0, 8), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("swap.pagesin",
+		       pmiID(60, 0, 8), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("swap.pagesout",
-		     pmiID(60, 0, 9), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
-#endif /* HAVE_PCP */
+	pcp_add_metric("swap.pagesout",
+		       pmiID(60, 0, 9), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 }
 
 /*
@@ -438,47 +423,45 @@ void pcp_def_swap_metrics(void)
  */
 void pcp_def_paging_metrics(void)
 {
-#ifdef HAVE_PCP
-	pmiAddMetric("mem.vmstat.pgpgin",
-		     pmiID(60, 28, 6), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("mem.vmstat.pgpgin",
+		       pmiID(60, 28, 6), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("mem.vmstat.pgpgout",
-		     pmiID(60, 28, 7), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("mem.vmstat.pgpgout",
+		       pmiID(60, 28, 7), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("mem.vmstat.pgfault",
-		     pmiID(60, 28, 16), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("mem.vmstat.pgfault",
+		       pmiID(60, 28, 16), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("mem.vmstat.pgmajfault",
-		     pmiID(60, 28, 17), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("mem.vmstat.pgmajfault",
+		       pmiID(60, 28, 17), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("mem.vmstat.pgfree",
-		     pmiID(60, 28, 13), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("mem.vmstat.pgfree",
+		       pmiID(60, 28, 13), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("mem.vmstat.pgscan_kswapd_total",
-		     pmiID(60, 28, 177), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("mem.vmstat.pgscan_kswapd_total",
+		       pmiID(60, 28, 177), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("mem.vmstat.pgscan_direct_total",
-		     pmiID(60, 28, 176), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("mem.vmstat.pgscan_direct_total",
+		       pmiID(60, 28, 176), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("mem.vmstat.pgsteal_total",
-		     pmiID(60, 28, 178), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("mem.vmstat.pgsteal_total",
+		       pmiID(60, 28, 178), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("mem.vmstat.pgpromote_success",
-		     pmiID(60, 28, 192), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("mem.vmstat.pgpromote_success",
+		       pmiID(60, 28, 192), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("mem.vmstat.pgdemote_total",
-		     pmiID(60, 28, 193), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
-#endif /* HAVE_PCP */
+	pcp_add_metric("mem.vmstat.pgdemote_total",
+		       pmiID(60, 28, 193), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 }
 
 /*
@@ -488,35 +471,33 @@ void pcp_def_paging_metrics(void)
  */
 void pcp_def_io_metrics(void)
 {
-#ifdef HAVE_PCP
-	pmiAddMetric("disk.all.total",
-		     pmiID(60, 0, 29), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("disk.all.total",
+		       pmiID(60, 0, 29), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("disk.all.read",
-		     pmiID(60, 0, 24), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("disk.all.read",
+		       pmiID(60, 0, 24), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("disk.all.write",
-		     pmiID(60, 0, 25), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("disk.all.write",
+		       pmiID(60, 0, 25), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("disk.all.discard",
-		     pmiID(60, 0, 96), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("disk.all.discard",
+		       pmiID(60, 0, 96), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("disk.all.read_bytes",
-		     pmiID(60, 0, 41), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+	pcp_add_metric("disk.all.read_bytes",
+		       pmiID(60, 0, 41), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-	pmiAddMetric("disk.all.write_bytes",
-		     pmiID(60, 0, 42), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+	pcp_add_metric("disk.all.write_bytes",
+		       pmiID(60, 0, 42), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-	pmiAddMetric("disk.all.discard_bytes",
-		     pmiID(60, 0, 98), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
-#endif /* HAVE_PCP */
+	pcp_add_metric("disk.all.discard_bytes",
+		       pmiID(60, 0, 98), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 }
 
 /*
@@ -529,78 +510,76 @@ void pcp_def_io_metrics(void)
  */
 void pcp_def_ram_memory_metrics(struct activity *a)
 {
-#ifdef HAVE_PCP
-	pmiAddMetric("hinv.physmem",
-		     pmiID(60, 1, 9), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_DISCRETE,
-		     pmiUnits(1, 0, 0, PM_SPACE_MBYTE, 0, 0));
+	pcp_add_metric("hinv.physmem",
+		       pmiID(60, 1, 9), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_DISCRETE,
+		       pmiUnits(1, 0, 0, PM_SPACE_MBYTE, 0, 0));
 
-	pmiAddMetric("mem.physmem",
-		     pmiID(60, 1, 0), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_DISCRETE,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+	pcp_add_metric("mem.physmem",
+		       pmiID(60, 1, 0), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_DISCRETE,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-	pmiAddMetric("mem.util.free",
-		     pmiID(60, 1, 2), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+	pcp_add_metric("mem.util.free",
+		       pmiID(60, 1, 2), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-	pmiAddMetric("mem.util.available",
-		     pmiID(60, 1, 58), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+	pcp_add_metric("mem.util.available",
+		       pmiID(60, 1, 58), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-	pmiAddMetric("mem.util.used",
-		     pmiID(60, 1, 1), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+	pcp_add_metric("mem.util.used",
+		       pmiID(60, 1, 1), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-	pmiAddMetric("mem.util.bufmem",
-		     pmiID(60, 1, 4), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+	pcp_add_metric("mem.util.bufmem",
+		       pmiID(60, 1, 4), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-	pmiAddMetric("mem.util.cached",
-		     pmiID(60, 1, 5), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+	pcp_add_metric("mem.util.cached",
+		       pmiID(60, 1, 5), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-	pmiAddMetric("mem.util.committed_AS",
-		     pmiID(60, 1, 26), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+	pcp_add_metric("mem.util.committed_AS",
+		       pmiID(60, 1, 26), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-	pmiAddMetric("mem.util.active",
-		     pmiID(60, 1, 14), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+	pcp_add_metric("mem.util.active",
+		       pmiID(60, 1, 14), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-	pmiAddMetric("mem.util.inactive",
-		     pmiID(60, 1, 15), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+	pcp_add_metric("mem.util.inactive",
+		       pmiID(60, 1, 15), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-	pmiAddMetric("mem.util.dirty",
-		     pmiID(60, 1, 22), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+	pcp_add_metric("mem.util.dirty",
+		       pmiID(60, 1, 22), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-	pmiAddMetric("mem.util.shared",
-		     pmiID(60, 1, 23), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+	pcp_add_metric("mem.util.shared",
+		       pmiID(60, 1, 23), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
 	if (DISPLAY_MEM_ALL(a->opt_flags)) {
 
-		pmiAddMetric("mem.util.anonpages",
-			     pmiID(60, 1, 30), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
-			     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+		pcp_add_metric("mem.util.anonpages",
+			       pmiID(60, 1, 30), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
+			       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-		pmiAddMetric("mem.util.slab",
-			     pmiID(60, 1, 25), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
-			     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+		pcp_add_metric("mem.util.slab",
+			       pmiID(60, 1, 25), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
+			       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-		pmiAddMetric("mem.util.kernelStack",
-			     pmiID(60, 1, 43), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
-			     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+		pcp_add_metric("mem.util.kernelStack",
+			       pmiID(60, 1, 43), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
+			       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-		pmiAddMetric("mem.util.pageTables",
-			     pmiID(60, 1, 27), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
-			     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+		pcp_add_metric("mem.util.pageTables",
+			       pmiID(60, 1, 27), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
+			       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-		pmiAddMetric("mem.util.vmallocUsed",
-			     pmiID(60, 1, 51), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
-			     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+		pcp_add_metric("mem.util.vmallocUsed",
+			       pmiID(60, 1, 51), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
+			       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 	}
-#endif /* HAVE_PCP */
 }
 
 /*
@@ -610,19 +589,17 @@ void pcp_def_ram_memory_metrics(struct activity *a)
  */
 void pcp_def_swap_memory_metrics(void)
 {
-#ifdef HAVE_PCP
-	pmiAddMetric("mem.util.swapFree",
-		     pmiID(60, 1, 21), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+	pcp_add_metric("mem.util.swapFree",
+		       pmiID(60, 1, 21), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-	pmiAddMetric("mem.util.swapTotal",
-		     pmiID(60, 1, 20), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+	pcp_add_metric("mem.util.swapTotal",
+		       pmiID(60, 1, 20), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-	pmiAddMetric("mem.util.swapCached",
-		     pmiID(60, 1, 13), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
-#endif /* HAVE_PCP */
+	pcp_add_metric("mem.util.swapCached",
+		       pmiID(60, 1, 13), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 }
 
 /*
@@ -635,7 +612,6 @@ void pcp_def_swap_memory_metrics(void)
  */
 void pcp_def_memory_metrics(struct activity *a)
 {
-#ifdef HAVE_PCP
 	if (DISPLAY_MEMORY(a->opt_flags)) {
 		pcp_def_ram_memory_metrics(a);
 	}
@@ -643,7 +619,6 @@ void pcp_def_memory_metrics(struct activity *a)
 	if (DISPLAY_SWAP(a->opt_flags)) {
 		pcp_def_swap_memory_metrics();
 	}
-#endif /* HAVE_PCP */
 }
 
 /*
@@ -653,23 +628,21 @@ void pcp_def_memory_metrics(struct activity *a)
  */
 void pcp_def_ktables_metrics(void)
 {
-#ifdef HAVE_PCP
-	pmiAddMetric("vfs.dentry.count",
-		     pmiID(60, 27, 5), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("vfs.dentry.count",
+		       pmiID(60, 27, 5), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
-	pmiAddMetric("vfs.files.count",
-		     pmiID(60, 27, 0), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("vfs.files.count",
+		       pmiID(60, 27, 0), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
-	pmiAddMetric("vfs.inodes.count",
-		     pmiID(60, 27, 3), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("vfs.inodes.count",
+		       pmiID(60, 27, 3), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
-	pmiAddMetric("kernel.all.nptys",
-		     pmiID(60, 72, 3), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
-#endif /* HAVE_PCP */
+	pcp_add_metric("kernel.all.nptys",
+		       pmiID(60, 72, 3), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 }
 
 /*
@@ -679,29 +652,27 @@ void pcp_def_ktables_metrics(void)
  */
 void pcp_def_queue_metrics(void)
 {
-#ifdef HAVE_PCP
 	pmInDom indom;
 
-	pmiAddMetric("kernel.all.runnable",
-		     pmiID(60, 2, 2), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("kernel.all.runnable",
+		       pmiID(60, 2, 2), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
-	pmiAddMetric("kernel.all.nprocs",
-		     pmiID(60, 2, 3), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("kernel.all.nprocs",
+		       pmiID(60, 2, 3), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("kernel.all.blocked",
-		     pmiID(60, 0, 16), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("kernel.all.blocked",
+		       pmiID(60, 0, 16), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
 	indom = pmiInDom(60, 2);
-	pmiAddMetric("kernel.all.load",
-		     pmiID(60, 2, 0), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
-	pmiAddInstance(indom, "1 minute", 1);
-	pmiAddInstance(indom, "5 minute", 5);
-	pmiAddInstance(indom, "15 minute", 15);
-#endif /* HAVE_PCP */
+	pcp_add_metric("kernel.all.load",
+		       pmiID(60, 2, 0), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_instance(indom, "1 minute", 1);
+	pcp_add_instance(indom, "5 minute", 5);
+	pcp_add_instance(indom, "15 minute", 15);
 }
 
 /*
@@ -714,7 +685,6 @@ void pcp_def_queue_metrics(void)
  */
 void pcp_def_disk_metrics(struct activity *a)
 {
-#ifdef HAVE_PCP
 	static pmInDom indom = PM_INDOM_NULL;
 
 	if (indom == PM_INDOM_NULL) {
@@ -726,63 +696,62 @@ void pcp_def_disk_metrics(struct activity *a)
 
 		/* Create instances */
 		while (list != NULL) {
-			pmiAddInstance(indom, list->item_name, inst++);
+			pcp_add_instance(indom, list->item_name, inst++);
 			list = list->next;
 		}
 	}
 
-	pmiAddMetric("disk.dev.read",
-		     pmiID(60, 0, 4), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("disk.dev.read",
+		       pmiID(60, 0, 4), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("disk.dev.write",
-		     pmiID(60, 0, 5), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("disk.dev.write",
+		       pmiID(60, 0, 5), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("disk.dev.total",
-		     pmiID(60, 0, 28), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("disk.dev.total",
+		       pmiID(60, 0, 28), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("disk.dev.total_bytes",
-		     pmiID(60, 0, 37), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+	pcp_add_metric("disk.dev.total_bytes",
+		       pmiID(60, 0, 37), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-	pmiAddMetric("disk.dev.read_bytes",
-		     pmiID(60, 0, 38), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+	pcp_add_metric("disk.dev.read_bytes",
+		       pmiID(60, 0, 38), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-	pmiAddMetric("disk.dev.write_bytes",
-		     pmiID(60, 0, 39), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+	pcp_add_metric("disk.dev.write_bytes",
+		       pmiID(60, 0, 39), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-	pmiAddMetric("disk.dev.discard_bytes",
-		     pmiID(60, 0, 90), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+	pcp_add_metric("disk.dev.discard_bytes",
+		       pmiID(60, 0, 90), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-	pmiAddMetric("disk.dev.read_rawactive",
-		     pmiID(60, 0, 72), PM_TYPE_U32, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("disk.dev.read_rawactive",
+		       pmiID(60, 0, 72), PM_TYPE_U32, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("disk.dev.write_rawactive",
-		     pmiID(60, 0, 73), PM_TYPE_U32, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("disk.dev.write_rawactive",
+		       pmiID(60, 0, 73), PM_TYPE_U32, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("disk.dev.total_rawactive",
-		     pmiID(60, 0, 79), PM_TYPE_U32, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("disk.dev.total_rawactive",
+		       pmiID(60, 0, 79), PM_TYPE_U32, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("disk.dev.discard_rawactive",
-		     pmiID(60, 0, 92), PM_TYPE_U32, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("disk.dev.discard_rawactive",
+		       pmiID(60, 0, 92), PM_TYPE_U32, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("disk.dev.avactive",
-		     pmiID(60, 0, 46), PM_TYPE_U32, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
+	pcp_add_metric("disk.dev.avactive",
+		       pmiID(60, 0, 46), PM_TYPE_U32, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 
-	pmiAddMetric("disk.dev.aveq",
-		     pmiID(60, 0, 47), PM_TYPE_U32, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
-#endif /* HAVE_PCP */
+	pcp_add_metric("disk.dev.aveq",
+		       pmiID(60, 0, 47), PM_TYPE_U32, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_MSEC, 0));
 }
 
 /*
@@ -795,7 +764,6 @@ void pcp_def_disk_metrics(struct activity *a)
  */
 void pcp_def_net_dev_metrics(struct activity *a)
 {
-#ifdef HAVE_PCP
 	static pmInDom indom = PM_INDOM_NULL;
 
 	if (indom == PM_INDOM_NULL) {
@@ -807,80 +775,79 @@ void pcp_def_net_dev_metrics(struct activity *a)
 
 		/* Create instances */
 		while (list != NULL) {
-			pmiAddInstance(indom, list->item_name, inst++);
+			pcp_add_instance(indom, list->item_name, inst++);
 			list = list->next;
 		}
 	}
 
 	if (a->id == A_NET_DEV) {
 		/* Create metrics for A_NET_DEV */
-		pmiAddMetric("network.interface.in.packets",
-			     pmiID(60, 3, 1), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-			     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+		pcp_add_metric("network.interface.in.packets",
+			       pmiID(60, 3, 1), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+			       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-		pmiAddMetric("network.interface.out.packets",
-			     pmiID(60, 3, 9), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-			     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+		pcp_add_metric("network.interface.out.packets",
+			       pmiID(60, 3, 9), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+			       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-		pmiAddMetric("network.interface.in.bytes",
-			     pmiID(60, 3, 0), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-			     pmiUnits(1, 0, 0, PM_SPACE_BYTE, 0, 0));
+		pcp_add_metric("network.interface.in.bytes",
+			       pmiID(60, 3, 0), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+			       pmiUnits(1, 0, 0, PM_SPACE_BYTE, 0, 0));
 
-		pmiAddMetric("network.interface.out.bytes",
-			     pmiID(60, 3, 8), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-			     pmiUnits(1, 0, 0, PM_SPACE_BYTE, 0, 0));
+		pcp_add_metric("network.interface.out.bytes",
+			       pmiID(60, 3, 8), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+			       pmiUnits(1, 0, 0, PM_SPACE_BYTE, 0, 0));
 
-		pmiAddMetric("network.interface.in.compressed",
-			     pmiID(60, 3, 6), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-			     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+		pcp_add_metric("network.interface.in.compressed",
+			       pmiID(60, 3, 6), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+			       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-		pmiAddMetric("network.interface.out.compressed",
-			     pmiID(60, 3, 15), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-			     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+		pcp_add_metric("network.interface.out.compressed",
+			       pmiID(60, 3, 15), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+			       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-		pmiAddMetric("network.interface.in.mcasts",
-			     pmiID(60, 3, 7), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-			     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+		pcp_add_metric("network.interface.in.mcasts",
+			       pmiID(60, 3, 7), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+			       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 	}
 	else {
 		/* Create metrics for A_NET_EDEV */
-		pmiAddMetric("network.interface.in.errors",
-			     pmiID(60, 3, 2), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-			     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+		pcp_add_metric("network.interface.in.errors",
+			       pmiID(60, 3, 2), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+			       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-		pmiAddMetric("network.interface.out.errors",
-			     pmiID(60, 3, 10), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-			     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+		pcp_add_metric("network.interface.out.errors",
+			       pmiID(60, 3, 10), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+			       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-		pmiAddMetric("network.interface.collisions",
-			     pmiID(60, 3, 13), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-			     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+		pcp_add_metric("network.interface.collisions",
+			       pmiID(60, 3, 13), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+			       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-		pmiAddMetric("network.interface.in.drops",
-			     pmiID(60, 3, 3), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-			     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+		pcp_add_metric("network.interface.in.drops",
+			       pmiID(60, 3, 3), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+			       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-		pmiAddMetric("network.interface.out.drops",
-			     pmiID(60, 3, 11), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-			     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+		pcp_add_metric("network.interface.out.drops",
+			       pmiID(60, 3, 11), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+			       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-		pmiAddMetric("network.interface.out.carrier",
-			     pmiID(60, 3, 14), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-			     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+		pcp_add_metric("network.interface.out.carrier",
+			       pmiID(60, 3, 14), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+			       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-		pmiAddMetric("network.interface.in.frame",
-			     pmiID(60, 3, 5), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-			     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+		pcp_add_metric("network.interface.in.frame",
+			       pmiID(60, 3, 5), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+			       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-		pmiAddMetric("network.interface.in.fifo",
-			     pmiID(60, 3, 4), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-			     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+		pcp_add_metric("network.interface.in.fifo",
+			       pmiID(60, 3, 4), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+			       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-		pmiAddMetric("network.interface.out.fifo",
-			     pmiID(60, 3, 12), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-			     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+		pcp_add_metric("network.interface.out.fifo",
+			       pmiID(60, 3, 12), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+			       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 	}
-#endif /* HAVE_PCP */
 }
 
 /*
@@ -893,7 +860,6 @@ void pcp_def_net_dev_metrics(struct activity *a)
  */
 void pcp_def_serial_metrics(struct activity *a)
 {
-#ifdef HAVE_PCP
 	int i;
 	pmInDom indom;
 	char buf[64];
@@ -902,36 +868,35 @@ void pcp_def_serial_metrics(struct activity *a)
 	indom = pmInDom_build(60, 35);
 
 	/* Create metrics */
-	pmiAddMetric("tty.serial.rx",
-		     pmiID(60, 74, 0), PM_TYPE_U32, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("tty.serial.rx",
+		       pmiID(60, 74, 0), PM_TYPE_U32, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
-	pmiAddMetric("tty.serial.tx",
-		     pmiID(60, 74, 1), PM_TYPE_U32, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("tty.serial.tx",
+		       pmiID(60, 74, 1), PM_TYPE_U32, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
-	pmiAddMetric("tty.serial.frame",
-		     pmiID(60, 74, 2), PM_TYPE_U32, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("tty.serial.frame",
+		       pmiID(60, 74, 2), PM_TYPE_U32, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
-	pmiAddMetric("tty.serial.parity",
-		     pmiID(60, 74, 3), PM_TYPE_U32, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("tty.serial.parity",
+		       pmiID(60, 74, 3), PM_TYPE_U32, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
-	pmiAddMetric("tty.serial.brk",
-		     pmiID(60, 74, 4), PM_TYPE_U32, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("tty.serial.brk",
+		       pmiID(60, 74, 4), PM_TYPE_U32, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
-	pmiAddMetric("tty.serial.overrun",
-		     pmiID(60, 74, 5), PM_TYPE_U32, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("tty.serial.overrun",
+		       pmiID(60, 74, 5), PM_TYPE_U32, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
 	for (i = 0; i < a->nr_ini; i++) {
 		/* Create instances */
 		sprintf(buf, "serial%d", i);
-		pmiAddInstance(indom, buf, i);
+		pcp_add_instance(indom, buf, i);
 	}
-#endif /* HAVE_PCP */
 }
 
 /*
@@ -941,27 +906,25 @@ void pcp_def_serial_metrics(struct activity *a)
  */
 void pcp_def_net_nfs_metrics(void)
 {
-#ifdef HAVE_PCP
 	pmInDom indom;
 
-	pmiAddMetric("rpc.client.rpccnt",
-		     pmiID(60, 7, 20), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("rpc.client.rpccnt",
+		       pmiID(60, 7, 20), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("rpc.client.rpcretrans",
-		     pmiID(60, 7, 21), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("rpc.client.rpcretrans",
+		       pmiID(60, 7, 21), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
 	indom = pmiInDom(60, 7);
-	pmiAddInstance(indom, "read", 6);
-	pmiAddInstance(indom, "write", 8);
-	pmiAddInstance(indom, "access", 18);
-	pmiAddInstance(indom, "getattr", 4);
-
-	pmiAddMetric("nfs.client.reqs",
-		     pmiID(60, 7, 4), PM_TYPE_U32, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
-#endif /* HAVE_PCP */
+	pcp_add_instance(indom, "read", 6);
+	pcp_add_instance(indom, "write", 8);
+	pcp_add_instance(indom, "access", 18);
+	pcp_add_instance(indom, "getattr", 4);
+
+	pcp_add_metric("nfs.client.reqs",
+		       pmiID(60, 7, 4), PM_TYPE_U32, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 }
 
 /*
@@ -971,47 +934,45 @@ void pcp_def_net_nfs_metrics(void)
  */
 void pcp_def_net_nfsd_metrics(void)
 {
-#ifdef HAVE_PCP
 	pmInDom indom;
 
-	pmiAddMetric("rpc.server.rpccnt",
-		     pmiID(60, 7, 30), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("rpc.server.rpccnt",
+		       pmiID(60, 7, 30), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("rpc.server.rpcbadclnt",
-		     pmiID(60, 7, 34), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("rpc.server.rpcbadclnt",
+		       pmiID(60, 7, 34), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("rpc.server.netcnt",
-		     pmiID(60, 7, 44), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("rpc.server.netcnt",
+		       pmiID(60, 7, 44), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("rpc.server.netudpcnt",
-		     pmiID(60, 7, 45), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("rpc.server.netudpcnt",
+		       pmiID(60, 7, 45), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("rpc.server.nettcpcnt",
-		     pmiID(60, 7, 46), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("rpc.server.nettcpcnt",
+		       pmiID(60, 7, 46), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("rpc.server.rchits",
-		     pmiID(60, 7, 35), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("rpc.server.rchits",
+		       pmiID(60, 7, 35), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("rpc.server.rcmisses",
-		     pmiID(60, 7, 36), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("rpc.server.rcmisses",
+		       pmiID(60, 7, 36), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
 	indom = pmiInDom(60, 7);
-	pmiAddInstance(indom, "read", 6);
-	pmiAddInstance(indom, "write", 8);
-	pmiAddInstance(indom, "access", 18);
-	pmiAddInstance(indom, "getattr", 4);
-
-	pmiAddMetric("nfs.server.reqs",
-		     pmiID(60, 7, 12), PM_TYPE_U32, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
-#endif /* HAVE_PCP */
+	pcp_add_instance(indom, "read", 6);
+	pcp_add_instance(indom, "write", 8);
+	pcp_add_instance(indom, "access", 18);
+	pcp_add_instance(indom, "getattr", 4);
+
+	pcp_add_metric("nfs.server.reqs",
+		       pmiID(60, 7, 12), PM_TYPE_U32, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 }
 
 /*
@@ -1021,31 +982,29 @@ void pcp_def_net_nfsd_metrics(void)
  */
 void pcp_def_net_sock_metrics(void)
 {
-#ifdef HAVE_PCP
-	pmiAddMetric("network.sockstat.total",
-		     pmiID(60, 11, 9), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.sockstat.total",
+		       pmiID(60, 11, 9), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.sockstat.tcp.inuse",
-		     pmiID(60, 11, 0), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.sockstat.tcp.inuse",
+		       pmiID(60, 11, 0), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.sockstat.udp.inuse",
-		     pmiID(60, 11, 3), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.sockstat.udp.inuse",
+		       pmiID(60, 11, 3), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.sockstat.raw.inuse",
-		     pmiID(60, 11, 6), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.sockstat.raw.inuse",
+		       pmiID(60, 11, 6), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.sockstat.frag.inuse",
-		     pmiID(60, 11, 15), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.sockstat.frag.inuse",
+		       pmiID(60, 11, 15), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.sockstat.tcp.tw",
-		     pmiID(60, 11, 11), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
-#endif /* HAVE_PCP */
+	pcp_add_metric("network.sockstat.tcp.tw",
+		       pmiID(60, 11, 11), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 }
 
 /*
@@ -1055,39 +1014,37 @@ void pcp_def_net_sock_metrics(void)
  */
 void pcp_def_net_ip_metrics(void)
 {
-#ifdef HAVE_PCP
-	pmiAddMetric("network.ip.inreceives",
-		     pmiID(60, 14, 2), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip.inreceives",
+		       pmiID(60, 14, 2), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip.forwdatagrams",
-		     pmiID(60, 14, 5), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip.forwdatagrams",
+		       pmiID(60, 14, 5), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip.indelivers",
-		     pmiID(60, 14, 8), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip.indelivers",
+		       pmiID(60, 14, 8), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip.outrequests",
-		     pmiID(60, 14, 9), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip.outrequests",
+		       pmiID(60, 14, 9), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip.reasmreqds",
-		     pmiID(60, 14, 13), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip.reasmreqds",
+		       pmiID(60, 14, 13), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip.reasmoks",
-		     pmiID(60, 14, 14), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip.reasmoks",
+		       pmiID(60, 14, 14), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip.fragoks",
-		     pmiID(60, 14, 16), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip.fragoks",
+		       pmiID(60, 14, 16), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip.fragcreates",
-		     pmiID(60, 14, 18), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
-#endif /* HAVE_PCP */
+	pcp_add_metric("network.ip.fragcreates",
+		       pmiID(60, 14, 18), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 }
 
 /*
@@ -1097,39 +1054,37 @@ void pcp_def_net_ip_metrics(void)
  */
 void pcp_def_net_eip_metrics(void)
 {
-#ifdef HAVE_PCP
-	pmiAddMetric("network.ip.inhdrerrors",
-		     pmiID(60, 14, 3), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip.inhdrerrors",
+		       pmiID(60, 14, 3), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip.inaddrerrors",
-		     pmiID(60, 14, 4), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip.inaddrerrors",
+		       pmiID(60, 14, 4), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip.inunknownprotos",
-		     pmiID(60, 14, 6), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip.inunknownprotos",
+		       pmiID(60, 14, 6), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip.indiscards",
-		     pmiID(60, 14, 7), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip.indiscards",
+		       pmiID(60, 14, 7), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip.outdiscards",
-		     pmiID(60, 14, 10), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip.outdiscards",
+		       pmiID(60, 14, 10), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip.outnoroutes",
-		     pmiID(60, 14, 11), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip.outnoroutes",
+		       pmiID(60, 14, 11), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip.reasmfails",
-		     pmiID(60, 14, 15), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip.reasmfails",
+		       pmiID(60, 14, 15), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip.fragfails",
-		     pmiID(60, 14, 17), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
-#endif /* HAVE_PCP */
+	pcp_add_metric("network.ip.fragfails",
+		       pmiID(60, 14, 17), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 }
 
 /*
@@ -1139,63 +1094,61 @@ void pcp_def_net_eip_metrics(void)
  */
 void pcp_def_net_icmp_metrics(void)
 {
-#ifdef HAVE_PCP
-	pmiAddMetric("network.icmp.inmsgs",
-		     pmiID(60, 14, 20), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp.inmsgs",
+		       pmiID(60, 14, 20), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp.outmsgs",
-		     pmiID(60, 14, 33), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp.outmsgs",
+		       pmiID(60, 14, 33), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp.inechos",
-		     pmiID(60, 14, 27), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp.inechos",
+		       pmiID(60, 14, 27), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp.inechoreps",
-		     pmiID(60, 14, 28), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp.inechoreps",
+		       pmiID(60, 14, 28), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp.outechos",
-		     pmiID(60, 14, 40), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp.outechos",
+		       pmiID(60, 14, 40), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp.outechoreps",
-		     pmiID(60, 14, 41), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp.outechoreps",
+		       pmiID(60, 14, 41), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp.intimestamps",
-		     pmiID(60, 14, 29), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp.intimestamps",
+		       pmiID(60, 14, 29), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp.intimestampreps",
-		     pmiID(60, 14, 30), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp.intimestampreps",
+		       pmiID(60, 14, 30), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp.outtimestamps",
-		     pmiID(60, 14, 42), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp.outtimestamps",
+		       pmiID(60, 14, 42), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp.outtimestampreps",
-		     pmiID(60, 14, 43), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp.outtimestampreps",
+		       pmiID(60, 14, 43), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp.inaddrmasks",
-		     pmiID(60, 14, 31), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp.inaddrmasks",
+		       pmiID(60, 14, 31), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp.inaddrmaskreps",
-		     pmiID(60, 14, 32), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp.inaddrmaskreps",
+		       pmiID(60, 14, 32), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp.outaddrmasks",
-		     pmiID(60, 14, 44), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp.outaddrmasks",
+		       pmiID(60, 14, 44), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp.outaddrmaskreps",
-		     pmiID(60, 14, 45), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
-#endif /* HAVE_PCP */
+	pcp_add_metric("network.icmp.outaddrmaskreps",
+		       pmiID(60, 14, 45), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 }
 
 /*
@@ -1205,55 +1158,53 @@ void pcp_def_net_icmp_metrics(void)
  */
 void pcp_def_net_eicmp_metrics(void)
 {
-#ifdef HAVE_PCP
-	pmiAddMetric("network.icmp.inerrors",
-		     pmiID(60, 14, 21), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp.inerrors",
+		       pmiID(60, 14, 21), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp.outerrors",
-		     pmiID(60, 14, 34), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp.outerrors",
+		       pmiID(60, 14, 34), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp.indestunreachs",
-		     pmiID(60, 14, 22), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp.indestunreachs",
+		       pmiID(60, 14, 22), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp.outdestunreachs",
-		     pmiID(60, 14, 35), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp.outdestunreachs",
+		       pmiID(60, 14, 35), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp.intimeexcds",
-		     pmiID(60, 14, 23), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp.intimeexcds",
+		       pmiID(60, 14, 23), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp.outtimeexcds",
-		     pmiID(60, 14, 36), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp.outtimeexcds",
+		       pmiID(60, 14, 36), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp.inparmprobs",
-		     pmiID(60, 14, 24), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp.inparmprobs",
+		       pmiID(60, 14, 24), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp.outparmprobs",
-		     pmiID(60, 14, 37), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp.outparmprobs",
+		       pmiID(60, 14, 37), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp.insrcquenchs",
-		     pmiID(60, 14, 25), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp.insrcquenchs",
+		       pmiID(60, 14, 25), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp.outsrcquenchs",
-		     pmiID(60, 14, 38), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp.outsrcquenchs",
+		       pmiID(60, 14, 38), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp.inredirects",
-		     pmiID(60, 14, 27), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp.inredirects",
+		       pmiID(60, 14, 27), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp.outredirects",
-		     pmiID(60, 14, 39), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
-#endif /* HAVE_PCP */
+	pcp_add_metric("network.icmp.outredirects",
+		       pmiID(60, 14, 39), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 }
 
 /*
@@ -1263,23 +1214,21 @@ void pcp_def_net_eicmp_metrics(void)
  */
 void pcp_def_net_tcp_metrics(void)
 {
-#ifdef HAVE_PCP
-	pmiAddMetric("network.tcp.activeopens",
-		     pmiID(60, 14, 54), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.tcp.activeopens",
+		       pmiID(60, 14, 54), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.tcp.passiveopens",
-		     pmiID(60, 14, 55), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.tcp.passiveopens",
+		       pmiID(60, 14, 55), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.tcp.insegs",
-		     pmiID(60, 14, 59), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.tcp.insegs",
+		       pmiID(60, 14, 59), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.tcp.outsegs",
-		     pmiID(60, 14, 60), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
-#endif /* HAVE_PCP */
+	pcp_add_metric("network.tcp.outsegs",
+		       pmiID(60, 14, 60), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 }
 
 /*
@@ -1289,27 +1238,25 @@ void pcp_def_net_tcp_metrics(void)
  */
 void pcp_def_net_etcp_metrics(void)
 {
-#ifdef HAVE_PCP
-	pmiAddMetric("network.tcp.attemptfails",
-		     pmiID(60, 14, 56), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.tcp.attemptfails",
+		       pmiID(60, 14, 56), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.tcp.estabresets",
-		     pmiID(60, 14, 57), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.tcp.estabresets",
+		       pmiID(60, 14, 57), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.tcp.retranssegs",
-		     pmiID(60, 14, 61), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.tcp.retranssegs",
+		       pmiID(60, 14, 61), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.tcp.inerrs",
-		     pmiID(60, 14, 62), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.tcp.inerrs",
+		       pmiID(60, 14, 62), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.tcp.outrsts",
-		     pmiID(60, 14, 63), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
-#endif /* HAVE_PCP */
+	pcp_add_metric("network.tcp.outrsts",
+		       pmiID(60, 14, 63), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 }
 
 /*
@@ -1319,23 +1266,21 @@ void pcp_def_net_etcp_metrics(void)
  */
 void pcp_def_net_udp_metrics(void)
 {
-#ifdef HAVE_PCP
-	pmiAddMetric("network.udp.indatagrams",
-		     pmiID(60, 14, 70), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.udp.indatagrams",
+		       pmiID(60, 14, 70), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.udp.outdatagrams",
-		     pmiID(60, 14, 74), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.udp.outdatagrams",
+		       pmiID(60, 14, 74), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.udp.noports",
-		     pmiID(60, 14, 71), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.udp.noports",
+		       pmiID(60, 14, 71), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.udp.inerrors",
-		     pmiID(60, 14, 72), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
-#endif /* HAVE_PCP */
+	pcp_add_metric("network.udp.inerrors",
+		       pmiID(60, 14, 72), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 }
 
 /*
@@ -1345,23 +1290,21 @@ void pcp_def_net_udp_metrics(void)
  */
 void pcp_def_net_sock6_metrics(void)
 {
-#ifdef HAVE_PCP
-	pmiAddMetric("network.sockstat.tcp6.inuse",
-		     pmiID(60, 73, 0), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.sockstat.tcp6.inuse",
+		       pmiID(60, 73, 0), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.sockstat.udp6.inuse",
-		     pmiID(60, 73, 1), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.sockstat.udp6.inuse",
+		       pmiID(60, 73, 1), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.sockstat.raw6.inuse",
-		     pmiID(60, 73, 3), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.sockstat.raw6.inuse",
+		       pmiID(60, 73, 3), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.sockstat.frag6.inuse",
-		     pmiID(60, 73, 4), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
-#endif /* HAVE_PCP */
+	pcp_add_metric("network.sockstat.frag6.inuse",
+		       pmiID(60, 73, 4), PM_TYPE_32, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 }
 
 /*
@@ -1371,47 +1314,45 @@ void pcp_def_net_sock6_metrics(void)
  */
 void pcp_def_net_ip6_metrics(void)
 {
-#ifdef HAVE_PCP
-	pmiAddMetric("network.ip6.inreceives",
-		     pmiID(60, 58, 0), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip6.inreceives",
+		       pmiID(60, 58, 0), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip6.outforwdatagrams",
-		     pmiID(60, 58, 9), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip6.outforwdatagrams",
+		       pmiID(60, 58, 9), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip6.indelivers",
-		     pmiID(60, 58, 8), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip6.indelivers",
+		       pmiID(60, 58, 8), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip6.outrequests",
-		     pmiID(60, 58, 10), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip6.outrequests",
+		       pmiID(60, 58, 10), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip6.reasmreqds",
-		     pmiID(60, 58, 14), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip6.reasmreqds",
+		       pmiID(60, 58, 14), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip6.reasmoks",
-		     pmiID(60, 58, 15), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip6.reasmoks",
+		       pmiID(60, 58, 15), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip6.inmcastpkts",
-		     pmiID(60, 58, 20), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip6.inmcastpkts",
+		       pmiID(60, 58, 20), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip6.outmcastpkts",
-		     pmiID(60, 58, 21), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip6.outmcastpkts",
+		       pmiID(60, 58, 21), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip6.fragoks",
-		     pmiID(60, 58, 17), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip6.fragoks",
+		       pmiID(60, 58, 17), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip6.fragcreates",
-		     pmiID(60, 58, 19), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
-#endif /* HAVE_PCP */
+	pcp_add_metric("network.ip6.fragcreates",
+		       pmiID(60, 58, 19), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 }
 
 /*
@@ -1421,51 +1362,49 @@ void pcp_def_net_ip6_metrics(void)
  */
 void pcp_def_net_eip6_metrics(void)
 {
-#ifdef HAVE_PCP
-	pmiAddMetric("network.ip6.inhdrerrors",
-		     pmiID(60, 58, 1), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip6.inhdrerrors",
+		       pmiID(60, 58, 1), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip6.inaddrerrors",
-		     pmiID(60, 58, 4), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip6.inaddrerrors",
+		       pmiID(60, 58, 4), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip6.inunknownprotos",
-		     pmiID(60, 58, 5), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip6.inunknownprotos",
+		       pmiID(60, 58, 5), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip6.intoobigerrors",
-		     pmiID(60, 58, 2), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip6.intoobigerrors",
+		       pmiID(60, 58, 2), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip6.indiscards",
-		     pmiID(60, 58, 7), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip6.indiscards",
+		       pmiID(60, 58, 7), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip6.outdiscards",
-		     pmiID(60, 58, 11), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip6.outdiscards",
+		       pmiID(60, 58, 11), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip6.innoroutes",
-		     pmiID(60, 58, 3), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip6.innoroutes",
+		       pmiID(60, 58, 3), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip6.outnoroutes",
-		     pmiID(60, 58, 12), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip6.outnoroutes",
+		       pmiID(60, 58, 12), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip6.reasmfails",
-		     pmiID(60, 58, 16), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip6.reasmfails",
+		       pmiID(60, 58, 16), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip6.fragfails",
-		     pmiID(60, 58, 18), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.ip6.fragfails",
+		       pmiID(60, 58, 18), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.ip6.intruncatedpkts",
-		     pmiID(60, 58, 6), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
-#endif /* HAVE_PCP */
+	pcp_add_metric("network.ip6.intruncatedpkts",
+		       pmiID(60, 58, 6), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 }
 
 /*
@@ -1475,75 +1414,73 @@ void pcp_def_net_eip6_metrics(void)
  */
 void pcp_def_net_icmp6_metrics(void)
 {
-#ifdef HAVE_PCP
-	pmiAddMetric("network.icmp6.inmsgs",
-		     pmiID(60, 58, 32), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.inmsgs",
+		       pmiID(60, 58, 32), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.outmsgs",
-		     pmiID(60, 58, 34), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.outmsgs",
+		       pmiID(60, 58, 34), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.inechos",
-		     pmiID(60, 58, 41), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.inechos",
+		       pmiID(60, 58, 41), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.inechoreplies",
-		     pmiID(60, 58, 42), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.inechoreplies",
+		       pmiID(60, 58, 42), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.outechoreplies",
-		     pmiID(60, 58, 57), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.outechoreplies",
+		       pmiID(60, 58, 57), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.ingroupmembqueries",
-		     pmiID(60, 58, 43), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.ingroupmembqueries",
+		       pmiID(60, 58, 43), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.ingroupmembresponses",
-		     pmiID(60, 58, 44), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.ingroupmembresponses",
+		       pmiID(60, 58, 44), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.outgroupmembresponses",
-		     pmiID(60, 58, 59), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.outgroupmembresponses",
+		       pmiID(60, 58, 59), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.ingroupmembreductions",
-		     pmiID(60, 58, 45), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.ingroupmembreductions",
+		       pmiID(60, 58, 45), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.outgroupmembreductions",
-		     pmiID(60, 58, 60), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.outgroupmembreductions",
+		       pmiID(60, 58, 60), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.inroutersolicits",
-		     pmiID(60, 58, 46), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.inroutersolicits",
+		       pmiID(60, 58, 46), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.outroutersolicits",
-		     pmiID(60, 58, 61), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.outroutersolicits",
+		       pmiID(60, 58, 61), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.inrouteradvertisements",
-		     pmiID(60, 58, 47), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.inrouteradvertisements",
+		       pmiID(60, 58, 47), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.inneighborsolicits",
-		     pmiID(60, 58, 48), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.inneighborsolicits",
+		       pmiID(60, 58, 48), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.outneighborsolicits",
-		     pmiID(60, 58, 63), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.outneighborsolicits",
+		       pmiID(60, 58, 63), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.inneighboradvertisements",
-		     pmiID(60, 58, 49), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.inneighboradvertisements",
+		       pmiID(60, 58, 49), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.outneighboradvertisements",
-		     pmiID(60, 58, 64), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
-#endif /* HAVE_PCP */
+	pcp_add_metric("network.icmp6.outneighboradvertisements",
+		       pmiID(60, 58, 64), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 }
 
 /*
@@ -1553,51 +1490,49 @@ void pcp_def_net_icmp6_metrics(void)
  */
 void pcp_def_net_eicmp6_metrics(void)
 {
-#ifdef HAVE_PCP
-	pmiAddMetric("network.icmp6.inerrors",
-		     pmiID(60, 58, 33), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.inerrors",
+		       pmiID(60, 58, 33), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.indestunreachs",
-		     pmiID(60, 58, 37), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.indestunreachs",
+		       pmiID(60, 58, 37), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.outdestunreachs",
-		     pmiID(60, 58, 52), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.outdestunreachs",
+		       pmiID(60, 58, 52), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.intimeexcds",
-		     pmiID(60, 58, 39), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.intimeexcds",
+		       pmiID(60, 58, 39), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.outtimeexcds",
-		     pmiID(60, 58, 54), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.outtimeexcds",
+		       pmiID(60, 58, 54), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.inparmproblems",
-		     pmiID(60, 58, 40), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.inparmproblems",
+		       pmiID(60, 58, 40), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.outparmproblems",
-		     pmiID(60, 58, 55), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.outparmproblems",
+		       pmiID(60, 58, 55), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.inredirects",
-		     pmiID(60, 58, 50), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.inredirects",
+		       pmiID(60, 58, 50), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.outredirects",
-		     pmiID(60, 58, 65), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.outredirects",
+		       pmiID(60, 58, 65), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.inpkttoobigs",
-		     pmiID(60, 58, 38), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.icmp6.inpkttoobigs",
+		       pmiID(60, 58, 38), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.icmp6.outpkttoobigs",
-		     pmiID(60, 58, 53), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
-#endif /* HAVE_PCP */
+	pcp_add_metric("network.icmp6.outpkttoobigs",
+		       pmiID(60, 58, 53), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 }
 
 /*
@@ -1607,23 +1542,21 @@ void pcp_def_net_eicmp6_metrics(void)
  */
 void pcp_def_net_udp6_metrics(void)
 {
-#ifdef HAVE_PCP
-	pmiAddMetric("network.udp6.indatagrams",
-		     pmiID(60, 58, 67), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.udp6.indatagrams",
+		       pmiID(60, 58, 67), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.udp6.outdatagrams",
-		     pmiID(60, 58, 70), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.udp6.outdatagrams",
+		       pmiID(60, 58, 70), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.udp6.noports",
-		     pmiID(60, 58, 68), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("network.udp6.noports",
+		       pmiID(60, 58, 68), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("network.udp6.inerrors",
-		     pmiID(60, 58, 69), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
-#endif /* HAVE_PCP */
+	pcp_add_metric("network.udp6.inerrors",
+		       pmiID(60, 58, 69), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 }
 
 /*
@@ -1633,23 +1566,21 @@ void pcp_def_net_udp6_metrics(void)
  */
 void pcp_def_huge_metrics(void)
 {
-#ifdef HAVE_PCP
-	pmiAddMetric("mem.util.hugepagesTotalBytes",
-		     pmiID(60, 1, 60), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(1, 0, 0, PM_SPACE_BYTE, 0, 0));
+	pcp_add_metric("mem.util.hugepagesTotalBytes",
+		       pmiID(60, 1, 60), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(1, 0, 0, PM_SPACE_BYTE, 0, 0));
 
-	pmiAddMetric("mem.util.hugepagesFreeBytes",
-		     pmiID(60, 1, 61), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(1, 0, 0, PM_SPACE_BYTE, 0, 0));
+	pcp_add_metric("mem.util.hugepagesFreeBytes",
+		       pmiID(60, 1, 61), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(1, 0, 0, PM_SPACE_BYTE, 0, 0));
 
-	pmiAddMetric("mem.util.hugepagesRsvdBytes",
-		     pmiID(60, 1, 62), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(1, 0, 0, PM_SPACE_BYTE, 0, 0));
+	pcp_add_metric("mem.util.hugepagesRsvdBytes",
+		       pmiID(60, 1, 62), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(1, 0, 0, PM_SPACE_BYTE, 0, 0));
 
-	pmiAddMetric("mem.util.hugepagesSurpBytes",
-		     pmiID(60, 1, 63), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
-		     pmiUnits(1, 0, 0, PM_SPACE_BYTE, 0, 0));
-#endif /* HAVE_PCP */
+	pcp_add_metric("mem.util.hugepagesSurpBytes",
+		       pmiID(60, 1, 63), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_INSTANT,
+		       pmiUnits(1, 0, 0, PM_SPACE_BYTE, 0, 0));
 }
 
 /*
@@ -1662,7 +1593,6 @@ void pcp_def_huge_metrics(void)
  */
 void pcp_def_pwr_fan_metrics(struct activity *a)
 {
-#ifdef HAVE_PCP
 	static pmInDom indom = PM_INDOM_NULL;
 
 	if (indom == PM_INDOM_NULL) {
@@ -1674,22 +1604,21 @@ void pcp_def_pwr_fan_metrics(struct activity *a)
 
 		for (inst = 0; inst < a->item_list_sz; inst++) {
 			sprintf(buf, "fan%d", inst + 1);
-			pmiAddInstance(indom, buf, inst);
+			pcp_add_instance(indom, buf, inst);
 		}
 	}
 
-	pmiAddMetric("power.fan.rpm",
-		     pmiID(34, 0, 0), PM_TYPE_U64, indom, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("power.fan.rpm",
+		       pmiID(34, 0, 0), PM_TYPE_U64, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
-	pmiAddMetric("power.fan.drpm",
-		     pmiID(34, 0, 1), PM_TYPE_U64, indom, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("power.fan.drpm",
+		       pmiID(34, 0, 1), PM_TYPE_U64, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
-	pmiAddMetric("power.fan.device",
-		     pmiID(34, 0, 2), PM_TYPE_STRING, indom, PM_SEM_DISCRETE,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
-#endif /* HAVE_PCP */
+	pcp_add_metric("power.fan.device",
+		       pmiID(34, 0, 2), PM_TYPE_STRING, indom, PM_SEM_DISCRETE,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 }
 
 /*
@@ -1702,7 +1631,6 @@ void pcp_def_pwr_fan_metrics(struct activity *a)
  */
 void pcp_def_pwr_temp_metrics(struct activity *a)
 {
-#ifdef HAVE_PCP
 	static pmInDom indom = PM_INDOM_NULL;
 
 	if (indom == PM_INDOM_NULL) {
@@ -1714,22 +1642,21 @@ void pcp_def_pwr_temp_metrics(struct activity *a)
 
 		for (inst = 0; inst < a->item_list_sz; inst++) {
 			sprintf(buf, "temp%d", inst + 1);
-			pmiAddInstance(indom, buf, inst);
+			pcp_add_instance(indom, buf, inst);
 		}
 	}
 
-	pmiAddMetric("power.temp.celsius",
-		     pmiID(34, 1, 0), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("power.temp.celsius",
+		       pmiID(34, 1, 0), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
-	pmiAddMetric("power.temp.percent",
-		     pmiID(34, 1, 1), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("power.temp.percent",
+		       pmiID(34, 1, 1), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
-	pmiAddMetric("power.temp.device",
-		     pmiID(34, 1, 2), PM_TYPE_STRING, indom, PM_SEM_DISCRETE,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
-#endif /* HAVE_PCP */
+	pcp_add_metric("power.temp.device",
+		       pmiID(34, 1, 2), PM_TYPE_STRING, indom, PM_SEM_DISCRETE,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 }
 
 /*
@@ -1742,7 +1669,6 @@ void pcp_def_pwr_temp_metrics(struct activity *a)
  */
 void pcp_def_pwr_in_metrics(struct activity *a)
 {
-#ifdef HAVE_PCP
 	static pmInDom indom = PM_INDOM_NULL;
 
 	if (indom == PM_INDOM_NULL) {
@@ -1754,22 +1680,21 @@ void pcp_def_pwr_in_metrics(struct activity *a)
 
 		for (inst = 0; inst < a->item_list_sz; inst++) {
 			sprintf(buf, "in%d", inst);
-			pmiAddInstance(indom, buf, inst);
+			pcp_add_instance(indom, buf, inst);
 		}
 	}
 
-	pmiAddMetric("power.in.voltage",
-		     pmiID(34, 2, 0), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("power.in.voltage",
+		       pmiID(34, 2, 0), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
-	pmiAddMetric("power.in.percent",
-		     pmiID(34, 2, 1), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("power.in.percent",
+		       pmiID(34, 2, 1), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
-	pmiAddMetric("power.in.device",
-		     pmiID(34, 2, 2), PM_TYPE_STRING, indom, PM_SEM_DISCRETE,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
-#endif /* HAVE_PCP */
+	pcp_add_metric("power.in.device",
+		       pmiID(34, 2, 2), PM_TYPE_STRING, indom, PM_SEM_DISCRETE,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 }
 
 /*
@@ -1782,7 +1707,6 @@ void pcp_def_pwr_in_metrics(struct activity *a)
  */
 void pcp_def_pwr_bat_metrics(struct activity *a)
 {
-#ifdef HAVE_PCP
 	static pmInDom indom = PM_INDOM_NULL;
 
 	if (indom == PM_INDOM_NULL) {
@@ -1794,19 +1718,18 @@ void pcp_def_pwr_bat_metrics(struct activity *a)
 
 		/* Create instances */
 		while (list != NULL) {
-			pmiAddInstance(indom, list->item_name, inst++);
+			pcp_add_instance(indom, list->item_name, inst++);
 			list = list->next;
 		}
 	}
 
-	pmiAddMetric("power.bat.capacity",
-		     pmiID(34, 4, 0), PM_TYPE_U32, indom, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("power.bat.capacity",
+		       pmiID(34, 4, 0), PM_TYPE_U32, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
-	pmiAddMetric("power.bat.status",
-		     pmiID(34, 4, 2), PM_TYPE_STRING, indom, PM_SEM_DISCRETE,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
-#endif /* HAVE_PCP */
+	pcp_add_metric("power.bat.status",
+		       pmiID(34, 4, 2), PM_TYPE_STRING, indom, PM_SEM_DISCRETE,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 }
 
 /*
@@ -1819,7 +1742,6 @@ void pcp_def_pwr_bat_metrics(struct activity *a)
  */
 void pcp_def_pwr_usb_metrics(struct activity *a)
 {
-#ifdef HAVE_PCP
 	static pmInDom indom = PM_INDOM_NULL;
 
 	if (indom == PM_INDOM_NULL) {
@@ -1831,34 +1753,33 @@ void pcp_def_pwr_usb_metrics(struct activity *a)
 
 		for (inst = 0; inst < a->item_list_sz; inst++) {
 			sprintf(buf, "usb%d", inst);
-			pmiAddInstance(indom, buf, inst);
+			pcp_add_instance(indom, buf, inst);
 		}
 	}
 
-	pmiAddMetric("power.usb.bus",
-		     pmiID(34, 3, 0), PM_TYPE_U32, indom, PM_SEM_DISCRETE,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("power.usb.bus",
+		       pmiID(34, 3, 0), PM_TYPE_U32, indom, PM_SEM_DISCRETE,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
-	pmiAddMetric("power.usb.vendorId",
-		     pmiID(34, 3, 1), PM_TYPE_STRING, indom, PM_SEM_DISCRETE,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("power.usb.vendorId",
+		       pmiID(34, 3, 1), PM_TYPE_STRING, indom, PM_SEM_DISCRETE,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
-	pmiAddMetric("power.usb.productId",
-		     pmiID(34, 3, 2), PM_TYPE_STRING, indom, PM_SEM_DISCRETE,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("power.usb.productId",
+		       pmiID(34, 3, 2), PM_TYPE_STRING, indom, PM_SEM_DISCRETE,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
-	pmiAddMetric("power.usb.maxpower",
-		     pmiID(34, 3, 3), PM_TYPE_U32, indom, PM_SEM_DISCRETE,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("power.usb.maxpower",
+		       pmiID(34, 3, 3), PM_TYPE_U32, indom, PM_SEM_DISCRETE,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
-	pmiAddMetric("power.usb.manufacturer",
-		     pmiID(34, 3, 4), PM_TYPE_STRING, indom, PM_SEM_DISCRETE,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("power.usb.manufacturer",
+		       pmiID(34, 3, 4), PM_TYPE_STRING, indom, PM_SEM_DISCRETE,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
-	pmiAddMetric("power.usb.productName",
-		     pmiID(34, 3, 5), PM_TYPE_STRING, indom, PM_SEM_DISCRETE,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
-#endif /* HAVE_PCP */
+	pcp_add_metric("power.usb.productName",
+		       pmiID(34, 3, 5), PM_TYPE_STRING, indom, PM_SEM_DISCRETE,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 }
 
 /*
@@ -1871,7 +1792,6 @@ void pcp_def_pwr_usb_metrics(struct activity *a)
  */
 void pcp_def_filesystem_metrics(struct activity *a)
 {
-#ifdef HAVE_PCP
 	static pmInDom indom = PM_INDOM_NULL;
 
 	if (indom == PM_INDOM_NULL) {
@@ -1883,43 +1803,42 @@ void pcp_def_filesystem_metrics(struct activity *a)
 
 		/* Create instances */
 		while (list != NULL) {
-			pmiAddInstance(indom, list->item_name, inst++);
+			pcp_add_instance(indom, list->item_name, inst++);
 			list = list->next;
 		}
 	}
 
-	pmiAddMetric("filesys.capacity",
-		     pmiID(60, 5, 1), PM_TYPE_U64, indom, PM_SEM_INSTANT,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+	pcp_add_metric("filesys.capacity",
+		       pmiID(60, 5, 1), PM_TYPE_U64, indom, PM_SEM_INSTANT,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-	pmiAddMetric("filesys.free",
-		     pmiID(60, 5, 3), PM_TYPE_U64, indom, PM_SEM_INSTANT,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+	pcp_add_metric("filesys.free",
+		       pmiID(60, 5, 3), PM_TYPE_U64, indom, PM_SEM_INSTANT,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-	pmiAddMetric("filesys.used",
-		     pmiID(60, 5, 2), PM_TYPE_U64, indom, PM_SEM_INSTANT,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+	pcp_add_metric("filesys.used",
+		       pmiID(60, 5, 2), PM_TYPE_U64, indom, PM_SEM_INSTANT,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 
-	pmiAddMetric("filesys.full",
-		     pmiID(60, 5, 8), PM_TYPE_DOUBLE, indom, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("filesys.full",
+		       pmiID(60, 5, 8), PM_TYPE_DOUBLE, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
-	pmiAddMetric("filesys.maxfiles",
-		     pmiID(60, 5, 4), PM_TYPE_U64, indom, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("filesys.maxfiles",
+		       pmiID(60, 5, 4), PM_TYPE_U64, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("filesys.freefiles",
-		     pmiID(60, 5, 6), PM_TYPE_U64, indom, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("filesys.freefiles",
+		       pmiID(60, 5, 6), PM_TYPE_U64, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("filesys.usedfiles",
-		     pmiID(60, 5, 5), PM_TYPE_U64, indom, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("filesys.usedfiles",
+		       pmiID(60, 5, 5), PM_TYPE_U64, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("filesys.avail",
-		     pmiID(60, 5, 10), PM_TYPE_U64, indom, PM_SEM_INSTANT,
-		     pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
-#endif /* HAVE_PCP */
+	pcp_add_metric("filesys.avail",
+		       pmiID(60, 5, 10), PM_TYPE_U64, indom, PM_SEM_INSTANT,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
 }
 
 /*
@@ -1932,7 +1851,6 @@ void pcp_def_filesystem_metrics(struct activity *a)
  */
 void pcp_def_fchost_metrics(struct activity *a)
 {
-#ifdef HAVE_PCP
 	static pmInDom indom = PM_INDOM_NULL;
 
 	if (indom == PM_INDOM_NULL) {
@@ -1944,30 +1862,214 @@ void pcp_def_fchost_metrics(struct activity *a)
 
 		/* Create instances */
 		while (list != NULL) {
-			pmiAddInstance(indom, list->item_name, inst++);
+			pcp_add_instance(indom, list->item_name, inst++);
 			list = list->next;
 		}
 	}
 
-	pmiAddMetric("fchost.in.frames",
-		     pmiID(60, 91, 0), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("fchost.in.frames",
+		       pmiID(60, 91, 0), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("fchost.out.frames",
-		     pmiID(60, 91, 1), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+	pcp_add_metric("fchost.out.frames",
+		       pmiID(60, 91, 1), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
 
-	pmiAddMetric("fchost.in.bytes",
-		     pmiID(60, 91, 2), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(1, 0, 0, PM_SPACE_BYTE, 0, 0));
+	pcp_add_metric("fchost.in.bytes",
+		       pmiID(60, 91, 2), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(1, 0, 0, PM_SPACE_BYTE, 0, 0));
 
-	pmiAddMetric("fchost.out.bytes",
-		     pmiID(60, 91, 3), PM_TYPE_U64, indom, PM_SEM_COUNTER,
-		     pmiUnits(1, 0, 0, PM_SPACE_BYTE, 0, 0));
-#endif /* HAVE_PCP */
+	pcp_add_metric("fchost.out.bytes",
+		       pmiID(60, 91, 3), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(1, 0, 0, PM_SPACE_BYTE, 0, 0));
+}
+
+/*
+ ***************************************************************************
+ * Define PCP metrics for cgroups statistics.
+ *
+ * IN:
+ * @a		Activity structure with statistics.
+ ***************************************************************************
+ */
+void pcp_def_cgroup_metrics(struct activity *a)
+{
+	static pmInDom indom = PM_INDOM_NULL;
+
+	if (indom == PM_INDOM_NULL) {
+		int inst = 0;
+		struct sa_item *list = a->item_list;
+
+		/* Create domain */
+		indom = pmInDom_build(3, 39);
+
+		/* Create instances */
+		while (list != NULL) {
+			pcp_add_instance(indom, list->item_name, inst++);
+			list = list->next;
+		}
+	}
+
+	pcp_add_metric("cgroup.cpu.stat.usage",
+		       pmiID(3, 80, 0), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_USEC, 0));
+
+	pcp_add_metric("cgroup.cpu.stat.user",
+		       pmiID(3, 80, 1), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_USEC, 0));
+
+	pcp_add_metric("cgroup.cpu.stat.system",
+		       pmiID(3, 80, 2), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_USEC, 0));
+
+	pcp_add_metric("cgroup.cpu.stat.throttled_usec",
+		       pmiID(3, 80, 3), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_USEC, 0));
+
+	pcp_add_metric("cgroup.memory.current",
+		       pmiID(3, 80, 4), PM_TYPE_U64, indom, PM_SEM_INSTANT,
+		       pmiUnits(1, 0, 0, PM_SPACE_KBYTE, 0, 0));
+
+	pcp_add_metric("cgroup.io.stat.rbytes",
+		       pmiID(3, 80, 5), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(1, 0, 0, PM_SPACE_BYTE, 0, 0));
+
+	pcp_add_metric("cgroup.io.stat.wbytes",
+		       pmiID(3, 80, 6), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(1, 0, 0, PM_SPACE_BYTE, 0, 0));
+
+	pcp_add_metric("cgroup.io.stat.rios",
+		       pmiID(3, 80, 7), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+
+	pcp_add_metric("cgroup.io.stat.wios",
+		       pmiID(3, 80, 8), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 0, 1, 0, 0, PM_COUNT_ONE));
+}
+
+/*
+ ***************************************************************************
+ * Define PCP metrics for cgroups pressure-stall statistics.
+ *
+ * IN:
+ * @a		Activity structure with statistics.
+ ***************************************************************************
+ */
+void pcp_def_psi_cgroup_metrics(struct activity *a)
+{
+	static pmInDom indom = PM_INDOM_NULL;
+
+	if (indom == PM_INDOM_NULL) {
+		int inst = 0;
+		struct sa_item *list = a->item_list;
+
+		/* Create domain */
+		indom = pmInDom_build(3, 40);
+
+		/* Create instances */
+		while (list != NULL) {
+			pcp_add_instance(indom, list->item_name, inst++);
+			list = list->next;
+		}
+	}
+
+	pcp_add_metric("cgroup.pressure.cpu.some.avg10sec",
+		       pmiID(3, 81, 0), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
+
+	pcp_add_metric("cgroup.pressure.cpu.some.avg1min",
+		       pmiID(3, 81, 1), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
+
+	pcp_add_metric("cgroup.pressure.cpu.some.avg5min",
+		       pmiID(3, 81, 2), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
+
+	pcp_add_metric("cgroup.pressure.cpu.some.total",
+		       pmiID(3, 81, 3), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_USEC, 0));
+
+	pcp_add_metric("cgroup.pressure.cpu.full.avg10sec",
+		       pmiID(3, 81, 4), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
+
+	pcp_add_metric("cgroup.pressure.cpu.full.avg1min",
+		       pmiID(3, 81, 5), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
+
+	pcp_add_metric("cgroup.pressure.cpu.full.avg5min",
+		       pmiID(3, 81, 6), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
+
+	pcp_add_metric("cgroup.pressure.cpu.full.total",
+		       pmiID(3, 81, 7), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_USEC, 0));
+
+	pcp_add_metric("cgroup.pressure.io.some.avg10sec",
+		       pmiID(3, 81, 8), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
+
+	pcp_add_metric("cgroup.pressure.io.some.avg1min",
+		       pmiID(3, 81, 9), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
+
+	pcp_add_metric("cgroup.pressure.io.some.avg5min",
+		       pmiID(3, 81, 10), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
+
+	pcp_add_metric("cgroup.pressure.io.some.total",
+		       pmiID(3, 81, 11), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_USEC, 0));
+
+	pcp_add_metric("cgroup.pressure.io.full.avg10sec",
+		       pmiID(3, 81, 12), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
+
+	pcp_add_metric("cgroup.pressure.io.full.avg1min",
+		       pmiID(3, 81, 13), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
+
+	pcp_add_metric("cgroup.pressure.io.full.avg5min",
+		       pmiID(3, 81, 14), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
+
+	pcp_add_metric("cgroup.pressure.io.full.total",
+		       pmiID(3, 81, 15), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_USEC, 0));
+
+	pcp_add_metric("cgroup.pressure.memory.some.avg10sec",
+		       pmiID(3, 81, 16), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
+
+	pcp_add_metric("cgroup.pressure.memory.some.avg1min",
+		       pmiID(3, 81, 17), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
+
+	pcp_add_metric("cgroup.pressure.memory.some.avg5min",
+		       pmiID(3, 81, 18), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
+
+	pcp_add_metric("cgroup.pressure.memory.some.total",
+		       pmiID(3, 81, 19), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_USEC, 0));
+
+	pcp_add_metric("cgroup.pressure.memory.full.avg10sec",
+		       pmiID(3, 81, 20), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
+
+	pcp_add_metric("cgroup.pressure.memory.full.avg1min",
+		       pmiID(3, 81, 21), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
+
+	pcp_add_metric("cgroup.pressure.memory.full.avg5min",
+		       pmiID(3, 81, 22), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
+
+	pcp_add_metric("cgroup.pressure.memory.full.total",
+		       pmiID(3, 81, 23), PM_TYPE_U64, indom, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_USEC, 0));
 }
 
-#ifdef HAVE_PCP
 /*
  * **************************************************************************
  * Define PCP metrics for pressure-stall CPU statistics.
@@ -1978,17 +2080,15 @@ void pcp_def_fchost_metrics(struct activity *a)
  */
 void pcp_def_psicpu_metrics(pmInDom indom)
 {
-	pmiAddMetric("kernel.all.pressure.cpu.some.total",
-		     pmiID(60, 83, 1), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_USEC, 0));
+	pcp_add_metric("kernel.all.pressure.cpu.some.total",
+		       pmiID(60, 83, 1), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_USEC, 0));
 
-	pmiAddMetric("kernel.all.pressure.cpu.some.avg",
-		     pmiID(60, 83, 0), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("kernel.all.pressure.cpu.some.avg",
+		       pmiID(60, 83, 0), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 }
-#endif /* HAVE_PCP */
 
-#ifdef HAVE_PCP
 /*
  * **************************************************************************
  * Define PCP metrics for pressure-stall I/O statistics.
@@ -1999,25 +2099,23 @@ void pcp_def_psicpu_metrics(pmInDom indom)
  */
 void pcp_def_psiio_metrics(pmInDom indom)
 {
-	pmiAddMetric("kernel.all.pressure.io.some.total",
-		     pmiID(60, 85, 1), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_USEC, 0));
+	pcp_add_metric("kernel.all.pressure.io.some.total",
+		       pmiID(60, 85, 1), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_USEC, 0));
 
-	pmiAddMetric("kernel.all.pressure.io.some.avg",
-		     pmiID(60, 85, 0), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("kernel.all.pressure.io.some.avg",
+		       pmiID(60, 85, 0), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
-	pmiAddMetric("kernel.all.pressure.io.full.total",
-		     pmiID(60, 85, 3), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_USEC, 0));
+	pcp_add_metric("kernel.all.pressure.io.full.total",
+		       pmiID(60, 85, 3), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_USEC, 0));
 
-	pmiAddMetric("kernel.all.pressure.io.full.avg",
-		     pmiID(60, 85, 2), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("kernel.all.pressure.io.full.avg",
+		       pmiID(60, 85, 2), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 }
-#endif /* HAVE_PCP */
 
-#ifdef HAVE_PCP
 /*
  * **************************************************************************
  * Define PCP metrics for pressure-stall memory statistics.
@@ -2028,23 +2126,22 @@ void pcp_def_psiio_metrics(pmInDom indom)
  */
 void pcp_def_psimem_metrics(pmInDom indom)
 {
-	pmiAddMetric("kernel.all.pressure.memory.some.total",
-		     pmiID(60, 84, 1), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_USEC, 0));
+	pcp_add_metric("kernel.all.pressure.memory.some.total",
+		       pmiID(60, 84, 1), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_USEC, 0));
 
-	pmiAddMetric("kernel.all.pressure.memory.some.avg",
-		     pmiID(60, 84, 0), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("kernel.all.pressure.memory.some.avg",
+		       pmiID(60, 84, 0), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 
-	pmiAddMetric("kernel.all.pressure.memory.full.total",
-		     pmiID(60, 84, 3), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
-		     pmiUnits(0, 1, 0, 0, PM_TIME_USEC, 0));
+	pcp_add_metric("kernel.all.pressure.memory.full.total",
+		       pmiID(60, 84, 3), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER,
+		       pmiUnits(0, 1, 0, 0, PM_TIME_USEC, 0));
 
-	pmiAddMetric("kernel.all.pressure.memory.full.avg",
-		     pmiID(60, 84, 2), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
-		     pmiUnits(0, 0, 0, 0, 0, 0));
+	pcp_add_metric("kernel.all.pressure.memory.full.avg",
+		       pmiID(60, 84, 2), PM_TYPE_FLOAT, indom, PM_SEM_INSTANT,
+		       pmiUnits(0, 0, 0, 0, 0, 0));
 }
-#endif /* HAVE_PCP */
 
 /*
  ***************************************************************************
@@ -2056,16 +2153,15 @@ void pcp_def_psimem_metrics(pmInDom indom)
  */
 void pcp_def_psi_metrics(struct activity *a)
 {
-#ifdef HAVE_PCP
 	static pmInDom indom = PM_INDOM_NULL;
 
 	if (indom == PM_INDOM_NULL) {
 		/* Create domain */
 		indom = pmInDom_build(60, 37);
 
-		pmiAddInstance(indom, "10 second", 10);
-		pmiAddInstance(indom, "1 minute", 60);
-		pmiAddInstance(indom, "5 minute", 300);
+		pcp_add_instance(indom, "10 second", 10);
+		pcp_add_instance(indom, "1 minute", 60);
+		pcp_add_instance(indom, "5 minute", 300);
 	}
 
 	if (a->id == A_PSI_CPU) {
@@ -2080,5 +2176,4 @@ void pcp_def_psi_metrics(struct activity *a)
 		/* Create metrics for A_PSI_MEM */
 		pcp_def_psimem_metrics(indom);
 	}
-#endif /* HAVE_PCP */
 }
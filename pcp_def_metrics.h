@@ -6,12 +6,51 @@
 #ifndef _PCP_DEF_METRICS_H
 #define _PCP_DEF_METRICS_H
 
+#ifndef HAVE_PCP
+/*
+ ***************************************************************************
+ * Minimal set of PCP definitions, so that metrics can still be defined
+ * (e.g. for OpenMetrics output) when PCP support is not compiled in.
+ * Values are the same as those used by libpcp.
+ ***************************************************************************
+ */
+typedef unsigned int pmID;
+typedef unsigned int pmInDom;
+typedef int pmUnits;
+
+#define PM_INDOM_NULL	0xffffffff
+
+#define PM_TYPE_32	0
+#define PM_TYPE_U32	1
+#define PM_TYPE_64	2
+#define PM_TYPE_U64	3
+#define PM_TYPE_FLOAT	4
+#define PM_TYPE_DOUBLE	5
+#define PM_TYPE_STRING	6
+
+#define PM_SEM_COUNTER	1
+#define PM_SEM_INSTANT	3
+#define PM_SEM_DISCRETE	4
+
+#define pmiID(d, c, i)			0
+#define pmiInDom(d, s)			((pmInDom) (((d) << 22) | (s)))
+#define pmInDom_build(d, s)		pmiInDom(d, s)
+#define pmiUnits(a, b, c, d, e, f)	0
+#endif /* HAVE_PCP undefined */
+
 /*
  ***************************************************************************
  * Prototypes for functions used to define PCP metrics.
  ***************************************************************************
  */
 
+void pcp_add_metric
+	(const char *, pmID, int, pmInDom, int, pmUnits);
+void pcp_add_instance
+	(pmInDom, const char *, int);
+void pcp_put_value
+	(const char *, const char *, const char *);
+
 void pcp_def_cpu_metrics(struct activity *);
 void pcp_def_pcsw_metrics(void);
 void pcp_def_irq_metrics(struct activity *);
@@ -45,6 +84,8 @@ void pcp_def_pwr_fan_metrics(struct activity *);
 void pcp_def_pwr_temp_metrics(struct activity *);
 void pcp_def_pwr_in_metrics(struct activity *);
 void pcp_def_pwr_bat_metrics(struct activity *);
+void pcp_def_cgroup_metrics(struct activity *);
+void pcp_def_psi_cgroup_metrics(struct activity *);
 void pcp_def_pwr_usb_metrics(struct activity *);
 void pcp_def_filesystem_metrics(struct activity *);
 void pcp_def_fchost_metrics(struct activity *);
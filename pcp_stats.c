@@ -37,6 +37,8 @@ extern char bat_status[][16];
 #include <pcp/import.h>
 #endif
 
+#include "pcp_def_metrics.h"
+
 /*
  ***************************************************************************
  * Display CPU statistics in PCP format.
@@ -50,7 +52,6 @@ extern char bat_status[][16];
  */
 __print_funct_t pcp_print_cpu_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	int i;
 	unsigned long long deltot_jiffies = 1;
 	char buf[64], cpuno[64];
@@ -114,55 +115,54 @@ __print_funct_t pcp_print_cpu_stats(struct activity *a, int curr)
 
 			if (!deltot_jiffies) {
 				/* Current CPU is tickless */
-				pmiPutValue("kernel.percpu.cpu.user", cpuno, "0");
-				pmiPutValue("kernel.percpu.cpu.nice", cpuno, "0");
-				pmiPutValue("kernel.percpu.cpu.sys", cpuno, "0");
-				pmiPutValue("kernel.percpu.cpu.iowait", cpuno, "0");
-				pmiPutValue("kernel.percpu.cpu.steal", cpuno, "0");
-				pmiPutValue("kernel.percpu.cpu.hardirq", cpuno, "0");
-				pmiPutValue("kernel.percpu.cpu.softirq", cpuno, "0");
-				pmiPutValue("kernel.percpu.cpu.guest", cpuno, "0");
-				pmiPutValue("kernel.percpu.cpu.guest_nice", cpuno, "0");
-				pmiPutValue("kernel.percpu.cpu.idle", cpuno, "100");
+				pcp_put_value("kernel.percpu.cpu.user", cpuno, "0");
+				pcp_put_value("kernel.percpu.cpu.nice", cpuno, "0");
+				pcp_put_value("kernel.percpu.cpu.sys", cpuno, "0");
+				pcp_put_value("kernel.percpu.cpu.iowait", cpuno, "0");
+				pcp_put_value("kernel.percpu.cpu.steal", cpuno, "0");
+				pcp_put_value("kernel.percpu.cpu.hardirq", cpuno, "0");
+				pcp_put_value("kernel.percpu.cpu.softirq", cpuno, "0");
+				pcp_put_value("kernel.percpu.cpu.guest", cpuno, "0");
+				pcp_put_value("kernel.percpu.cpu.guest_nice", cpuno, "0");
+				pcp_put_value("kernel.percpu.cpu.idle", cpuno, "100");
 
 				continue;
 			}
 		}
 
 		snprintf(buf, sizeof(buf), "%llu", scc->cpu_user - scc->cpu_guest);
-		pmiPutValue(i ? "kernel.percpu.cpu.user" : "kernel.all.cpu.user", str, buf);
+		pcp_put_value(i ? "kernel.percpu.cpu.user" : "kernel.all.cpu.user", str, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", scc->cpu_nice - scc->cpu_guest_nice);
-		pmiPutValue(i ? "kernel.percpu.cpu.nice" : "kernel.all.cpu.nice", str, buf);
+		pcp_put_value(i ? "kernel.percpu.cpu.nice" : "kernel.all.cpu.nice", str, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", scc->cpu_sys);
-		pmiPutValue(i ? "kernel.percpu.cpu.sys" : "kernel.all.cpu.sys", str, buf);
+		pcp_put_value(i ? "kernel.percpu.cpu.sys" : "kernel.all.cpu.sys", str, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", scc->cpu_iowait);
-		pmiPutValue(i ? "kernel.percpu.cpu.iowait" : "kernel.all.cpu.iowait", str, buf);
+		pcp_put_value(i ? "kernel.percpu.cpu.iowait" : "kernel.all.cpu.iowait", str, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", scc->cpu_steal);
-		pmiPutValue(i ? "kernel.percpu.cpu.steal" : "kernel.all.cpu.steal", str, buf);
+		pcp_put_value(i ? "kernel.percpu.cpu.steal" : "kernel.all.cpu.steal", str, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", scc->cpu_hardirq + scc->cpu_softirq);
-		pmiPutValue(i ? "kernel.percpu.cpu.irq.total" : "kernel.all.cpu.irq.total", str, buf);
+		pcp_put_value(i ? "kernel.percpu.cpu.irq.total" : "kernel.all.cpu.irq.total", str, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", scc->cpu_hardirq);
-		pmiPutValue(i ? "kernel.percpu.cpu.irq.hard" : "kernel.all.cpu.irq.hard", str, buf);
+		pcp_put_value(i ? "kernel.percpu.cpu.irq.hard" : "kernel.all.cpu.irq.hard", str, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", scc->cpu_softirq);
-		pmiPutValue(i ? "kernel.percpu.cpu.irq.soft" : "kernel.all.cpu.irq.soft", str, buf);
+		pcp_put_value(i ? "kernel.percpu.cpu.irq.soft" : "kernel.all.cpu.irq.soft", str, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", scc->cpu_guest);
-		pmiPutValue(i ? "kernel.percpu.cpu.guest" : "kernel.all.cpu.guest", str, buf);
+		pcp_put_value(i ? "kernel.percpu.cpu.guest" : "kernel.all.cpu.guest", str, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", scc->cpu_guest_nice);
-		pmiPutValue(i ? "kernel.percpu.cpu.guest_nice" : "kernel.all.cpu.guest_nice", str, buf);
+		pcp_put_value(i ? "kernel.percpu.cpu.guest_nice" : "kernel.all.cpu.guest_nice", str, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", scc->cpu_idle);
-		pmiPutValue(i ? "kernel.percpu.cpu.idle" : "kernel.all.cpu.idle", str, buf);
+		pcp_put_value(i ? "kernel.percpu.cpu.idle" : "kernel.all.cpu.idle", str, buf);
 	}
-#endif	/* HAVE_PCP */
 }
 
 /*
@@ -176,17 +176,15 @@ __print_funct_t pcp_print_cpu_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_pcsw_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_pcsw
 		*spc = (struct stats_pcsw *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) spc->context_switch);
-	pmiPutValue("kernel.all.pswitch", NULL, buf);
+	pcp_put_value("kernel.all.pswitch", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%lu", spc->processes);
-	pmiPutValue("kernel.all.sysfork", NULL, buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("kernel.all.sysfork", NULL, buf);
 }
 
 /*
@@ -200,7 +198,6 @@ __print_funct_t pcp_print_pcsw_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_irq_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	int i, c;
 	char buf[64], name[64];
 	struct stats_irq *stc_cpu_irq, *stc_cpuall_irq;
@@ -241,11 +238,11 @@ __print_funct_t pcp_print_irq_stats(struct activity *a, int curr)
 				/* This is CPU "all" */
 				if (!i) {
 					/* This is interrupt "sum" */
-					pmiPutValue("kernel.all.intr", NULL, buf);
+					pcp_put_value("kernel.all.intr", NULL, buf);
 				}
 				else {
-					pmiPutValue("kernel.all.interrupts.total",
-						    stc_cpuall_irq->irq_name, buf);
+					pcp_put_value("kernel.all.interrupts.total",
+						      stc_cpuall_irq->irq_name, buf);
 				}
 			}
 			else {
@@ -253,11 +250,10 @@ __print_funct_t pcp_print_irq_stats(struct activity *a, int curr)
 				snprintf(name, sizeof(name), "%s::cpu%d",
 					 stc_cpuall_irq->irq_name, c - 1);
 
-				pmiPutValue("kernel.percpu.interrupts", name, buf);
+				pcp_put_value("kernel.percpu.interrupts", name, buf);
 			}
 		}
 	}
-#endif	/* HAVE_PCP */
 }
 
 /*
@@ -273,17 +269,15 @@ __print_funct_t pcp_print_irq_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_swap_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_swap
 		*ssc = (struct stats_swap *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%lu", ssc->pswpin);
-	pmiPutValue("swap.pagesin", NULL, buf);
+	pcp_put_value("swap.pagesin", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%lu", ssc->pswpout);
-	pmiPutValue("swap.pagesout", NULL, buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("swap.pagesout", NULL, buf);
 }
 
 /*
@@ -297,41 +291,39 @@ __print_funct_t pcp_print_swap_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_paging_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_paging
 		*spc = (struct stats_paging *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) spc->pgpgin);
-	pmiPutValue("mem.vmstat.pgpgin", NULL, buf);
+	pcp_put_value("mem.vmstat.pgpgin", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) spc->pgpgout);
-	pmiPutValue("mem.vmstat.pgpgout", NULL, buf);
+	pcp_put_value("mem.vmstat.pgpgout", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) spc->pgfault);
-	pmiPutValue("mem.vmstat.pgfault", NULL, buf);
+	pcp_put_value("mem.vmstat.pgfault", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) spc->pgmajfault);
-	pmiPutValue("mem.vmstat.pgmajfault", NULL, buf);
+	pcp_put_value("mem.vmstat.pgmajfault", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) spc->pgfree);
-	pmiPutValue("mem.vmstat.pgfree", NULL, buf);
+	pcp_put_value("mem.vmstat.pgfree", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) spc->pgscan_kswapd);
-	pmiPutValue("mem.vmstat.pgscan_kswapd_total", NULL, buf);
+	pcp_put_value("mem.vmstat.pgscan_kswapd_total", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) spc->pgscan_direct);
-	pmiPutValue("mem.vmstat.pgscan_direct_total", NULL, buf);
+	pcp_put_value("mem.vmstat.pgscan_direct_total", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) spc->pgsteal);
-	pmiPutValue("mem.vmstat.pgsteal_total", NULL, buf);
+	pcp_put_value("mem.vmstat.pgsteal_total", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) spc->pgpromote);
-	pmiPutValue("mem.vmstat.pgpromote_success", NULL, buf);
+	pcp_put_value("mem.vmstat.pgpromote_success", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) spc->pgdemote);
-	pmiPutValue("mem.vmstat.pgdemote_total", NULL, buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("mem.vmstat.pgdemote_total", NULL, buf);
 }
 
 /*
@@ -345,32 +337,30 @@ __print_funct_t pcp_print_paging_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_io_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_io
 		*sic = (struct stats_io *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%llu", sic->dk_drive);
-	pmiPutValue("disk.all.total", NULL, buf);
+	pcp_put_value("disk.all.total", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", sic->dk_drive_rio);
-	pmiPutValue("disk.all.read", NULL, buf);
+	pcp_put_value("disk.all.read", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu",sic->dk_drive_wio);
-	pmiPutValue("disk.all.write", NULL, buf);
+	pcp_put_value("disk.all.write", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", sic->dk_drive_dio);
-	pmiPutValue("disk.all.discard", NULL, buf);
+	pcp_put_value("disk.all.discard", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", sic->dk_drive_rblk);
-	pmiPutValue("disk.all.read_bytes", NULL, buf);
+	pcp_put_value("disk.all.read_bytes", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", sic->dk_drive_wblk);
-	pmiPutValue("disk.all.write_bytes", NULL, buf);
+	pcp_put_value("disk.all.write_bytes", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", sic->dk_drive_dblk);
-	pmiPutValue("disk.all.discard_bytes", NULL, buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("disk.all.discard_bytes", NULL, buf);
 }
 
 /*
@@ -384,62 +374,60 @@ __print_funct_t pcp_print_io_stats(struct activity *a, int curr)
  */
 void pcp_print_ram_memory_stats(struct stats_memory *smc, int dispall)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 
 	snprintf(buf, sizeof(buf), "%lu", (unsigned long) (smc->tlmkb >> 10));
-	pmiPutValue("hinv.physmem", NULL, buf);
+	pcp_put_value("hinv.physmem", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", smc->tlmkb);
-	pmiPutValue("mem.physmem", NULL, buf);
+	pcp_put_value("mem.physmem", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", smc->frmkb);
-	pmiPutValue("mem.util.free", NULL, buf);
+	pcp_put_value("mem.util.free", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", smc->availablekb);
-	pmiPutValue("mem.util.available", NULL, buf);
+	pcp_put_value("mem.util.available", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", smc->tlmkb - smc->availablekb);
-	pmiPutValue("mem.util.used", NULL, buf);
+	pcp_put_value("mem.util.used", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", smc->bufkb);
-	pmiPutValue("mem.util.bufmem", NULL, buf);
+	pcp_put_value("mem.util.bufmem", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", smc->camkb);
-	pmiPutValue("mem.util.cached", NULL, buf);
+	pcp_put_value("mem.util.cached", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", smc->comkb);
-	pmiPutValue("mem.util.committed_AS", NULL, buf);
+	pcp_put_value("mem.util.committed_AS", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", smc->activekb);
-	pmiPutValue("mem.util.active", NULL, buf);
+	pcp_put_value("mem.util.active", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", smc->inactkb);
-	pmiPutValue("mem.util.inactive", NULL, buf);
+	pcp_put_value("mem.util.inactive", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", smc->dirtykb);
-	pmiPutValue("mem.util.dirty", NULL, buf);
+	pcp_put_value("mem.util.dirty", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", smc->shmemkb);
-	pmiPutValue("mem.util.shared", NULL, buf);
+	pcp_put_value("mem.util.shared", NULL, buf);
 
 	if (dispall) {
 		snprintf(buf, sizeof(buf), "%llu", smc->anonpgkb);
-		pmiPutValue("mem.util.anonpages", NULL, buf);
+		pcp_put_value("mem.util.anonpages", NULL, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", smc->slabkb);
-		pmiPutValue("mem.util.slab", NULL, buf);
+		pcp_put_value("mem.util.slab", NULL, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", smc->kstackkb);
-		pmiPutValue("mem.util.kernelStack", NULL, buf);
+		pcp_put_value("mem.util.kernelStack", NULL, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", smc->pgtblkb);
-		pmiPutValue("mem.util.pageTables", NULL, buf);
+		pcp_put_value("mem.util.pageTables", NULL, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", smc->vmusedkb);
-		pmiPutValue("mem.util.vmallocUsed", NULL, buf);
+		pcp_put_value("mem.util.vmallocUsed", NULL, buf);
 	}
-#endif	/* HAVE_PCP */
 }
 
 /*
@@ -452,18 +440,16 @@ void pcp_print_ram_memory_stats(struct stats_memory *smc, int dispall)
  */
 void pcp_print_swap_memory_stats(struct stats_memory *smc)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 
 	snprintf(buf, sizeof(buf), "%llu", smc->frskb);
-	pmiPutValue("mem.util.swapFree", NULL, buf);
+	pcp_put_value("mem.util.swapFree", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", smc->tlskb);
-	pmiPutValue("mem.util.swapTotal", NULL, buf);
+	pcp_put_value("mem.util.swapTotal", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", smc->caskb);
-	pmiPutValue("mem.util.swapCached", NULL, buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("mem.util.swapCached", NULL, buf);
 }
 
 /*
@@ -477,7 +463,6 @@ void pcp_print_swap_memory_stats(struct stats_memory *smc)
  */
 __print_funct_t pcp_print_memory_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	struct stats_memory
 		*smc = (struct stats_memory *) a->buf[curr];
 
@@ -488,7 +473,6 @@ __print_funct_t pcp_print_memory_stats(struct activity *a, int curr)
 	if (DISPLAY_SWAP(a->opt_flags)) {
 		pcp_print_swap_memory_stats(smc);
 	}
-#endif	/* HAVE_PCP */
 }
 
 /*
@@ -502,23 +486,21 @@ __print_funct_t pcp_print_memory_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_ktables_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_ktables
 		*skc = (struct stats_ktables *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%lu", (unsigned long) skc->dentry_stat);
-	pmiPutValue("vfs.dentry.count", NULL, buf);
+	pcp_put_value("vfs.dentry.count", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%lu", (unsigned long) skc->file_used);
-	pmiPutValue("vfs.files.count", NULL, buf);
+	pcp_put_value("vfs.files.count", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%lu", (unsigned long) skc->inode_used);
-	pmiPutValue("vfs.inodes.count", NULL, buf);
+	pcp_put_value("vfs.inodes.count", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", skc->pty_nr);
-	pmiPutValue("kernel.all.nptys", NULL, buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("kernel.all.nptys", NULL, buf);
 }
 
 /*
@@ -532,29 +514,27 @@ __print_funct_t pcp_print_ktables_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_queue_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_queue
 		*sqc = (struct stats_queue *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%lu", (unsigned long) sqc->nr_running);
-	pmiPutValue("kernel.all.runnable", NULL, buf);
+	pcp_put_value("kernel.all.runnable", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%lu", (unsigned long) sqc->nr_threads);
-	pmiPutValue("kernel.all.nprocs", NULL, buf);
+	pcp_put_value("kernel.all.nprocs", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%lu", (unsigned long) sqc->procs_blocked);
-	pmiPutValue("kernel.all.blocked", NULL, buf);
+	pcp_put_value("kernel.all.blocked", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%f", (double) sqc->load_avg_1 / 100);
-	pmiPutValue("kernel.all.load", "1 minute", buf);
+	pcp_put_value("kernel.all.load", "1 minute", buf);
 
 	snprintf(buf, sizeof(buf), "%f", (double) sqc->load_avg_5 / 100);
-	pmiPutValue("kernel.all.load", "5 minute", buf);
+	pcp_put_value("kernel.all.load", "5 minute", buf);
 
 	snprintf(buf, sizeof(buf), "%f", (double) sqc->load_avg_15 / 100);
-	pmiPutValue("kernel.all.load", "15 minute", buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("kernel.all.load", "15 minute", buf);
 }
 
 /*
@@ -568,7 +548,6 @@ __print_funct_t pcp_print_queue_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_disk_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	int i;
 	struct stats_disk *sdc;
 	char *dev_name;
@@ -591,39 +570,38 @@ __print_funct_t pcp_print_disk_stats(struct activity *a, int curr)
 		}
 
 		snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sdc->nr_ios);
-		pmiPutValue("disk.dev.total", dev_name, buf);
+		pcp_put_value("disk.dev.total", dev_name, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", (unsigned long long) (sdc->rd_sect + sdc->wr_sect) / 2);
-		pmiPutValue("disk.dev.total_bytes", dev_name, buf);
+		pcp_put_value("disk.dev.total_bytes", dev_name, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sdc->rd_sect / 2);
-		pmiPutValue("disk.dev.read_bytes", dev_name, buf);
+		pcp_put_value("disk.dev.read_bytes", dev_name, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sdc->wr_sect / 2);
-		pmiPutValue("disk.dev.write_bytes", dev_name, buf);
+		pcp_put_value("disk.dev.write_bytes", dev_name, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sdc->dc_sect / 2);
-		pmiPutValue("disk.dev.discard_bytes", dev_name, buf);
+		pcp_put_value("disk.dev.discard_bytes", dev_name, buf);
 
 		snprintf(buf, sizeof(buf), "%lu", (unsigned long) sdc->rd_ticks + sdc->wr_ticks);
-		pmiPutValue("disk.dev.total_rawactive", dev_name, buf);
+		pcp_put_value("disk.dev.total_rawactive", dev_name, buf);
 
 		snprintf(buf, sizeof(buf), "%lu", (unsigned long) sdc->rd_ticks);
-		pmiPutValue("disk.dev.read_rawactive", dev_name, buf);
+		pcp_put_value("disk.dev.read_rawactive", dev_name, buf);
 
 		snprintf(buf, sizeof(buf), "%lu", (unsigned long) sdc->wr_ticks);
-		pmiPutValue("disk.dev.write_rawactive", dev_name, buf);
+		pcp_put_value("disk.dev.write_rawactive", dev_name, buf);
 
 		snprintf(buf, sizeof(buf), "%lu", (unsigned long)sdc->dc_ticks);
-		pmiPutValue("disk.dev.discard_rawactive", dev_name, buf);
+		pcp_put_value("disk.dev.discard_rawactive", dev_name, buf);
 
 		snprintf(buf, sizeof(buf), "%lu", (unsigned long)sdc->tot_ticks);
-		pmiPutValue("disk.dev.avactive", dev_name, buf);
+		pcp_put_value("disk.dev.avactive", dev_name, buf);
 
 		snprintf(buf, sizeof(buf), "%lu", (unsigned long)sdc->rq_ticks);
-		pmiPutValue("disk.dev.aveq", dev_name, buf);
+		pcp_put_value("disk.dev.aveq", dev_name, buf);
 	}
-#endif	/* HAVE_PCP */
 }
 
 /*
@@ -637,7 +615,6 @@ __print_funct_t pcp_print_disk_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_net_dev_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	int i;
 	struct stats_net_dev *sndc;
 	char buf[64];
@@ -663,27 +640,26 @@ __print_funct_t pcp_print_net_dev_stats(struct activity *a, int curr)
 		 */
 
 		snprintf(buf, sizeof(buf), "%llu", sndc->rx_packets);
-		pmiPutValue("network.interface.in.packets", sndc->interface, buf);
+		pcp_put_value("network.interface.in.packets", sndc->interface, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", sndc->tx_packets);
-		pmiPutValue("network.interface.out.packets", sndc->interface, buf);
+		pcp_put_value("network.interface.out.packets", sndc->interface, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", sndc->rx_bytes);
-		pmiPutValue("network.interface.in.bytes", sndc->interface, buf);
+		pcp_put_value("network.interface.in.bytes", sndc->interface, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", sndc->tx_bytes);
-		pmiPutValue("network.interface.out.bytes", sndc->interface, buf);
+		pcp_put_value("network.interface.out.bytes", sndc->interface, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", sndc->rx_compressed);
-		pmiPutValue("network.interface.in.compressed", sndc->interface, buf);
+		pcp_put_value("network.interface.in.compressed", sndc->interface, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", sndc->tx_compressed);
-		pmiPutValue("network.interface.out.compressed", sndc->interface, buf);
+		pcp_put_value("network.interface.out.compressed", sndc->interface, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", sndc->multicast);
-		pmiPutValue("network.interface.in.mcasts", sndc->interface, buf);
+		pcp_put_value("network.interface.in.mcasts", sndc->interface, buf);
 	}
-#endif	/* HAVE_PCP */
 }
 
 /*
@@ -697,7 +673,6 @@ __print_funct_t pcp_print_net_dev_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_net_edev_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	int i;
 	struct stats_net_edev *snedc;
 	char buf[64];
@@ -714,33 +689,32 @@ __print_funct_t pcp_print_net_edev_stats(struct activity *a, int curr)
 		}
 
 		snprintf(buf, sizeof(buf), "%llu", snedc->rx_errors);
-		pmiPutValue("network.interface.in.errors", snedc->interface, buf);
+		pcp_put_value("network.interface.in.errors", snedc->interface, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", snedc->tx_errors);
-		pmiPutValue("network.interface.out.errors", snedc->interface, buf);
+		pcp_put_value("network.interface.out.errors", snedc->interface, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", snedc->collisions);
-		pmiPutValue("network.interface.collisions", snedc->interface, buf);
+		pcp_put_value("network.interface.collisions", snedc->interface, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", snedc->rx_dropped);
-		pmiPutValue("network.interface.in.drops", snedc->interface, buf);
+		pcp_put_value("network.interface.in.drops", snedc->interface, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", snedc->tx_dropped);
-		pmiPutValue("network.interface.out.drops", snedc->interface, buf);
+		pcp_put_value("network.interface.out.drops", snedc->interface, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", snedc->tx_carrier_errors);
-		pmiPutValue("network.interface.out.carrier", snedc->interface, buf);
+		pcp_put_value("network.interface.out.carrier", snedc->interface, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", snedc->rx_frame_errors);
-		pmiPutValue("network.interface.in.frame", snedc->interface, buf);
+		pcp_put_value("network.interface.in.frame", snedc->interface, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", snedc->rx_fifo_errors);
-		pmiPutValue("network.interface.in.fifo", snedc->interface, buf);
+		pcp_put_value("network.interface.in.fifo", snedc->interface, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", snedc->tx_fifo_errors);
-		pmiPutValue("network.interface.out.fifo", snedc->interface, buf);
+		pcp_put_value("network.interface.out.fifo", snedc->interface, buf);
 	}
-#endif	/* HAVE_PCP */
 }
 
 /*
@@ -754,7 +728,6 @@ __print_funct_t pcp_print_net_edev_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_serial_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	int i;
 	char buf[64], serialno[64];
 	struct stats_serial *ssc;
@@ -766,24 +739,23 @@ __print_funct_t pcp_print_serial_stats(struct activity *a, int curr)
 		snprintf(serialno, sizeof(serialno), "serial%u", ssc->line);
 
 		snprintf(buf, sizeof(buf), "%u", ssc->rx);
-		pmiPutValue("tty.serial.rx", serialno, buf);
+		pcp_put_value("tty.serial.rx", serialno, buf);
 
 		snprintf(buf, sizeof(buf), "%u", ssc->tx);
-		pmiPutValue("tty.serial.tx", serialno, buf);
+		pcp_put_value("tty.serial.tx", serialno, buf);
 
 		snprintf(buf, sizeof(buf), "%u", ssc->frame);
-		pmiPutValue("tty.serial.frame", serialno, buf);
+		pcp_put_value("tty.serial.frame", serialno, buf);
 
 		snprintf(buf, sizeof(buf), "%u", ssc->parity);
-		pmiPutValue("tty.serial.parity", serialno, buf);
+		pcp_put_value("tty.serial.parity", serialno, buf);
 
 		snprintf(buf, sizeof(buf), "%u", ssc->brk);
-		pmiPutValue("tty.serial.brk", serialno, buf);
+		pcp_put_value("tty.serial.brk", serialno, buf);
 
 		snprintf(buf, sizeof(buf), "%u", ssc->overrun);
-		pmiPutValue("tty.serial.overrun", serialno, buf);
+		pcp_put_value("tty.serial.overrun", serialno, buf);
 	}
-#endif	/* HAVE_PCP */
 }
 
 /*
@@ -797,29 +769,27 @@ __print_funct_t pcp_print_serial_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_net_nfs_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_net_nfs
 		*snnc = (struct stats_net_nfs *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%u", snnc->nfs_rpccnt);
-	pmiPutValue("rpc.client.rpccnt", NULL, buf);
+	pcp_put_value("rpc.client.rpccnt", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%u", snnc->nfs_rpcretrans);
-	pmiPutValue("rpc.client.rpcretrans", NULL, buf);
+	pcp_put_value("rpc.client.rpcretrans", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%u", snnc->nfs_readcnt);
-	pmiPutValue("nfs.client.reqs", "read", buf);
+	pcp_put_value("nfs.client.reqs", "read", buf);
 
 	snprintf(buf, sizeof(buf), "%u", snnc->nfs_writecnt);
-	pmiPutValue("nfs.client.reqs", "write", buf);
+	pcp_put_value("nfs.client.reqs", "write", buf);
 
 	snprintf(buf, sizeof(buf), "%u", snnc->nfs_accesscnt);
-	pmiPutValue("nfs.client.reqs", "access", buf);
+	pcp_put_value("nfs.client.reqs", "access", buf);
 
 	snprintf(buf, sizeof(buf), "%u", snnc->nfs_getattcnt);
-	pmiPutValue("nfs.client.reqs", "getattr", buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("nfs.client.reqs", "getattr", buf);
 }
 
 /*
@@ -833,44 +803,42 @@ __print_funct_t pcp_print_net_nfs_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_net_nfsd_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_net_nfsd
 		*snndc = (struct stats_net_nfsd *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%u", snndc->nfsd_rpccnt);
-	pmiPutValue("rpc.server.rpccnt", NULL, buf);
+	pcp_put_value("rpc.server.rpccnt", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%u", snndc->nfsd_rpcbad);
-	pmiPutValue("rpc.server.rpcbadclnt", NULL, buf);
+	pcp_put_value("rpc.server.rpcbadclnt", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%u", snndc->nfsd_netcnt);
-	pmiPutValue("rpc.server.netcnt", NULL, buf);
+	pcp_put_value("rpc.server.netcnt", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%u", snndc->nfsd_netudpcnt);
-	pmiPutValue("rpc.server.netudpcnt", NULL, buf);
+	pcp_put_value("rpc.server.netudpcnt", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%u", snndc->nfsd_nettcpcnt);
-	pmiPutValue("rpc.server.nettcpcnt", NULL, buf);
+	pcp_put_value("rpc.server.nettcpcnt", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%u", snndc->nfsd_rchits);
-	pmiPutValue("rpc.server.rchits", NULL, buf);
+	pcp_put_value("rpc.server.rchits", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%u", snndc->nfsd_rcmisses);
-	pmiPutValue("rpc.server.rcmisses", NULL, buf);
+	pcp_put_value("rpc.server.rcmisses", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%u", snndc->nfsd_readcnt);
-	pmiPutValue("nfs.server.reqs", "read", buf);
+	pcp_put_value("nfs.server.reqs", "read", buf);
 
 	snprintf(buf, sizeof(buf), "%u", snndc->nfsd_writecnt);
-	pmiPutValue("nfs.server.reqs", "write", buf);
+	pcp_put_value("nfs.server.reqs", "write", buf);
 
 	snprintf(buf, sizeof(buf), "%u", snndc->nfsd_accesscnt);
-	pmiPutValue("nfs.server.reqs", "access", buf);
+	pcp_put_value("nfs.server.reqs", "access", buf);
 
 	snprintf(buf, sizeof(buf), "%u", snndc->nfsd_getattcnt);
-	pmiPutValue("nfs.server.reqs", "getattr", buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("nfs.server.reqs", "getattr", buf);
 }
 
 /*
@@ -884,29 +852,27 @@ __print_funct_t pcp_print_net_nfsd_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_net_sock_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_net_sock
 		*snsc = (struct stats_net_sock *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%u", snsc->sock_inuse);
-	pmiPutValue("network.sockstat.total", NULL, buf);
+	pcp_put_value("network.sockstat.total", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%u", snsc->tcp_inuse);
-	pmiPutValue("network.sockstat.tcp.inuse", NULL, buf);
+	pcp_put_value("network.sockstat.tcp.inuse", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%u", snsc->udp_inuse);
-	pmiPutValue("network.sockstat.udp.inuse", NULL, buf);
+	pcp_put_value("network.sockstat.udp.inuse", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%u", snsc->raw_inuse);
-	pmiPutValue("network.sockstat.raw.inuse", NULL, buf);
+	pcp_put_value("network.sockstat.raw.inuse", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%u", snsc->frag_inuse);
-	pmiPutValue("network.sockstat.frag.inuse", NULL, buf);
+	pcp_put_value("network.sockstat.frag.inuse", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%u", snsc->tcp_tw);
-	pmiPutValue("network.sockstat.tcp.tw", NULL, buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("network.sockstat.tcp.tw", NULL, buf);
 }
 
 /*
@@ -922,35 +888,33 @@ __print_funct_t pcp_print_net_sock_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_net_ip_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_net_ip
 		*snic = (struct stats_net_ip *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%llu", snic->InReceives);
-	pmiPutValue("network.ip.inreceives", NULL, buf);
+	pcp_put_value("network.ip.inreceives", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", snic->ForwDatagrams);
-	pmiPutValue("network.ip.forwdatagrams", NULL, buf);
+	pcp_put_value("network.ip.forwdatagrams", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", snic->InDelivers);
-	pmiPutValue("network.ip.indelivers", NULL, buf);
+	pcp_put_value("network.ip.indelivers", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", snic->OutRequests);
-	pmiPutValue("network.ip.outrequests", NULL, buf);
+	pcp_put_value("network.ip.outrequests", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", snic->ReasmReqds);
-	pmiPutValue("network.ip.reasmreqds", NULL, buf);
+	pcp_put_value("network.ip.reasmreqds", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", snic->ReasmOKs);
-	pmiPutValue("network.ip.reasmoks", NULL, buf);
+	pcp_put_value("network.ip.reasmoks", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", snic->FragOKs);
-	pmiPutValue("network.ip.fragoks", NULL, buf);
+	pcp_put_value("network.ip.fragoks", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", snic->FragCreates);
-	pmiPutValue("network.ip.fragcreates", NULL, buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("network.ip.fragcreates", NULL, buf);
 }
 
 /*
@@ -964,35 +928,33 @@ __print_funct_t pcp_print_net_ip_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_net_eip_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_net_eip
 		*sneic = (struct stats_net_eip *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%llu", sneic->InHdrErrors);
-	pmiPutValue("network.ip.inhdrerrors", NULL, buf);
+	pcp_put_value("network.ip.inhdrerrors", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", sneic->InAddrErrors);
-	pmiPutValue("network.ip.inaddrerrors", NULL, buf);
+	pcp_put_value("network.ip.inaddrerrors", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", sneic->InUnknownProtos);
-	pmiPutValue("network.ip.inunknownprotos", NULL, buf);
+	pcp_put_value("network.ip.inunknownprotos", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", sneic->InDiscards);
-	pmiPutValue("network.ip.indiscards", NULL, buf);
+	pcp_put_value("network.ip.indiscards", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", sneic->OutDiscards);
-	pmiPutValue("network.ip.outdiscards", NULL, buf);
+	pcp_put_value("network.ip.outdiscards", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", sneic->OutNoRoutes);
-	pmiPutValue("network.ip.outnoroutes", NULL, buf);
+	pcp_put_value("network.ip.outnoroutes", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", sneic->ReasmFails);
-	pmiPutValue("network.ip.reasmfails", NULL, buf);
+	pcp_put_value("network.ip.reasmfails", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", sneic->FragFails);
-	pmiPutValue("network.ip.fragfails", NULL, buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("network.ip.fragfails", NULL, buf);
 }
 
 /*
@@ -1006,53 +968,51 @@ __print_funct_t pcp_print_net_eip_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_net_icmp_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_net_icmp
 		*snic = (struct stats_net_icmp *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->InMsgs);
-	pmiPutValue("network.icmp.inmsgs", NULL, buf);
+	pcp_put_value("network.icmp.inmsgs", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->OutMsgs);
-	pmiPutValue("network.icmp.outmsgs", NULL, buf);
+	pcp_put_value("network.icmp.outmsgs", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->InEchos);
-	pmiPutValue("network.icmp.inechos", NULL, buf);
+	pcp_put_value("network.icmp.inechos", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->InEchoReps);
-	pmiPutValue("network.icmp.inechoreps", NULL, buf);
+	pcp_put_value("network.icmp.inechoreps", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->OutEchos);
-	pmiPutValue("network.icmp.outechos", NULL, buf);
+	pcp_put_value("network.icmp.outechos", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->OutEchoReps);
-	pmiPutValue("network.icmp.outechoreps", NULL, buf);
+	pcp_put_value("network.icmp.outechoreps", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->InTimestamps);
-	pmiPutValue("network.icmp.intimestamps", NULL, buf);
+	pcp_put_value("network.icmp.intimestamps", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->InTimestampReps);
-	pmiPutValue("network.icmp.intimestampreps", NULL, buf);
+	pcp_put_value("network.icmp.intimestampreps", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->OutTimestamps);
-	pmiPutValue("network.icmp.outtimestamps", NULL, buf);
+	pcp_put_value("network.icmp.outtimestamps", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->OutTimestampReps);
-	pmiPutValue("network.icmp.outtimestampreps", NULL, buf);
+	pcp_put_value("network.icmp.outtimestampreps", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->InAddrMasks);
-	pmiPutValue("network.icmp.inaddrmasks", NULL, buf);
+	pcp_put_value("network.icmp.inaddrmasks", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->InAddrMaskReps);
-	pmiPutValue("network.icmp.inaddrmaskreps", NULL, buf);
+	pcp_put_value("network.icmp.inaddrmaskreps", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->OutAddrMasks);
-	pmiPutValue("network.icmp.outaddrmasks", NULL, buf);
+	pcp_put_value("network.icmp.outaddrmasks", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->OutAddrMaskReps);
-	pmiPutValue("network.icmp.outaddrmaskreps", NULL, buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("network.icmp.outaddrmaskreps", NULL, buf);
 }
 
 
@@ -1067,47 +1027,45 @@ __print_funct_t pcp_print_net_icmp_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_net_eicmp_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_net_eicmp
 		*sneic = (struct stats_net_eicmp *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sneic->InErrors);
-	pmiPutValue("network.icmp.inerrors", NULL, buf);
+	pcp_put_value("network.icmp.inerrors", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sneic->OutErrors);
-	pmiPutValue("network.icmp.outerrors", NULL, buf);
+	pcp_put_value("network.icmp.outerrors", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sneic->InDestUnreachs);
-	pmiPutValue("network.icmp.indestunreachs", NULL, buf);
+	pcp_put_value("network.icmp.indestunreachs", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sneic->OutDestUnreachs);
-	pmiPutValue("network.icmp.outdestunreachs", NULL, buf);
+	pcp_put_value("network.icmp.outdestunreachs", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sneic->InTimeExcds);
-	pmiPutValue("network.icmp.intimeexcds", NULL, buf);
+	pcp_put_value("network.icmp.intimeexcds", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sneic->OutTimeExcds);
-	pmiPutValue("network.icmp.outtimeexcds", NULL, buf);
+	pcp_put_value("network.icmp.outtimeexcds", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sneic->InParmProbs);
-	pmiPutValue("network.icmp.inparmprobs", NULL, buf);
+	pcp_put_value("network.icmp.inparmprobs", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sneic->OutParmProbs);
-	pmiPutValue("network.icmp.outparmprobs", NULL, buf);
+	pcp_put_value("network.icmp.outparmprobs", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sneic->InSrcQuenchs);
-	pmiPutValue("network.icmp.insrcquenchs", NULL, buf);
+	pcp_put_value("network.icmp.insrcquenchs", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sneic->OutSrcQuenchs);
-	pmiPutValue("network.icmp.outsrcquenchs", NULL, buf);
+	pcp_put_value("network.icmp.outsrcquenchs", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sneic->InRedirects);
-	pmiPutValue("network.icmp.inredirects", NULL, buf);
+	pcp_put_value("network.icmp.inredirects", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sneic->OutRedirects);
-	pmiPutValue("network.icmp.outredirects", NULL, buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("network.icmp.outredirects", NULL, buf);
 }
 
 /*
@@ -1121,23 +1079,21 @@ __print_funct_t pcp_print_net_eicmp_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_net_tcp_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_net_tcp
 		*sntc = (struct stats_net_tcp *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sntc->ActiveOpens);
-	pmiPutValue("network.tcp.activeopens", NULL, buf);
+	pcp_put_value("network.tcp.activeopens", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sntc->PassiveOpens);
-	pmiPutValue("network.tcp.passiveopens", NULL, buf);
+	pcp_put_value("network.tcp.passiveopens", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sntc->InSegs);
-	pmiPutValue("network.tcp.insegs", NULL, buf);
+	pcp_put_value("network.tcp.insegs", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sntc->OutSegs);
-	pmiPutValue("network.tcp.outsegs", NULL, buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("network.tcp.outsegs", NULL, buf);
 }
 
 /*
@@ -1151,26 +1107,24 @@ __print_funct_t pcp_print_net_tcp_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_net_etcp_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_net_etcp
 		*snetc = (struct stats_net_etcp *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snetc->AttemptFails);
-	pmiPutValue("network.tcp.attemptfails", NULL, buf);
+	pcp_put_value("network.tcp.attemptfails", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snetc->EstabResets);
-	pmiPutValue("network.tcp.estabresets", NULL, buf);
+	pcp_put_value("network.tcp.estabresets", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snetc->RetransSegs);
-	pmiPutValue("network.tcp.retranssegs", NULL, buf);
+	pcp_put_value("network.tcp.retranssegs", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snetc->InErrs);
-	pmiPutValue("network.tcp.inerrs", NULL, buf);
+	pcp_put_value("network.tcp.inerrs", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snetc->OutRsts);
-	pmiPutValue("network.tcp.outrsts", NULL, buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("network.tcp.outrsts", NULL, buf);
 }
 
 /*
@@ -1184,23 +1138,21 @@ __print_funct_t pcp_print_net_etcp_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_net_udp_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_net_udp
 		*snuc = (struct stats_net_udp *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snuc->InDatagrams);
-	pmiPutValue("network.udp.indatagrams", NULL, buf);
+	pcp_put_value("network.udp.indatagrams", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snuc->OutDatagrams);
-	pmiPutValue("network.udp.outdatagrams", NULL, buf);
+	pcp_put_value("network.udp.outdatagrams", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snuc->NoPorts);
-	pmiPutValue("network.udp.noports", NULL, buf);
+	pcp_put_value("network.udp.noports", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snuc->InErrors);
-	pmiPutValue("network.udp.inerrors", NULL, buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("network.udp.inerrors", NULL, buf);
 }
 
 /*
@@ -1214,23 +1166,21 @@ __print_funct_t pcp_print_net_udp_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_net_sock6_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_net_sock6
 		*snsc = (struct stats_net_sock6 *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%u", snsc->tcp6_inuse);
-	pmiPutValue("network.sockstat.tcp6.inuse", NULL, buf);
+	pcp_put_value("network.sockstat.tcp6.inuse", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%u", snsc->udp6_inuse);
-	pmiPutValue("network.sockstat.udp6.inuse", NULL, buf);
+	pcp_put_value("network.sockstat.udp6.inuse", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%u", snsc->raw6_inuse);
-	pmiPutValue("network.sockstat.raw6.inuse", NULL, buf);
+	pcp_put_value("network.sockstat.raw6.inuse", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%u", snsc->frag6_inuse);
-	pmiPutValue("network.sockstat.frag6.inuse", NULL, buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("network.sockstat.frag6.inuse", NULL, buf);
 }
 
 /*
@@ -1244,41 +1194,39 @@ __print_funct_t pcp_print_net_sock6_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_net_ip6_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_net_ip6
 		*snic = (struct stats_net_ip6 *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%llu", snic->InReceives6);
-	pmiPutValue("network.ip6.inreceives", NULL, buf);
+	pcp_put_value("network.ip6.inreceives", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", snic->OutForwDatagrams6);
-	pmiPutValue("network.ip6.outforwdatagrams", NULL, buf);
+	pcp_put_value("network.ip6.outforwdatagrams", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", snic->InDelivers6);
-	pmiPutValue("network.ip6.indelivers", NULL, buf);
+	pcp_put_value("network.ip6.indelivers", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", snic->OutRequests6);
-	pmiPutValue("network.ip6.outrequests", NULL, buf);
+	pcp_put_value("network.ip6.outrequests", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", snic->ReasmReqds6);
-	pmiPutValue("network.ip6.reasmreqds", NULL, buf);
+	pcp_put_value("network.ip6.reasmreqds", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", snic->ReasmOKs6);
-	pmiPutValue("network.ip6.reasmoks", NULL, buf);
+	pcp_put_value("network.ip6.reasmoks", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", snic->InMcastPkts6);
-	pmiPutValue("network.ip6.inmcastpkts", NULL, buf);
+	pcp_put_value("network.ip6.inmcastpkts", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", snic->OutMcastPkts6);
-	pmiPutValue("network.ip6.outmcastpkts", NULL, buf);
+	pcp_put_value("network.ip6.outmcastpkts", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", snic->FragOKs6);
-	pmiPutValue("network.ip6.fragoks", NULL, buf);
+	pcp_put_value("network.ip6.fragoks", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", snic->FragCreates6);
-	pmiPutValue("network.ip6.fragcreates", NULL, buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("network.ip6.fragcreates", NULL, buf);
 }
 
 /*
@@ -1292,44 +1240,42 @@ __print_funct_t pcp_print_net_ip6_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_net_eip6_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_net_eip6
 		*sneic = (struct stats_net_eip6 *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%llu", sneic->InHdrErrors6);
-	pmiPutValue("network.ip6.inhdrerrors", NULL, buf);
+	pcp_put_value("network.ip6.inhdrerrors", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", sneic->InAddrErrors6);
-	pmiPutValue("network.ip6.inaddrerrors", NULL, buf);
+	pcp_put_value("network.ip6.inaddrerrors", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", sneic->InUnknownProtos6);
-	pmiPutValue("network.ip6.inunknownprotos", NULL, buf);
+	pcp_put_value("network.ip6.inunknownprotos", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", sneic->InTooBigErrors6);
-	pmiPutValue("network.ip6.intoobigerrors", NULL, buf);
+	pcp_put_value("network.ip6.intoobigerrors", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", sneic->InDiscards6);
-	pmiPutValue("network.ip6.indiscards", NULL, buf);
+	pcp_put_value("network.ip6.indiscards", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", sneic->OutDiscards6);
-	pmiPutValue("network.ip6.outdiscards", NULL, buf);
+	pcp_put_value("network.ip6.outdiscards", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", sneic->InNoRoutes6);
-	pmiPutValue("network.ip6.innoroutes", NULL, buf);
+	pcp_put_value("network.ip6.innoroutes", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", sneic->OutNoRoutes6);
-	pmiPutValue("network.ip6.outnoroutes", NULL, buf);
+	pcp_put_value("network.ip6.outnoroutes", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", sneic->ReasmFails6);
-	pmiPutValue("network.ip6.reasmfails", NULL, buf);
+	pcp_put_value("network.ip6.reasmfails", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", sneic->FragFails6);
-	pmiPutValue("network.ip6.fragfails", NULL, buf);
+	pcp_put_value("network.ip6.fragfails", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", sneic->InTruncatedPkts6);
-	pmiPutValue("network.ip6.intruncatedpkts", NULL, buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("network.ip6.intruncatedpkts", NULL, buf);
 }
 
 /*
@@ -1343,62 +1289,60 @@ __print_funct_t pcp_print_net_eip6_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_net_icmp6_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_net_icmp6
 		*snic = (struct stats_net_icmp6 *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->InMsgs6);
-	pmiPutValue("network.icmp6.inmsgs", NULL, buf);
+	pcp_put_value("network.icmp6.inmsgs", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->OutMsgs6);
-	pmiPutValue("network.icmp6.outmsgs", NULL, buf);
+	pcp_put_value("network.icmp6.outmsgs", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->InEchos6);
-	pmiPutValue("network.icmp6.inechos", NULL, buf);
+	pcp_put_value("network.icmp6.inechos", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->InEchoReplies6);
-	pmiPutValue("network.icmp6.inechoreplies", NULL, buf);
+	pcp_put_value("network.icmp6.inechoreplies", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->OutEchoReplies6);
-	pmiPutValue("network.icmp6.outechoreplies", NULL, buf);
+	pcp_put_value("network.icmp6.outechoreplies", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->InGroupMembQueries6);
-	pmiPutValue("network.icmp6.ingroupmembqueries", NULL, buf);
+	pcp_put_value("network.icmp6.ingroupmembqueries", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->InGroupMembResponses6);
-	pmiPutValue("network.icmp6.ingroupmembresponses", NULL, buf);
+	pcp_put_value("network.icmp6.ingroupmembresponses", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->OutGroupMembResponses6);
-	pmiPutValue("network.icmp6.outgroupmembresponses", NULL, buf);
+	pcp_put_value("network.icmp6.outgroupmembresponses", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->InGroupMembReductions6);
-	pmiPutValue("network.icmp6.ingroupmembreductions", NULL, buf);
+	pcp_put_value("network.icmp6.ingroupmembreductions", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->OutGroupMembReductions6);
-	pmiPutValue("network.icmp6.outgroupmembreductions", NULL, buf);
+	pcp_put_value("network.icmp6.outgroupmembreductions", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->InRouterSolicits6);
-	pmiPutValue("network.icmp6.inroutersolicits", NULL, buf);
+	pcp_put_value("network.icmp6.inroutersolicits", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->OutRouterSolicits6);
-	pmiPutValue("network.icmp6.outroutersolicits", NULL, buf);
+	pcp_put_value("network.icmp6.outroutersolicits", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->InRouterAdvertisements6);
-	pmiPutValue("network.icmp6.inrouteradvertisements", NULL, buf);
+	pcp_put_value("network.icmp6.inrouteradvertisements", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->InNeighborSolicits6);
-	pmiPutValue("network.icmp6.inneighborsolicits", NULL, buf);
+	pcp_put_value("network.icmp6.inneighborsolicits", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->OutNeighborSolicits6);
-	pmiPutValue("network.icmp6.outneighborsolicits", NULL, buf);
+	pcp_put_value("network.icmp6.outneighborsolicits", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->InNeighborAdvertisements6);
-	pmiPutValue("network.icmp6.inneighboradvertisements", NULL, buf);
+	pcp_put_value("network.icmp6.inneighboradvertisements", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snic->OutNeighborAdvertisements6);
-	pmiPutValue("network.icmp6.outneighboradvertisements", NULL, buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("network.icmp6.outneighboradvertisements", NULL, buf);
 }
 
 /*
@@ -1412,44 +1356,42 @@ __print_funct_t pcp_print_net_icmp6_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_net_eicmp6_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_net_eicmp6
 		*sneic = (struct stats_net_eicmp6 *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sneic->InErrors6);
-	pmiPutValue("network.icmp6.inerrors", NULL, buf);
+	pcp_put_value("network.icmp6.inerrors", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sneic->InDestUnreachs6);
-	pmiPutValue("network.icmp6.indestunreachs", NULL, buf);
+	pcp_put_value("network.icmp6.indestunreachs", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sneic->OutDestUnreachs6);
-	pmiPutValue("network.icmp6.outdestunreachs", NULL, buf);
+	pcp_put_value("network.icmp6.outdestunreachs", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sneic->InTimeExcds6);
-	pmiPutValue("network.icmp6.intimeexcds", NULL, buf);
+	pcp_put_value("network.icmp6.intimeexcds", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sneic->OutTimeExcds6);
-	pmiPutValue("network.icmp6.outtimeexcds", NULL, buf);
+	pcp_put_value("network.icmp6.outtimeexcds", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sneic->InParmProblems6);
-	pmiPutValue("network.icmp6.inparmproblems", NULL, buf);
+	pcp_put_value("network.icmp6.inparmproblems", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sneic->OutParmProblems6);
-	pmiPutValue("network.icmp6.outparmproblems", NULL, buf);
+	pcp_put_value("network.icmp6.outparmproblems", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sneic->InRedirects6);
-	pmiPutValue("network.icmp6.inredirects", NULL, buf);
+	pcp_put_value("network.icmp6.inredirects", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sneic->OutRedirects6);
-	pmiPutValue("network.icmp6.outredirects", NULL, buf);
+	pcp_put_value("network.icmp6.outredirects", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sneic->InPktTooBigs6);
-	pmiPutValue("network.icmp6.inpkttoobigs", NULL, buf);
+	pcp_put_value("network.icmp6.inpkttoobigs", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sneic->OutPktTooBigs6);
-	pmiPutValue("network.icmp6.outpkttoobigs", NULL, buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("network.icmp6.outpkttoobigs", NULL, buf);
 }
 
 /*
@@ -1463,23 +1405,21 @@ __print_funct_t pcp_print_net_eicmp6_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_net_udp6_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_net_udp6
 		*snuc = (struct stats_net_udp6 *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snuc->InDatagrams6);
-	pmiPutValue("network.udp6.indatagrams", NULL, buf);
+	pcp_put_value("network.udp6.indatagrams", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snuc->OutDatagrams6);
-	pmiPutValue("network.udp6.outdatagrams", NULL, buf);
+	pcp_put_value("network.udp6.outdatagrams", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snuc->NoPorts6);
-	pmiPutValue("network.udp6.noports", NULL, buf);
+	pcp_put_value("network.udp6.noports", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", (unsigned long long) snuc->InErrors6);
-	pmiPutValue("network.udp6.inerrors", NULL, buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("network.udp6.inerrors", NULL, buf);
 }
 
 /*
@@ -1493,7 +1433,6 @@ __print_funct_t pcp_print_net_udp6_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_pwr_cpufreq_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	int i;
 	struct stats_pwr_cpufreq *spc;
 	char buf[64], cpuno[64];
@@ -1516,9 +1455,8 @@ __print_funct_t pcp_print_pwr_cpufreq_stats(struct activity *a, int curr)
 		}
 
 		snprintf(buf, sizeof(buf), "%f", ((double) spc->cpufreq) / 100);
-		pmiPutValue("hinv.cpu.clock", cpuno, buf);
+		pcp_put_value("hinv.cpu.clock", cpuno, buf);
 	}
-#endif	/* HAVE_PCP */
 }
 
 /*
@@ -1532,7 +1470,6 @@ __print_funct_t pcp_print_pwr_cpufreq_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_pwr_fan_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	int i;
 	struct stats_pwr_fan *spc;
 	char buf[64], instance[32];
@@ -1544,16 +1481,15 @@ __print_funct_t pcp_print_pwr_fan_stats(struct activity *a, int curr)
 
 		snprintf(buf, sizeof(buf), "%llu",
 			 (unsigned long long) spc->rpm);
-		pmiPutValue("power.fan.rpm", instance, buf);
+		pcp_put_value("power.fan.rpm", instance, buf);
 
 		snprintf(buf, sizeof(buf), "%llu",
 			 (unsigned long long) (spc->rpm - spc->rpm_min));
-		pmiPutValue("power.fan.drpm", instance, buf);
+		pcp_put_value("power.fan.drpm", instance, buf);
 
 		snprintf(buf, sizeof(buf), "%s", spc->device);
-		pmiPutValue("power.fan.device", instance, buf);
+		pcp_put_value("power.fan.device", instance, buf);
 	}
-#endif	/* HAVE_PCP */
 }
 
 /*
@@ -1567,7 +1503,6 @@ __print_funct_t pcp_print_pwr_fan_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_pwr_temp_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	int i;
 	struct stats_pwr_temp *spc;
 	char buf[64], instance[32];
@@ -1578,19 +1513,18 @@ __print_funct_t pcp_print_pwr_temp_stats(struct activity *a, int curr)
 		sprintf(instance, "temp%d", i + 1);
 
 		snprintf(buf, sizeof(buf), "%f", spc->temp);
-		pmiPutValue("power.temp.celsius", instance, buf);
+		pcp_put_value("power.temp.celsius", instance, buf);
 
 		snprintf(buf, sizeof(buf), "%f",
 			 (spc->temp_max - spc->temp_min) ?
 			 (spc->temp - spc->temp_min) / (spc->temp_max - spc->temp_min) * 100 :
 			 0.0);
-		pmiPutValue("power.temp.percent", instance, buf);
+		pcp_put_value("power.temp.percent", instance, buf);
 
 		snprintf(buf, sizeof(buf), "%s",
 			spc->device);
-		pmiPutValue("power.temp.device", instance, buf);
+		pcp_put_value("power.temp.device", instance, buf);
 	}
-#endif	/* HAVE_PCP */
 }
 
 /*
@@ -1606,7 +1540,6 @@ __print_funct_t pcp_print_pwr_temp_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_pwr_in_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	int i;
 	struct stats_pwr_in *spc;
 	char buf[64], instance[32];
@@ -1618,19 +1551,18 @@ __print_funct_t pcp_print_pwr_in_stats(struct activity *a, int curr)
 
 		snprintf(buf, sizeof(buf), "%f",
 			 spc->in);
-		pmiPutValue("power.in.voltage", instance, buf);
+		pcp_put_value("power.in.voltage", instance, buf);
 
 		snprintf(buf, sizeof(buf), "%f",
 			 (spc->in_max - spc->in_min) ?
 			 (spc->in - spc->in_min) / (spc->in_max - spc->in_min) * 100 :
 			 0.0);
-		pmiPutValue("power.in.percent", instance, buf);
+		pcp_put_value("power.in.percent", instance, buf);
 
 		snprintf(buf, sizeof(buf), "%s",
 			spc->device);
-		pmiPutValue("power.in.device", instance, buf);
+		pcp_put_value("power.in.device", instance, buf);
 	}
-#endif	/* HAVE_PCP */
 }
 
 /*
@@ -1644,7 +1576,6 @@ __print_funct_t pcp_print_pwr_in_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_pwr_bat_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	int i;
 	struct stats_pwr_bat *spbc;
 	char buf[64], bat_name[16];
@@ -1656,7 +1587,7 @@ __print_funct_t pcp_print_pwr_bat_stats(struct activity *a, int curr)
 		snprintf(bat_name, sizeof(bat_name), "BAT%d", (int) spbc->bat_id);
 
 		snprintf(buf, sizeof(buf), "%u", (unsigned int) spbc->capacity);
-		pmiPutValue("power.bat.capacity", bat_name, buf);
+		pcp_put_value("power.bat.capacity", bat_name, buf);
 
 		/* Battery status code should not be greater than or equal to BAT_STS_NR */
 		if (spbc->status >= BAT_STS_NR) {
@@ -1664,9 +1595,8 @@ __print_funct_t pcp_print_pwr_bat_stats(struct activity *a, int curr)
 		}
 
 		snprintf(buf, sizeof(buf), "%s", bat_status[(unsigned int) spbc->status]);
-		pmiPutValue("power.bat.status", bat_name, buf);
+		pcp_put_value("power.bat.status", bat_name, buf);
 	}
-#endif	/* HAVE_PCP */
 }
 
 /*
@@ -1682,23 +1612,21 @@ __print_funct_t pcp_print_pwr_bat_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_huge_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_huge
 		*smc = (struct stats_huge *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%llu", smc->frhkb * 1024);
-	pmiPutValue("mem.util.hugepagesFreeBytes", NULL, buf);
+	pcp_put_value("mem.util.hugepagesFreeBytes", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", smc->tlhkb * 1024);
-	pmiPutValue("mem.util.hugepagesTotalBytes", NULL, buf);
+	pcp_put_value("mem.util.hugepagesTotalBytes", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", smc->rsvdhkb * 1024);
-	pmiPutValue("mem.util.hugepagesRsvdBytes", NULL, buf);
+	pcp_put_value("mem.util.hugepagesRsvdBytes", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%llu", smc->surphkb * 1024);
-	pmiPutValue("mem.util.hugepagesSurpBytes", NULL, buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("mem.util.hugepagesSurpBytes", NULL, buf);
 }
 
 /*
@@ -1712,7 +1640,6 @@ __print_funct_t pcp_print_huge_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_pwr_usb_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	int i;
 	struct stats_pwr_usb *suc;
 	char buf[64], instance[32];
@@ -1723,24 +1650,23 @@ __print_funct_t pcp_print_pwr_usb_stats(struct activity *a, int curr)
 		sprintf(instance, "usb%d", i);
 
 		snprintf(buf, sizeof(buf), "%u", suc->bus_nr);
-		pmiPutValue("power.usb.bus", instance, buf);
+		pcp_put_value("power.usb.bus", instance, buf);
 
 		snprintf(buf, sizeof(buf), "%x", suc->vendor_id);
-		pmiPutValue("power.usb.vendorId", instance, buf);
+		pcp_put_value("power.usb.vendorId", instance, buf);
 
 		snprintf(buf, sizeof(buf), "%x", suc->product_id);
-		pmiPutValue("power.usb.productId", instance, buf);
+		pcp_put_value("power.usb.productId", instance, buf);
 
 		snprintf(buf, sizeof(buf), "%u", suc->bmaxpower << 1);
-		pmiPutValue("power.usb.maxpower", instance, buf);
+		pcp_put_value("power.usb.maxpower", instance, buf);
 
 		snprintf(buf, sizeof(buf), "%s", suc->manufacturer);
-		pmiPutValue("power.usb.manufacturer", instance, buf);
+		pcp_put_value("power.usb.manufacturer", instance, buf);
 
 		snprintf(buf, sizeof(buf), "%s", suc->product);
-		pmiPutValue("power.usb.productName", instance, buf);
+		pcp_put_value("power.usb.productName", instance, buf);
 	}
-#endif	/* HAVE_PCP */
 }
 
 /*
@@ -1754,7 +1680,6 @@ __print_funct_t pcp_print_pwr_usb_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_filesystem_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	int i;
 	struct stats_filesystem *sfc;
 	char buf[64];
@@ -1774,33 +1699,32 @@ __print_funct_t pcp_print_filesystem_stats(struct activity *a, int curr)
 		}
 
 		snprintf(buf, sizeof(buf), "%llu", sfc->f_blocks / 1024);
-		pmiPutValue("filesys.capacity", dev_name, buf);
+		pcp_put_value("filesys.capacity", dev_name, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", sfc->f_bfree / 1024);
-		pmiPutValue("filesys.free", dev_name, buf);
+		pcp_put_value("filesys.free", dev_name, buf);
 
 		snprintf(buf, sizeof(buf), "%llu",
 			 (sfc->f_blocks - sfc->f_bfree) / 1024);
-		pmiPutValue("filesys.used", dev_name, buf);
+		pcp_put_value("filesys.used", dev_name, buf);
 
 		snprintf(buf, sizeof(buf), "%f",
 			 sfc->f_blocks ? SP_VALUE(sfc->f_bfree, sfc->f_blocks, sfc->f_blocks)
 				       : 0.0);
-		pmiPutValue("filesys.full", dev_name, buf);
+		pcp_put_value("filesys.full", dev_name, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", sfc->f_files);
-		pmiPutValue("filesys.maxfiles", dev_name, buf);
+		pcp_put_value("filesys.maxfiles", dev_name, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", sfc->f_ffree);
-		pmiPutValue("filesys.freefiles", dev_name, buf);
+		pcp_put_value("filesys.freefiles", dev_name, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", sfc->f_files - sfc->f_ffree);
-		pmiPutValue("filesys.usedfiles", dev_name, buf);
+		pcp_put_value("filesys.usedfiles", dev_name, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", sfc->f_bavail / 1024);
-		pmiPutValue("filesys.avail", dev_name, buf);
+		pcp_put_value("filesys.avail", dev_name, buf);
 	}
-#endif	/* HAVE_PCP */
 }
 
 /*
@@ -1814,7 +1738,6 @@ __print_funct_t pcp_print_filesystem_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_softnet_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	int i;
 	struct stats_softnet *ssnc;
 	char buf[64], cpuno[64];
@@ -1850,24 +1773,23 @@ __print_funct_t pcp_print_softnet_stats(struct activity *a, int curr)
 		}
 
 		snprintf(buf, sizeof(buf), "%llu", (unsigned long long) ssnc->processed);
-		pmiPutValue("network.softnet.percpu.processed", cpuno, buf);
+		pcp_put_value("network.softnet.percpu.processed", cpuno, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", (unsigned long long) ssnc->dropped);
-		pmiPutValue("network.softnet.percpu.dropped", cpuno, buf);
+		pcp_put_value("network.softnet.percpu.dropped", cpuno, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", (unsigned long long) ssnc->time_squeeze);
-		pmiPutValue("network.softnet.percpu.time_squeeze", cpuno, buf);
+		pcp_put_value("network.softnet.percpu.time_squeeze", cpuno, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", (unsigned long long) ssnc->received_rps);
-		pmiPutValue("network.softnet.percpu.received_rps", cpuno, buf);
+		pcp_put_value("network.softnet.percpu.received_rps", cpuno, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", (unsigned long long) ssnc->flow_limit);
-		pmiPutValue("network.softnet.percpu.flow_limit", cpuno, buf);
+		pcp_put_value("network.softnet.percpu.flow_limit", cpuno, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", (unsigned long long) ssnc->backlog_len);
-		pmiPutValue("network.softnet.percpu.backlog_length", cpuno, buf);
+		pcp_put_value("network.softnet.percpu.backlog_length", cpuno, buf);
 	}
-#endif	/* HAVE_PCP */
 }
 
 /*
@@ -1881,7 +1803,6 @@ __print_funct_t pcp_print_softnet_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_fchost_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	int i;
 	struct stats_fchost *sfcc;
 	char buf[64];
@@ -1891,18 +1812,17 @@ __print_funct_t pcp_print_fchost_stats(struct activity *a, int curr)
 		sfcc = (struct stats_fchost *) ((char *) a->buf[curr] + i * a->msize);
 
 		snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sfcc->f_rxframes);
-		pmiPutValue("fchost.in.frames", sfcc->fchost_name, buf);
+		pcp_put_value("fchost.in.frames", sfcc->fchost_name, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sfcc->f_txframes);
-		pmiPutValue("fchost.out.frames", sfcc->fchost_name, buf);
+		pcp_put_value("fchost.out.frames", sfcc->fchost_name, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sfcc->f_rxwords * 4);
-		pmiPutValue("fchost.in.bytes", sfcc->fchost_name, buf);
+		pcp_put_value("fchost.in.bytes", sfcc->fchost_name, buf);
 
 		snprintf(buf, sizeof(buf), "%llu", (unsigned long long) sfcc->f_txwords * 4);
-		pmiPutValue("fchost.out.bytes", sfcc->fchost_name, buf);
+		pcp_put_value("fchost.out.bytes", sfcc->fchost_name, buf);
 	}
-#endif	/* HAVE_PCP */
 }
 
 /*
@@ -1916,23 +1836,21 @@ __print_funct_t pcp_print_fchost_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_psicpu_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_psi_cpu
 		*psic = (struct stats_psi_cpu *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%f", (double) psic->some_acpu_10 / 100);
-	pmiPutValue("kernel.all.pressure.cpu.some.avg", "10 second", buf);
+	pcp_put_value("kernel.all.pressure.cpu.some.avg", "10 second", buf);
 
 	snprintf(buf, sizeof(buf), "%f", (double) psic->some_acpu_60 / 100);
-	pmiPutValue("kernel.all.pressure.cpu.some.avg", "1 minute", buf);
+	pcp_put_value("kernel.all.pressure.cpu.some.avg", "1 minute", buf);
 
 	snprintf(buf, sizeof(buf), "%f", (double) psic->some_acpu_300 / 100);
-	pmiPutValue("kernel.all.pressure.cpu.some.avg", "5 minute", buf);
+	pcp_put_value("kernel.all.pressure.cpu.some.avg", "5 minute", buf);
 
 	snprintf(buf, sizeof(buf), "%llu", psic->some_cpu_total);
-	pmiPutValue("kernel.all.pressure.cpu.some.total", NULL, buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("kernel.all.pressure.cpu.some.total", NULL, buf);
 }
 
 /*
@@ -1946,35 +1864,33 @@ __print_funct_t pcp_print_psicpu_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_psiio_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_psi_io
 		*psic = (struct stats_psi_io *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%f", (double) psic->some_aio_10 / 100);
-	pmiPutValue("kernel.all.pressure.io.some.avg", "10 second", buf);
+	pcp_put_value("kernel.all.pressure.io.some.avg", "10 second", buf);
 
 	snprintf(buf, sizeof(buf), "%f", (double) psic->some_aio_60 / 100);
-	pmiPutValue("kernel.all.pressure.io.some.avg", "1 minute", buf);
+	pcp_put_value("kernel.all.pressure.io.some.avg", "1 minute", buf);
 
 	snprintf(buf, sizeof(buf), "%f", (double) psic->some_aio_300 / 100);
-	pmiPutValue("kernel.all.pressure.io.some.avg", "5 minute", buf);
+	pcp_put_value("kernel.all.pressure.io.some.avg", "5 minute", buf);
 
 	snprintf(buf, sizeof(buf), "%llu", psic->some_io_total);
-	pmiPutValue("kernel.all.pressure.io.some.total", NULL, buf);
+	pcp_put_value("kernel.all.pressure.io.some.total", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%f", (double) psic->full_aio_10 / 100);
-	pmiPutValue("kernel.all.pressure.io.full.avg", "10 second", buf);
+	pcp_put_value("kernel.all.pressure.io.full.avg", "10 second", buf);
 
 	snprintf(buf, sizeof(buf), "%f", (double) psic->full_aio_60 / 100);
-	pmiPutValue("kernel.all.pressure.io.full.avg", "1 minute", buf);
+	pcp_put_value("kernel.all.pressure.io.full.avg", "1 minute", buf);
 
 	snprintf(buf, sizeof(buf), "%f", (double) psic->full_aio_300 / 100);
-	pmiPutValue("kernel.all.pressure.io.full.avg", "5 minute", buf);
+	pcp_put_value("kernel.all.pressure.io.full.avg", "5 minute", buf);
 
 	snprintf(buf, sizeof(buf), "%llu", psic->full_io_total);
-	pmiPutValue("kernel.all.pressure.io.full.total", NULL, buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("kernel.all.pressure.io.full.total", NULL, buf);
 }
 
 /*
@@ -1988,33 +1904,186 @@ __print_funct_t pcp_print_psiio_stats(struct activity *a, int curr)
  */
 __print_funct_t pcp_print_psimem_stats(struct activity *a, int curr)
 {
-#ifdef HAVE_PCP
 	char buf[64];
 	struct stats_psi_mem
 		*psic = (struct stats_psi_mem *) a->buf[curr];
 
 	snprintf(buf, sizeof(buf), "%f", (double) psic->some_amem_10 / 100);
-	pmiPutValue("kernel.all.pressure.memory.some.avg", "10 second", buf);
+	pcp_put_value("kernel.all.pressure.memory.some.avg", "10 second", buf);
 
 	snprintf(buf, sizeof(buf), "%f", (double) psic->some_amem_60 / 100);
-	pmiPutValue("kernel.all.pressure.memory.some.avg", "1 minute", buf);
+	pcp_put_value("kernel.all.pressure.memory.some.avg", "1 minute", buf);
 
 	snprintf(buf, sizeof(buf), "%f", (double) psic->some_amem_300 / 100);
-	pmiPutValue("kernel.all.pressure.memory.some.avg", "5 minute", buf);
+	pcp_put_value("kernel.all.pressure.memory.some.avg", "5 minute", buf);
 
 	snprintf(buf, sizeof(buf), "%llu", psic->some_mem_total);
-	pmiPutValue("kernel.all.pressure.memory.some.total", NULL, buf);
+	pcp_put_value("kernel.all.pressure.memory.some.total", NULL, buf);
 
 	snprintf(buf, sizeof(buf), "%f", (double) psic->full_amem_10 / 100);
-	pmiPutValue("kernel.all.pressure.memory.full.avg", "10 second", buf);
+	pcp_put_value("kernel.all.pressure.memory.full.avg", "10 second", buf);
 
 	snprintf(buf, sizeof(buf), "%f", (double) psic->full_amem_60 / 100);
-	pmiPutValue("kernel.all.pressure.memory.full.avg", "1 minute", buf);
+	pcp_put_value("kernel.all.pressure.memory.full.avg", "1 minute", buf);
 
 	snprintf(buf, sizeof(buf), "%f", (double) psic->full_amem_300 / 100);
-	pmiPutValue("kernel.all.pressure.memory.full.avg", "5 minute", buf);
+	pcp_put_value("kernel.all.pressure.memory.full.avg", "5 minute", buf);
 
 	snprintf(buf, sizeof(buf), "%llu", psic->full_mem_total);
-	pmiPutValue("kernel.all.pressure.memory.full.total", NULL, buf);
-#endif	/* HAVE_PCP */
+	pcp_put_value("kernel.all.pressure.memory.full.total", NULL, buf);
+}
+
+/*
+ ***************************************************************************
+ * Display cgroups statistics in PCP format.
+ *
+ * IN:
+ * @a		Activity structure with statistics.
+ * @curr	Index in array for current sample statistics.
+ ***************************************************************************
+ */
+__print_funct_t pcp_print_cgroup_stats(struct activity *a, int curr)
+{
+	int i;
+	struct stats_cgroup *scc;
+	char buf[64];
+
+	for (i = 0; i < a->nr[curr]; i++) {
+
+		scc = (struct stats_cgroup *) ((char *) a->buf[curr] + i * a->msize);
+
+		if (a->item_list != NULL) {
+			/* A list of cgroups has been entered on the command line */
+			if (!search_list_item(a->item_list, scc->cgroup_name))
+				/* Cgroup not found */
+				continue;
+		}
+
+		snprintf(buf, sizeof(buf), "%llu", scc->usage_usec);
+		pcp_put_value("cgroup.cpu.stat.usage", scc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%llu", scc->user_usec);
+		pcp_put_value("cgroup.cpu.stat.user", scc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%llu", scc->system_usec);
+		pcp_put_value("cgroup.cpu.stat.system", scc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%llu", scc->throttled_usec);
+		pcp_put_value("cgroup.cpu.stat.throttled_usec", scc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%llu", scc->mem_current);
+		pcp_put_value("cgroup.memory.current", scc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%llu", scc->rbytes);
+		pcp_put_value("cgroup.io.stat.rbytes", scc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%llu", scc->wbytes);
+		pcp_put_value("cgroup.io.stat.wbytes", scc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%llu", scc->rios);
+		pcp_put_value("cgroup.io.stat.rios", scc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%llu", scc->wios);
+		pcp_put_value("cgroup.io.stat.wios", scc->cgroup_name, buf);
+	}
+}
+
+/*
+ ***************************************************************************
+ * Display cgroups pressure-stall statistics in PCP format.
+ *
+ * IN:
+ * @a		Activity structure with statistics.
+ * @curr	Index in array for current sample statistics.
+ ***************************************************************************
+ */
+__print_funct_t pcp_print_psi_cgroup_stats(struct activity *a, int curr)
+{
+	int i;
+	struct stats_psi_cgroup *spcc;
+	char buf[64];
+
+	for (i = 0; i < a->nr[curr]; i++) {
+
+		spcc = (struct stats_psi_cgroup *) ((char *) a->buf[curr] + i * a->msize);
+
+		if (a->item_list != NULL) {
+			/* A list of cgroups has been entered on the command line */
+			if (!search_list_item(a->item_list, spcc->cgroup_name))
+				/* Cgroup not found */
+				continue;
+		}
+
+		snprintf(buf, sizeof(buf), "%f", (double) spcc->some_acpu_10 / 100);
+		pcp_put_value("cgroup.pressure.cpu.some.avg10sec", spcc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%f", (double) spcc->some_acpu_60 / 100);
+		pcp_put_value("cgroup.pressure.cpu.some.avg1min", spcc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%f", (double) spcc->some_acpu_300 / 100);
+		pcp_put_value("cgroup.pressure.cpu.some.avg5min", spcc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%llu", spcc->some_cpu_total);
+		pcp_put_value("cgroup.pressure.cpu.some.total", spcc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%f", (double) spcc->full_acpu_10 / 100);
+		pcp_put_value("cgroup.pressure.cpu.full.avg10sec", spcc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%f", (double) spcc->full_acpu_60 / 100);
+		pcp_put_value("cgroup.pressure.cpu.full.avg1min", spcc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%f", (double) spcc->full_acpu_300 / 100);
+		pcp_put_value("cgroup.pressure.cpu.full.avg5min", spcc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%llu", spcc->full_cpu_total);
+		pcp_put_value("cgroup.pressure.cpu.full.total", spcc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%f", (double) spcc->some_aio_10 / 100);
+		pcp_put_value("cgroup.pressure.io.some.avg10sec", spcc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%f", (double) spcc->some_aio_60 / 100);
+		pcp_put_value("cgroup.pressure.io.some.avg1min", spcc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%f", (double) spcc->some_aio_300 / 100);
+		pcp_put_value("cgroup.pressure.io.some.avg5min", spcc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%llu", spcc->some_io_total);
+		pcp_put_value("cgroup.pressure.io.some.total", spcc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%f", (double) spcc->full_aio_10 / 100);
+		pcp_put_value("cgroup.pressure.io.full.avg10sec", spcc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%f", (double) spcc->full_aio_60 / 100);
+		pcp_put_value("cgroup.pressure.io.full.avg1min", spcc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%f", (double) spcc->full_aio_300 / 100);
+		pcp_put_value("cgroup.pressure.io.full.avg5min", spcc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%llu", spcc->full_io_total);
+		pcp_put_value("cgroup.pressure.io.full.total", spcc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%f", (double) spcc->some_amem_10 / 100);
+		pcp_put_value("cgroup.pressure.memory.some.avg10sec", spcc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%f", (double) spcc->some_amem_60 / 100);
+		pcp_put_value("cgroup.pressure.memory.some.avg1min", spcc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%f", (double) spcc->some_amem_300 / 100);
+		pcp_put_value("cgroup.pressure.memory.some.avg5min", spcc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%llu", spcc->some_mem_total);
+		pcp_put_value("cgroup.pressure.memory.some.total", spcc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%f", (double) spcc->full_amem_10 / 100);
+		pcp_put_value("cgroup.pressure.memory.full.avg10sec", spcc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%f", (double) spcc->full_amem_60 / 100);
+		pcp_put_value("cgroup.pressure.memory.full.avg1min", spcc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%f", (double) spcc->full_amem_300 / 100);
+		pcp_put_value("cgroup.pressure.memory.full.avg5min", spcc->cgroup_name, buf);
+
+		snprintf(buf, sizeof(buf), "%llu", spcc->full_mem_total);
+		pcp_put_value("cgroup.pressure.memory.full.total", spcc->cgroup_name, buf);
+	}
 }
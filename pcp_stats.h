@@ -81,6 +81,10 @@ __print_funct_t pcp_print_pwr_in_stats
 	(struct activity *, int);
 __print_funct_t pcp_print_pwr_bat_stats
 	(struct activity *, int);
+__print_funct_t pcp_print_cgroup_stats
+	(struct activity *, int);
+__print_funct_t pcp_print_psi_cgroup_stats
+	(struct activity *, int);
 __print_funct_t pcp_print_huge_stats
 	(struct activity *, int);
 __print_funct_t pcp_print_pwr_usb_stats
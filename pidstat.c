@@ -28,15 +28,29 @@
 #include <dirent.h>
 #include <ctype.h>
 #include <sys/types.h>
+#include <sys/resource.h>
 #include <pwd.h>
 #include <sys/utsname.h>
 #include <sys/wait.h>
 #include <regex.h>
+#include <limits.h>
+#include <errno.h>
+
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
 
 #ifdef HAVE_LINUX_SCHED_H
 #include <linux/sched.h>
 #endif
 
+#ifdef HAVE_LINUX_TASKSTATS_H
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/genetlink.h>
+#include <linux/taskstats.h>
+#endif
+
 #include "version.h"
 #include "pidstat.h"
 #include "rd_stats.h"
@@ -60,29 +74,61 @@ extern int __env;
 #endif
 
 unsigned long long tot_jiffies[3] = {0, 0, 0};
-unsigned long long uptime_cs[3] = {0, 0, 0};
+unsigned long long uptime_ns[3] = {0, 0, 0};
 struct st_pid *pid_list = NULL;
+/* Hash table used to find a PID in the list */
+struct st_pid **pid_htab = NULL;
+unsigned int pid_htab_sz = 0;	/* Nb of buckets (always a power of 2) */
+unsigned int pid_htab_nr = 0;	/* Nb of PID structures in hash table */
+/* Last PID and TID inserted or found in list */
+struct st_pid *last_pid = NULL, *last_tid = NULL;
+/* Max number of tasks for which file descriptors are kept open */
+unsigned int pid_fd_max = 0;
 
 struct tm ps_tstamp[3];
 char commstr[MAX_COMM_LEN];
 char userstr[MAX_USER_LEN];
 char procstr[MAX_COMM_LEN];
+/* Compiled regex for strings entered with options -C and -G */
+regex_t commregex, procregex;
 
 int cpu_nr = 0;			/* Nb of processors on the machine */
 unsigned long tlmkb;		/* Total memory in kB */
-long interval = -1;
+long interval = -1;		/* Interval in seconds (rounded up) */
+long interval_ms = 0;		/* Interval in milliseconds */
 long count = 0;
 unsigned int pidflag = 0;	/* General flags */
 unsigned int tskflag = 0;	/* TASK/CHILD stats */
 unsigned int actflag = 0;	/* Activity flag */
 uint64_t xflags = 0;		/* Extended flag for options used by multiple commands */
 
-struct sigaction alrm_act, int_act, chld_act;
+struct sigaction int_act, chld_act;
 int signal_caught = 0;
 int status = 0;
 
 int dplaces_nr = -1;		/* Number of decimal places */
 
+/* List of cgroups (option --cgroup) */
+struct st_cgroup *cg_list = NULL;
+/* Last cgroup inserted or found in list */
+struct st_cgroup *last_cg = NULL;
+int cg_depth = CGROUP_DEPTH;	/* Max depth of cgroups displayed */
+char *cg_root = NULL;		/* Cgroup v2 hierarchy mount point */
+/* Ancestors of the cgroup being read, indexed by their depth */
+struct st_cgroup **cg_anc = NULL;
+
+int workers_nr = 1;		/* Number of threads used to read /proc */
+/* List of tasks whose stats are to be read during current sample */
+struct pid_work *pid_work = NULL;
+int pid_work_sz = 0;
+
+#ifdef HAVE_LINUX_TASKSTATS_H
+__thread int ts_fd = -1;	/* Netlink socket used to get taskstats (one per thread) */
+int ts_exit_fd = -1;		/* Netlink socket receiving stats of exiting tasks */
+unsigned short ts_family = 0;	/* Taskstats generic netlink family ID */
+int ts_delayacct = FALSE;	/* TRUE if delay accounting is enabled */
+#endif
+
 /*
  ***************************************************************************
  * Print usage and exit.
@@ -100,23 +146,11 @@ void usage(char *progname)
 			  "[ -d ] [ -H ] [ -h ] [ -I ] [ -l ] [ -R ] [ -r ] [ -s ] [ -t ] [ -U [ <username> ] ]\n"
 			  "[ -u ] [ -V ] [ -v ] [ -w ] [ -C <command> ] [ -G <process_name> ]\n"
 			  "[ -p { <pid> [,...] | SELF | ALL } ] [ -T { TASK | CHILD | ALL } ]\n"
-			  "[ --dec={ 0 | 1 | 2 } ] [ --human ] [ -o JSON ]\n"));
+			  "[ --cgroup[=<depth>] ] [ --dec={ 0 | 1 | 2 } ] [ --human ] [ --taskstats ]\n"
+			  "[ --workers=<nb> ] [ -o JSON ]\n"));
 	exit(1);
 }
 
-/*
- ***************************************************************************
- * SIGALRM signal handler. No need to reset the handler here.
- *
- * IN:
- * @sig	Signal number.
- ***************************************************************************
- */
-void alarm_handler(int sig)
-{
-	alarm(interval);
-}
-
 /*
  ***************************************************************************
  * SIGINT, SIGTERM and SIGCHLD signals handler.
@@ -141,6 +175,241 @@ void int_handler(int sig)
 	}
 }
 
+/*
+ ***************************************************************************
+ * Compute hash value of a PID for the PID hash table.
+ *
+ * IN:
+ * @pid		PID number.
+ *
+ * RETURNS:
+ * Index of the bucket in hash table.
+ ***************************************************************************
+ */
+unsigned int hash_pid(pid_t pid)
+{
+	return (((unsigned int) pid * 2654435761U) & (pid_htab_sz - 1));
+}
+
+/*
+ ***************************************************************************
+ * Look for a PID or TID in the hash table.
+ *
+ * IN:
+ * @pid		PID number.
+ * @tgid_p	NULL if @pid is a process, or pointer on the structure of its
+ *		TGID if @pid is a TID.
+ *
+ * RETURNS:
+ * Pointer on the st_pid structure, or NULL if not found.
+ ***************************************************************************
+ */
+struct st_pid *lookup_pid(pid_t pid, struct st_pid *tgid_p)
+{
+	struct st_pid *p;
+
+	if (!pid_htab_sz)
+		return NULL;
+
+	for (p = pid_htab[hash_pid(pid)]; p != NULL; p = p->hnext) {
+		if ((p->pid == pid) && (p->tgid == tgid_p))
+			return p;
+	}
+
+	return NULL;
+}
+
+/*
+ ***************************************************************************
+ * Insert a PID structure in the hash table. Grow the table if it is too
+ * heavily loaded.
+ *
+ * IN:
+ * @ps		Pointer on the st_pid structure to insert.
+ ***************************************************************************
+ */
+void hash_add_pid(struct st_pid *ps)
+{
+	unsigned int h;
+
+	if (pid_htab_nr >= pid_htab_sz * 2) {
+		struct st_pid *p, *pn;
+		unsigned int i, old_sz = pid_htab_sz;
+
+		pid_htab_sz = old_sz ? old_sz * 2 : PID_HTAB_MIN_SIZE;
+		SREALLOC(pid_htab, struct st_pid *, pid_htab_sz * sizeof(struct st_pid *));
+		memset(pid_htab + old_sz, 0, (pid_htab_sz - old_sz) * sizeof(struct st_pid *));
+
+		/*
+		 * Rehash entries from old buckets. Each chain is detached
+		 * before its entries are dispatched among the new buckets.
+		 */
+		for (i = 0; i < old_sz; i++) {
+			p = pid_htab[i];
+			pid_htab[i] = NULL;
+			for (; p != NULL; p = pn) {
+				pn = p->hnext;
+				h = hash_pid(p->pid);
+				p->hnext = pid_htab[h];
+				pid_htab[h] = p;
+			}
+		}
+	}
+
+	h = hash_pid(ps->pid);
+	ps->hnext = pid_htab[h];
+	pid_htab[h] = ps;
+	pid_htab_nr++;
+}
+
+/*
+ ***************************************************************************
+ * Remove a PID structure from the hash table.
+ *
+ * IN:
+ * @ps		Pointer on the st_pid structure to remove.
+ ***************************************************************************
+ */
+void hash_del_pid(struct st_pid *ps)
+{
+	struct st_pid **pp;
+
+	for (pp = &pid_htab[hash_pid(ps->pid)]; *pp != NULL; pp = &((*pp)->hnext)) {
+		if (*pp == ps) {
+			*pp = ps->hnext;
+			pid_htab_nr--;
+			return;
+		}
+	}
+}
+
+/*
+ ***************************************************************************
+ * Close the file descriptors kept open for a task.
+ *
+ * IN:
+ * @plist	Pointer on the linked list where PID is saved.
+ ***************************************************************************
+ */
+void close_pid_fds(struct st_pid *plist)
+{
+	if (plist->statfd >= 0) {
+		close(plist->statfd);
+		plist->statfd = -1;
+	}
+	if (plist->dirfd >= 0) {
+		close(plist->dirfd);
+		plist->dirfd = -1;
+	}
+}
+
+/*
+ ***************************************************************************
+ * Set the max number of tasks for which file descriptors may be kept open.
+ * Raise the soft limit on the number of open files if possible. Each task
+ * may use two fds (its /proc directory and its stat file), and some fds
+ * are kept available for the other files opened by pidstat and its threads.
+ ***************************************************************************
+ */
+void set_pid_fd_max(void)
+{
+	struct rlimit rlim;
+	rlim_t reserved = PID_FD_RESERVED + 2 * workers_nr;
+
+	if (getrlimit(RLIMIT_NOFILE, &rlim) < 0)
+		return;
+
+	if (rlim.rlim_cur < rlim.rlim_max) {
+		rlim.rlim_cur = rlim.rlim_max;
+		if (setrlimit(RLIMIT_NOFILE, &rlim) < 0) {
+			getrlimit(RLIMIT_NOFILE, &rlim);
+		}
+	}
+
+	if ((rlim.rlim_cur == RLIM_INFINITY) || (rlim.rlim_cur / 2 > UINT_MAX)) {
+		pid_fd_max = UINT_MAX;
+	}
+	else if (rlim.rlim_cur > reserved) {
+		pid_fd_max = (rlim.rlim_cur - reserved) / 2;
+	}
+}
+
+/*
+ ***************************************************************************
+ * Open a file located in /proc/#[/task/##] directory. The file is opened
+ * relative to the directory fd kept open for the task, so that its full
+ * pathname doesn't need to be resolved again at each sample. The directory
+ * fd is opened first if necessary. If there are too many tasks to keep
+ * their fds open, the full pathname of the file is used instead.
+ *
+ * IN:
+ * @pid		Process whose file is to be opened.
+ * @plist	Pointer on the linked list where PID is saved.
+ * @tgid	If != 0, thread whose file is to be opened.
+ * @name	Name of the file in /proc/#[/task/##] directory.
+ * @flags	Flags passed to open().
+ *
+ * RETURNS:
+ * File descriptor, or -1 if the file couldn't be opened.
+ ***************************************************************************
+ */
+int open_pid_file(pid_t pid, struct st_pid *plist, pid_t tgid, const char *name,
+		  int flags)
+{
+	char filename[128];
+	int len;
+
+	if (plist->dirfd < 0) {
+		if (tgid) {
+			len = sprintf(filename, TASK_DIR, tgid, pid);
+		}
+		else {
+			len = sprintf(filename, PID_DIR, pid);
+		}
+
+		if (pid_htab_nr > pid_fd_max) {
+			/* Too many tasks: Don't keep any fd open for this one */
+			snprintf(filename + len, sizeof(filename) - len, "/%s", name);
+			return open(filename, flags);
+		}
+
+		if ((plist->dirfd = open(filename, O_PIDDIR)) < 0)
+			/* No such process */
+			return -1;
+	}
+
+	return openat(plist->dirfd, name, flags);
+}
+
+/*
+ ***************************************************************************
+ * Open a file located in /proc/#[/task/##] directory as a stream.
+ *
+ * IN:
+ * @pid		Process whose file is to be opened.
+ * @plist	Pointer on the linked list where PID is saved.
+ * @tgid	If != 0, thread whose file is to be opened.
+ * @name	Name of the file in /proc/#[/task/##] directory.
+ *
+ * RETURNS:
+ * Pointer on the stream, or NULL if the file couldn't be opened.
+ ***************************************************************************
+ */
+FILE *fopen_pid_file(pid_t pid, struct st_pid *plist, pid_t tgid, const char *name)
+{
+	int fd;
+	FILE *fp;
+
+	if ((fd = open_pid_file(pid, plist, tgid, name, O_RDONLY)) < 0)
+		return NULL;
+
+	if ((fp = fdopen(fd, "r")) == NULL) {
+		close(fd);
+	}
+
+	return fp;
+}
+
 /*
  ***************************************************************************
  * Free unused PID structures.
@@ -155,11 +424,16 @@ void sfree_pid(struct st_pid **plist, int force)
 	int i;
 	struct st_pid *p;
 
+	/* Insertion hints may point to structures about to be freed */
+	last_pid = last_tid = NULL;
+
 	while (*plist != NULL) {
 
 		p = *plist;
 		if (!p->exist || force) {
 			*plist = p->next;
+			hash_del_pid(p);
+			close_pid_fds(p);
 			for (i = 0; i < 3; i++) {
 				if (p->pstats[i]) {
 					free(p->pstats[i]);
@@ -171,6 +445,12 @@ void sfree_pid(struct st_pid **plist, int force)
 			plist = &(p->next);
 		}
 	}
+
+	if (force && pid_htab) {
+		free(pid_htab);
+		pid_htab = NULL;
+		pid_htab_sz = pid_htab_nr = 0;
+	}
 }
 
 /*
@@ -224,6 +504,11 @@ void check_flags(void)
 		act |= P_A_CPU + P_A_MEM;
 	}
 
+	if (DISPLAY_CGROUP(pidflag)) {
+		/* Only these activities are available for cgroups */
+		act &= P_A_CPU + P_A_MEM + P_A_IO + P_A_CTXSW;
+	}
+
 	actflag &= act;
 
 	if (!actflag) {
@@ -237,6 +522,11 @@ void check_flags(void)
  * Look for the PID in the list and store it if necessary.
  *       PID ->  PID -> TGID ->  TID ->  TID ->  TID ->  PID -> NULL
  * Eg.: 1234 -> 1289 -> 1356 -> 1356 -> 1361 -> 4678 -> 1376 -> NULL
+ * The PID is looked for in the hash table. If it has to be inserted in the
+ * list, the search for its position starts from the last PID (or TID)
+ * inserted or found when possible. Since /proc entries are read in
+ * ascending order, this makes inserting a PID a constant time operation
+ * in most cases.
  *
  * IN:
  * @plist	Pointer address on the start of the linked list.
@@ -264,13 +554,20 @@ struct st_pid *add_list_pid(struct st_pid **plist, pid_t pid, pid_t tgid)
 		 * Add it in ascending order, not taking into account
 		 * other TIDs.
 		 */
+		if ((p = lookup_pid(pid, NULL)) != NULL) {
+			/* PID found in list */
+			last_pid = p;
+			return p;
+		}
+
+		if (last_pid && (last_pid->pid < pid)) {
+			/* Start from last PID inserted or found */
+			plist = &(last_pid->next);
+		}
+
 		while (*plist != NULL) {
 
 			p = *plist;
-			if (!p->tgid && (p->pid == pid))
-				/* PID found in list */
-				return p;
-
 			if (!p->tgid && (p->pid > pid))
 				/* Stop now to insert PID in list */
 				break;
@@ -279,42 +576,37 @@ struct st_pid *add_list_pid(struct st_pid **plist, pid_t pid, pid_t tgid)
 		}
 	}
 	else {
-		int tgid_found = FALSE;
-
 		/*
 		 * PID is a TID.
 		 * It will be inserted in ascending order immediately
 		 * following its TGID.
 		 */
-		while (*plist != NULL) {
+		if ((tgid_p = lookup_pid(tgid, NULL)) == NULL)
+			/* TGID not found: Stop now */
+			return NULL;
 
-			p = *plist;
-			if (p->pid == tgid) {
-				/* TGID found in list */
-				tgid_found = TRUE;
-				tgid_p = p;
-				break;
-			}
+		if ((p = lookup_pid(pid, tgid_p)) != NULL) {
+			/* TID found in list */
+			last_tid = p;
+			return p;
+		}
 
-			plist = &(p->next);
+		if (last_tid && (last_tid->tgid == tgid_p) && (last_tid->pid < pid)) {
+			/* Start from last TID inserted or found for this TGID */
+			plist = &(last_tid->next);
+		}
+		else {
+			plist = &(tgid_p->next);
 		}
-		if (!tgid_found)
-			/* TGID not found: Stop now */
-			return NULL;
 
-		plist = &(p->next);
 		while (*plist != NULL) {
 
 			p = *plist;
-			if ((p->tgid == tgid_p) && (p->pid == pid))
-				/* TID found in list */
-				return p;
-
-			if ((p->tgid == tgid_p) && (p->pid > pid))
-				/* Stop now to insert TID in list */
-				break;
-			if (p->tgid != tgid_p)
-				/* End of TID list: insert TID here */
+			if ((p->tgid != tgid_p) || (p->pid > pid))
+				/*
+				 * Stop now to insert TID in list
+				 * (or end of TID list: insert TID here)
+				 */
 				break;
 
 			plist = &(p->next);
@@ -341,9 +633,15 @@ struct st_pid *add_list_pid(struct st_pid **plist, pid_t pid, pid_t tgid)
 	}
 	p->pid = pid;
 	p->next = ps;
+	p->dirfd = p->statfd = -1;
 	if (tgid_p) {
 		p->tgid = tgid_p;
+		last_tid = p;
+	}
+	else {
+		last_pid = p;
 	}
+	hash_add_pid(p);
 
 	return p;
 }
@@ -445,115 +743,230 @@ void read_proc_meminfo(void)
 
 /*
  ***************************************************************************
- * Read stats from /proc/#[/task/##]/stat.
+ * Read contents of /proc/#[/task/##]/stat file. The file is kept open
+ * between samples and read again from the beginning, the kernel generating
+ * its contents anew each time. If the file (or the directory of the task)
+ * can no longer be read then the task has terminated, but its PID may have
+ * been reused by a new task: In this case the file is opened again using
+ * its pathname.
  *
  * IN:
  * @pid		Process whose stats are to be read.
  * @plist	Pointer on the linked list where PID is saved.
  * @tgid	If !=0, thread whose stats are to be read.
- * @curr	Index in array for current sample statistics.
+ * @size	Size of buffer.
  *
  * OUT:
- * @thread_nr	Number of threads of the process.
+ * @buffer	Contents of the file.
  *
  * RETURNS:
- * 0 if stats have been successfully read, and 1 otherwise.
+ * Number of bytes read, or a value <= 0 if the file couldn't be read.
  ***************************************************************************
  */
-int read_proc_pid_stat(pid_t pid, struct st_pid *plist,
-		       unsigned int *thread_nr, pid_t tgid, int curr)
+int read_pid_stat_file(pid_t pid, struct st_pid *plist, pid_t tgid,
+		       char *buffer, int size)
 {
-	int fd, sz, rc, commsz;
-	char filename[128];
-	static char buffer[1024 + 1];
-	char *start, *end;
-	struct pid_stats *pst = plist->pstats[curr];
-
-	if (tgid) {
-		sprintf(filename, TASK_STAT, tgid, pid);
-	}
-	else {
-		sprintf(filename, PID_STAT, pid);
-	}
-
-	if ((fd = open(filename, O_RDONLY)) < 0)
-		/* No such process */
-		return 1;
+	int fd, sz;
+	int stale = (plist->dirfd >= 0);
 
-	sz = read(fd, buffer, 1024);
-	close(fd);
-	if (sz <= 0)
-		return 1;
-	buffer[sz] = '\0';
+	while (TRUE) {
+		if (plist->statfd >= 0) {
+			fd = plist->statfd;
+		}
+		else {
+			fd = open_pid_file(pid, plist, tgid, "stat", O_RDONLY);
+		}
 
-	if ((start = strchr(buffer, '(')) == NULL)
-		return 1;
-	start += 1;
-	if ((end = strrchr(start, ')')) == NULL)
-		return 1;
-	commsz = end - start;
-	if (commsz >= MAX_COMM_LEN)
-		return 1;
-	memcpy(plist->comm, start, commsz);
-	plist->comm[commsz] = '\0';
-	start = end + 2;
+		sz = (fd >= 0) ? pread(fd, buffer, size, 0) : -1;
 
-	rc = sscanf(start,
-		    "%*s %*d %*d %*d %*d %*d %*u %llu %llu"
-		    " %llu %llu %llu %llu %lld %lld %*d %*d %u %*u %*d %llu %llu"
-		    " %*u %*u %*u %*u %*u %*u %*u %*u %*u %*u %*u %*u %*u"
-		    " %*u %u %u %u %llu %llu %lld\n",
-		    &pst->minflt, &pst->cminflt, &pst->majflt, &pst->cmajflt,
-		    &pst->utime,  &pst->stime, &pst->cutime, &pst->cstime,
-		    thread_nr, &pst->vsz, &pst->rss, &pst->processor,
-		    &pst->priority, &pst->policy,
-		    &pst->blkio_swapin_delays, &pst->gtime, &pst->cgtime);
+		if ((fd >= 0) && (fd != plist->statfd)) {
+			if ((sz > 0) && (plist->dirfd >= 0)) {
+				/* Keep file open for next samples */
+				plist->statfd = fd;
+			}
+			else {
+				close(fd);
+			}
+		}
 
-	if (rc < 15)
-		return 1;
+		if ((sz > 0) || !stale)
+			return sz;
 
-	if (rc < 17) {
-		/* gtime and cgtime fields are unavailable in file */
-		pst->gtime = pst->cgtime = 0;
+		/* Try again without using the fds of the terminated task */
+		close_pid_fds(plist);
+		stale = FALSE;
 	}
+}
 
-	/* Convert to kB */
-	pst->vsz >>= 10;
-	pst->rss = PG_TO_KB(pst->rss);
+/*
+ ***************************************************************************
+ * Forget the stats of a task whose PID has been reused by a new one.
+ *
+ * IN:
+ * @plist	Pointer on the linked list where PID is saved.
+ * @curr	Index in array for current sample statistics.
+ ***************************************************************************
+ */
+void reset_pid_stats(struct st_pid *plist, int curr)
+{
+	int i;
 
-	return 0;
+	for (i = 0; i < 3; i++) {
+		if (i != curr) {
+			memset(plist->pstats[i], 0, PID_STATS_SIZE);
+		}
+	}
+	plist->cmdline[0] = '\0';
+	plist->flags = 0;
 }
 
 /*
  ***************************************************************************
- * Read stats from /proc/#[/task/##]/schedstat.
+ * Get task's command name from the contents of /proc/#[/task/##]/stat.
  *
  * IN:
- * @pid		Process whose stats are to be read.
  * @plist	Pointer on the linked list where PID is saved.
- * @tgid	If != 0, thread whose stats are to be read.
- * @curr	Index in array for current sample statistics.
+ * @buffer	Contents of the stat file.
+ *
+ * OUT:
+ * @plist	Structure where command name has been saved.
  *
  * RETURNS:
- * 0 if stats have been successfully read, and 1 otherwise.
+ * Pointer on the fields following the command name, or NULL on error.
  ***************************************************************************
  */
-int read_proc_pid_sched(pid_t pid, struct st_pid *plist, pid_t tgid, int curr)
+char *get_pid_comm(struct st_pid *plist, char *buffer)
 {
-	int fd, rc = 0;
-	char filename[128];
-	static char buffer[1024 + 1];
-	unsigned long long wtime = 0;
-	struct pid_stats *pst = plist->pstats[curr];
+	char *start, *end;
+	int commsz;
 
-	if (tgid) {
-		sprintf(filename, TASK_SCHED, tgid, pid);
-	}
-	else {
-		sprintf(filename, PID_SCHED, pid);
+	if ((start = strchr(buffer, '(')) == NULL)
+		return NULL;
+	start += 1;
+	if ((end = strrchr(start, ')')) == NULL)
+		return NULL;
+	commsz = end - start;
+	if (commsz >= MAX_COMM_LEN)
+		return NULL;
+	memcpy(plist->comm, start, commsz);
+	plist->comm[commsz] = '\0';
+
+	return end + 2;
+}
+
+/*
+ ***************************************************************************
+ * Read only the command name of a task from /proc/#[/task/##]/stat.
+ *
+ * IN:
+ * @pid		Process whose command name is to be read.
+ * @plist	Pointer on the linked list where PID is saved.
+ * @tgid	If !=0, thread whose command name is to be read.
+ *
+ * RETURNS:
+ * 0 if command name has been successfully read, and 1 otherwise.
+ ***************************************************************************
+ */
+int read_proc_pid_comm(pid_t pid, struct st_pid *plist, pid_t tgid)
+{
+	int sz;
+	char buffer[1024 + 1];
+
+	if ((sz = read_pid_stat_file(pid, plist, tgid, buffer, 1024)) <= 0)
+		return 1;
+	buffer[sz] = '\0';
+
+	return (get_pid_comm(plist, buffer) == NULL);
+}
+
+/*
+ ***************************************************************************
+ * Read stats from /proc/#[/task/##]/stat.
+ *
+ * IN:
+ * @pid		Process whose stats are to be read.
+ * @plist	Pointer on the linked list where PID is saved.
+ * @tgid	If !=0, thread whose stats are to be read.
+ * @curr	Index in array for current sample statistics.
+ *
+ * OUT:
+ * @thread_nr	Number of threads of the process.
+ *
+ * RETURNS:
+ * 0 if stats have been successfully read, and 1 otherwise.
+ ***************************************************************************
+ */
+int read_proc_pid_stat(pid_t pid, struct st_pid *plist,
+		       unsigned int *thread_nr, pid_t tgid, int curr)
+{
+	int sz, rc;
+	char buffer[1024 + 1];
+	char *start;
+	unsigned long long start_time;
+	struct pid_stats *pst = plist->pstats[curr];
+
+	if ((sz = read_pid_stat_file(pid, plist, tgid, buffer, 1024)) <= 0)
+		/* No such process */
+		return 1;
+	buffer[sz] = '\0';
+
+	if ((start = get_pid_comm(plist, buffer)) == NULL)
+		return 1;
+
+	rc = sscanf(start,
+		    "%*s %*d %*d %*d %*d %*d %*u %llu %llu"
+		    " %llu %llu %llu %llu %lld %lld %*d %*d %u %*u %llu %llu %llu"
+		    " %*u %*u %*u %*u %*u %*u %*u %*u %*u %*u %*u %*u %*u"
+		    " %*u %u %u %u %llu %llu %lld\n",
+		    &pst->minflt, &pst->cminflt, &pst->majflt, &pst->cmajflt,
+		    &pst->utime,  &pst->stime, &pst->cutime, &pst->cstime,
+		    thread_nr, &start_time, &pst->vsz, &pst->rss, &pst->processor,
+		    &pst->priority, &pst->policy,
+		    &pst->blkio_swapin_delays, &pst->gtime, &pst->cgtime);
+
+	if (rc < 16)
+		return 1;
+
+	if (rc < 18) {
+		/* gtime and cgtime fields are unavailable in file */
+		pst->gtime = pst->cgtime = 0;
+	}
+
+	if (plist->start_time && (plist->start_time != start_time)) {
+		/* PID has been reused by a new task */
+		reset_pid_stats(plist, curr);
 	}
+	plist->start_time = start_time;
+
+	/* Convert to kB */
+	pst->vsz >>= 10;
+	pst->rss = PG_TO_KB(pst->rss);
+
+	return 0;
+}
+
+/*
+ ***************************************************************************
+ * Read stats from /proc/#[/task/##]/schedstat.
+ *
+ * IN:
+ * @pid		Process whose stats are to be read.
+ * @plist	Pointer on the linked list where PID is saved.
+ * @tgid	If != 0, thread whose stats are to be read.
+ * @curr	Index in array for current sample statistics.
+ *
+ * RETURNS:
+ * 0 if stats have been successfully read, and 1 otherwise.
+ ***************************************************************************
+ */
+int read_proc_pid_sched(pid_t pid, struct st_pid *plist, pid_t tgid, int curr)
+{
+	int fd, rc = 0;
+	char buffer[1024 + 1];
+	unsigned long long wtime = 0;
+	struct pid_stats *pst = plist->pstats[curr];
 
-	if ((fd = open(filename, O_RDONLY)) >= 0) {
+	if ((fd = open_pid_file(pid, plist, tgid, "schedstat", O_RDONLY)) >= 0) {
 		int sz;
 
 		/* schedstat file found for process */
@@ -592,17 +1005,10 @@ int read_proc_pid_sched(pid_t pid, struct st_pid *plist, pid_t tgid, int curr)
 int read_proc_pid_status(pid_t pid, struct st_pid *plist, pid_t tgid, int curr)
 {
 	FILE *fp;
-	char filename[128], line[256];
+	char line[256];
 	struct pid_stats *pst = plist->pstats[curr];
 
-	if (tgid) {
-		sprintf(filename, TASK_STATUS, tgid, pid);
-	}
-	else {
-		sprintf(filename, PID_STATUS, pid);
-	}
-
-	if ((fp = fopen(filename, "r")) == NULL)
+	if ((fp = fopen_pid_file(pid, plist, tgid, "status")) == NULL)
 		/* No such process */
 		return 1;
 
@@ -643,18 +1049,11 @@ int read_proc_pid_status(pid_t pid, struct st_pid *plist, pid_t tgid, int curr)
 int read_proc_pid_smap(pid_t pid, struct st_pid *plist, pid_t tgid, int curr)
 {
 	FILE *fp;
-	char filename[128], line[256];
+	char line[256];
 	int state = 0;
 	struct pid_stats *pst = plist->pstats[curr];
 
-	if (tgid) {
-		sprintf(filename, TASK_SMAP, tgid, pid);
-	}
-	else {
-		sprintf(filename, PID_SMAP, pid);
-	}
-
-	if ((fp = fopen(filename, "rt")) == NULL)
+	if ((fp = fopen_pid_file(pid, plist, tgid, "smaps")) == NULL)
 		/* No such process */
 		return 1;
 
@@ -686,6 +1085,77 @@ int read_proc_pid_smap(pid_t pid, struct st_pid *plist, pid_t tgid, int curr)
 	return 0;
 }
 
+/*
+ *****************************************************************************
+ * Read stack information using /proc/#[/task/##]/maps to find the stack
+ * mapping, and /proc/#[/task/##]/pagemap to know which of its pages are
+ * present in memory. Contrary to smaps, those files don't need the kernel
+ * to walk the page tables of every mapping of the task, which is very
+ * expensive for processes with a large number of mappings.
+ * The result approximates the Referenced field of smaps: Both count
+ * resident pages only (swapped out pages are not counted), but Referenced
+ * is further limited to pages recently accessed, which pagemap doesn't tell.
+ *
+ * @pid		Process whose stats are to be read.
+ * @plist	Pointer on the linked list where PID is saved.
+ * @tgid	If != 0, thread whose stats are to be read.
+ * @curr	Index in array for current sample statistics.
+ *
+ * RETURNS:
+ * 0 if stats have been successfully read, and 1 otherwise.
+ *****************************************************************************
+ */
+int read_proc_pid_stack(pid_t pid, struct st_pid *plist, pid_t tgid, int curr)
+{
+	FILE *fp;
+	char line[256];
+	int fd, i, n, found = FALSE;
+	unsigned long long start, end, addr, pg_sz = 1024ULL << kb_shift;
+	unsigned long pages = 0;
+	uint64_t pm[PAGEMAP_CHUNK];
+	struct pid_stats *pst = plist->pstats[curr];
+
+	if ((fp = fopen_pid_file(pid, plist, tgid, "maps")) == NULL)
+		return 1;
+
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		if (strstr(line, " [stack]\n")) {
+			found = (sscanf(line, "%llx-%llx", &start, &end) == 2);
+			break;
+		}
+	}
+
+	fclose(fp);
+
+	if (!found || (end <= start))
+		return 1;
+
+	if ((fd = open_pid_file(pid, plist, tgid, "pagemap", O_RDONLY)) < 0)
+		return 1;
+
+	/* Pagemap file contains one 64-bit entry per virtual page */
+	for (addr = start; addr < end; addr += n * pg_sz) {
+		n = MINIMUM((end - addr) / pg_sz, PAGEMAP_CHUNK);
+		if (pread(fd, pm, n * sizeof(uint64_t),
+			  (off_t) (addr / pg_sz * sizeof(uint64_t))) != (ssize_t) (n * sizeof(uint64_t))) {
+			close(fd);
+			return 1;
+		}
+		for (i = 0; i < n; i++) {
+			if (pm[i] & PM_PRESENT) {
+				pages++;
+			}
+		}
+	}
+
+	close(fd);
+
+	pst->stack_size = (end - start) >> 10;
+	pst->stack_ref = PG_TO_KB(pages);
+
+	return 0;
+}
+
 /*
  *****************************************************************************
  * Read process command line from /proc/#[/task/##]/cmdline.
@@ -706,18 +1176,11 @@ int read_proc_pid_smap(pid_t pid, struct st_pid *plist, pid_t tgid, int curr)
 int read_proc_pid_cmdline(pid_t pid, struct st_pid *plist, pid_t tgid)
 {
 	FILE *fp;
-	char filename[128], line[MAX_CMDLINE_LEN];
+	char line[MAX_CMDLINE_LEN];
 	size_t len;
 	int found = FALSE;
 
-	if (tgid) {
-		sprintf(filename, TASK_CMDLINE, tgid, pid);
-	}
-	else {
-		sprintf(filename, PID_CMDLINE, pid);
-	}
-
-	if ((fp = fopen(filename, "r")) == NULL)
+	if ((fp = fopen_pid_file(pid, plist, tgid, "cmdline")) == NULL)
 		/* No such process */
 		return 1;
 
@@ -766,17 +1229,10 @@ int read_proc_pid_cmdline(pid_t pid, struct st_pid *plist, pid_t tgid)
 int read_proc_pid_io(pid_t pid, struct st_pid *plist, pid_t tgid, int curr)
 {
 	FILE *fp;
-	char filename[128], line[256];
+	char line[256];
 	struct pid_stats *pst = plist->pstats[curr];
 
-	if (tgid) {
-		sprintf(filename, TASK_IO, tgid, pid);
-	}
-	else {
-		sprintf(filename, PID_IO, pid);
-	}
-
-	if ((fp = fopen(filename, "r")) == NULL) {
+	if ((fp = fopen_pid_file(pid, plist, tgid, "io")) == NULL) {
 		/* No such process... or file non existent! */
 		plist->flags |= F_NO_PID_IO;
 		/*
@@ -801,167 +1257,1213 @@ int read_proc_pid_io(pid_t pid, struct st_pid *plist, pid_t tgid, int curr)
 
 	fclose(fp);
 
-	plist->flags &= ~F_NO_PID_IO;
+	plist->flags &= ~F_NO_PID_IO;
+
+	return 0;
+}
+
+/*
+ ***************************************************************************
+ * Count number of file descriptors in /proc/#[/task/##]/fd directory.
+ *
+ * IN:
+ * @pid		Process whose stats are to be read.
+ * @plist	Pointer on the linked list where PID is saved.
+ * @tgid	If != 0, thread whose stats are to be read.
+ * @curr	Index in array for current sample statistics.
+ *
+ * RETURNS:
+ * 0 if stats have been successfully read.
+ * Also returns 0 if current process has terminated or if we cannot read its
+ * fd directory, but in this case, set process' F_NO_PID_FD flag to
+ * indicate that fd directory couldn't be read.
+ ***************************************************************************
+ */
+int read_proc_pid_fd(pid_t pid, struct st_pid *plist, pid_t tgid, int curr)
+{
+	DIR *dir = NULL;
+	struct dirent *drp;
+	int fd;
+	struct pid_stats *pst = plist->pstats[curr];
+
+	if ((fd = open_pid_file(pid, plist, tgid, "fd", O_RDONLY | O_DIRECTORY)) >= 0) {
+		if ((dir = fdopendir(fd)) == NULL) {
+			close(fd);
+		}
+	}
+
+	if (dir == NULL) {
+		/* Cannot read fd directory */
+		plist->flags |= F_NO_PID_FD;
+		return 0;
+	}
+
+	pst->fd_nr = 0;
+
+	/* Count number of entries if fd directory */
+	while ((drp = readdir(dir)) != NULL) {
+		if (isdigit(drp->d_name[0])) {
+			(pst->fd_nr)++;
+		}
+	}
+
+	closedir(dir);
+
+	plist->flags &= ~F_NO_PID_FD;
+
+	return 0;
+}
+
+#ifdef HAVE_LINUX_TASKSTATS_H
+/*
+ ***************************************************************************
+ * Open a generic netlink socket.
+ *
+ * RETURNS:
+ * Socket descriptor, or -1 on failure.
+ ***************************************************************************
+ */
+int ts_open(void)
+{
+	int fd;
+	struct sockaddr_nl nladdr;
+
+	if ((fd = __socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_GENERIC)) < 0)
+		return -1;
+
+	memset(&nladdr, 0, sizeof(nladdr));
+	nladdr.nl_family = AF_NETLINK;
+	if (__bind(fd, (struct sockaddr *) &nladdr, sizeof(nladdr)) < 0) {
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+/*
+ ***************************************************************************
+ * Send a command with one attribute to a generic netlink family.
+ *
+ * IN:
+ * @fd		Netlink socket.
+ * @type	Generic netlink family ID.
+ * @flags	Additional netlink flags (e.g. NLM_F_ACK).
+ * @cmd		Command.
+ * @attr	Attribute type.
+ * @data	Attribute value.
+ * @len		Length of attribute value.
+ *
+ * RETURNS:
+ * 0 on success, and -1 otherwise.
+ ***************************************************************************
+ */
+int ts_send_cmd(int fd, unsigned short type, unsigned short flags, unsigned char cmd,
+		unsigned short attr, const void *data, int len)
+{
+	struct {
+		struct nlmsghdr n;
+		struct genlmsghdr g;
+		char buf[256];
+	} msg;
+	struct nlattr *na;
+	struct sockaddr_nl nladdr;
+
+	if (len > (int) (sizeof(msg.buf) - NLA_HDRLEN))
+		return -1;
+
+	memset(&msg, 0, sizeof(msg));
+	msg.n.nlmsg_len = NLMSG_LENGTH(GENL_HDRLEN);
+	msg.n.nlmsg_type = type;
+	msg.n.nlmsg_flags = NLM_F_REQUEST | flags;
+	msg.g.cmd = cmd;
+	msg.g.version = TASKSTATS_GENL_VERSION;
+
+	na = (struct nlattr *) ((char *) NLMSG_DATA(&msg.n) + GENL_HDRLEN);
+	na->nla_type = attr;
+	na->nla_len = NLA_HDRLEN + len;
+	memcpy((char *) na + NLA_HDRLEN, data, len);
+	msg.n.nlmsg_len += NLA_ALIGN(na->nla_len);
+
+	memset(&nladdr, 0, sizeof(nladdr));
+	nladdr.nl_family = AF_NETLINK;
+
+	if (__sendto(fd, &msg, msg.n.nlmsg_len, 0, (struct sockaddr *) &nladdr,
+		     sizeof(nladdr)) != (ssize_t) msg.n.nlmsg_len)
+		return -1;
+
+	return 0;
+}
+
+/*
+ ***************************************************************************
+ * Receive a generic netlink message.
+ *
+ * IN:
+ * @fd		Netlink socket.
+ * @buf		Buffer where the message will be saved.
+ * @size	Size of buffer.
+ * @flags	Flags passed to recv().
+ *
+ * RETURNS:
+ * Pointer on the message header, or NULL if no message has been received
+ * or if an error message has been received.
+ ***************************************************************************
+ */
+struct nlmsghdr *ts_recv(int fd, char *buf, int size, int flags)
+{
+	struct nlmsghdr *n = (struct nlmsghdr *) buf;
+	int len;
+
+	if ((len = __recv(fd, buf, size, flags)) < 0)
+		return NULL;
+
+	if (!NLMSG_OK(n, len) || (n->nlmsg_type == NLMSG_ERROR) ||
+	    (n->nlmsg_len < NLMSG_LENGTH(GENL_HDRLEN)))
+		return NULL;
+
+	return n;
+}
+
+/*
+ ***************************************************************************
+ * Look for an attribute in a list of netlink attributes.
+ *
+ * IN:
+ * @na		First attribute of the list.
+ * @rem		Length of the list.
+ * @type	Type of the attribute to look for.
+ *
+ * RETURNS:
+ * Pointer on the attribute, or NULL if not found.
+ ***************************************************************************
+ */
+struct nlattr *ts_find_attr(struct nlattr *na, int rem, unsigned short type)
+{
+	while ((rem >= NLA_HDRLEN) && (na->nla_len >= NLA_HDRLEN) && (na->nla_len <= rem)) {
+		if (na->nla_type == type)
+			return na;
+
+		rem -= NLA_ALIGN(na->nla_len);
+		na = (struct nlattr *) ((char *) na + NLA_ALIGN(na->nla_len));
+	}
+
+	return NULL;
+}
+
+/*
+ ***************************************************************************
+ * Get the taskstats structure for a single task contained in a taskstats
+ * netlink message.
+ *
+ * IN:
+ * @n		Netlink message.
+ *
+ * OUT:
+ * @ts		Taskstats structure.
+ *
+ * RETURNS:
+ * 0 on success, and -1 if the message contains no stats for a single task.
+ ***************************************************************************
+ */
+int ts_get_stats(struct nlmsghdr *n, struct taskstats *ts)
+{
+	struct nlattr *na;
+	int len;
+
+	/* Stats aggregated for a whole thread group are ignored */
+	if ((na = ts_find_attr((struct nlattr *) ((char *) NLMSG_DATA(n) + GENL_HDRLEN),
+			       NLMSG_PAYLOAD(n, GENL_HDRLEN), TASKSTATS_TYPE_AGGR_PID)) == NULL)
+		return -1;
+
+	if ((na = ts_find_attr((struct nlattr *) ((char *) na + NLA_HDRLEN),
+			       na->nla_len - NLA_HDRLEN, TASKSTATS_TYPE_STATS)) == NULL)
+		return -1;
+
+	/* Structure sent by the kernel may be smaller or larger than ours */
+	len = MINIMUM(na->nla_len - NLA_HDRLEN, (int) sizeof(struct taskstats));
+	memset(ts, 0, sizeof(struct taskstats));
+	memcpy(ts, (char *) na + NLA_HDRLEN, len);
+
+	return 0;
+}
+
+/*
+ ***************************************************************************
+ * Get taskstats for a given task.
+ *
+ * IN:
+ * @fd		Netlink socket.
+ * @pid		Task whose stats are to be read.
+ *
+ * OUT:
+ * @ts		Taskstats structure.
+ *
+ * RETURNS:
+ * 0 on success, and -1 otherwise.
+ ***************************************************************************
+ */
+int ts_get_task(int fd, pid_t pid, struct taskstats *ts)
+{
+	char buf[TS_MSG_SIZE];
+	struct nlmsghdr *n;
+	uint32_t p = pid;
+
+	if (ts_send_cmd(fd, ts_family, 0, TASKSTATS_CMD_GET,
+			TASKSTATS_CMD_ATTR_PID, &p, sizeof(p)) < 0)
+		return -1;
+
+	if ((n = ts_recv(fd, buf, sizeof(buf), 0)) == NULL)
+		return -1;
+
+	return ts_get_stats(n, ts);
+}
+
+/*
+ ***************************************************************************
+ * Get taskstats generic netlink family ID.
+ *
+ * IN:
+ * @fd		Netlink socket.
+ *
+ * RETURNS:
+ * Family ID, or 0 if it cannot be found.
+ ***************************************************************************
+ */
+unsigned short ts_get_family(int fd)
+{
+	char buf[TS_MSG_SIZE];
+	struct nlmsghdr *n;
+	struct nlattr *na;
+
+	if (ts_send_cmd(fd, GENL_ID_CTRL, 0, CTRL_CMD_GETFAMILY, CTRL_ATTR_FAMILY_NAME,
+			TASKSTATS_GENL_NAME, strlen(TASKSTATS_GENL_NAME) + 1) < 0)
+		return 0;
+
+	if ((n = ts_recv(fd, buf, sizeof(buf), 0)) == NULL)
+		return 0;
+
+	if ((na = ts_find_attr((struct nlattr *) ((char *) NLMSG_DATA(n) + GENL_HDRLEN),
+			       NLMSG_PAYLOAD(n, GENL_HDRLEN), CTRL_ATTR_FAMILY_ID)) == NULL)
+		return 0;
+
+	return *((unsigned short *) ((char *) na + NLA_HDRLEN));
+}
+
+/*
+ ***************************************************************************
+ * Register a socket to receive the stats of tasks exiting on any CPU.
+ *
+ * RETURNS:
+ * Socket descriptor, or -1 on failure.
+ ***************************************************************************
+ */
+int ts_register_exit(void)
+{
+	FILE *fp;
+	char buf[TS_MSG_SIZE], cpumask[128];
+	struct nlmsghdr *n;
+	int fd, size = TS_RCVBUF_SIZE;
+
+	/* Get list of possible CPUs */
+	if (((fp = fopen(CPU_POSSIBLE, "r")) == NULL) ||
+	    (fgets(cpumask, sizeof(cpumask), fp) == NULL)) {
+		snprintf(cpumask, sizeof(cpumask), "0-%d", cpu_nr - 1);
+	}
+	if (fp) {
+		fclose(fp);
+	}
+	cpumask[strcspn(cpumask, "\n")] = '\0';
+
+	if ((fd = ts_open()) < 0)
+		return -1;
+
+	/* Try to avoid losing notifications when many tasks exit */
+	setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+
+	/* Ask for an acknowledgment to know if registration has succeeded */
+	if ((ts_send_cmd(fd, ts_family, NLM_F_ACK, TASKSTATS_CMD_GET,
+			 TASKSTATS_CMD_ATTR_REGISTER_CPUMASK, cpumask, strlen(cpumask) + 1) < 0) ||
+	    (__recv(fd, buf, sizeof(buf), 0) < 0)) {
+		close(fd);
+		return -1;
+	}
+
+	n = (struct nlmsghdr *) buf;
+	if ((n->nlmsg_type != NLMSG_ERROR) ||
+	    ((struct nlmsgerr *) NLMSG_DATA(n))->error) {
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+/*
+ ***************************************************************************
+ * Init taskstats backend. If taskstats cannot be used (kernel not
+ * supporting them, missing privileges...) then the stats will be read
+ * from /proc files.
+ ***************************************************************************
+ */
+void init_taskstats(void)
+{
+	FILE *fp;
+	struct taskstats ts;
+	int c;
+
+	if (((ts_fd = ts_open()) < 0) ||
+	    ((ts_family = ts_get_family(ts_fd)) == 0) ||
+	    ts_get_task(ts_fd, __getpid(), &ts)) {
+		if (ts_fd >= 0) {
+			close(ts_fd);
+			ts_fd = -1;
+		}
+		pidflag &= ~P_F_TASKSTATS;
+		return;
+	}
+
+	/* Delays are reported only if delay accounting is enabled */
+	if ((fp = fopen(TASK_DELAYACCT, "r")) != NULL) {
+		c = fgetc(fp);
+		ts_delayacct = (c == '1');
+		fclose(fp);
+	}
+
+	/* Failing to register for exiting tasks stats is not fatal */
+	ts_exit_fd = ts_register_exit();
+}
+
+/*
+ ***************************************************************************
+ * Close sockets used by taskstats backend.
+ ***************************************************************************
+ */
+void close_taskstats(void)
+{
+	if (ts_fd >= 0) {
+		close(ts_fd);
+		ts_fd = -1;
+	}
+	if (ts_exit_fd >= 0) {
+		close(ts_exit_fd);
+		ts_exit_fd = -1;
+	}
+}
+
+/*
+ ***************************************************************************
+ * Read stats for given task using taskstats. Those stats replace the ones
+ * read from /proc/#[/task/##]/status and schedstat files (the latter only
+ * if delay accounting is enabled), and also from /proc/#/task/##/io file
+ * for a thread (for a process, this file contains stats for all its
+ * threads whereas taskstats are given only for the thread group leader).
+ *
+ * IN:
+ * @pid		Process whose stats are to be read.
+ * @plist	Pointer on the linked list where PID is saved.
+ * @thread_nr	Number of threads of the process.
+ * @tgid	If !=0, thread whose stats are to be read.
+ * @curr	Index in array for current sample statistics.
+ *
+ * RETURNS:
+ * 0 if stats have been successfully read, and 1 otherwise.
+ ***************************************************************************
+ */
+int read_taskstats(pid_t pid, struct st_pid *plist, unsigned int thread_nr,
+		   pid_t tgid, int curr)
+{
+	struct taskstats ts;
+	struct pid_stats *pst = plist->pstats[curr];
+
+	/* Each thread reading /proc uses its own socket */
+	if (ts_fd < 0) {
+		if ((ts_fd = ts_open()) < 0)
+			return 1;
+	}
+
+	if (ts_get_task(ts_fd, pid, &ts))
+		return 1;
+
+	plist->uid = ts.ac_uid;
+	pst->threads = thread_nr;
+	pst->nvcsw = ts.nvcsw;
+	pst->nivcsw = ts.nivcsw;
+
+	if (ts_delayacct) {
+		/* Convert ns to jiffies */
+		pst->wtime = ts.cpu_delay_total * HZ / 1000000000;
+	}
+	else {
+		read_proc_pid_sched(pid, plist, tgid, curr);
+	}
+
+	if (tgid) {
+		pst->read_bytes = ts.read_bytes;
+		pst->write_bytes = ts.write_bytes;
+		pst->cancelled_write_bytes = ts.cancelled_write_bytes;
+		plist->flags &= ~F_NO_PID_IO;
+	}
+
+	return 0;
+}
+
+/*
+ ***************************************************************************
+ * Save the stats of a task that has exited during current interval, so
+ * that its activity until it exited is displayed. Stats not given by
+ * taskstats are those of previous sample. Counters are not allowed to
+ * decrease (e.g. CPU times are not scaled the same way in /proc/#/stat).
+ *
+ * IN:
+ * @plist	Pointer on the linked list where PID is saved.
+ * @ts		Taskstats structure for the task.
+ * @prev	Index in array where stats used as reference are.
+ * @curr	Index in array for current sample statistics.
+ ***************************************************************************
+ */
+void save_exited_pid_stats(struct st_pid *plist, struct taskstats *ts, int prev, int curr)
+{
+	struct pid_stats *pstc = plist->pstats[curr];
+
+	memcpy(pstc, plist->pstats[prev], PID_STATS_SIZE);
+
+	TS_SET(pstc->utime, ts->ac_utime * HZ / 1000000);
+	TS_SET(pstc->stime, ts->ac_stime * HZ / 1000000);
+	TS_SET(pstc->minflt, ts->ac_minflt);
+	TS_SET(pstc->majflt, ts->ac_majflt);
+	TS_SET(pstc->nvcsw, ts->nvcsw);
+	TS_SET(pstc->nivcsw, ts->nivcsw);
+	TS_SET(pstc->read_bytes, ts->read_bytes);
+	TS_SET(pstc->write_bytes, ts->write_bytes);
+	TS_SET(pstc->cancelled_write_bytes, ts->cancelled_write_bytes);
+	if (ts_delayacct) {
+		TS_SET(pstc->wtime, ts->cpu_delay_total * HZ / 1000000000);
+	}
+
+	plist->exist = TRUE;
+}
+
+/*
+ ***************************************************************************
+ * Read stats of tasks which have exited since previous sample.
+ * Only a process which had only one thread is considered, since taskstats
+ * of a thread group leader don't include those of other threads.
+ *
+ * IN:
+ * @curr	Index in array for current sample statistics.
+ ***************************************************************************
+ */
+void read_taskstats_exits(int curr)
+{
+	char buf[TS_EXIT_MSG_SIZE];
+	struct nlmsghdr *n;
+	struct taskstats ts;
+	struct st_pid *plist, *tgid_p;
+	int prev = !curr;
+
+	while (TRUE) {
+		if ((n = ts_recv(ts_exit_fd, buf, sizeof(buf), MSG_DONTWAIT)) == NULL) {
+			if (errno == ENOBUFS)
+				/* Some notifications have been lost */
+				continue;
+			break;
+		}
+
+		if (ts_get_stats(n, &ts))
+			continue;
+
+		if (!ts.ac_tgid || (ts.ac_tgid == ts.ac_pid)) {
+			/* Thread group leader */
+			plist = lookup_pid(ts.ac_pid, NULL);
+			if (plist && !plist->exist && (plist->pstats[prev]->threads <= 1)) {
+				save_exited_pid_stats(plist, &ts, prev, curr);
+			}
+		}
+
+		if (DISPLAY_TID(pidflag) && ts.ac_tgid &&
+		    ((tgid_p = lookup_pid(ts.ac_tgid, NULL)) != NULL)) {
+			plist = lookup_pid(ts.ac_pid, tgid_p);
+			if (plist && !plist->exist) {
+				save_exited_pid_stats(plist, &ts, prev, curr);
+			}
+		}
+	}
+}
+#endif
+
+/*
+ ***************************************************************************
+ * Read various stats for given PID.
+ *
+ * IN:
+ * @pid		Process whose stats are to be read.
+ * @plist	Pointer on the linked list where PID is saved.
+ * @tgid	If !=0, thread whose stats are to be read.
+ * @curr	Index in array for current sample statistics.
+ *
+ * OUT:
+ * @thread_nr	Number of threads of the process.
+ *
+ * RETURNS:
+ * 0 if stats have been successfully read, and 1 otherwise.
+ ***************************************************************************
+ */
+int read_pid_stats(pid_t pid, struct st_pid *plist, unsigned int *thread_nr,
+		   pid_t tgid, int curr)
+{
+	int ts = FALSE;
+
+	if (read_proc_pid_stat(pid, plist, thread_nr, tgid, curr))
+		return 1;
+
+#ifdef HAVE_LINUX_TASKSTATS_H
+	if (USE_TASKSTATS(pidflag)) {
+		/* Use /proc files if taskstats cannot be read for this task */
+		ts = !read_taskstats(pid, plist, *thread_nr, tgid, curr);
+	}
+#endif
+
+	if (!ts) {
+		/*
+		 * No need to test the return code here: Not finding
+		 * the schedstat files shouldn't make pidstat stop.
+		 */
+		read_proc_pid_sched(pid, plist, tgid, curr);
+	}
+
+	if (DISPLAY_CMDLINE(pidflag) && !plist->cmdline[0]) {
+		if (read_proc_pid_cmdline(pid, plist, tgid))
+			return 1;
+	}
+
+	if (!ts && read_proc_pid_status(pid, plist, tgid, curr))
+		return 1;
+
+	if (DISPLAY_STACK(actflag)) {
+		/* Use smaps file only if maps or pagemap files cannot be read */
+		if (read_proc_pid_stack(pid, plist, tgid, curr) &&
+		    read_proc_pid_smap(pid, plist, tgid, curr))
+			return 1;
+	}
+
+	if (DISPLAY_KTAB(actflag)) {
+		if (read_proc_pid_fd(pid, plist, tgid, curr))
+			return 1;
+	}
+
+	if (DISPLAY_IO(actflag) && !(ts && tgid))
+		/* Assume that /proc/#/task/#/io exists! */
+		return (read_proc_pid_io(pid, plist, tgid, curr));
+
+	return 0;
+}
+
+/*
+ ***************************************************************************
+ * Check whether the command of a task whose stats have just been read
+ * matches the strings entered with options -C and -G, and save the
+ * result in task's flags so that the task can be skipped next time.
+ *
+ * IN:
+ * @plist	Pointer on the linked list where PID is saved.
+ * @curr	Index in array for current sample statistics.
+ ***************************************************************************
+ */
+void set_pid_filter_flags(struct st_pid *plist, int curr)
+{
+	char *pc;
+
+	pc = get_tcmd(plist);	/* Get pointer on task's command string */
+
+	if (COMMAND_STRING(pidflag) && regexec(&commregex, pc, 0, NULL, 0)) {
+		/* regex pattern not found in command name */
+		plist->flags |= F_NO_COMM_MATCH;
+	}
+	else {
+		plist->flags &= ~F_NO_COMM_MATCH;
+	}
+
+	if (PROCESS_STRING(pidflag) && !plist->tgid && regexec(&procregex, pc, 0, NULL, 0)) {
+		/* regex pattern not found in process command name */
+		plist->flags |= F_NO_PROC_MATCH;
+	}
+	else {
+		plist->flags &= ~F_NO_PROC_MATCH;
+	}
+
+	if (IS_PID_SKIPPED(plist->flags)) {
+		if (!(plist->flags & (F_NO_COMM_MATCH | F_NO_PROC_MATCH))) {
+			/*
+			 * Task now matches (e.g. it has exec'd a new program) but
+			 * its previous stats are outdated: Use current ones instead.
+			 */
+			memcpy(plist->pstats[!curr], plist->pstats[curr], PID_STATS_SIZE);
+		}
+		plist->flags &= ~F_PID_SKIPPED;
+	}
+}
+
+/*
+ ***************************************************************************
+ * Check whether a task is already known not to match the strings entered
+ * with options -C and -G, in which case its stats don't need to be read.
+ * Tasks whose directory entry in /proc has changed (e.g. because their PID
+ * has been reused) are always read again. As the command name of a task
+ * may change (e.g. when it execs a new program), it is read again from
+ * the stat file (whose fd is kept open) and checked at each sample: Only
+ * the other files are not read if the task still doesn't match.
+ *
+ * IN:
+ * @pid		Process whose stats are to be read.
+ * @tgid	If != 0, thread whose stats are to be read.
+ * @plist	Pointer on the linked list where PID is saved.
+ * @ino		Inode number of task's directory in /proc (0 if unknown).
+ *
+ * RETURNS:
+ * TRUE if task's stats don't need to be read.
+ ***************************************************************************
+ */
+int is_pid_filtered(pid_t pid, pid_t tgid, struct st_pid *plist, ino_t ino)
+{
+	int filtered;
+	char *pc;
+
+	filtered = (ino && (ino == plist->ino) &&
+		    (plist->flags & (F_NO_COMM_MATCH | F_NO_PROC_MATCH)));
+	plist->ino = ino;
+
+	if (!filtered)
+		return FALSE;
+
+	if (!plist->tgid && DISPLAY_TID(pidflag) && !NO_PROC_MATCH(plist->flags))
+		/* Process must be read so that its threads can be read too */
+		return FALSE;
+
+	if (read_proc_pid_comm(pid, plist, tgid))
+		/* Let the caller find out that the task has terminated */
+		return FALSE;
+
+	pc = get_tcmd(plist);	/* Get pointer on task's command string */
+
+	if ((NO_COMM_MATCH(plist->flags) && !regexec(&commregex, pc, 0, NULL, 0)) ||
+	    (NO_PROC_MATCH(plist->flags) && !regexec(&procregex, pc, 0, NULL, 0)))
+		/* Command name has changed and now matches */
+		return FALSE;
+
+	plist->flags |= F_PID_SKIPPED;
+
+	return TRUE;
+}
+
+/*
+ ***************************************************************************
+ * Add a task to the list of tasks whose stats are to be read.
+ *
+ * IN:
+ * @nr		Number of tasks already in the list.
+ * @pid		Task whose stats are to be read.
+ * @tgid	If != 0, thread group leader of the task.
+ * @plist	Pointer on the linked list where task is saved.
+ ***************************************************************************
+ */
+void add_pid_work(int nr, pid_t pid, pid_t tgid, struct st_pid *plist)
+{
+	if (nr >= pid_work_sz) {
+		pid_work_sz = pid_work_sz ? pid_work_sz * 2 : 1024;
+		SREALLOC(pid_work, struct pid_work, (size_t) pid_work_sz * sizeof(struct pid_work));
+	}
+	pid_work[nr].pid = pid;
+	pid_work[nr].tgid = tgid;
+	pid_work[nr].plist = plist;
+}
+
+/*
+ ***************************************************************************
+ * Read stats for a range of tasks from the list. A task that has
+ * terminated is marked as nonexistent.
+ *
+ * IN:
+ * @start	Index of first task to read.
+ * @end		Index following the last task to read.
+ * @curr	Index in array for current sample statistics.
+ ***************************************************************************
+ */
+void read_pid_work_range(int start, int end, int curr)
+{
+	int i;
+	unsigned int thr_nr;
+	struct pid_work *pw;
+
+	for (i = start; i < end; i++) {
+		pw = pid_work + i;
+		if (read_pid_stats(pw->pid, pw->plist, &thr_nr, pw->tgid, curr)) {
+			/* PID has terminated */
+			pw->plist->exist = FALSE;
+		}
+		else if (COMMAND_STRING(pidflag) || PROCESS_STRING(pidflag)) {
+			set_pid_filter_flags(pw->plist, curr);
+		}
+	}
+}
+
+#ifdef HAVE_PTHREAD_H
+/*
+ * Parameters shared by the threads reading tasks stats.
+ * Tasks are dispatched in chunks of PID_WORK_CHUNK entries.
+ */
+struct pid_work_ctx {
+	pthread_mutex_t lock;
+	int next;	/* Index of next task to read */
+	int end;	/* Index following the last task to read */
+	int curr;
+};
+
+/*
+ ***************************************************************************
+ * Worker thread: Read stats for tasks from the list until no more tasks
+ * are left.
+ *
+ * IN:
+ * @arg		Pointer on the structure shared by all the threads.
+ ***************************************************************************
+ */
+void *pid_work_thread(void *arg)
+{
+	struct pid_work_ctx *ctx = (struct pid_work_ctx *) arg;
+	int start, end;
+
+	do {
+		pthread_mutex_lock(&ctx->lock);
+		start = ctx->next;
+		end = MINIMUM(start + PID_WORK_CHUNK, ctx->end);
+		ctx->next = end;
+		pthread_mutex_unlock(&ctx->lock);
+
+		read_pid_work_range(start, end, ctx->curr);
+	}
+	while (start < end);
+
+	return NULL;
+}
+
+/*
+ ***************************************************************************
+ * Start routine of threads created to read tasks stats.
+ *
+ * IN:
+ * @arg		Pointer on the structure shared by all the threads.
+ ***************************************************************************
+ */
+void *pid_worker(void *arg)
+{
+	pid_work_thread(arg);
+
+#ifdef HAVE_LINUX_TASKSTATS_H
+	if (ts_fd >= 0) {
+		/* Close taskstats socket used by this thread */
+		close(ts_fd);
+	}
+#endif
+
+	return NULL;
+}
+#endif
+
+/*
+ ***************************************************************************
+ * Read stats for a range of tasks from the list, using several threads if
+ * requested (option --workers).
+ *
+ * IN:
+ * @start	Index of first task to read.
+ * @end		Index following the last task to read.
+ * @curr	Index in array for current sample statistics.
+ ***************************************************************************
+ */
+void read_pid_work(int start, int end, int curr)
+{
+#ifdef HAVE_PTHREAD_H
+	pthread_t tid[MAX_WORKERS];
+	struct pid_work_ctx ctx;
+	int i, thr_nr;
+
+	/* Don't start more threads than necessary */
+	thr_nr = MINIMUM(workers_nr, (end - start + PID_WORK_CHUNK - 1) / PID_WORK_CHUNK);
+
+	if (thr_nr > 1) {
+		pthread_mutex_init(&ctx.lock, NULL);
+		ctx.next = start;
+		ctx.end = end;
+		ctx.curr = curr;
+
+		for (i = 1; i < thr_nr; i++) {
+			if (pthread_create(&tid[i], NULL, pid_worker, &ctx))
+				/* Current thread will do the remaining work */
+				break;
+		}
+		thr_nr = i;
+
+		/* Current thread also takes part in the work */
+		pid_work_thread(&ctx);
+
+		for (i = 1; i < thr_nr; i++) {
+			pthread_join(tid[i], NULL);
+		}
+		pthread_mutex_destroy(&ctx.lock);
+
+		return;
+	}
+#endif
+	read_pid_work_range(start, end, curr);
+}
+
+/*
+ ***************************************************************************
+ * Add threads found in /proc/#/task directory to the list of tasks whose
+ * stats are to be read.
+ *
+ * IN:
+ * @pid		Process number whose threads stats are to be read.
+ * @nr		Number of tasks already in the list.
+ * @curr	Index in array for current sample statistics.
+ *
+ * RETURNS:
+ * New number of tasks in the list.
+ ***************************************************************************
+ */
+int add_task_work(pid_t pid, int nr, int curr)
+{
+	DIR *dir;
+	pid_t tid;
+	struct dirent *drp;
+	char filename[128];
+	struct st_pid *tlist;
+
+	/* Open /proc/#/task directory */
+	sprintf(filename, PROC_TASK, pid);
+	if ((dir = __opendir(filename)) == NULL)
+		return nr;
+
+	while ((drp = __readdir(dir)) != NULL) {
+
+		if (!isdigit(drp->d_name[0])) {
+			continue;
+		}
+
+		tid = atoi(drp->d_name);
+
+		tlist = add_list_pid(&pid_list, tid, pid);
+		if (!tlist)
+			continue;
+		tlist->exist = TRUE;
+
+		if (is_pid_filtered(tid, pid, tlist, drp->d_ino))
+			/* Thread is known not to be displayed */
+			continue;
+
+		add_pid_work(nr++, tid, pid, tlist);
+	}
+
+	__closedir(dir);
+
+	return nr;
+}
+
+/*
+ ***************************************************************************
+ * Look for a cgroup in the list and add it if not found.
+ * Cgroups are kept in the order in which they are found when the cgroup
+ * hierarchy is walked. As this order usually doesn't change from one
+ * sample to the next, the cgroup is first looked for right after the last
+ * one found.
+ *
+ * IN:
+ * @name	Cgroup path relative to the cgroup root.
+ *
+ * RETURNS:
+ * Pointer on the cgroup structure in the list.
+ ***************************************************************************
+ */
+struct st_cgroup *add_list_cgroup(const char *name)
+{
+	struct st_cgroup **cgp, *cg;
+
+	cgp = last_cg ? &(last_cg->next) : &cg_list;
+
+	if ((*cgp == NULL) || strcmp((*cgp)->name, name)) {
+		for (cg = cg_list; cg != NULL; cg = cg->next) {
+			if (!strcmp(cg->name, name)) {
+				/* Cgroup found in list */
+				last_cg = cg;
+				return cg;
+			}
+		}
+
+		/* Cgroup not found: Insert it after the last one found */
+		if ((cg = (struct st_cgroup *) malloc(sizeof(struct st_cgroup))) == NULL) {
+			perror("malloc");
+			exit(4);
+		}
+		memset(cg, 0, sizeof(struct st_cgroup));
+		if ((cg->name = strdup(name)) == NULL) {
+			perror("strdup");
+			exit(4);
+		}
+		cg->next = *cgp;
+		*cgp = cg;
+	}
+
+	last_cg = *cgp;
+
+	return last_cg;
+}
+
+/*
+ ***************************************************************************
+ * Free structures of cgroups which no longer exist.
+ *
+ * IN:
+ * @force	Set to TRUE if all cgroup structures are to be freed.
+ ***************************************************************************
+ */
+void sfree_cgroup(int force)
+{
+	struct st_cgroup **cgp = &cg_list, *cg;
+
+	while (*cgp != NULL) {
+		cg = *cgp;
+		if (!cg->exist || force) {
+			*cgp = cg->next;
+			free(cg->name);
+			free(cg);
+		}
+		else {
+			cgp = &(cg->next);
+		}
+	}
+	last_cg = NULL;
+}
+
+/*
+ ***************************************************************************
+ * Read context switches of the threads belonging to a cgroup. Context
+ * switches are not accounted by cgroups and have to be read for each
+ * thread from /proc/#/status.
+ *
+ * IN:
+ * @dirname	Directory of the cgroup.
+ * @cst		Structure where context switches are added.
+ ***************************************************************************
+ */
+void read_cgroup_ctxsw(const char *dirname, struct cgroup_stats *cst)
+{
+	FILE *fp, *fps;
+	char line[256], filename[MAX_PF_NAME];
+	unsigned long long nvcsw, nivcsw;
+	unsigned int tid;
+
+	snprintf(filename, sizeof(filename), "%s/%s", dirname, CG_THREADS);
+	if ((fp = fopen(filename, "r")) == NULL)
+		return;
+
+	while (fgets(line, sizeof(line), fp) != NULL) {
+
+		if (sscanf(line, "%u", &tid) != 1)
+			continue;
+
+		snprintf(filename, sizeof(filename), PID_STATUS, tid);
+		if ((fps = fopen(filename, "r")) == NULL)
+			/* Thread has terminated */
+			continue;
+
+		while (fgets(line, sizeof(line), fps) != NULL) {
+
+			if (!strncmp(line, "voluntary_ctxt_switches:", 24)) {
+				if (sscanf(line + 24, "%llu", &nvcsw) == 1) {
+					cst->nvcsw += nvcsw;
+				}
+			}
+			else if (!strncmp(line, "nonvoluntary_ctxt_switches:", 27)) {
+				if (sscanf(line + 27, "%llu", &nivcsw) == 1) {
+					cst->nivcsw += nivcsw;
+				}
+			}
+		}
+		fclose(fps);
+	}
+
+	fclose(fp);
+}
+
+/*
+ ***************************************************************************
+ * Add context switches of the threads belonging to a descendant cgroup.
+ * Called by walk_cgroup_dir().
+ *
+ * IN:
+ * @dirname	Directory of the cgroup.
+ * @cgname	Unused here.
+ * @depth	Unused here.
+ * @arg		Structure where context switches are added.
+ *
+ * RETURNS:
+ * 0 so that all the descendant cgroups are walked.
+ ***************************************************************************
+ */
+int add_cgroup_ctxsw(const char *dirname, const char *cgname, int depth, void *arg)
+{
+	read_cgroup_ctxsw(dirname, (struct cgroup_stats *) arg);
 
 	return 0;
 }
 
 /*
  ***************************************************************************
- * Count number of file descriptors in /proc/#[/task/##]/fd directory.
+ * Read stats for a cgroup from files located in its directory:
+ * cpu.stat, memory.current, memory.stat and io.stat (some of these files
+ * may not exist depending on the controllers enabled for the cgroup).
  *
  * IN:
- * @pid		Process whose stats are to be read.
- * @plist	Pointer on the linked list where PID is saved.
- * @tgid	If != 0, thread whose stats are to be read.
+ * @cg		Cgroup structure.
+ * @dirname	Directory of the cgroup.
  * @curr	Index in array for current sample statistics.
  *
  * RETURNS:
- * 0 if stats have been successfully read.
- * Also returns 0 if current process has terminated or if we cannot read its
- * fd directory, but in this case, set process' F_NO_PID_FD flag to
- * indicate that fd directory couldn't be read.
+ * 0 if stats have been successfully read, and 1 if the cgroup no longer
+ * exists.
  ***************************************************************************
  */
-int read_proc_pid_fd(pid_t pid, struct st_pid *plist, pid_t tgid, int curr)
+int read_cgroup_stats(struct st_cgroup *cg, const char *dirname, int curr)
 {
-	DIR *dir;
-	struct dirent *drp;
-	char filename[128];
-	struct pid_stats *pst = plist->pstats[curr];
-
-	if (tgid) {
-		sprintf(filename, TASK_FD, tgid, pid);
-	}
-	else {
-		sprintf(filename, PID_FD, pid);
-	}
+	FILE *fp;
+	char filename[MAX_PF_NAME], line[256];
+	unsigned long long val;
+	struct stats_cgroup st_cg;
+	struct cgroup_stats *cst = &(cg->cstats[curr]);
 
-	if ((dir = opendir(filename)) == NULL) {
-		/* Cannot read fd directory */
-		plist->flags |= F_NO_PID_FD;
-		return 0;
-	}
+	memset(cst, 0, CGROUP_STATS_SIZE);
 
-	pst->fd_nr = 0;
+	if (read_cgroup_stat(&st_cg, dirname, (DISPLAY_MEM(actflag) ? CG_RD_MEM : 0) |
+						(DISPLAY_IO(actflag) ? CG_RD_IO : 0)))
+		return 1;
 
-	/* Count number of entries if fd directory */
-	while ((drp = readdir(dir)) != NULL) {
-		if (isdigit(drp->d_name[0])) {
-			(pst->fd_nr)++;
+	cst->usage_usec = st_cg.usage_usec;
+	cst->user_usec = st_cg.user_usec;
+	cst->system_usec = st_cg.system_usec;
+	cst->mem_current = st_cg.mem_current;
+	cst->rbytes = st_cg.rbytes;
+	cst->wbytes = st_cg.wbytes;
+	cst->rios = st_cg.rios;
+	cst->wios = st_cg.wios;
+
+	snprintf(filename, sizeof(filename), "%s/%s", dirname, CG_MEM_STAT);
+	if (DISPLAY_MEM(actflag) && ((fp = fopen(filename, "r")) != NULL)) {
+		while (fgets(line, sizeof(line), fp) != NULL) {
+
+			if (!strncmp(line, "anon ", 5)) {
+				sscanf(line + 5, "%llu", &val);
+				cst->anon = val >> 10;
+			}
+			else if (!strncmp(line, "file ", 5)) {
+				sscanf(line + 5, "%llu", &val);
+				cst->file = val >> 10;
+			}
+			else if (!strncmp(line, "pgfault ", 8)) {
+				sscanf(line + 8, "%llu", &cst->pgfault);
+			}
+			else if (!strncmp(line, "pgmajfault ", 11)) {
+				sscanf(line + 11, "%llu", &cst->pgmajfault);
+			}
 		}
+		fclose(fp);
 	}
 
-	closedir(dir);
-
-	plist->flags &= ~F_NO_PID_FD;
-
 	return 0;
 }
 
 /*
  ***************************************************************************
- * Read various stats for given PID.
+ * Read stats for a cgroup found while walking the cgroup hierarchy.
+ * Context switches of the threads belonging to the cgroup (and to its
+ * descendants if it is at max depth) are also added to those of its
+ * ancestors.
  *
  * IN:
- * @pid		Process whose stats are to be read.
- * @plist	Pointer on the linked list where PID is saved.
- * @tgid	If !=0, thread whose stats are to be read.
- * @curr	Index in array for current sample statistics.
- *
- * OUT:
- * @thread_nr	Number of threads of the process.
+ * @dirname	Directory of the cgroup.
+ * @cgname	Cgroup path relative to the cgroup root ("" for root cgroup).
+ * @depth	Depth of the cgroup (0 for root cgroup).
+ * @arg		Index in array for current sample statistics.
  *
  * RETURNS:
- * 0 if stats have been successfully read, and 1 otherwise.
+ * 0 if stats have been successfully read, and 1 if the cgroup no longer
+ * exists.
  ***************************************************************************
  */
-int read_pid_stats(pid_t pid, struct st_pid *plist, unsigned int *thread_nr,
-		   pid_t tgid, int curr)
+int read_cgroup_node(const char *dirname, const char *cgname, int depth, void *arg)
 {
-	if (read_proc_pid_stat(pid, plist, thread_nr, tgid, curr))
+	struct st_cgroup *cg;
+	struct cgroup_stats *cst;
+	char name[MAX_PF_NAME];
+	int i, curr = *((int *) arg);
+
+	snprintf(name, sizeof(name), "/%s", cgname);
+	cg = add_list_cgroup(name);
+	if (read_cgroup_stats(cg, dirname, curr))
+		/* Cgroup has been removed */
 		return 1;
+	cg->exist = TRUE;
+	cg_anc[depth] = cg;
+
+	if (DISPLAY_CTXSW(actflag)) {
+		cst = &(cg->cstats[curr]);
+		read_cgroup_ctxsw(dirname, cst);
+		if (depth >= cg_depth) {
+			walk_cgroup_dir(cg_root, cgname, depth + 1, INT_MAX, add_cgroup_ctxsw, cst);
+		}
 
-	/*
-	 * No need to test the return code here: Not finding
-	 * the schedstat files shouldn't make pidstat stop.
-	 */
-	read_proc_pid_sched(pid, plist, tgid, curr);
-
-	if (DISPLAY_CMDLINE(pidflag) && !plist->cmdline[0]) {
-		if (read_proc_pid_cmdline(pid, plist, tgid))
-			return 1;
-	}
-
-	if (read_proc_pid_status(pid, plist, tgid, curr))
-		return 1;
-
-	if (DISPLAY_STACK(actflag)) {
-		if (read_proc_pid_smap(pid, plist, tgid, curr))
-			return 1;
-	}
-
-	if (DISPLAY_KTAB(actflag)) {
-		if (read_proc_pid_fd(pid, plist, tgid, curr))
-			return 1;
+		for (i = 0; i < depth; i++) {
+			cg_anc[i]->cstats[curr].nvcsw += cst->nvcsw;
+			cg_anc[i]->cstats[curr].nivcsw += cst->nivcsw;
+		}
 	}
 
-	if (DISPLAY_IO(actflag))
-		/* Assume that /proc/#/task/#/io exists! */
-		return (read_proc_pid_io(pid, plist, tgid, curr));
-
 	return 0;
 }
 
 /*
  ***************************************************************************
- * Read stats for threads in /proc/#/task directory.
+ * Read stats for cgroups (option --cgroup): Root cgroup first, then its
+ * descendants up to the max depth.
  *
  * IN:
- * @pid		Process number whose threads stats are to be read.
- * @plist	Pointer on the linked list where PID is saved.
  * @curr	Index in array for current sample statistics.
  ***************************************************************************
  */
-void read_task_stats(pid_t pid, struct st_pid *plist, int curr)
+void read_cgroup_list(int curr)
 {
-	DIR *dir;
-	pid_t tid;
-	struct dirent *drp;
-	char filename[128];
-	unsigned int thr_nr;
-	struct st_pid *tlist;
-
-	/* Open /proc/#/task directory */
-	sprintf(filename, PROC_TASK, pid);
-	if ((dir = __opendir(filename)) == NULL)
-		return;
-
-	while ((drp = __readdir(dir)) != NULL) {
-
-		if (!isdigit(drp->d_name[0])) {
-			continue;
-		}
-
-		tid = atoi(drp->d_name);
+	struct st_cgroup *cg;
 
-		tlist = add_list_pid(&pid_list, tid, pid);
-		if (!tlist)
-			continue;
-		tlist->exist = TRUE;
+	/* Every cgroup is potentially nonexistent */
+	for (cg = cg_list; cg != NULL; cg = cg->next) {
+		cg->exist = FALSE;
+	}
+	last_cg = NULL;
 
-		if (read_pid_stats(tid, tlist, &thr_nr, pid, curr)) {
-			/* Thread doesn't exist */
-			tlist->exist = FALSE;
-		}
+	if (cg_root && !read_cgroup_node(cg_root, "", 0, &curr) && cg_depth) {
+		walk_cgroup_dir(cg_root, "", 1, cg_depth, read_cgroup_node, &curr);
 	}
 
-	__closedir(dir);
+	/* Free unused cgroup structures */
+	sfree_cgroup(FALSE);
 }
 
 /*
  ***************************************************************************
  * Read various stats.
+ * Tasks whose stats are to be read are first saved in a list. Their stats
+ * are then read (possibly by several threads) and threads belonging to
+ * the processes are then looked for if option -t has been used.
  *
  * IN:
  * @curr	Index in array for current sample statistics.
@@ -969,7 +2471,7 @@ void read_task_stats(pid_t pid, struct st_pid *plist, int curr)
  */
 void read_stats(int curr)
 {
-	unsigned int thr_nr;
+	int i, nr = 0, pnr;
 	pid_t pid;
 	struct st_pid *plist;
 	struct stats_cpu *st_cpu;
@@ -996,6 +2498,12 @@ void read_stats(int curr)
 			    st_cpu->cpu_steal + st_cpu->cpu_softirq;
 	free(st_cpu);
 
+	if (DISPLAY_CGROUP(pidflag)) {
+		/* Read stats for cgroups instead of tasks */
+		read_cgroup_list(curr);
+		return;
+	}
+
 	if (DISPLAY_ALL_PID(pidflag)) {
 		DIR *dir;
 		struct dirent *drp;
@@ -1020,14 +2528,11 @@ void read_stats(int curr)
 				continue;
 			plist->exist = TRUE;
 
-			if (read_pid_stats(pid, plist, &thr_nr, 0, curr)) {
-				/* PID has terminated */
-				plist->exist = FALSE;
+			if (is_pid_filtered(pid, 0, plist, drp->d_ino))
+				/* Process is known not to be displayed */
+				continue;
 
-			} else if (DISPLAY_TID(pidflag)) {
-				/* Read stats for threads in task subdirectory */
-				read_task_stats(pid, plist, curr);
-			}
+			add_pid_work(nr++, pid, 0, plist);
 		}
 
 		/* Close /proc directory */
@@ -1044,23 +2549,49 @@ void read_stats(int curr)
 				 * The user can only enter PIDs on the command line.
 				 * If there is a TID then this is because the user has
 				 * used option -t, and the TID has been inserted in the
-				 * list by read_task_stats() function below.
+				 * list by add_task_work() function below.
 				 */
 				continue;
 
-			if (read_pid_stats(plist->pid, plist, &thr_nr, 0, curr)) {
-				/* PID has terminated */
-				plist->exist = FALSE;
-			}
-			else {
-				plist->exist = TRUE;
+			plist->exist = TRUE;
+			add_pid_work(nr++, plist->pid, 0, plist);
+		}
+	}
 
-				if (DISPLAY_TID(pidflag)) {
-					read_task_stats(plist->pid, plist, curr);
-				}
+	/* Read stats for processes */
+	read_pid_work(0, nr, curr);
+
+	if (DISPLAY_TID(pidflag)) {
+		/*
+		 * Read stats for threads in task subdirectory of existing processes.
+		 * Threads are appended to the list after the processes.
+		 */
+		pnr = nr;
+		for (i = 0; i < pnr; i++) {
+			if (pid_work[i].plist->exist &&
+			    !NO_PROC_MATCH(pid_work[i].plist->flags)) {
+				nr = add_task_work(pid_work[i].pid, nr, curr);
 			}
 		}
+		read_pid_work(pnr, nr, curr);
+	}
+
+#ifdef HAVE_LINUX_TASKSTATS_H
+	if (ts_exit_fd >= 0) {
+		/* Get stats of tasks which have exited since previous sample */
+		read_taskstats_exits(curr);
+	}
+#endif
+
+#ifdef TEST
+	/*
+	 * Test mode: Files from a different root directory are read at
+	 * each sample, so don't keep fds open from one sample to the next.
+	 */
+	for (plist = pid_list; plist != NULL; plist = plist->next) {
+		close_pid_fds(plist);
 	}
+#endif
 
 	/* Free unused PID structures */
 	sfree_pid(&pid_list, FALSE);
@@ -1094,9 +2625,6 @@ void read_stats(int curr)
 int get_pid_to_display(int prev, int curr, unsigned int activity, unsigned int pflag,
 		       struct st_pid *plist)
 {
-	int rc;
-	char *pc;
-	regex_t regex;
 	struct pid_stats *pstc = plist->pstats[curr], *pstp = plist->pstats[prev];
 
 	if (!plist->exist)
@@ -1108,6 +2636,14 @@ int get_pid_to_display(int prev, int curr, unsigned int activity, unsigned int p
 		plist->flags &= ~F_PID_DISPLAYED;
 	}
 
+	if (NO_COMM_MATCH(plist->flags) || NO_PROC_MATCH(plist->flags))
+		/*
+		 * Command name doesn't match string entered with option -C,
+		 * or process command name doesn't match string entered
+		 * with option -G.
+		 */
+		return -1;
+
 	if ((DISPLAY_ALL_PID(pidflag) || DISPLAY_TID(pidflag)) &&
 		DISPLAY_ACTIVE_PID(pidflag)) {
 		int isActive = FALSE;
@@ -1205,40 +2741,10 @@ int get_pid_to_display(int prev, int curr, unsigned int activity, unsigned int p
 			return -1;
 	}
 
-	if (COMMAND_STRING(pidflag)) {
-		if (regcomp(&regex, commstr, REG_EXTENDED | REG_NOSUB) != 0)
-			/* Error in preparing regex structure */
-			return -1;
-
-		pc = get_tcmd(plist);	/* Get pointer on task's command string */
-		rc = regexec(&regex, pc, 0, NULL, 0);
-		regfree(&regex);
-
-		if (rc)
-			/* regex pattern not found in command name */
-			return -1;
-	}
-
-	if (PROCESS_STRING(pidflag)) {
-		if (!plist->tgid) {
-			/* This PID is a process ("thread group leader") */
-			if (regcomp(&regex, procstr, REG_EXTENDED | REG_NOSUB) != 0)
-				/* Error in preparing regex structure */
-				return -1;
-
-			pc = get_tcmd(plist);	/* Get pointer on task's command string */
-			rc = regexec(&regex, pc, 0, NULL, 0);
-			regfree(&regex);
-
-			if (rc)
-				/* regex pattern not found in command name */
-				return -1;
-
-		}
-		else if (!IS_PID_DISPLAYED(plist->tgid->flags))
-			/* This pid is a thread and is not part of a process to display */
-			return -1;
-	}
+	if (PROCESS_STRING(pidflag) && plist->tgid &&
+	    !IS_PID_DISPLAYED(plist->tgid->flags))
+		/* This pid is a thread and is not part of a process to display */
+		return -1;
 
 	if (USER_STRING(pidflag)) {
 		struct passwd *pwdent;
@@ -3387,6 +4893,169 @@ int write_pid_rt_stats(int prev, int curr, int dis,
 	}
 }
 
+/*
+ ***************************************************************************
+ * Display statistics for cgroups (option --cgroup).
+ *
+ * IN:
+ * @prev	Index in array where stats used as reference are.
+ * @curr	Index in array for current sample statistics.
+ * @dis		TRUE if a header line must be printed.
+ * @disp_avg	TRUE if average stats are displayed.
+ * @prev_string	String displayed at the beginning of a header line. This is
+ * 		the timestamp of the previous sample, or "Average" when
+ * 		displaying average stats.
+ * @curr_string	String displayed at the beginning of current sample stats.
+ * 		This is the timestamp of the current sample, or "Average"
+ * 		when displaying average stats.
+ * @itv		Interval of time in 1/100th of a second.
+ *
+ * RETURNS:
+ * 0 if no cgroups have been displayed.
+ ***************************************************************************
+ */
+int write_cgroup_stats(int prev, int curr, int dis, int disp_avg,
+		       char *prev_string, char *curr_string,
+		       unsigned long long itv)
+{
+	struct st_cgroup *cg;
+	struct cgroup_stats *cstc, *cstp, cst0;
+	unsigned long long usec_itv;
+	double rbytes, wbytes;
+	int again = 0;
+
+	memset(&cst0, 0, CGROUP_STATS_SIZE);
+
+	/* Interval of time in microseconds */
+	usec_itv = itv * 10000;
+
+	if (DISPLAY_CPU(actflag)) {
+		if (dis) {
+			printf("\n%-11s", prev_string);
+			printf("    %%usr %%system    %%CPU  Cgroup\n");
+		}
+
+		for (cg = cg_list; cg != NULL; cg = cg->next) {
+			cstc = &(cg->cstats[curr]);
+			cstp = &(cg->cstats[prev]);
+			if (cstc->usage_usec < cstp->usage_usec) {
+				/* Cgroup has been removed then created again */
+				cstp = &cst0;
+			}
+
+			printf("%-11s", curr_string);
+			cprintf_xpc(DISPLAY_UNIT(pidflag), XHIGH, 3, 7, 2,
+				    SP_VALUE(cstp->user_usec, cstc->user_usec, usec_itv),
+				    SP_VALUE(cstp->system_usec, cstc->system_usec, usec_itv),
+				    IRIX_MODE_OFF(pidflag) ?
+				    SP_VALUE(cstp->usage_usec, cstc->usage_usec, usec_itv * cpu_nr) :
+				    SP_VALUE(cstp->usage_usec, cstc->usage_usec, usec_itv));
+			cprintf_s(IS_STR, "  %s\n", cg->name);
+			again = 1;
+		}
+	}
+
+	if (DISPLAY_MEM(actflag)) {
+		if (dis) {
+			printf("\n%-11s", prev_string);
+			printf("  minflt/s  majflt/s     MEM    ANON    FILE   %%MEM  Cgroup\n");
+		}
+
+		for (cg = cg_list; cg != NULL; cg = cg->next) {
+			cstc = &(cg->cstats[curr]);
+			cstp = &(cg->cstats[prev]);
+			if (cstc->pgfault < cstp->pgfault) {
+				cstp = &cst0;
+			}
+
+			printf("%-11s", curr_string);
+			cprintf_f(NO_UNIT, FALSE, 2, 9, 2,
+				  S_VALUE(cstp->pgfault - cstp->pgmajfault,
+					  cstc->pgfault - cstc->pgmajfault, itv),
+				  S_VALUE(cstp->pgmajfault, cstc->pgmajfault, itv));
+
+			if (disp_avg) {
+				cprintf_f(DISPLAY_UNIT(pidflag) ? UNIT_KILOBYTE : NO_UNIT, FALSE, 3, 7, 0,
+					  (double) cg->total_mem / cg->mem_asum_count,
+					  (double) cg->total_anon / cg->mem_asum_count,
+					  (double) cg->total_file / cg->mem_asum_count);
+				cprintf_xpc(DISPLAY_UNIT(pidflag), XHIGH, 1, 6, 2,
+					    tlmkb ?
+					    SP_VALUE(0, cg->total_mem / cg->mem_asum_count, tlmkb)
+					    : 0.0);
+			}
+			else {
+				/* This will be used to compute average */
+				cg->total_mem += cstc->mem_current;
+				cg->total_anon += cstc->anon;
+				cg->total_file += cstc->file;
+				cg->mem_asum_count += 1;
+
+				cprintf_u64(DISPLAY_UNIT(pidflag) ? UNIT_KILOBYTE : NO_UNIT, 3, 7,
+					    cstc->mem_current, cstc->anon, cstc->file);
+				cprintf_xpc(DISPLAY_UNIT(pidflag), XHIGH, 1, 6, 2,
+					    tlmkb ? SP_VALUE(0, cstc->mem_current, tlmkb) : 0.0);
+			}
+			cprintf_s(IS_STR, "  %s\n", cg->name);
+			again = 1;
+		}
+	}
+
+	if (DISPLAY_IO(actflag)) {
+		if (dis) {
+			printf("\n%-11s", prev_string);
+			printf("   kB_rd/s   kB_wr/s      rd/s      wr/s  Cgroup\n");
+		}
+
+		for (cg = cg_list; cg != NULL; cg = cg->next) {
+			cstc = &(cg->cstats[curr]);
+			cstp = &(cg->cstats[prev]);
+			if ((cstc->rbytes < cstp->rbytes) || (cstc->wbytes < cstp->wbytes)) {
+				cstp = &cst0;
+			}
+
+			printf("%-11s", curr_string);
+			rbytes = S_VALUE(cstp->rbytes, cstc->rbytes, itv);
+			wbytes = S_VALUE(cstp->wbytes, cstc->wbytes, itv);
+			if (!DISPLAY_UNIT(pidflag)) {
+				rbytes /= 1024;
+				wbytes /= 1024;
+			}
+			cprintf_f(DISPLAY_UNIT(pidflag) ? UNIT_BYTE : NO_UNIT, FALSE, 2, 9, 2,
+				  rbytes, wbytes);
+			cprintf_f(NO_UNIT, FALSE, 2, 9, 2,
+				  S_VALUE(cstp->rios, cstc->rios, itv),
+				  S_VALUE(cstp->wios, cstc->wios, itv));
+			cprintf_s(IS_STR, "  %s\n", cg->name);
+			again = 1;
+		}
+	}
+
+	if (DISPLAY_CTXSW(actflag)) {
+		if (dis) {
+			printf("\n%-11s", prev_string);
+			printf("   cswch/s nvcswch/s  Cgroup\n");
+		}
+
+		for (cg = cg_list; cg != NULL; cg = cg->next) {
+			cstc = &(cg->cstats[curr]);
+			cstp = &(cg->cstats[prev]);
+
+			/* Threads may have left the cgroup: Counters may decrease */
+			printf("%-11s", curr_string);
+			cprintf_f(NO_UNIT, FALSE, 2, 9, 2,
+				  cstc->nvcsw < cstp->nvcsw ? 0.0 :
+				  S_VALUE(cstp->nvcsw, cstc->nvcsw, itv),
+				  cstc->nivcsw < cstp->nivcsw ? 0.0 :
+				  S_VALUE(cstp->nivcsw, cstc->nivcsw, itv));
+			cprintf_s(IS_STR, "  %s\n", cg->name);
+			again = 1;
+		}
+	}
+
+	return again;
+}
+
 /*
  ***************************************************************************
  * Display statistics.
@@ -3425,9 +5094,13 @@ int write_stats_core(int prev, int curr, int dis, int disp_avg,
 		xprintf(tab, "\"timestamp\": \"%s\",", curr_string);
 	}
 
-	itv = get_interval(uptime_cs[prev], uptime_cs[curr]);
+	itv = get_interval_ns(uptime_ns[prev], uptime_ns[curr]);
 
-	if (DISPLAY_ONELINE(pidflag)) {
+	if (DISPLAY_CGROUP(pidflag)) {
+		again = write_cgroup_stats(prev, curr, dis, disp_avg,
+					   prev_string, curr_string, itv);
+	}
+	else if (DISPLAY_ONELINE(pidflag)) {
 		if (DISPLAY_TASK_STATS(tskflag)) {
 			again += write_pid_task_all_stats(prev, curr, dis,
 							  prev_string, curr_string,
@@ -3596,9 +5269,12 @@ void rw_pidstat_loop(int dis_hdr, int rows)
 	int again;
 	unsigned long lines = rows;
 	struct st_pid *plist;
+	struct st_cgroup *cg;
+	struct timespec deadline;
 
 	/* Read system uptime */
-	read_uptime(&uptime_cs[0]);
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+	read_uptime_ns(&uptime_ns[0]);
 	read_stats(0);
 
 	if (DISPLAY_MEM(actflag)) {
@@ -3616,21 +5292,16 @@ void rw_pidstat_loop(int dis_hdr, int rows)
 		goto terminate;
 	}
 
-	/* Set a handler for SIGALRM */
-	memset(&alrm_act, 0, sizeof(alrm_act));
-	alrm_act.sa_handler = alarm_handler;
-	sigaction(SIGALRM, &alrm_act, NULL);
-	if (interval) {
-		alarm(interval);
-	}
-
 	/* Save the first stats collected. Will be used to compute the average */
 	ps_tstamp[2] = ps_tstamp[0];
 	tot_jiffies[2] = tot_jiffies[0];
-	uptime_cs[2] = uptime_cs[0];
+	uptime_ns[2] = uptime_ns[0];
 	for (plist = pid_list; plist != NULL; plist = plist->next) {
 		memcpy(plist->pstats[2], plist->pstats[0], PID_STATS_SIZE);
 	}
+	for (cg = cg_list; cg != NULL; cg = cg->next) {
+		cg->cstats[2] = cg->cstats[0];
+	}
 
 	/* Set a handler for SIGINT and SIGTERM */
 	memset(&int_act, 0, sizeof(int_act));
@@ -3638,8 +5309,8 @@ void rw_pidstat_loop(int dis_hdr, int rows)
 	sigaction(SIGINT, &int_act, NULL);
 	sigaction(SIGTERM, &int_act, NULL);
 
-	/* Wait for SIGALRM (or possibly SIGINT) signal */
-	__pause();
+	/* Wait for next sampling deadline (or possibly SIGINT/SIGCHLD signal) */
+	__wait_deadline(&deadline, interval_ms);
 
 	if (signal_caught && interval)
 		/*
@@ -3655,8 +5326,8 @@ void rw_pidstat_loop(int dis_hdr, int rows)
 		/* Get time */
 		get_xtime(&ps_tstamp[curr], 0, LOCAL_TIME);
 
-		/* Read system uptime (in 1/100th of a second) */
-		read_uptime(&(uptime_cs[curr]));
+		/* Read system uptime (in nanoseconds) */
+		read_uptime_ns(&(uptime_ns[curr]));
 
 		/* Read stats */
 		read_stats(curr);
@@ -3681,7 +5352,7 @@ void rw_pidstat_loop(int dis_hdr, int rows)
 
 		if (count) {
 
-			__pause();
+			__wait_deadline(&deadline, interval_ms);
 
 			if (signal_caught) {
 				/*
@@ -3865,6 +5536,11 @@ int main(int argc, char **argv)
 			}
 		}
 
+		else if (!strcmp(argv[opt], "--taskstats")) {
+			pidflag |= P_F_TASKSTATS;
+			opt++;
+		}
+
 		else if (!strcmp(argv[opt], "--human")) {
 			pidflag |= P_D_UNIT;
 			opt++;
@@ -3891,6 +5567,35 @@ int main(int argc, char **argv)
 			opt++;
 		}
 
+		else if (!strncmp(argv[opt], "--cgroup", 8)) {
+			/* Display stats for cgroups */
+			pidflag |= P_D_CGROUP;
+			if (argv[opt][8] == '=') {
+				/* Get max depth of cgroups to display */
+				if (!argv[opt][9] ||
+				    (strspn(argv[opt] + 9, DIGITS) != strlen(argv[opt] + 9))) {
+					usage(argv[0]);
+				}
+				cg_depth = atoi(argv[opt] + 9);
+			}
+			else if (argv[opt][8]) {
+				usage(argv[0]);
+			}
+			opt++;
+		}
+
+		else if (!strncmp(argv[opt], "--workers=", 10)) {
+			/* Get number of threads used to read /proc */
+			if (strspn(argv[opt] + 10, DIGITS) != strlen(argv[opt] + 10)) {
+				usage(argv[0]);
+			}
+			workers_nr = atoi(argv[opt] + 10);
+			if ((workers_nr < 1) || (workers_nr > MAX_WORKERS)) {
+				usage(argv[0]);
+			}
+			opt++;
+		}
+
 		else if (!strcmp(argv[opt], "-T")) {
 			if (!argv[++opt]) {
 				usage(argv[0]);
@@ -4035,13 +5740,11 @@ int main(int argc, char **argv)
 		}
 
 		else if (interval < 0) {	/* Get interval */
-			if (strspn(argv[opt], DIGITS) != strlen(argv[opt])) {
-				usage(argv[0]);
-			}
-			interval = atol(argv[opt++]);
-			if (interval < 0) {
+			interval_ms = parse_interval(argv[opt++]);
+			if (interval_ms < 0) {
 				usage(argv[0]);
 			}
+			interval = (interval_ms + 999) / 1000;
 			count = -1;
 		}
 
@@ -4073,9 +5776,31 @@ int main(int argc, char **argv)
 		dis_hdr = 1;
 	}
 
+	/* Stats for cgroups cannot be displayed with these options */
+	if (DISPLAY_CGROUP(pidflag) &&
+	    (DISPLAY_PID(pidflag) || DISPLAY_TID(pidflag) || DISPLAY_ONELINE(pidflag) ||
+	     COMMAND_STRING(pidflag) || PROCESS_STRING(pidflag) || USER_STRING(pidflag) ||
+	     DISPLAY_CHILD_STATS(tskflag) || EXEC_PGM(pidflag) ||
+	     DISPLAY_JSON_OUTPUT(xflags))) {
+		usage(argv[0]);
+	}
+
 	/* Check flags and set default values */
 	check_flags();
 
+	if (DISPLAY_CGROUP(pidflag)) {
+		cg_root = get_cgroup_root();
+		SREALLOC(cg_anc, struct st_cgroup *, (size_t) (cg_depth + 1) * sizeof(struct st_cgroup *));
+	}
+
+	/* Prepare regex structures for strings entered with options -C and -G */
+	if ((COMMAND_STRING(pidflag) &&
+	     regcomp(&commregex, commstr, REG_EXTENDED | REG_NOSUB)) ||
+	    (PROCESS_STRING(pidflag) &&
+	     regcomp(&procregex, procstr, REG_EXTENDED | REG_NOSUB))) {
+		usage(argv[0]);
+	}
+
 	/* Count nb of proc */
 	cpu_nr = get_cpu_nr(~0, FALSE);
 
@@ -4114,11 +5839,28 @@ int main(int argc, char **argv)
 			 header.nodename, header.machine, cpu_nr,
 			 DISPLAY_JSON_OUTPUT(xflags));
 
+	/* Set max number of tasks for which fds can be kept open */
+	set_pid_fd_max();
+
+#ifdef HAVE_LINUX_TASKSTATS_H
+	if (USE_TASKSTATS(pidflag)) {
+		init_taskstats();
+	}
+#else
+	pidflag &= ~P_F_TASKSTATS;
+#endif
+
 	/* Main loop */
 	rw_pidstat_loop(dis_hdr, rows);
 
 	/* Free structures */
 	sfree_pid(&pid_list, TRUE);
+	sfree_cgroup(TRUE);
+	free(cg_anc);
+	free(pid_work);
+#ifdef HAVE_LINUX_TASKSTATS_H
+	close_taskstats();
+#endif
 
 	/*
 	 * @status contains the exit code of the child process monitored with option -e,
@@ -71,6 +71,8 @@
 #define P_D_UNIT	0x0800
 #define P_D_SEC_EPOCH	0x1000
 #define P_F_EXEC_PGM	0x2000
+#define P_F_TASKSTATS	0x4000
+#define P_D_CGROUP	0x8000
 
 #define DISPLAY_PID(m)		(((m) & P_D_PID) == P_D_PID)
 #define DISPLAY_ALL_PID(m)	(((m) & P_D_ALL_PID) == P_D_ALL_PID)
@@ -86,35 +88,75 @@
 #define DISPLAY_UNIT(m)		(((m) & P_D_UNIT) == P_D_UNIT)
 #define PRINT_SEC_EPOCH(m)	(((m) & P_D_SEC_EPOCH) == P_D_SEC_EPOCH)
 #define EXEC_PGM(m)		(((m) & P_F_EXEC_PGM) == P_F_EXEC_PGM)
+#define USE_TASKSTATS(m)	(((m) & P_F_TASKSTATS) == P_F_TASKSTATS)
+#define DISPLAY_CGROUP(m)	(((m) & P_D_CGROUP) == P_D_CGROUP)
 
 /* Per-process flags */
 #define F_NO_PID_IO	0x01
 #define F_NO_PID_FD	0x02
 #define F_PID_DISPLAYED	0x04
+#define F_NO_COMM_MATCH	0x08	/* Command doesn't match string entered with option -C */
+#define F_NO_PROC_MATCH	0x10	/* Process command doesn't match string entered with option -G */
+#define F_PID_SKIPPED	0x20	/* Stats not read during last sample */
 
 #define NO_PID_IO(m)		(((m) & F_NO_PID_IO) == F_NO_PID_IO)
 #define NO_PID_FD(m)		(((m) & F_NO_PID_FD) == F_NO_PID_FD)
 #define IS_PID_DISPLAYED(m)	(((m) & F_PID_DISPLAYED) == F_PID_DISPLAYED)
+#define NO_COMM_MATCH(m)	(((m) & F_NO_COMM_MATCH) == F_NO_COMM_MATCH)
+#define NO_PROC_MATCH(m)	(((m) & F_NO_PROC_MATCH) == F_NO_PROC_MATCH)
+#define IS_PID_SKIPPED(m)	(((m) & F_PID_SKIPPED) == F_PID_SKIPPED)
+
+/* Max number of threads used to read /proc (option --workers) */
+#define MAX_WORKERS		256
+/* Number of tasks given to a worker thread at a time */
+#define PID_WORK_CHUNK		32
+
+/* Number of fds not used to keep /proc files open */
+#define PID_FD_RESERVED		64
+
+/* Number of pagemap entries read at a time */
+#define PAGEMAP_CHUNK		512
+/* "Page present" bit in a pagemap entry */
+#define PM_PRESENT		(1ULL << 63)
+
+/* Size of buffers used to receive taskstats netlink messages */
+#define TS_MSG_SIZE		2048
+#define TS_EXIT_MSG_SIZE	4096
+/* Size of receive buffer of the socket getting stats of exiting tasks */
+#define TS_RCVBUF_SIZE		(1024 * 1024)
+
+/* Update a counter with a value from taskstats only if it is greater */
+#define TS_SET(f, v)	do {				\
+				if ((v) > (f)) {	\
+					(f) = (v);	\
+				}			\
+			} while (0)
+
+/* Default max depth of cgroups displayed with option --cgroup */
+#define CGROUP_DEPTH		3
+
+/* Initial number of buckets in PID hash table (must be a power of 2) */
+#define PID_HTAB_MIN_SIZE	256
 
 
 #define PROC		PRE "/proc"
 
-#define PID_STAT	PRE "/proc/%u/stat"
-#define PID_STATUS	PRE "/proc/%u/status"
-#define PID_IO		PRE "/proc/%u/io"
-#define PID_CMDLINE	PRE "/proc/%u/cmdline"
-#define PID_SMAP	PRE "/proc/%u/smaps"
-#define PID_FD		PRE "/proc/%u/fd"
-#define PID_SCHED	PRE "/proc/%u/schedstat"
+#define PID_DIR		PRE "/proc/%u"
 
 #define PROC_TASK	PRE "/proc/%u/task"
-#define TASK_STAT	PRE "/proc/%u/task/%u/stat"
-#define TASK_SCHED	PRE "/proc/%u/task/%u/schedstat"
-#define TASK_STATUS	PRE "/proc/%u/task/%u/status"
-#define TASK_IO		PRE "/proc/%u/task/%u/io"
-#define TASK_CMDLINE	PRE "/proc/%u/task/%u/cmdline"
-#define TASK_SMAP	PRE "/proc/%u/task/%u/smaps"
-#define TASK_FD		PRE "/proc/%u/task/%u/fd"
+#define TASK_DIR	PRE "/proc/%u/task/%u"
+
+#define TASK_DELAYACCT	PRE "/proc/sys/kernel/task_delayacct"
+#define CPU_POSSIBLE	PRE "/sys/devices/system/cpu/possible"
+
+#define PID_STATUS	PRE "/proc/%u/status"
+
+/* Flags used to open the /proc directory of a task */
+#ifdef O_PATH
+#define O_PIDDIR	(O_PATH | O_DIRECTORY | O_CLOEXEC)
+#else
+#define O_PIDDIR	(O_RDONLY | O_DIRECTORY | O_CLOEXEC)
+#endif
 
 #define PRINT_ID_HDR(_timestamp_, _flag_)	do {						\
 							printf("\n%-11s", _timestamp_);	\
@@ -200,9 +242,13 @@ struct st_pid {
 	unsigned long long total_stack_ref;
 	unsigned long long total_threads;
 	unsigned long long total_fd_nr;
+	unsigned long long start_time;	/* Task start time (used to detect PID reuse) */
+	ino_t		   ino;		/* Inode number of /proc/#[/task/##] directory (0 if unknown) */
 	pid_t		   pid;
 	uid_t		   uid;
 	int		   exist;	/* TRUE if PID exists */
+	int		   dirfd;	/* fd of /proc/#[/task/##] directory (-1 if not open) */
+	int		   statfd;	/* fd of /proc/#[/task/##]/stat file (-1 if not open) */
 	unsigned int	   flags;
 	unsigned int	   rt_asum_count;
 	unsigned int	   rc_asum_count;
@@ -213,8 +259,47 @@ struct st_pid {
 	struct pid_stats  *pstats[3];
 	struct st_pid	  *tgid;	/* If current task is a TID, pointer to its TGID. NULL otherwise. */
 	struct st_pid	  *next;
+	struct st_pid	  *hnext;	/* Next structure in the same hash table bucket */
 	char		   comm[MAX_COMM_LEN];
 	char		   cmdline[MAX_CMDLINE_LEN];
 };
 
+/* Task whose stats are to be read during current sample */
+struct pid_work {
+	struct st_pid	  *plist;
+	pid_t		   pid;
+	pid_t		   tgid;	/* != 0 if task is a TID */
+};
+
+/* Statistics for a cgroup (option --cgroup) */
+struct cgroup_stats {
+	unsigned long long usage_usec;
+	unsigned long long user_usec;
+	unsigned long long system_usec;
+	unsigned long long pgfault;
+	unsigned long long pgmajfault;
+	unsigned long long mem_current;	/* in kB */
+	unsigned long long anon;	/* in kB */
+	unsigned long long file;	/* in kB */
+	unsigned long long rbytes;
+	unsigned long long wbytes;
+	unsigned long long rios;
+	unsigned long long wios;
+	unsigned long long nvcsw;
+	unsigned long long nivcsw;
+};
+
+#define CGROUP_STATS_SIZE	(sizeof(struct cgroup_stats))
+
+struct st_cgroup {
+	unsigned long long total_mem;
+	unsigned long long total_anon;
+	unsigned long long total_file;
+	unsigned int	   mem_asum_count;
+	int		   exist;	/* TRUE if cgroup exists */
+	struct cgroup_stats cstats[3];
+	struct st_cgroup  *next;
+	char		  *name;	/* Path relative to cgroup root ("/" for root cgroup) */
+};
+
 #endif  /* _PIDSTAT_H */
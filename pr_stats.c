@@ -140,15 +140,19 @@ void print_hdr_line(char *p_timestamp, struct activity *a, int pos, int iwidth,
  * IN:
  * @a			Activity structure with statistics.
  * @cpu			CPU number (0 for CPU "all").
- * @deltot_jiffies	Interval in jiffies.
- * @scc			Current statistics sample.
- * @scp			Previous statistics sample.
+ * @cpc			Interval and percentages for each CPU.
  ***************************************************************************
  */
-void save_cpu_xstats(struct activity *a, int cpu, unsigned long long deltot_jiffies,
-		     struct stats_cpu *scc, struct stats_cpu *scp)
+void save_cpu_xstats(struct activity *a, int cpu, struct cpu_pc_values *cpc)
 {
-	if (!cpu && !deltot_jiffies) {
+	if (cpu && !cpc->itv[cpu])
+		/*
+		 * Percentages are not computed for a tickless CPU.
+		 * Don't save them, as was already the case when they were NaN.
+		 */
+		return;
+
+	if (!cpu && !cpc->itv[cpu]) {
 		int j, k;
 
 		/* Current CPU (which is not CPU "all") is tickless */
@@ -169,57 +173,35 @@ void save_cpu_xstats(struct activity *a, int cpu, unsigned long long deltot_jiff
 
 	if (DISPLAY_CPU_DEF(a->opt_flags)) {
 		/* %user */
-		save_minmax(a, cpu * a->xnr,
-			    ll_sp_value(scp->cpu_user, scc->cpu_user, deltot_jiffies));
+		save_minmax(a, cpu * a->xnr, CPU_PC(cpc, CPU_PC_USER, cpu));
 		/* %nice */
-		save_minmax(a, cpu * a->xnr + 1,
-			    ll_sp_value(scp->cpu_nice, scc->cpu_nice, deltot_jiffies));
+		save_minmax(a, cpu * a->xnr + 1, CPU_PC(cpc, CPU_PC_NICE_TOT, cpu));
 		/* %system */
-		save_minmax(a, cpu * a->xnr + 2,
-			    ll_sp_value(scp->cpu_sys + scp->cpu_hardirq + scp->cpu_softirq,
-					scc->cpu_sys + scc->cpu_hardirq + scc->cpu_softirq,
-		   deltot_jiffies));
+		save_minmax(a, cpu * a->xnr + 2, CPU_PC(cpc, CPU_PC_SYS_TOT, cpu));
 	}
 	else {  /* DISPLAY_CPU_ALL(a->opt_flags) */
 		/* %usr */
-		save_minmax(a, cpu * a->xnr,
-			    (scc->cpu_user - scc->cpu_guest) < (scp->cpu_user - scp->cpu_guest) ?
-			    0.0 :
-			    ll_sp_value(scp->cpu_user - scp->cpu_guest,
-					scc->cpu_user - scc->cpu_guest, deltot_jiffies));
+		save_minmax(a, cpu * a->xnr, CPU_PC(cpc, CPU_PC_USR, cpu));
 		/* %nice */
-		save_minmax(a, cpu * a->xnr + 1,
-			    (scc->cpu_nice - scc->cpu_guest_nice) < (scp->cpu_nice - scp->cpu_guest_nice) ?
-			    0.0 :
-			    ll_sp_value(scp->cpu_nice - scp->cpu_guest_nice,
-					scc->cpu_nice - scc->cpu_guest_nice, deltot_jiffies));
+		save_minmax(a, cpu * a->xnr + 1, CPU_PC(cpc, CPU_PC_NICE, cpu));
 		/* %sys */
-		save_minmax(a, cpu * a->xnr + 2,
-			    ll_sp_value(scp->cpu_sys, scc->cpu_sys, deltot_jiffies));
+		save_minmax(a, cpu * a->xnr + 2, CPU_PC(cpc, CPU_PC_SYS, cpu));
 		/* %irq */
-		save_minmax(a, cpu * a->xnr + 5,
-			    ll_sp_value(scp->cpu_hardirq, scc->cpu_hardirq, deltot_jiffies));
+		save_minmax(a, cpu * a->xnr + 5, CPU_PC(cpc, CPU_PC_IRQ, cpu));
 		/* %soft */
-		save_minmax(a, cpu * a->xnr + 6,
-			    ll_sp_value(scp->cpu_softirq, scc->cpu_softirq, deltot_jiffies));
+		save_minmax(a, cpu * a->xnr + 6, CPU_PC(cpc, CPU_PC_SOFT, cpu));
 		/* %guest */
-		save_minmax(a, cpu * a->xnr + 7,
-			    ll_sp_value(scp->cpu_guest, scc->cpu_guest, deltot_jiffies));
+		save_minmax(a, cpu * a->xnr + 7, CPU_PC(cpc, CPU_PC_GUEST, cpu));
 		/* %gnice */
-		save_minmax(a, cpu * a->xnr + 8,
-			    ll_sp_value(scp->cpu_guest_nice, scc->cpu_guest_nice, deltot_jiffies));
+		save_minmax(a, cpu * a->xnr + 8, CPU_PC(cpc, CPU_PC_GNICE, cpu));
 	}
 
 	/* %iowait */
-	save_minmax(a, cpu * a->xnr + 3,
-		    ll_sp_value(scp->cpu_iowait, scc->cpu_iowait, deltot_jiffies));
+	save_minmax(a, cpu * a->xnr + 3, CPU_PC(cpc, CPU_PC_IOWAIT, cpu));
 	/* %steal */
-	save_minmax(a, cpu * a->xnr + 4,
-		    ll_sp_value(scp->cpu_steal, scc->cpu_steal, deltot_jiffies));
+	save_minmax(a, cpu * a->xnr + 4, CPU_PC(cpc, CPU_PC_STEAL, cpu));
 	/* %idle */
-	save_minmax(a, cpu * a->xnr + 9,
-		    (scc->cpu_idle < scp->cpu_idle ? 0.0 :
-		    ll_sp_value(scp->cpu_idle, scc->cpu_idle, deltot_jiffies)));
+	save_minmax(a, cpu * a->xnr + 9, CPU_PC(cpc, CPU_PC_IDLE, cpu));
 }
 
 /*
@@ -229,13 +211,10 @@ void save_cpu_xstats(struct activity *a, int cpu, unsigned long long deltot_jiff
  * IN:
  * @a			Activity structure with statistics.
  * @cpu			CPU number (0 for CPU "all").
- * @deltot_jiffies	Interval in jiffies.
- * @scc			Current statistics sample.
- * @scp			Previous statistics sample.
+ * @cpc			Interval and percentages for each CPU.
  ***************************************************************************
  */
-void print_oneline_cpu_stats(struct activity *a, int cpu, unsigned long long deltot_jiffies,
-			     struct stats_cpu *scc, struct stats_cpu *scp)
+void print_oneline_cpu_stats(struct activity *a, int cpu, struct cpu_pc_values *cpc)
 {
 	if (cpu == 0) {
 		/* This is CPU "all" */
@@ -244,7 +223,7 @@ void print_oneline_cpu_stats(struct activity *a, int cpu, unsigned long long del
 	else {
 		cprintf_in(IS_INT, " %7d", "", cpu - 1);
 
-		if (!deltot_jiffies) {
+		if (!cpc->itv[cpu]) {
 			/*
 			 * If the CPU is tickless then there is no change in CPU values
 			 * but the sum of values is not zero.
@@ -272,41 +251,29 @@ void print_oneline_cpu_stats(struct activity *a, int cpu, unsigned long long del
 
 	if (DISPLAY_CPU_DEF(a->opt_flags)) {
 		cprintf_xpc(DISPLAY_UNIT(flags), XHIGH, 5, 9, 2,
-			    ll_sp_value(scp->cpu_user, scc->cpu_user, deltot_jiffies),
-			    ll_sp_value(scp->cpu_nice, scc->cpu_nice, deltot_jiffies),
-			    ll_sp_value(scp->cpu_sys + scp->cpu_hardirq + scp->cpu_softirq,
-					scc->cpu_sys + scc->cpu_hardirq + scc->cpu_softirq,
-					deltot_jiffies),
-			    ll_sp_value(scp->cpu_iowait, scc->cpu_iowait, deltot_jiffies),
-			    ll_sp_value(scp->cpu_steal, scc->cpu_steal, deltot_jiffies));
+			    CPU_PC(cpc, CPU_PC_USER, cpu),
+			    CPU_PC(cpc, CPU_PC_NICE_TOT, cpu),
+			    CPU_PC(cpc, CPU_PC_SYS_TOT, cpu),
+			    CPU_PC(cpc, CPU_PC_IOWAIT, cpu),
+			    CPU_PC(cpc, CPU_PC_STEAL, cpu));
 
 		cprintf_xpc(DISPLAY_UNIT(flags), XLOW, 1, 9, 2,
-			    scc->cpu_idle < scp->cpu_idle ?
-			    0.0 :
-			    ll_sp_value(scp->cpu_idle, scc->cpu_idle, deltot_jiffies));
+			    CPU_PC(cpc, CPU_PC_IDLE, cpu));
 	}
 	else { /* DISPLAY_CPU_ALL(a->opt_flags) */
 		cprintf_xpc(DISPLAY_UNIT(flags), XHIGH, 9, 9, 2,
-			    (scc->cpu_user - scc->cpu_guest) < (scp->cpu_user - scp->cpu_guest) ?
-			    0.0 :
-			    ll_sp_value(scp->cpu_user - scp->cpu_guest,
-					scc->cpu_user - scc->cpu_guest, deltot_jiffies),
-			    (scc->cpu_nice - scc->cpu_guest_nice) < (scp->cpu_nice - scp->cpu_guest_nice) ?
-			    0.0 :
-			    ll_sp_value(scp->cpu_nice - scp->cpu_guest_nice,
-					scc->cpu_nice - scc->cpu_guest_nice, deltot_jiffies),
-			    ll_sp_value(scp->cpu_sys, scc->cpu_sys, deltot_jiffies),
-			    ll_sp_value(scp->cpu_iowait, scc->cpu_iowait, deltot_jiffies),
-			    ll_sp_value(scp->cpu_steal, scc->cpu_steal, deltot_jiffies),
-			    ll_sp_value(scp->cpu_hardirq, scc->cpu_hardirq, deltot_jiffies),
-			    ll_sp_value(scp->cpu_softirq, scc->cpu_softirq, deltot_jiffies),
-			    ll_sp_value(scp->cpu_guest, scc->cpu_guest, deltot_jiffies),
-			    ll_sp_value(scp->cpu_guest_nice, scc->cpu_guest_nice, deltot_jiffies));
+			    CPU_PC(cpc, CPU_PC_USR, cpu),
+			    CPU_PC(cpc, CPU_PC_NICE, cpu),
+			    CPU_PC(cpc, CPU_PC_SYS, cpu),
+			    CPU_PC(cpc, CPU_PC_IOWAIT, cpu),
+			    CPU_PC(cpc, CPU_PC_STEAL, cpu),
+			    CPU_PC(cpc, CPU_PC_IRQ, cpu),
+			    CPU_PC(cpc, CPU_PC_SOFT, cpu),
+			    CPU_PC(cpc, CPU_PC_GUEST, cpu),
+			    CPU_PC(cpc, CPU_PC_GNICE, cpu));
 
 		cprintf_xpc(DISPLAY_UNIT(flags), XLOW, 1, 9, 2,
-			    scc->cpu_idle < scp->cpu_idle ?
-			    0.0 :
-			    ll_sp_value(scp->cpu_idle, scc->cpu_idle, deltot_jiffies));
+			    CPU_PC(cpc, CPU_PC_IDLE, cpu));
 	}
 	printf("\n");
 }
@@ -332,7 +299,7 @@ __print_funct_t print_cpu_stats(struct activity *a, int prev, int curr,
 {
 	int i;
 	unsigned long long deltot_jiffies = 1;
-	struct stats_cpu *scc, *scp;
+	struct cpu_pc_values *cpc;
 	unsigned char offline_cpu_bitmap[BITMAP_SIZE(NR_CPUS)] = {0};
 
 	if (xinit && a->nr_spalloc) {
@@ -372,6 +339,10 @@ __print_funct_t print_cpu_stats(struct activity *a, int prev, int curr,
 							   flags, offline_cpu_bitmap);
 	}
 
+	/* Compute interval and percentages for every CPU to display */
+	cpc = get_cpu_pc_statistics(a, prev, curr, deltot_jiffies,
+				    offline_cpu_bitmap);
+
 	/*
 	 * Now display CPU statistics (including CPU "all"),
 	 * except for offline CPU or CPU that the user doesn't want to see.
@@ -391,33 +362,11 @@ __print_funct_t print_cpu_stats(struct activity *a, int prev, int curr,
 			/* Don't display CPU */
 			continue;
 
-		scc = (struct stats_cpu *) ((char *) a->buf[curr] + i * a->msize);
-		scp = (struct stats_cpu *) ((char *) a->buf[prev] + i * a->msize);
-
-		if (i == 0) {
-			/* This is CPU "all" */
-			if (a->nr_ini == 1) {
-				/*
-				 * This is a UP machine. In this case
-				 * interval has still not been calculated.
-				 */
-				deltot_jiffies = get_per_cpu_interval(scc, scp);
-			}
-			if (!deltot_jiffies) {
-				/* CPU "all" cannot be tickless */
-				deltot_jiffies = 1;
-			}
-		}
-		else {
-			/* Recalculate interval for current proc */
-			deltot_jiffies = get_per_cpu_interval(scc, scp);
-		}
-
 		/* Check if min and max values should be displayed */
 		if (DISPLAY_MINMAX(flags)) {
 			if (prev != 2) {
 				/* Save min and max values */
-				save_cpu_xstats(a, i, deltot_jiffies, scc, scp);
+				save_cpu_xstats(a, i, cpc);
 			}
 			else if ((*(a->spmin + i * a->xnr) != DBL_MAX) &&
 				 (*(a->spmax + i * a->xnr) != -DBL_MAX)) {
@@ -438,7 +387,7 @@ __print_funct_t print_cpu_stats(struct activity *a, int prev, int curr,
 		printf("%-11s", timestamp[curr]);
 
 		/* Print CPU stats */
-		print_oneline_cpu_stats(a, i, deltot_jiffies, scc, scp);
+		print_oneline_cpu_stats(a, i, cpc);
 	}
 }
 
@@ -503,10 +452,10 @@ __print_funct_t print_pcsw_stats(struct activity *a, int prev, int curr,
 __print_funct_t print_irq_stats(struct activity *a, int prev, int curr,
 				unsigned long long itv)
 {
-	int c, i;
-	struct stats_irq *stc_cpu_irq, *stp_cpu_irq, *stc_cpuall_irq, *stp_cpuall_irq;
+	int c, i, nr;
+	struct stats_irq *stc_cpuall_irq, *stp_cpuall_irq;
 	unsigned char masked_cpu_bitmap[BITMAP_SIZE(NR_CPUS)] = {0};
-	double val;
+	double *rates, val;
 
 	if (xinit && a->nr_spalloc) {
 		/*
@@ -532,6 +481,10 @@ __print_funct_t print_irq_stats(struct activity *a, int prev, int curr,
 	/* Identify offline and unselected CPU, and keep persistent statistics values */
 	get_global_int_statistics(a, prev, curr, flags, masked_cpu_bitmap);
 
+	/* Compute all the values in one pass over the buffers */
+	nr = MINIMUM(a->nr[curr], a->bitmap->b_size + 1);
+	rates = get_irq_rates(a, prev, curr, itv, nr);
+
 	/*
 	 * Always display header line. The columns may vary if e.g. a CPU goes offline
 	 * and/or comes back online.
@@ -574,29 +527,14 @@ __print_funct_t print_irq_stats(struct activity *a, int prev, int curr,
 			cprintf_in(IS_STR, " %9s", stc_cpuall_irq->irq_name, 0);
 		}
 
-		for (c = 0; (c < a->nr[curr]) && (c < a->bitmap->b_size + 1); c++) {
-
-			stc_cpu_irq = (struct stats_irq *) ((char *) a->buf[curr] + c * a->msize * a->nr2
-										  + i * a->msize);
-			stp_cpu_irq = (struct stats_irq *) ((char *) a->buf[prev] + c * a->msize * a->nr2
-										  + i * a->msize);
+		for (c = 0; c < nr; c++) {
 
 			/* Should current CPU (including CPU "all") be displayed? */
 			if (IS_CPU_SET(masked_cpu_bitmap, c))
 				/* No */
 				continue;
 
-			if (!c && (stc_cpu_irq->irq_nr < stp_cpu_irq->irq_nr)) {
-				/*
-				 * Total number among all CPU for a given interrupt may decrease if
-				 * a CPU has gone offline. In this case we display "0.00" instead of
-				 * the huge number that would appear otherwise.
-				 */
-				val = 0.0;
-			}
-			else {
-				val = S_VALUE(stp_cpu_irq->irq_nr, stc_cpu_irq->irq_nr, itv);
-			}
+			val = rates[i * nr + c];
 			cprintf_f(NO_UNIT, FALSE, 1, 9, 2, val);
 			if (DISPLAY_MINMAX(flags) && (prev != 2)) {
 				/* Save min and max values */
@@ -4902,3 +4840,231 @@ __print_funct_t print_avg_pwr_bat_stats(struct activity *a, int prev, int curr,
 {
 	stub_print_pwr_bat_stats(a, prev, curr, TRUE, itv);
 }
+
+/*
+ ***************************************************************************
+ * Display cgroups statistics.
+ *
+ * IN:
+ * @a		Activity structure with statistics.
+ * @prev	Index in array where stats used as reference are.
+ * @curr	Index in array for current sample statistics.
+ * @itv		Interval of time in 1/100th of a second.
+ ***************************************************************************
+ */
+__print_funct_t print_cgroup_stats(struct activity *a, int prev, int curr,
+				   unsigned long long itv)
+{
+	int i, j;
+	struct stats_cgroup *scc, *scp, sczero;
+	int unit = NO_UNIT;
+	int g_fields[] = {2, 0, 1, 3, -1, 5, 6, 7, 8};
+	unsigned int local_types_nr[] = {9, 0, 0};
+
+	if (xinit && a->nr_spalloc) {
+		/*
+		 * Init min and max values.
+		 * Used only when reading from a file: Init happens when there is a
+		 * LINUX RESTART message in file. The min and max values are those for
+		 * the statistics located between two LINUX RESTART messages.
+		 */
+		init_extrema_values(a, a->nr_spalloc * a->xnr);
+	}
+	memset(&sczero, 0, STATS_CGROUP_SIZE);
+
+	if (DISPLAY_UNIT(flags)) {
+		/* Default values unit is bytes */
+		unit = UNIT_BYTE;
+	}
+
+	if ((dish || DISPLAY_ZERO_OMIT(flags)) &&
+	    !((prev == 2) && DISPLAY_MINMAX(flags))) {
+		print_hdr_line(timestamp[!curr], a, FIRST, -1, 9, NULL);
+	}
+
+	for (i = 0; i < a->nr[curr]; i++) {
+		scc = (struct stats_cgroup *) ((char *) a->buf[curr] + i * a->msize);
+
+		if (a->item_list != NULL) {
+			/* A list of cgroups has been entered on the command line */
+			if (!search_list_item(a->item_list, scc->cgroup_name))
+				/* Cgroup not found */
+				continue;
+		}
+
+		if (!WANT_SINCE_BOOT(flags)) {
+			j = check_cgroup_reg(a, curr, prev, i);
+		}
+		else {
+			j = -1;
+		}
+		if (j < 0) {
+			/*
+			 * This is a newly created cgroup or we want stats since boot time.
+			 * Previous stats are zero.
+			 */
+			scp = &sczero;
+		}
+		else {
+			scp = (struct stats_cgroup *) ((char *) a->buf[prev] + j * a->msize);
+		}
+
+		if (DISPLAY_ZERO_OMIT(flags) && !memcmp(scp, scc, STATS_CGROUP_SIZE2CMP))
+			continue;
+
+		/* Check if min and max values should be displayed */
+		if (DISPLAY_MINMAX(flags)) {
+			int k, pos;
+
+			/* Look for item in list or add it to the list if non existent */
+			add_list_item(&(a->xdev_list), scc->cgroup_name, MAX_CG_LEN, &k);
+			pos = k * a->xnr;
+			if (k >= a->nr_spalloc) {
+				/* Reallocate buffers for min/max values if necessary */
+				reallocate_minmax_buf(a, k, flags);
+			}
+
+			if (prev != 2) {
+				/* Save min and max values */
+				save_extrema(local_types_nr, (void *) scc, (void *) scp,
+					     itv, a->spmin + pos, a->spmax + pos, g_fields);
+
+				/* Save min and max values for memory used by the cgroup */
+				save_minmax(a, pos + 4, (double) scc->mem_current);
+			}
+			else {
+				/* Display min and max values */
+				print_hdr_line(timestamp[!curr], a, FIRST, -1, 9, NULL);
+				print_cgroup_xstats(H_MIN, unit, scc->cgroup_name,
+						    a->spmin + pos);
+				print_cgroup_xstats(H_MAX, unit, scc->cgroup_name,
+						    a->spmax + pos);
+			}
+		}
+
+		printf("%-11s", timestamp[curr]);
+
+		/* Values in usec per second are converted to percentages */
+		cprintf_xpc(DISPLAY_UNIT(flags), FALSE, 4, 9, 2,
+			   S_VALUE(scp->user_usec,      scc->user_usec,      itv) / 10000,
+			   S_VALUE(scp->system_usec,    scc->system_usec,    itv) / 10000,
+			   S_VALUE(scp->usage_usec,     scc->usage_usec,     itv) / 10000,
+			   S_VALUE(scp->throttled_usec, scc->throttled_usec, itv) / 10000);
+		cprintf_u64(unit < 0 ? NO_UNIT : UNIT_KILOBYTE, 1, 9, scc->mem_current);
+		cprintf_f(unit, FALSE, 2, 9, 2,
+			  S_VALUE(scp->rbytes, scc->rbytes, itv) / (unit < 0 ? 1024 : 1),
+			  S_VALUE(scp->wbytes, scc->wbytes, itv) / (unit < 0 ? 1024 : 1));
+		cprintf_f(NO_UNIT, FALSE, 2, 9, 2,
+			  S_VALUE(scp->rios, scc->rios, itv),
+			  S_VALUE(scp->wios, scc->wios, itv));
+		cprintf_in(IS_STR, " %s", scc->cgroup_name, 0);
+		printf("\n");
+	}
+}
+
+/*
+ ***************************************************************************
+ * Display cgroups pressure-stall statistics.
+ *
+ * IN:
+ * @a		Activity structure with statistics.
+ * @prev	Index in array where stats used as reference are.
+ * @curr	Index in array for current sample statistics.
+ * @itv		Interval of time in 1/100th of a second.
+ ***************************************************************************
+ */
+__print_funct_t print_psi_cgroup_stats(struct activity *a, int prev, int curr,
+				       unsigned long long itv)
+{
+	int i, j;
+	struct stats_psi_cgroup *spcc, *spcp, spczero;
+	int g_fields[] = {0, 1, 2, 3, 4, 5};
+	unsigned int local_types_nr[] = {6, 0, 0};
+
+	if (xinit && a->nr_spalloc) {
+		/*
+		 * Init min and max values.
+		 * Used only when reading from a file: Init happens when there is a
+		 * LINUX RESTART message in file. The min and max values are those for
+		 * the statistics located between two LINUX RESTART messages.
+		 */
+		init_extrema_values(a, a->nr_spalloc * a->xnr);
+	}
+	memset(&spczero, 0, STATS_PSI_CGROUP_SIZE);
+
+	if ((dish || DISPLAY_ZERO_OMIT(flags)) &&
+	    !((prev == 2) && DISPLAY_MINMAX(flags))) {
+		print_hdr_line(timestamp[!curr], a, FIRST, -1, 9, NULL);
+	}
+
+	for (i = 0; i < a->nr[curr]; i++) {
+		spcc = (struct stats_psi_cgroup *) ((char *) a->buf[curr] + i * a->msize);
+
+		if (a->item_list != NULL) {
+			/* A list of cgroups has been entered on the command line */
+			if (!search_list_item(a->item_list, spcc->cgroup_name))
+				/* Cgroup not found */
+				continue;
+		}
+
+		if (!WANT_SINCE_BOOT(flags)) {
+			j = check_psi_cgroup_reg(a, curr, prev, i);
+		}
+		else {
+			j = -1;
+		}
+		if (j < 0) {
+			/*
+			 * This is a newly created cgroup or we want stats since boot time.
+			 * Previous stats are zero.
+			 */
+			spcp = &spczero;
+		}
+		else {
+			spcp = (struct stats_psi_cgroup *) ((char *) a->buf[prev] + j * a->msize);
+		}
+
+		if (DISPLAY_ZERO_OMIT(flags) &&
+		    !memcmp(spcp, spcc, STATS_PSI_CGROUP_ULL * sizeof(unsigned long long)))
+			/* Skip cgroup if it has not stalled on the interval */
+			continue;
+
+		/* Check if min and max values should be displayed */
+		if (DISPLAY_MINMAX(flags)) {
+			int k, pos;
+
+			/* Look for item in list or add it to the list if non existent */
+			add_list_item(&(a->xdev_list), spcc->cgroup_name, MAX_CG_LEN, &k);
+			pos = k * a->xnr;
+			if (k >= a->nr_spalloc) {
+				/* Reallocate buffers for min/max values if necessary */
+				reallocate_minmax_buf(a, k, flags);
+			}
+
+			if (prev != 2) {
+				/* Save min and max values */
+				save_extrema(local_types_nr, (void *) spcc, (void *) spcp,
+					     itv, a->spmin + pos, a->spmax + pos, g_fields);
+			}
+			else {
+				/* Display min and max values */
+				print_hdr_line(timestamp[!curr], a, FIRST, -1, 9, NULL);
+				print_psi_cgroup_xstats(H_MIN, spcc->cgroup_name, a->spmin + pos);
+				print_psi_cgroup_xstats(H_MAX, spcc->cgroup_name, a->spmax + pos);
+			}
+		}
+
+		printf("%-11s", timestamp[curr]);
+
+		/* Stall times in usec per second are converted to percentages */
+		cprintf_xpc(DISPLAY_UNIT(flags), XHIGH, 6, 9, 2,
+			    S_VALUE(spcp->some_cpu_total, spcc->some_cpu_total, itv) / 10000,
+			    S_VALUE(spcp->full_cpu_total, spcc->full_cpu_total, itv) / 10000,
+			    S_VALUE(spcp->some_io_total,  spcc->some_io_total,  itv) / 10000,
+			    S_VALUE(spcp->full_io_total,  spcc->full_io_total,  itv) / 10000,
+			    S_VALUE(spcp->some_mem_total, spcc->some_mem_total, itv) / 10000,
+			    S_VALUE(spcp->full_mem_total, spcc->full_mem_total, itv) / 10000);
+		cprintf_in(IS_STR, " %s", spcc->cgroup_name, 0);
+		printf("\n");
+	}
+}
@@ -102,6 +102,10 @@ __print_funct_t print_psimem_stats
 	(struct activity *, int, int, unsigned long long);
 __print_funct_t print_pwr_bat_stats
 	(struct activity *, int, int, unsigned long long);
+__print_funct_t print_cgroup_stats
+	(struct activity *, int, int, unsigned long long);
+__print_funct_t print_psi_cgroup_stats
+	(struct activity *, int, int, unsigned long long);
 
 /* Functions used to display average statistics */
 __print_funct_t print_avg_memory_stats
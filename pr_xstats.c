@@ -634,3 +634,56 @@ void print_pwr_bat_xstats(int ismax, char *name, double *spextr)
 
 	printf("\n");
 }
+
+/*
+ * **************************************************************************
+ * Display min or max values for cgroups statistics.
+ *
+ * IN:
+ * @ismax	TRUE: Display max header - FALSE: Display min header.
+ * @unit	Unit used to display values.
+ * @name	Cgroup name.
+ * @spextr	Pointer on array with min or max values.
+ ***************************************************************************
+ */
+void print_cgroup_xstats(int ismax, int unit, char *name, double *spextr)
+{
+	/* Print min / max header */
+	print_minmax(ismax);
+
+	cprintf_xpc(DISPLAY_UNIT(flags), FALSE, 4, 9, 2,
+		    *spextr / 10000, *(spextr + 1) / 10000,
+		    *(spextr + 2) / 10000, *(spextr + 3) / 10000);
+	cprintf_f(unit < 0 ? NO_UNIT : UNIT_KILOBYTE, FALSE, 1, 9, 0, *(spextr + 4));
+	cprintf_f(unit, FALSE, 2, 9, 2,
+		  unit < 0 ? *(spextr + 5) / 1024 : *(spextr + 5),
+		  unit < 0 ? *(spextr + 6) / 1024 : *(spextr + 6));
+	cprintf_f(NO_UNIT, FALSE, 2, 9, 2, *(spextr + 7), *(spextr + 8));
+	cprintf_in(IS_STR, " %s", name, 0);
+
+	printf("\n");
+}
+
+/*
+ * **************************************************************************
+ * Display min or max values for cgroups pressure-stall statistics.
+ *
+ * IN:
+ * @ismax	TRUE: Display max header - FALSE: Display min header.
+ * @name	Cgroup name.
+ * @spextr	Pointer on array with min or max values.
+ ***************************************************************************
+ */
+void print_psi_cgroup_xstats(int ismax, char *name, double *spextr)
+{
+	/* Print min / max header */
+	print_minmax(ismax);
+
+	cprintf_xpc(DISPLAY_UNIT(flags), XHIGH, 6, 9, 2,
+		    *spextr / 10000, *(spextr + 1) / 10000,
+		    *(spextr + 2) / 10000, *(spextr + 3) / 10000,
+		    *(spextr + 4) / 10000, *(spextr + 5) / 10000);
+	cprintf_in(IS_STR, " %s", name, 0);
+
+	printf("\n");
+}
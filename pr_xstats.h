@@ -56,5 +56,9 @@ void print_psi_xstats
 	(int, int, double *);
 void print_pwr_bat_xstats
 	(int, char *, double *);
+void print_cgroup_xstats
+	(int, int, char *, double *);
+void print_psi_cgroup_xstats
+	(int, char *, double *);
 
 #endif /* _PR_XSTATS_H */
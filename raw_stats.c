@@ -1860,3 +1860,124 @@ __print_funct_t raw_print_pwr_bat_stats(struct activity *a, char *timestr, int c
 		printf(";\n");
 	}
 }
+
+/*
+ ***************************************************************************
+ * Display cgroups statistics in raw format.
+ *
+ * IN:
+ * @a		Activity structure with statistics.
+ * @timestr	Time for current statistics sample.
+ * @curr	Index in array for current sample statistics.
+ ***************************************************************************
+ */
+__print_funct_t raw_print_cgroup_stats(struct activity *a, char *timestr, int curr)
+{
+	int i, j;
+	struct stats_cgroup *scc, *scp, sczero;
+
+	memset(&sczero, 0, STATS_CGROUP_SIZE);
+
+	for (i = 0; i < a->nr[curr]; i++) {
+
+		scc = (struct stats_cgroup *) ((char *) a->buf[curr] + i * a->msize);
+
+		if (a->item_list != NULL) {
+			/* A list of cgroups has been entered on the command line */
+			if (!search_list_item(a->item_list, scc->cgroup_name))
+				/* Cgroup not found */
+				continue;
+		}
+
+		printf("%s; %s", timestr, pfield(a->hdr_line, FIRST));
+		j = check_cgroup_reg(a, curr, !curr, i);
+		if (j < 0) {
+			/* This is a newly created cgroup. Previous stats are zero */
+			scp = &sczero;
+			if (DISPLAY_DEBUG_MODE(flags)) {
+				cprintf_s(IS_DEBUG, "%s",  j == -1 ? " [NEW]" : " [BCK]");
+			}
+		}
+		else {
+			scp = (struct stats_cgroup *) ((char *) a->buf[!curr] + j * a->msize);
+		}
+		printf("; %s;", scc->cgroup_name);
+
+		printf(" %s", pfield(NULL, 0));
+		pval(scp->user_usec, scc->user_usec);
+		printf(" %s", pfield(NULL, 0));
+		pval(scp->system_usec, scc->system_usec);
+		printf(" %s", pfield(NULL, 0));
+		pval(scp->usage_usec, scc->usage_usec);
+		printf(" %s", pfield(NULL, 0));
+		pval(scp->throttled_usec, scc->throttled_usec);
+		printf(" %s; %llu;", pfield(NULL, 0), scc->mem_current);
+		printf(" %s", pfield(NULL, 0));
+		pval(scp->rbytes, scc->rbytes);
+		printf(" %s", pfield(NULL, 0));
+		pval(scp->wbytes, scc->wbytes);
+		printf(" %s", pfield(NULL, 0));
+		pval(scp->rios, scc->rios);
+		printf(" %s", pfield(NULL, 0));
+		pval(scp->wios, scc->wios);
+		printf("\n");
+	}
+}
+
+/*
+ ***************************************************************************
+ * Display cgroups pressure-stall statistics in raw format.
+ *
+ * IN:
+ * @a		Activity structure with statistics.
+ * @timestr	Time for current statistics sample.
+ * @curr	Index in array for current sample statistics.
+ ***************************************************************************
+ */
+__print_funct_t raw_print_psi_cgroup_stats(struct activity *a, char *timestr, int curr)
+{
+	int i, j;
+	struct stats_psi_cgroup *spcc, *spcp, spczero;
+
+	memset(&spczero, 0, STATS_PSI_CGROUP_SIZE);
+
+	for (i = 0; i < a->nr[curr]; i++) {
+
+		spcc = (struct stats_psi_cgroup *) ((char *) a->buf[curr] + i * a->msize);
+
+		if (a->item_list != NULL) {
+			/* A list of cgroups has been entered on the command line */
+			if (!search_list_item(a->item_list, spcc->cgroup_name))
+				/* Cgroup not found */
+				continue;
+		}
+
+		printf("%s; %s", timestr, pfield(a->hdr_line, FIRST));
+		j = check_psi_cgroup_reg(a, curr, !curr, i);
+		if (j < 0) {
+			/* This is a newly created cgroup. Previous stats are zero */
+			spcp = &spczero;
+			if (DISPLAY_DEBUG_MODE(flags)) {
+				cprintf_s(IS_DEBUG, "%s",  j == -1 ? " [NEW]" : " [BCK]");
+			}
+		}
+		else {
+			spcp = (struct stats_psi_cgroup *) ((char *) a->buf[!curr] + j * a->msize);
+		}
+		printf("; %s;", spcc->cgroup_name);
+
+		printf(" %s", pfield(NULL, 0));
+		pval(spcp->some_cpu_total, spcc->some_cpu_total);
+		printf(" %s", pfield(NULL, 0));
+		pval(spcp->full_cpu_total, spcc->full_cpu_total);
+		printf(" %s", pfield(NULL, 0));
+		pval(spcp->some_io_total, spcc->some_io_total);
+		printf(" %s", pfield(NULL, 0));
+		pval(spcp->full_io_total, spcc->full_io_total);
+		printf(" %s", pfield(NULL, 0));
+		pval(spcp->some_mem_total, spcc->some_mem_total);
+		printf(" %s", pfield(NULL, 0));
+		pval(spcp->full_mem_total, spcc->full_mem_total);
+		printf("\n");
+	}
+}
@@ -100,5 +100,9 @@ __print_funct_t raw_print_psimem_stats
 	(struct activity *, char *, int);
 __print_funct_t raw_print_pwr_bat_stats
 	(struct activity *, char *, int);
+__print_funct_t raw_print_cgroup_stats
+	(struct activity *, char *, int);
+__print_funct_t raw_print_psi_cgroup_stats
+	(struct activity *, char *, int);
 
 #endif /* _RAW_STATS_H */
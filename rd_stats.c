@@ -41,6 +41,17 @@
 #define _(string) (string)
 #endif
 
+#ifdef SOURCE_SADC
+/* Array where statistics for cgroups are saved while walking the hierarchy */
+struct cgroup_array {
+	void	*st;
+	size_t	 st_size;
+	__nr_t	 nr_alloc;
+	__nr_t	 nr_read;
+	int	 (*f_read) (void *, const char *, const char *);
+};
+#endif
+
 /* Generic PSI structure */
 struct stats_psi {
 	unsigned long long total;
@@ -541,6 +552,34 @@ void read_uptime(unsigned long long *uptime)
 	}
 }
 
+/*
+ ***************************************************************************
+ * Read machine uptime with a nanosecond resolution. CLOCK_BOOTTIME is the
+ * clock behind /proc/uptime, so that values read here can be compared with
+ * those read by read_uptime() or with task start times.
+ *
+ * OUT:
+ * @uptime	Uptime value in nanoseconds.
+ *
+ * USED BY:
+ * sadc, iostat, mpstat, pidstat
+ ***************************************************************************
+ */
+void read_uptime_ns(unsigned long long *uptime)
+{
+	struct timespec ts;
+
+	if (!__clock_gettime(CLOCK_BOOTTIME, &ts)) {
+		*uptime = (unsigned long long) ts.tv_sec * 1000000000ULL +
+			  (unsigned long long) ts.tv_nsec;
+		return;
+	}
+
+	/* Clock not available: Use /proc/uptime */
+	read_uptime(uptime);
+	*uptime *= NSEC_PER_CS;
+}
+
 /*
  ***************************************************************************
  * Compute "extended" device statistics (service time, etc.).
@@ -679,6 +718,301 @@ unsigned long long get_per_cpu_interval(struct stats_cpu *scc,
 	return interval + ishift;
 }
 
+/*
+ ***************************************************************************
+ * Compute a CPU percentage the same way as ll_sp_value() does (the latter
+ * is not available to sadc, which is also linked with this file).
+ *
+ * IN:
+ * @prev	Previous value of the counter.
+ * @curr	Current value of the counter.
+ * @itv		Interval of time, expressed in jiffies.
+ *
+ * RETURNS:
+ * Percentage value, or 0 if the counter went backwards.
+ ***************************************************************************
+ */
+static inline double get_cpu_pc_value(unsigned long long prev, unsigned long long curr,
+				      unsigned long long itv)
+{
+	return (curr < prev) ? 0.0 : SP_VALUE(prev, curr, itv);
+}
+
+/*
+ ***************************************************************************
+ * Compute CPU percentages for a set of CPU.
+ * Only CPU which are selected and online are considered, so that the
+ * previous statistics of the other CPU are left untouched.
+ *
+ * IN:
+ * @cpc		Structure where buffers are allocated.
+ * @scc		Current sample statistics (array of @nr structures,
+ *		including CPU "all").
+ * @scp		Previous sample statistics (same).
+ * @size	Size of a structure in arrays (may be different from
+ *		sizeof(struct stats_cpu) when data are read from a file).
+ * @nr		Number of CPU (including CPU "all").
+ * @itv0	Interval of time to use for CPU "all".
+ * @cpu_bitmap	Bitmap of CPU selected by the user.
+ * @offline_cpu_bitmap
+ *		Bitmap of offline CPU.
+ *
+ * OUT:
+ * @cpc		Interval and percentages for each CPU. Percentages are
+ *		available with CPU_PC(). Interval is 0 for a tickless CPU
+ *		or a CPU which is not considered, and its percentages are
+ *		then not computed.
+ *
+ * USED BY:
+ * sar, sadf, mpstat
+ ***************************************************************************
+ */
+void compute_cpu_pc_values(struct cpu_pc_values *cpc, void *scc, void *scp,
+			   size_t size, int nr, unsigned long long itv0,
+			   const unsigned char cpu_bitmap[],
+			   const unsigned char offline_cpu_bitmap[])
+{
+	int i;
+	struct stats_cpu *c, *p;
+	unsigned long long itv;
+	double *pc;
+
+	if (nr > cpc->nr_alloc) {
+		SREALLOC(cpc->pc, double, sizeof(double) * NR_CPU_PC * nr);
+		SREALLOC(cpc->itv, unsigned long long, sizeof(unsigned long long) * nr);
+		cpc->nr_alloc = nr;
+	}
+
+	for (i = 0; i < nr; i++) {
+		cpc->itv[i] = 0;
+
+		if (!IS_CPU_SELECTED(cpu_bitmap, i) ||
+		    IS_CPU_OFFLINE(offline_cpu_bitmap, i))
+			continue;
+
+		c = (struct stats_cpu *) ((char *) scc + i * size);
+		p = (struct stats_cpu *) ((char *) scp + i * size);
+
+		/* Note: Previous idle and iowait values may be modified here */
+		itv = i ? get_per_cpu_interval(c, p) : itv0;
+		if (!itv)
+			/* CPU is tickless */
+			continue;
+
+		cpc->itv[i] = itv;
+		pc = cpc->pc + i * NR_CPU_PC;
+
+		pc[CPU_PC_USR]	    = get_cpu_pc_value(p->cpu_user - p->cpu_guest,
+						       c->cpu_user - c->cpu_guest, itv);
+		pc[CPU_PC_NICE]	    = get_cpu_pc_value(p->cpu_nice - p->cpu_guest_nice,
+						       c->cpu_nice - c->cpu_guest_nice, itv);
+		pc[CPU_PC_SYS]	    = get_cpu_pc_value(p->cpu_sys, c->cpu_sys, itv);
+		pc[CPU_PC_IOWAIT]   = get_cpu_pc_value(p->cpu_iowait, c->cpu_iowait, itv);
+		pc[CPU_PC_STEAL]    = get_cpu_pc_value(p->cpu_steal, c->cpu_steal, itv);
+		pc[CPU_PC_IRQ]	    = get_cpu_pc_value(p->cpu_hardirq, c->cpu_hardirq, itv);
+		pc[CPU_PC_SOFT]	    = get_cpu_pc_value(p->cpu_softirq, c->cpu_softirq, itv);
+		pc[CPU_PC_GUEST]    = get_cpu_pc_value(p->cpu_guest, c->cpu_guest, itv);
+		pc[CPU_PC_GNICE]    = get_cpu_pc_value(p->cpu_guest_nice, c->cpu_guest_nice, itv);
+		pc[CPU_PC_IDLE]	    = get_cpu_pc_value(p->cpu_idle, c->cpu_idle, itv);
+		pc[CPU_PC_USER]	    = get_cpu_pc_value(p->cpu_user, c->cpu_user, itv);
+		pc[CPU_PC_NICE_TOT] = get_cpu_pc_value(p->cpu_nice, c->cpu_nice, itv);
+		pc[CPU_PC_SYS_TOT]  = get_cpu_pc_value(p->cpu_sys + p->cpu_hardirq + p->cpu_softirq,
+						       c->cpu_sys + c->cpu_hardirq + c->cpu_softirq, itv);
+	}
+}
+
+/*
+ ***************************************************************************
+ * Get the directory where the cgroup v2 hierarchy is mounted: Either
+ * /sys/fs/cgroup, or /sys/fs/cgroup/unified when the system uses a hybrid
+ * cgroup v1/v2 hierarchy.
+ *
+ * RETURNS:
+ * Name of the directory, or NULL if no cgroup v2 hierarchy has been found.
+ ***************************************************************************
+ */
+char *get_cgroup_root(void)
+{
+	if (!access(SYSFS_CGROUP "/" CG_CONTROLLERS, F_OK))
+		return SYSFS_CGROUP;
+
+	if (!access(SYSFS_CGROUP_UNIFIED "/" CG_CONTROLLERS, F_OK))
+		return SYSFS_CGROUP_UNIFIED;
+
+	return NULL;
+}
+
+/*
+ ***************************************************************************
+ * Compare two cgroup names. Used by qsort().
+ ***************************************************************************
+ */
+int cmp_cgroup_name(const void *a, const void *b)
+{
+	return strcmp(*((char **) a), *((char **) b));
+}
+
+/*
+ ***************************************************************************
+ * Walk the child cgroups of a cgroup (sorted by name, so that they are
+ * found in the same order from one sample to the next), then recursively
+ * their own child cgroups up to the max depth, calling a function for
+ * each of them.
+ *
+ * IN:
+ * @root	Directory where the cgroup v2 hierarchy is mounted.
+ * @cgname	Cgroup path relative to the cgroup root ("" for root cgroup).
+ * @depth	Depth of the child cgroups (1 for top-level cgroups).
+ * @max_depth	Max depth of the cgroups to walk.
+ * @f_visit	Function called for each cgroup with its directory, its path
+ * 		relative to the cgroup root and its depth. It returns 0 to
+ * 		walk its child cgroups, 1 to skip them, and -1 to stop.
+ * @arg		Argument passed to @f_visit.
+ *
+ * RETURNS:
+ * 0 on success, or -1 if the walk has been stopped by @f_visit.
+ ***************************************************************************
+ */
+int walk_cgroup_dir(const char *root, const char *cgname, int depth, int max_depth,
+		    int (*f_visit) (const char *, const char *, int, void *), void *arg)
+{
+	DIR *dir;
+	struct dirent *drd;
+	struct stat buf;
+	char dirname[MAX_PF_NAME], *name, **subdir = NULL;
+	int i, nr = 0, sz = 0, rc = 0, v;
+
+	snprintf(dirname, sizeof(dirname), "%s/%s", root, cgname);
+	if ((dir = __opendir(dirname)) == NULL)
+		return 0;
+
+	while ((drd = __readdir(dir)) != NULL) {
+
+		if (drd->d_name[0] == '.')
+			continue;
+
+		if (drd->d_type != DT_DIR) {
+			if (drd->d_type != DT_UNKNOWN)
+				continue;
+
+			snprintf(dirname, sizeof(dirname), "%s/%s%s%s",
+				 root, cgname, *cgname ? "/" : "", drd->d_name);
+			if ((stat(dirname, &buf) < 0) || !S_ISDIR(buf.st_mode))
+				continue;
+		}
+
+		if (nr >= sz) {
+			sz = sz ? sz * 2 : 16;
+			SREALLOC(subdir, char *, (size_t) sz * sizeof(char *));
+		}
+		if ((subdir[nr++] = strdup(drd->d_name)) == NULL) {
+			perror("strdup");
+			exit(4);
+		}
+	}
+	__closedir(dir);
+
+	qsort(subdir, nr, sizeof(char *), cmp_cgroup_name);
+
+	for (i = 0; i < nr; i++) {
+
+		if (!rc &&
+		    (snprintf(dirname, sizeof(dirname), "%s/%s%s%s", root, cgname,
+			      *cgname ? "/" : "", subdir[i]) < (int) sizeof(dirname))) {
+			/* Cgroup path relative to the cgroup root */
+			name = dirname + strlen(root) + 1;
+
+			if ((v = (*f_visit)(dirname, name, depth, arg)) < 0) {
+				rc = -1;
+			}
+			else if (!v && (depth < max_depth)) {
+				rc = walk_cgroup_dir(root, name, depth + 1, max_depth, f_visit, arg);
+			}
+		}
+		free(subdir[i]);
+	}
+	free(subdir);
+
+	return rc;
+}
+
+/*
+ ***************************************************************************
+ * Read statistics for a cgroup from files cpu.stat, memory.current and
+ * io.stat located in its directory. The last two files may not exist
+ * depending on the controllers enabled for the cgroup.
+ *
+ * IN:
+ * @st_cg	Structure where stats will be saved.
+ * @dirname	Directory of the cgroup.
+ * @flags	CG_RD_MEM and/or CG_RD_IO to also read memory.current and
+ * 		io.stat files.
+ *
+ * OUT:
+ * @st_cg	Structure with statistics (except the cgroup name).
+ *
+ * RETURNS:
+ * 0 on success, 1 if the cgroup no longer exists.
+ ***************************************************************************
+ */
+int read_cgroup_stat(struct stats_cgroup *st_cg, const char *dirname, int flags)
+{
+	FILE *fp;
+	char filename[MAX_PF_NAME], line[256];
+	unsigned long long rbytes, wbytes, rios, wios;
+
+	memset(st_cg, 0, STATS_CGROUP_SIZE);
+
+	/* cpu.stat file always exists, even if cpu controller is not enabled */
+	snprintf(filename, sizeof(filename), "%s/%s", dirname, CG_CPU_STAT);
+	if ((fp = fopen(filename, "r")) == NULL)
+		return 1;
+
+	while (fgets(line, sizeof(line), fp) != NULL) {
+
+		if (!strncmp(line, "usage_usec ", 11)) {
+			sscanf(line + 11, "%llu", &st_cg->usage_usec);
+		}
+		else if (!strncmp(line, "user_usec ", 10)) {
+			sscanf(line + 10, "%llu", &st_cg->user_usec);
+		}
+		else if (!strncmp(line, "system_usec ", 12)) {
+			sscanf(line + 12, "%llu", &st_cg->system_usec);
+		}
+		else if (!strncmp(line, "throttled_usec ", 15)) {
+			sscanf(line + 15, "%llu", &st_cg->throttled_usec);
+		}
+	}
+	fclose(fp);
+
+	/* Memory currently used by the cgroup, saved in kB */
+	snprintf(filename, sizeof(filename), "%s/%s", dirname, CG_MEM_CURRENT);
+	if ((flags & CG_RD_MEM) && ((fp = fopen(filename, "r")) != NULL)) {
+		if (fscanf(fp, "%llu", &st_cg->mem_current) == 1) {
+			st_cg->mem_current >>= 10;
+		}
+		fclose(fp);
+	}
+
+	/* One line per device in io.stat: Sum stats for all of them */
+	snprintf(filename, sizeof(filename), "%s/%s", dirname, CG_IO_STAT);
+	if ((flags & CG_RD_IO) && ((fp = fopen(filename, "r")) != NULL)) {
+		while (fgets(line, sizeof(line), fp) != NULL) {
+
+			if (sscanf(line, "%*s rbytes=%llu wbytes=%llu rios=%llu wios=%llu",
+				   &rbytes, &wbytes, &rios, &wios) == 4) {
+				st_cg->rbytes += rbytes;
+				st_cg->wbytes += wbytes;
+				st_cg->rios += rios;
+				st_cg->wios += wios;
+			}
+		}
+		fclose(fp);
+	}
+
+	return 0;
+}
+
 #ifdef SOURCE_SADC
 /*---------------- BEGIN: FUNCTIONS USED BY SADC ONLY ---------------------*/
 
@@ -3018,11 +3352,11 @@ int read_softnet(struct stats_softnet *st_softnet, __nr_t nr_alloc,
 /*
  ***************************************************************************
  * Read pressure-stall information from a file located in /proc/pressure
- * directory.
+ * directory or in a cgroup directory.
  *
  * IN:
  * @st_psi	Structure where stats will be saved.
- * @filename	File located in /proc/pressure directory to read.
+ * @filename	Pressure file to read.
  * @token	"some" or "full". Indicate which line shall be read in file.
  *
  * OUT:
@@ -3268,5 +3602,252 @@ __nr_t read_bat(struct stats_pwr_bat *st_bat, __nr_t nr_alloc)
 	return bat_read;
 }
 
+/*
+ ***************************************************************************
+ * Save the name of a cgroup. A name too long to be saved entirely is
+ * truncated, its last character being replaced with a '*'.
+ *
+ * IN:
+ * @cgname	Cgroup path relative to the cgroup root.
+ *
+ * OUT:
+ * @name	Cgroup name (MAX_CG_LEN bytes long buffer).
+ ***************************************************************************
+ */
+void save_cgroup_name(char *name, const char *cgname)
+{
+	strncpy(name, cgname, MAX_CG_LEN - 1);
+	name[MAX_CG_LEN - 1] = '\0';
+	if (strlen(cgname) >= MAX_CG_LEN) {
+		name[MAX_CG_LEN - 2] = '*';
+	}
+}
+
+/*
+ ***************************************************************************
+ * Read statistics for a cgroup from files cpu.stat, memory.current and
+ * io.stat located in its directory.
+ *
+ * IN:
+ * @st		Structure where stats will be saved.
+ * @dirname	Directory of the cgroup.
+ * @cgname	Cgroup path relative to the cgroup root.
+ *
+ * OUT:
+ * @st		Structure with statistics.
+ *
+ * RETURNS:
+ * 0 on success, 1 if the cgroup no longer exists.
+ ***************************************************************************
+ */
+int read_cgroup_files(void *st, const char *dirname, const char *cgname)
+{
+	struct stats_cgroup *st_cg = (struct stats_cgroup *) st;
+
+	if (read_cgroup_stat(st_cg, dirname, CG_RD_MEM | CG_RD_IO))
+		return 1;
+
+	save_cgroup_name(st_cg->cgroup_name, cgname);
+
+	return 0;
+}
+
+/*
+ ***************************************************************************
+ * Read statistics for a cgroup found while walking the cgroup hierarchy,
+ * and save them in next structure of an array.
+ *
+ * IN:
+ * @dirname	Directory of the cgroup.
+ * @cgname	Cgroup path relative to the cgroup root.
+ * @depth	Depth of the cgroup (1 for top-level cgroups).
+ * @arg		Array where stats will be saved.
+ *
+ * OUT:
+ * @arg		Array with statistics.
+ *
+ * RETURNS:
+ * 0 on success, or -1 if the buffer was too small and needs to be
+ * reallocated.
+ ***************************************************************************
+ */
+int read_cgroup_array(const char *dirname, const char *cgname, int depth, void *arg)
+{
+	struct cgroup_array *cga = (struct cgroup_array *) arg;
+
+	if (cga->nr_read + 1 > cga->nr_alloc)
+		return -1;
+
+	if (!(*cga->f_read)((char *) cga->st + cga->nr_read * cga->st_size, dirname, cgname)) {
+		cga->nr_read++;
+	}
+
+	return 0;
+}
+
+/*
+ ***************************************************************************
+ * Read statistics for the cgroups of the cgroup v2 hierarchy up to the
+ * max depth.
+ *
+ * IN:
+ * @st		Array of structures where stats will be saved.
+ * @st_size	Size of one structure in array.
+ * @nr_alloc	Total number of structures allocated. Value is >= 0.
+ * @max_depth	Max depth of the cgroups to read (1 for top-level cgroups).
+ * @f_read	Function used to read the stats of one cgroup.
+ *
+ * OUT:
+ * @st		Array of structures with statistics.
+ *
+ * RETURNS:
+ * Number of cgroups read, or -1 if the buffer was too small and needs to
+ * be reallocated.
+ ***************************************************************************
+ */
+__nr_t read_cgroup_hierarchy(void *st, size_t st_size, __nr_t nr_alloc, int max_depth,
+			     int (*f_read) (void *, const char *, const char *))
+{
+	struct cgroup_array cga;
+	char *root;
+
+	if ((root = get_cgroup_root()) == NULL)
+		return 0;
+
+	cga.st = st;
+	cga.st_size = st_size;
+	cga.nr_alloc = nr_alloc;
+	cga.nr_read = 0;
+	cga.f_read = f_read;
+
+	if (walk_cgroup_dir(root, "", 1, max_depth, read_cgroup_array, &cga) < 0)
+		return -1;
+
+	return cga.nr_read;
+}
+
+/*
+ ***************************************************************************
+ * Read cgroups statistics.
+ *
+ * IN:
+ * @st_cg	Structure where stats will be saved.
+ * @nr_alloc	Total number of structures allocated. Value is >= 0.
+ * @max_depth	Max depth of the cgroups to read (1 for top-level cgroups).
+ *
+ * OUT:
+ * @st_cg	Structure with statistics.
+ *
+ * RETURNS:
+ * Number of cgroups read, or -1 if the buffer was too small and needs to
+ * be reallocated.
+ ***************************************************************************
+ */
+__nr_t read_cgroup(struct stats_cgroup *st_cg, __nr_t nr_alloc, int max_depth)
+{
+	return read_cgroup_hierarchy(st_cg, STATS_CGROUP_SIZE, nr_alloc, max_depth,
+				     read_cgroup_files);
+}
+
+/*
+ ***************************************************************************
+ * Read pressure-stall statistics for a cgroup from files cpu.pressure,
+ * io.pressure and memory.pressure located in its directory.
+ *
+ * IN:
+ * @st		Structure where stats will be saved.
+ * @dirname	Directory of the cgroup.
+ * @cgname	Cgroup path relative to the cgroup root.
+ *
+ * OUT:
+ * @st		Structure with statistics.
+ *
+ * RETURNS:
+ * 0 on success, 1 if the cgroup no longer exists or if pressure-stall
+ * information is not available for it.
+ ***************************************************************************
+ */
+int read_psi_cgroup_files(void *st, const char *dirname, const char *cgname)
+{
+	struct stats_psi_cgroup *st_psi_cg = (struct stats_psi_cgroup *) st;
+	struct stats_psi st_psi;
+	char filename[MAX_PF_NAME];
+
+	memset(st_psi_cg, 0, STATS_PSI_CGROUP_SIZE);
+	save_cgroup_name(st_psi_cg->cgroup_name, cgname);
+
+	/* Read CPU stats. "full" line may not exist with older kernels */
+	snprintf(filename, sizeof(filename), "%s/%s", dirname, CG_CPU_PRESSURE);
+	if (!read_psi_stub(&st_psi, filename, "some"))
+		return 1;
+
+	st_psi_cg->some_acpu_10   = st_psi.avg10;
+	st_psi_cg->some_acpu_60   = st_psi.avg60;
+	st_psi_cg->some_acpu_300  = st_psi.avg300;
+	st_psi_cg->some_cpu_total = st_psi.total;
+
+	if (read_psi_stub(&st_psi, filename, "full")) {
+		st_psi_cg->full_acpu_10   = st_psi.avg10;
+		st_psi_cg->full_acpu_60   = st_psi.avg60;
+		st_psi_cg->full_acpu_300  = st_psi.avg300;
+		st_psi_cg->full_cpu_total = st_psi.total;
+	}
+
+	/* Read I/O stats */
+	snprintf(filename, sizeof(filename), "%s/%s", dirname, CG_IO_PRESSURE);
+	if (read_psi_stub(&st_psi, filename, "some")) {
+		st_psi_cg->some_aio_10   = st_psi.avg10;
+		st_psi_cg->some_aio_60   = st_psi.avg60;
+		st_psi_cg->some_aio_300  = st_psi.avg300;
+		st_psi_cg->some_io_total = st_psi.total;
+	}
+	if (read_psi_stub(&st_psi, filename, "full")) {
+		st_psi_cg->full_aio_10   = st_psi.avg10;
+		st_psi_cg->full_aio_60   = st_psi.avg60;
+		st_psi_cg->full_aio_300  = st_psi.avg300;
+		st_psi_cg->full_io_total = st_psi.total;
+	}
+
+	/* Read memory stats */
+	snprintf(filename, sizeof(filename), "%s/%s", dirname, CG_MEM_PRESSURE);
+	if (read_psi_stub(&st_psi, filename, "some")) {
+		st_psi_cg->some_amem_10   = st_psi.avg10;
+		st_psi_cg->some_amem_60   = st_psi.avg60;
+		st_psi_cg->some_amem_300  = st_psi.avg300;
+		st_psi_cg->some_mem_total = st_psi.total;
+	}
+	if (read_psi_stub(&st_psi, filename, "full")) {
+		st_psi_cg->full_amem_10   = st_psi.avg10;
+		st_psi_cg->full_amem_60   = st_psi.avg60;
+		st_psi_cg->full_amem_300  = st_psi.avg300;
+		st_psi_cg->full_mem_total = st_psi.total;
+	}
+
+	return 0;
+}
+
+/*
+ ***************************************************************************
+ * Read pressure-stall statistics for cgroups.
+ *
+ * IN:
+ * @st_psi_cg	Structure where stats will be saved.
+ * @nr_alloc	Total number of structures allocated. Value is >= 0.
+ * @max_depth	Max depth of the cgroups to read (1 for top-level cgroups).
+ *
+ * OUT:
+ * @st_psi_cg	Structure with statistics.
+ *
+ * RETURNS:
+ * Number of cgroups read, or -1 if the buffer was too small and needs to
+ * be reallocated.
+ ***************************************************************************
+ */
+__nr_t read_psi_cgroup(struct stats_psi_cgroup *st_psi_cg, __nr_t nr_alloc, int max_depth)
+{
+	return read_cgroup_hierarchy(st_psi_cg, STATS_PSI_CGROUP_SIZE, nr_alloc, max_depth,
+				     read_psi_cgroup_files);
+}
+
 /*------------------ END: FUNCTIONS USED BY SADC ONLY ---------------------*/
 #endif /* SOURCE_SADC */
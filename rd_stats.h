@@ -28,6 +28,10 @@
 #define MAX_FCH_LEN	16
 /* Maximum length of interrupt name */
 #define MAX_SA_IRQ_LEN	8
+/* Maximum length of cgroup name (path relative to cgroup root) */
+#define MAX_CG_LEN	128
+/* Maximum depth of cgroups for which statistics are collected */
+#define MAX_CG_DEPTH	8
 
 #define CNT_PART	1
 #define CNT_ALL_DEV	0
@@ -87,6 +91,21 @@
 #define SYSFS_PWR_SUPPLY	PRE "/sys/class/power_supply"
 #define BAT_CAPACITY		"%s/%s/capacity"
 #define BAT_STATUS		"%s/%s/status"
+#define SYSFS_CGROUP		PRE "/sys/fs/cgroup"
+#define SYSFS_CGROUP_UNIFIED	PRE "/sys/fs/cgroup/unified"
+#define CG_CONTROLLERS		"cgroup.controllers"
+#define CG_CPU_STAT		"cpu.stat"
+#define CG_MEM_CURRENT		"memory.current"
+#define CG_IO_STAT		"io.stat"
+#define CG_MEM_STAT		"memory.stat"
+#define CG_THREADS		"cgroup.threads"
+#define CG_CPU_PRESSURE		"cpu.pressure"
+#define CG_IO_PRESSURE		"io.pressure"
+#define CG_MEM_PRESSURE		"memory.pressure"
+
+/* Optional files read by read_cgroup_stat() */
+#define CG_RD_MEM	0x01	/* memory.current */
+#define CG_RD_IO	0x02	/* io.stat */
 
 /*
  ***************************************************************************
@@ -130,6 +149,44 @@ struct stats_cpu {
 #define STATS_CPU_U	0
 #define STATS_CPU_XNR	10
 
+/*
+ * Indexes of CPU percentages computed by compute_cpu_pc_values().
+ * The first ten ones are in the same order as the fields displayed
+ * by sar -u ALL.
+ */
+enum {
+	CPU_PC_USR	= 0,	/* user - guest */
+	CPU_PC_NICE	= 1,	/* nice - guest_nice */
+	CPU_PC_SYS	= 2,
+	CPU_PC_IOWAIT	= 3,
+	CPU_PC_STEAL	= 4,
+	CPU_PC_IRQ	= 5,
+	CPU_PC_SOFT	= 6,
+	CPU_PC_GUEST	= 7,
+	CPU_PC_GNICE	= 8,
+	CPU_PC_IDLE	= 9,
+	CPU_PC_USER	= 10,	/* user, including guest */
+	CPU_PC_NICE_TOT	= 11,	/* nice, including guest_nice */
+	CPU_PC_SYS_TOT	= 12	/* sys + hardirq + softirq */
+};
+
+#define NR_CPU_PC	13
+
+/*
+ * Structure used to compute CPU percentages for a set of CPU.
+ * The NR_CPU_PC percentages of a CPU are saved next to each other.
+ */
+struct cpu_pc_values {
+	/* Percentages */
+	double		   *pc;
+	/* Interval for each CPU, 0 if CPU is tickless or not considered */
+	unsigned long long *itv;
+	int		   nr_alloc;
+};
+
+/* Percentage of field @f for CPU @i */
+#define CPU_PC(c, f, i)	((c)->pc[(i) * NR_CPU_PC + (f)])
+
 /*
  * Structure for task creation and context switch statistics.
  * The attribute (aligned(8)) is necessary so that sizeof(structure) has
@@ -832,6 +889,63 @@ struct stats_pwr_bat {
 #define STATS_PWR_BAT_U		0
 #define STATS_PWR_BAT_XNR	2
 
+/* Structure for cgroups statistics */
+struct stats_cgroup {
+	unsigned long long usage_usec;
+	unsigned long long user_usec;
+	unsigned long long system_usec;
+	unsigned long long throttled_usec;
+	unsigned long long mem_current;
+	unsigned long long rbytes;
+	unsigned long long wbytes;
+	unsigned long long rios;
+	unsigned long long wios;
+	char		   cgroup_name[MAX_CG_LEN];
+};
+
+#define STATS_CGROUP_SIZE	(sizeof(struct stats_cgroup))
+#define STATS_CGROUP_SIZE2CMP	(STATS_CGROUP_SIZE - MAX_CG_LEN)
+#define STATS_CGROUP_ULL	9
+#define STATS_CGROUP_UL		0
+#define STATS_CGROUP_U		0
+#define STATS_CGROUP_XNR	9
+
+/* Structure for cgroups pressure-stall statistics */
+struct stats_psi_cgroup {
+	unsigned long long some_cpu_total;
+	unsigned long long full_cpu_total;
+	unsigned long long some_io_total;
+	unsigned long long full_io_total;
+	unsigned long long some_mem_total;
+	unsigned long long full_mem_total;
+	unsigned int	   some_acpu_10;
+	unsigned int	   some_acpu_60;
+	unsigned int	   some_acpu_300;
+	unsigned int	   full_acpu_10;
+	unsigned int	   full_acpu_60;
+	unsigned int	   full_acpu_300;
+	unsigned int	   some_aio_10;
+	unsigned int	   some_aio_60;
+	unsigned int	   some_aio_300;
+	unsigned int	   full_aio_10;
+	unsigned int	   full_aio_60;
+	unsigned int	   full_aio_300;
+	unsigned int	   some_amem_10;
+	unsigned int	   some_amem_60;
+	unsigned int	   some_amem_300;
+	unsigned int	   full_amem_10;
+	unsigned int	   full_amem_60;
+	unsigned int	   full_amem_300;
+	char		   cgroup_name[MAX_CG_LEN];
+};
+
+#define STATS_PSI_CGROUP_SIZE		(sizeof(struct stats_psi_cgroup))
+#define STATS_PSI_CGROUP_SIZE2CMP	(STATS_PSI_CGROUP_SIZE - MAX_CG_LEN)
+#define STATS_PSI_CGROUP_ULL		6
+#define STATS_PSI_CGROUP_UL		0
+#define STATS_PSI_CGROUP_U		18
+#define STATS_PSI_CGROUP_XNR		6
+
 /*
  ***************************************************************************
  * Prototypes for functions used to read system statistics
@@ -843,6 +957,9 @@ void compute_ext_disk_stats
 	 struct ext_disk_stats *);
 unsigned long long get_per_cpu_interval
 	(struct stats_cpu *, struct stats_cpu *);
+void compute_cpu_pc_values
+	(struct cpu_pc_values *, void *, void *, size_t, int, unsigned long long,
+	 const unsigned char [], const unsigned char []);
 FILE *open_stat_stream
 	(void);
 __nr_t read_stat_cpu
@@ -853,8 +970,17 @@ __nr_t read_meminfo
 	(struct stats_memory *);
 void read_uptime
 	(unsigned long long *);
+void read_uptime_ns
+	(unsigned long long *);
 void refresh_proc_stat
 	(void);
+char *get_cgroup_root
+	(void);
+int walk_cgroup_dir
+	(const char *, const char *, int, int,
+	 int (*) (const char *, const char *, int, void *), void *);
+int read_cgroup_stat
+	(struct stats_cgroup *, const char *, int);
 #ifdef SOURCE_SADC
 void oct2chr
 	(char *);
@@ -934,6 +1060,10 @@ __nr_t read_psimem
 	(struct stats_psi_mem *);
 __nr_t read_bat
 	(struct stats_pwr_bat *, __nr_t);
+__nr_t read_cgroup
+	(struct stats_cgroup *, __nr_t, int);
+__nr_t read_psi_cgroup
+	(struct stats_psi_cgroup *, __nr_t, int);
 
 #endif /* SOURCE_SADC */
 
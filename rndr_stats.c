@@ -3513,3 +3513,195 @@ __print_funct_t render_pwr_bat_stats(struct activity *a, int isdb, char *pre,
 		       bat_status[(unsigned int) spbc->status]);
 	}
 }
+
+/*
+ ***************************************************************************
+ * Display cgroups statistics in selected format.
+ *
+ * IN:
+ * @a		Activity structure with statistics.
+ * @isdb	Flag, true if db printing, false if ppc printing.
+ * @pre		Prefix string for output entries
+ * @curr	Index in array for current sample statistics.
+ * @itv		Interval of time in 1/100th of a second.
+ ***************************************************************************
+ */
+__print_funct_t render_cgroup_stats(struct activity *a, int isdb, char *pre,
+				    int curr, unsigned long long itv)
+{
+	int i, j;
+	struct stats_cgroup *scc, *scp, sczero;
+	int pt_newlin
+		= PT_NOFLAG + (DISPLAY_HORIZONTALLY(flags) ? 0 : PT_NEWLIN);
+
+	memset(&sczero, 0, STATS_CGROUP_SIZE);
+
+	for (i = 0; i < a->nr[curr]; i++) {
+
+		scc = (struct stats_cgroup *) ((char *) a->buf[curr] + i * a->msize);
+
+		if (a->item_list != NULL) {
+			/* A list of cgroups has been entered on the command line */
+			if (!search_list_item(a->item_list, scc->cgroup_name))
+				/* Cgroup not found */
+				continue;
+		}
+
+		j = check_cgroup_reg(a, curr, !curr, i);
+		if (j < 0) {
+			/* This is a newly created cgroup. Previous stats are zero */
+			scp = &sczero;
+		}
+		else {
+			scp = (struct stats_cgroup *) ((char *) a->buf[!curr] + j * a->msize);
+		}
+
+		render(isdb, pre, PT_NOFLAG,
+		       "%s\t%%usr", "%s",
+		       cons(sv, scc->cgroup_name, NOVAL),
+		       NOVAL,
+		       S_VALUE(scp->user_usec, scc->user_usec, itv) / 10000,
+		       NULL);
+
+		render(isdb, pre, PT_NOFLAG,
+		       "%s\t%%system", NULL,
+		       cons(sv, scc->cgroup_name, NOVAL),
+		       NOVAL,
+		       S_VALUE(scp->system_usec, scc->system_usec, itv) / 10000,
+		       NULL);
+
+		render(isdb, pre, PT_NOFLAG,
+		       "%s\t%%cpu", NULL,
+		       cons(sv, scc->cgroup_name, NOVAL),
+		       NOVAL,
+		       S_VALUE(scp->usage_usec, scc->usage_usec, itv) / 10000,
+		       NULL);
+
+		render(isdb, pre, PT_NOFLAG,
+		       "%s\t%%throttled", NULL,
+		       cons(sv, scc->cgroup_name, NOVAL),
+		       NOVAL,
+		       S_VALUE(scp->throttled_usec, scc->throttled_usec, itv) / 10000,
+		       NULL);
+
+		render(isdb, pre, PT_USEINT,
+		       "%s\tkbmem", NULL,
+		       cons(sv, scc->cgroup_name, NOVAL),
+		       scc->mem_current,
+		       DNOVAL, NULL);
+
+		render(isdb, pre, PT_NOFLAG,
+		       "%s\trkB/s", NULL,
+		       cons(sv, scc->cgroup_name, NOVAL),
+		       NOVAL,
+		       S_VALUE(scp->rbytes, scc->rbytes, itv) / 1024,
+		       NULL);
+
+		render(isdb, pre, PT_NOFLAG,
+		       "%s\twkB/s", NULL,
+		       cons(sv, scc->cgroup_name, NOVAL),
+		       NOVAL,
+		       S_VALUE(scp->wbytes, scc->wbytes, itv) / 1024,
+		       NULL);
+
+		render(isdb, pre, PT_NOFLAG,
+		       "%s\trd/s", NULL,
+		       cons(sv, scc->cgroup_name, NOVAL),
+		       NOVAL,
+		       S_VALUE(scp->rios, scc->rios, itv),
+		       NULL);
+
+		render(isdb, pre, pt_newlin,
+		       "%s\twr/s", NULL,
+		       cons(sv, scc->cgroup_name, NOVAL),
+		       NOVAL,
+		       S_VALUE(scp->wios, scc->wios, itv),
+		       NULL);
+	}
+}
+
+/*
+ ***************************************************************************
+ * Display cgroups pressure-stall statistics in selected format.
+ *
+ * IN:
+ * @a		Activity structure with statistics.
+ * @isdb	Flag, true if db printing, false if ppc printing.
+ * @pre		Prefix string for output entries
+ * @curr	Index in array for current sample statistics.
+ * @itv		Interval of time in 1/100th of a second.
+ ***************************************************************************
+ */
+__print_funct_t render_psi_cgroup_stats(struct activity *a, int isdb, char *pre,
+					int curr, unsigned long long itv)
+{
+	int i, j;
+	struct stats_psi_cgroup *spcc, *spcp, spczero;
+	int pt_newlin
+		= PT_NOFLAG + (DISPLAY_HORIZONTALLY(flags) ? 0 : PT_NEWLIN);
+
+	memset(&spczero, 0, STATS_PSI_CGROUP_SIZE);
+
+	for (i = 0; i < a->nr[curr]; i++) {
+
+		spcc = (struct stats_psi_cgroup *) ((char *) a->buf[curr] + i * a->msize);
+
+		if (a->item_list != NULL) {
+			/* A list of cgroups has been entered on the command line */
+			if (!search_list_item(a->item_list, spcc->cgroup_name))
+				/* Cgroup not found */
+				continue;
+		}
+
+		j = check_psi_cgroup_reg(a, curr, !curr, i);
+		if (j < 0) {
+			/* This is a newly created cgroup. Previous stats are zero */
+			spcp = &spczero;
+		}
+		else {
+			spcp = (struct stats_psi_cgroup *) ((char *) a->buf[!curr] + j * a->msize);
+		}
+
+		render(isdb, pre, PT_NOFLAG,
+		       "%s\t%%scpu", "%s",
+		       cons(sv, spcc->cgroup_name, NOVAL),
+		       NOVAL,
+		       S_VALUE(spcp->some_cpu_total, spcc->some_cpu_total, itv) / 10000,
+		       NULL);
+
+		render(isdb, pre, PT_NOFLAG,
+		       "%s\t%%fcpu", NULL,
+		       cons(sv, spcc->cgroup_name, NOVAL),
+		       NOVAL,
+		       S_VALUE(spcp->full_cpu_total, spcc->full_cpu_total, itv) / 10000,
+		       NULL);
+
+		render(isdb, pre, PT_NOFLAG,
+		       "%s\t%%sio", NULL,
+		       cons(sv, spcc->cgroup_name, NOVAL),
+		       NOVAL,
+		       S_VALUE(spcp->some_io_total, spcc->some_io_total, itv) / 10000,
+		       NULL);
+
+		render(isdb, pre, PT_NOFLAG,
+		       "%s\t%%fio", NULL,
+		       cons(sv, spcc->cgroup_name, NOVAL),
+		       NOVAL,
+		       S_VALUE(spcp->full_io_total, spcc->full_io_total, itv) / 10000,
+		       NULL);
+
+		render(isdb, pre, PT_NOFLAG,
+		       "%s\t%%smem", NULL,
+		       cons(sv, spcc->cgroup_name, NOVAL),
+		       NOVAL,
+		       S_VALUE(spcp->some_mem_total, spcc->some_mem_total, itv) / 10000,
+		       NULL);
+
+		render(isdb, pre, pt_newlin,
+		       "%s\t%%fmem", NULL,
+		       cons(sv, spcc->cgroup_name, NOVAL),
+		       NOVAL,
+		       S_VALUE(spcp->full_mem_total, spcc->full_mem_total, itv) / 10000,
+		       NULL);
+	}
+}
@@ -132,5 +132,9 @@ __print_funct_t render_psimem_stats
 	(struct activity *, int, char *, int, unsigned long long);
 __print_funct_t render_pwr_bat_stats
 	(struct activity *, int, char *, int, unsigned long long);
+__print_funct_t render_cgroup_stats
+	(struct activity *, int, char *, int, unsigned long long);
+__print_funct_t render_psi_cgroup_stats
+	(struct activity *, int, char *, int, unsigned long long);
 
 #endif /* _RNDR_STATS_H */
@@ -16,12 +16,12 @@
  */
 
 /* Number of activities */
-#define NR_ACT		43
+#define NR_ACT		45
 /* The value below is used for sanity check */
 #define MAX_NR_ACT	256
 
 /* Number of functions used to count items */
-#define NR_F_COUNT	14
+#define NR_F_COUNT	16
 
 /* Activities */
 enum {
@@ -67,7 +67,9 @@ enum {
 	A_PSI_CPU	= 40,
 	A_PSI_IO	= 41,
 	A_PSI_MEM	= 42,
-	A_PWR_BAT	= 43
+	A_PWR_BAT	= 43,
+	A_CGROUP	= 44,
+	A_PSI_CGROUP	= 45
 };
 
 /* Macro used to flag an activity that should be collected */
@@ -181,6 +183,11 @@ enum {
 
 #define DISPLAY_MOUNT(m)	(((m) & AO_F_MOUNT)       == AO_F_MOUNT)
 
+/* Output flags for option -S CGROUP (max depth of cgroups, default is 1) */
+#define AO_F_CG_DEPTH		0x0000000f
+
+#define CG_DEPTH(m)		(((m) & AO_F_CG_DEPTH) ? ((m) & AO_F_CG_DEPTH) : 1)
+
 /*
  ***************************************************************************
  * Various keywords and constants.
@@ -232,6 +239,7 @@ enum {
 #define K_POWER		"POWER"
 #define K_USB		"USB"
 #define K_BAT		"BAT"
+#define K_CGROUP	"CGROUP"
 
 #define K_SKIP_EMPTY	"skipempty"
 #define K_AUTOSCALE	"autoscale"
@@ -249,6 +257,7 @@ enum {
 
 /* Environment variables */
 #define ENV_COLORS_PALETTE	"S_COLORS_PALETTE"
+#define ENV_SADC_SOCKET		"S_SADC_SOCKET"
 
 /* Groups of activities */
 #define G_DEFAULT	0x00
@@ -258,6 +267,7 @@ enum {
 #define G_IPV6		0x08
 #define G_POWER		0x10
 #define G_XDISK		0x20
+#define G_CGROUP	0x40
 
 /* sadc program */
 #define SADC		"sadc"
@@ -286,6 +296,7 @@ enum {
 #define MAX_NR_FS		(65536 * 4096)
 #define MAX_NR_FCHOSTS		65536
 #define MAX_NR_BATS		4096
+#define MAX_NR_CGROUPS		65536
 
 /* NR_MAX is the upper limit used for unknown activities */
 #define NR_MAX		(65536 * 4096)
@@ -387,7 +398,7 @@ struct sa_item {
  */
 
 /* Number of output formats */
-#define NR_FMT	9
+#define NR_FMT	10
 
 /* Output formats */
 enum {
@@ -400,7 +411,8 @@ enum {
 	F_CONV_OUTPUT	= 6,
 	F_SVG_OUTPUT	= 7,
 	F_RAW_OUTPUT	= 8,
-	F_PCP_OUTPUT	= 9
+	F_PCP_OUTPUT	= 9,
+	F_OM_OUTPUT	= 10
 };
 
 /* Structure for SVG specific parameters */
@@ -807,10 +819,31 @@ struct record_header {
 	 * Timestamp (number of seconds since the epoch).
 	 */
 	unsigned long long ust_time;
+	/*
+	 * Machine uptime in nanoseconds. Used to compute the interval
+	 * between two samples precisely when sadc is run with sub-second
+	 * intervals. Zero in files created by older sysstat versions.
+	 */
+	unsigned long long uptime_ns;
+	/*
+	 * Timestamp (number of nanoseconds since the epoch).
+	 * Zero in files created by older sysstat versions.
+	 */
+	unsigned long long ust_time_ns;
+	/*
+	 * Time elapsed (in nanoseconds) between the sampling deadline and
+	 * the moment sadc actually started to collect the statistics.
+	 */
+	unsigned long long skew_ns;
 	/*
 	 * TRUE if an extra_desc structure exists.
 	 */
 	unsigned int extra_next;
+	/*
+	 * Number of sampling deadlines skipped by sadc before this record
+	 * because they had already expired when it was ready to wait for them.
+	 */
+	unsigned int skipped_nr;
 	/*
 	 * Record type: R_STATS, R_RESTART,...
 	 */
@@ -827,9 +860,181 @@ struct record_header {
 
 #define RECORD_HEADER_SIZE	(sizeof(struct record_header))
 #define MAX_RECORD_HEADER_SIZE	512	/* Used for sanity check */
-#define RECORD_HEADER_ULL_NR	2	/* Nr of unsigned long long in record_header structure */
+#define RECORD_HEADER_ULL_NR	5	/* Nr of unsigned long long in record_header structure */
 #define RECORD_HEADER_UL_NR	0	/* Nr of unsigned long in record_header structure */
-#define RECORD_HEADER_U_NR	1	/* Nr of unsigned int in record_header structure */
+#define RECORD_HEADER_U_NR	2	/* Nr of unsigned int in record_header structure */
+
+
+/*
+ ***************************************************************************
+ * Shared memory live feed (sadc --shm option).
+ *
+ * The shared memory object published by sadc has the following layout:
+ *
+ * +------------------------------------------------------------------+
+ * | Feed header (struct shm_feed_header)                             |
+ * +------------------------------------------------------------------+
+ * | Stream header: file_magic + file_header + file_activity list     |
+ * | (same contents as those sent by sadc to sar on its stdout).      |
+ * +------------------------------------------------------------------+
+ * | Slot #0: struct shm_slot, followed by a record laid out as it is |
+ * | sent on stdout (record_header, then for each activity: number of |
+ * | items if any, then statistics structures).                       |
+ * +------------------------------------------------------------------+
+ * | ...                                                              |
+ * +------------------------------------------------------------------+
+ * | Slot #SHM_SLOT_NR-1                                              |
+ * +------------------------------------------------------------------+
+ *
+ * Record with sequence number n (n >= 1) is saved in slot #(n-1) % SHM_SLOT_NR.
+ * Slots and feed header are protected by seqlock-style counters: sadc makes
+ * the counter odd before updating the data and even again once it's done.
+ * A reader copies the data, then checks that the counter was even and has
+ * not changed meanwhile. Else it tries again.
+ ***************************************************************************
+ */
+
+/* Default name of the shared memory object */
+#define SHM_DEFAULT_NAME	"/sysstat"
+#define SHM_FEED_MAGIC		0xd5a1
+/* Number of slots in the ring buffer */
+#define SHM_SLOT_NR		4
+/* Delay between two polls of the feed by a reader waiting for a new record (ns) */
+#define SHM_POLL_DELAY		10000000
+
+#define SHM_ALIGN(m)		(((m) + 7) & ~((size_t) 7))
+
+struct shm_feed_header {
+	/*
+	 * Layout generation counter. Odd when sadc is (re)building the layout
+	 * (resizing the object or rewriting the stream header).
+	 */
+	uint64_t gen;
+	/*
+	 * Sequence number of the last record published (0 if none yet).
+	 */
+	uint64_t last_seq;
+	/*
+	 * Total size of the object. The object can only grow.
+	 */
+	uint64_t shm_size;
+	/*
+	 * Must be SHM_FEED_MAGIC.
+	 */
+	unsigned int shm_magic;
+	/*
+	 * Number of slots in the ring buffer.
+	 */
+	unsigned int slot_nr;
+	/*
+	 * Size of the stream header following this structure.
+	 */
+	unsigned int hdr_len;
+	/*
+	 * Size of each slot, including its struct shm_slot header.
+	 */
+	unsigned int slot_size;
+};
+
+#define SHM_FEED_HEADER_SIZE	(sizeof(struct shm_feed_header))
+
+struct shm_slot {
+	/*
+	 * Seqlock counter: Odd while sadc is writing the slot.
+	 */
+	uint64_t seq;
+	/*
+	 * Sequence number of the record saved in the slot.
+	 */
+	uint64_t rec_seq;
+	/*
+	 * Size of the record saved in the slot.
+	 */
+	unsigned int rec_len;
+	unsigned int padding;
+};
+
+#define SHM_SLOT_SIZE		(sizeof(struct shm_slot))
+
+/* Structure used by readers of the shared memory live feed */
+struct shm_feed {
+	/*
+	 * Mapping of the shared memory object.
+	 */
+	void *base;
+	size_t map_len;
+	int fd;
+	/*
+	 * Layout generation and sequence number of the last record fetched.
+	 */
+	uint64_t gen;
+	uint64_t rec_seq;
+	/*
+	 * Private copy of the stream header, and buffer where the data fetched
+	 * (stream header if it has changed, then record) are saved.
+	 * Data are consumed from position @pos.
+	 */
+	char *hdr;
+	size_t hdr_len;
+	char *buf;
+	size_t buf_alloc;
+	size_t len;
+	size_t pos;
+};
+
+/* Values returned by shm_fetch_record() */
+#define SHM_NO_RECORD	0
+#define SHM_NEW_RECORD	1
+#define SHM_NEW_HEADER	2
+
+/*
+ ***************************************************************************
+ * Broadcast socket (sadc --socket option).
+ *
+ * A client connecting to the UNIX socket of sadc first receives a
+ * struct sadc_hello, then the same data as those sent by sadc to sar on
+ * its stdout: Stream header (file_magic + file_header + file_activity list)
+ * followed by every record collected from now on (including R_LAST_STATS
+ * records followed by a new stream header when a file is rotated).
+ ***************************************************************************
+ */
+
+/* Default path of the broadcast socket */
+#define SADC_SOCKET		"/run/sadc.sock"
+#define SADC_HELLO_MAGIC	0xd5a2
+/* Max number of clients connected at the same time */
+#define MAX_SOCK_CLIENTS	64
+/*
+ * Max size of the data waiting to be sent to a client. Records which don't
+ * fit are dropped for this client.
+ */
+#define MAX_SOCK_QUEUE_SIZE	(4 * 1024 * 1024)
+
+struct sadc_hello {
+	/*
+	 * Must be SADC_HELLO_MAGIC.
+	 */
+	unsigned int hello_magic;
+	/*
+	 * Interval of time (in milliseconds) between two records sent by sadc.
+	 */
+	unsigned int interval_ms;
+};
+
+#define SADC_HELLO_SIZE		(sizeof(struct sadc_hello))
+
+/* Client of the broadcast socket, as seen by sadc */
+struct sock_client {
+	/*
+	 * Queue of data waiting to be sent to the client.
+	 * Data from position @pos to @len have not been sent yet.
+	 */
+	char *queue;
+	size_t q_alloc;
+	size_t len;
+	size_t pos;
+	int fd;
+};
 
 
 /*
@@ -1427,6 +1632,10 @@ __nr_t count_new_disk
 	(struct activity *, int);
 __nr_t count_new_bat
 	(struct activity *, int);
+__nr_t count_new_cgroup
+	(struct activity *, int);
+__nr_t count_new_psi_cgroup
+	(struct activity *, int);
 
 /* Functions used to count number of items */
 __nr_t wrap_get_cpu_nr
@@ -1457,6 +1666,10 @@ __nr_t wrap_detect_psi
 	(struct activity *);
 __nr_t wrap_get_bat_nr
 	(struct activity *);
+__nr_t wrap_get_cgroup_nr
+	(struct activity *);
+__nr_t wrap_get_psi_cgroup_nr
+	(struct activity *);
 
 /* Functions used to read activities statistics */
 __read_funct_t wrap_read_stat_cpu
@@ -1545,6 +1758,10 @@ __read_funct_t wrap_read_psimem
 	(struct activity *);
 __read_funct_t wrap_read_bat
 	(struct activity *);
+__read_funct_t wrap_read_cgroup
+	(struct activity *);
+__read_funct_t wrap_read_psi_cgroup
+	(struct activity *);
 
 /* Other functions */
 int check_alt_sa_dir
@@ -1579,6 +1796,10 @@ void allocate_structures
 	(struct activity * [], uint64_t);
 int check_disk_reg
 	(struct activity *, int, int, int);
+int check_cgroup_reg
+	(struct activity *, int, int, int);
+int check_psi_cgroup_reg
+	(struct activity *, int, int, int);
 void check_file_actlst
 	(int *, char *, struct activity * [], uint64_t, struct file_magic *,
 	 struct file_header *, struct file_activity **, unsigned int [], int *, int *);
@@ -1610,8 +1831,12 @@ char *get_fs_name_to_display
 	(struct activity *, uint64_t, struct stats_filesystem *);
 unsigned long long get_global_cpu_statistics
 	(struct activity *, int, int, uint64_t, unsigned char []);
+struct cpu_pc_values *get_cpu_pc_statistics
+	(struct activity *, int, int, unsigned long long, unsigned char []);
 void get_global_int_statistics
 	(struct activity *, int, int, uint64_t, unsigned char []);
+double *get_irq_rates
+	(struct activity *, int, int, unsigned long long, int);
 void get_global_soft_statistics
 	(struct activity *, int, int, uint64_t, unsigned char []);
 void get_itv_value
@@ -1688,6 +1913,16 @@ void set_hdr_rectime
 	(unsigned int, struct tm *, struct file_header *);
 void set_record_timestamp_string
 	(uint64_t, char *, char *, int, struct tstamp_ext *);
+int shm_attach_feed
+	(struct shm_feed *, const char *);
+void shm_detach_feed
+	(struct shm_feed *);
+int shm_fetch_record
+	(struct shm_feed *);
+int shm_map_feed
+	(struct shm_feed *);
+size_t shm_read_feed
+	(struct shm_feed *, void *, size_t);
 void swap_struct
 	(const unsigned int [], void *, int);
 #endif /* SOURCE_SADC undefined */
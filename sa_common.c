@@ -22,6 +22,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <time.h>
 #include <errno.h>
 #include <unistd.h>	/* For STDOUT_FILENO, among others */
@@ -33,6 +34,8 @@
 #include <sys/stat.h>
 #include <ctype.h>
 #include <float.h>
+#include <sched.h>
+#include <sys/mman.h>
 
 #include "version.h"
 #include "sa.h"
@@ -949,9 +952,19 @@ void get_itv_value(struct record_header *record_hdr_curr,
 		   struct record_header *record_hdr_prev,
 		   unsigned long long *itv)
 {
-	/* Interval value in jiffies */
-	*itv = get_interval(record_hdr_prev->uptime_cs,
-			    record_hdr_curr->uptime_cs);
+	if (record_hdr_prev->uptime_ns && record_hdr_curr->uptime_ns) {
+		/*
+		 * Both records have a high resolution uptime: Use it so that
+		 * the interval is still accurate with sub-second sampling.
+		 */
+		*itv = get_interval_ns(record_hdr_prev->uptime_ns,
+				       record_hdr_curr->uptime_ns);
+	}
+	else {
+		/* Interval value in 1/100th of a second */
+		*itv = get_interval(record_hdr_prev->uptime_cs,
+				    record_hdr_curr->uptime_cs);
+	}
 }
 
 /*
@@ -1213,6 +1226,165 @@ int check_net_edev_reg(struct activity *a, int curr, int ref, int pos)
 	return -1;
 }
 
+/*
+ ***************************************************************************
+ * Tell if a counter of a cgroup has decreased between two samples.
+ *
+ * IN:
+ * @scc		Current cgroup statistics.
+ * @scp		Cgroup statistics used as reference.
+ *
+ * RETURNS:
+ * TRUE if a counter has decreased.
+ ***************************************************************************
+ */
+static int cgroup_counters_decreased(const void *scc, const void *scp)
+{
+	const struct stats_cgroup *c = scc, *p = scp;
+
+	return ((c->usage_usec     < p->usage_usec)     ||
+		(c->throttled_usec < p->throttled_usec) ||
+		(c->rbytes         < p->rbytes)         ||
+		(c->wbytes         < p->wbytes)         ||
+		(c->rios           < p->rios)           ||
+		(c->wios           < p->wios));
+}
+
+/*
+ ***************************************************************************
+ * Tell if a counter of a cgroup pressure-stall statistics has decreased
+ * between two samples.
+ *
+ * IN:
+ * @scc		Current cgroup PSI statistics.
+ * @scp		Cgroup PSI statistics used as reference.
+ *
+ * RETURNS:
+ * TRUE if a counter has decreased.
+ ***************************************************************************
+ */
+static int psi_cgroup_counters_decreased(const void *scc, const void *scp)
+{
+	const struct stats_psi_cgroup *c = scc, *p = scp;
+
+	return ((c->some_cpu_total < p->some_cpu_total) ||
+		(c->full_cpu_total < p->full_cpu_total) ||
+		(c->some_io_total  < p->some_io_total)  ||
+		(c->full_io_total  < p->full_io_total)  ||
+		(c->some_mem_total < p->some_mem_total) ||
+		(c->full_mem_total < p->full_mem_total));
+}
+
+/*
+ ***************************************************************************
+ * Look for current cgroup in the array of sample statistics used as
+ * reference. Cgroups are identified by their name, located at offset
+ * @name_off in each structure.
+ *
+ * IN:
+ * @a			Activity structure with statistics.
+ * @curr		Index in array for current sample statistics.
+ * @ref			Index in array for sample statistics used as reference.
+ * @pos			Index on current cgroup.
+ * @name_off		Offset of cgroup name in statistics structure.
+ * @f_decreased		Function telling if a counter has decreased.
+ *
+ * RETURNS:
+ * Position of current cgroup in array of sample statistics used as
+ * reference.
+ * -1 if it is a newly created cgroup.
+ * -2 if it is a known cgroup but which has been removed then created
+ * again on the interval.
+ ***************************************************************************
+ */
+static int check_cgroup_entry(struct activity *a, int curr, int ref, int pos,
+			      size_t name_off,
+			      int (*f_decreased)(const void *, const void *))
+{
+	char *scc, *scp;
+	int j0, j = pos;
+
+	if (!a->nr[ref])
+		/*
+		 * No items found in previous iteration:
+		 * Current cgroup is necessarily new.
+		 */
+		return -1;
+
+	if (j >= a->nr[ref]) {
+		j = a->nr[ref] - 1;
+	}
+	j0 = j;
+
+	scc = (char *) a->buf[curr] + pos * a->msize;
+
+	do {
+		scp = (char *) a->buf[ref] + j * a->msize;
+
+		if (!strcmp(scc + name_off, scp + name_off)) {
+			/*
+			 * Cgroup found.
+			 * If a counter has decreased, then we may assume that the
+			 * cgroup was removed, then created again.
+			 */
+			if (f_decreased(scc, scp))
+				return -2;
+
+			return j;
+		}
+		if (++j >= a->nr[ref]) {
+			j = 0;
+		}
+	}
+	while (j != j0);
+
+	/* This is a newly created cgroup */
+	return -1;
+}
+
+/*
+ ***************************************************************************
+ * Cgroups may be created and removed dynamically. This is what we try to
+ * guess here.
+ *
+ * IN:
+ * @a		Activity structure with statistics.
+ * @curr	Index in array for current sample statistics.
+ * @ref		Index in array for sample statistics used as reference.
+ * @pos		Index on current cgroup.
+ *
+ * RETURNS:
+ * See check_cgroup_entry().
+ ***************************************************************************
+ */
+int check_cgroup_reg(struct activity *a, int curr, int ref, int pos)
+{
+	return check_cgroup_entry(a, curr, ref, pos,
+				  offsetof(struct stats_cgroup, cgroup_name),
+				  cgroup_counters_decreased);
+}
+
+/*
+ ***************************************************************************
+ * Same as check_cgroup_reg() but for cgroups pressure-stall statistics.
+ *
+ * IN:
+ * @a		Activity structure with statistics.
+ * @curr	Index in array for current sample statistics.
+ * @ref		Index in array for sample statistics used as reference.
+ * @pos		Index on current cgroup.
+ *
+ * RETURNS:
+ * See check_cgroup_entry().
+ ***************************************************************************
+ */
+int check_psi_cgroup_reg(struct activity *a, int curr, int ref, int pos)
+{
+	return check_cgroup_entry(a, curr, ref, pos,
+				  offsetof(struct stats_psi_cgroup, cgroup_name),
+				  psi_cgroup_counters_decreased);
+}
+
 /*
  ***************************************************************************
  * Disks may be registered dynamically (true in /proc/diskstats file).
@@ -1716,12 +1888,13 @@ int read_record_hdr(int ifd, void *buffer, struct record_header *record_hdr,
 
 		/* Raw output in debug mode */
 		if (DISPLAY_DEBUG_MODE(flags) && (ofmt->id == F_RAW_OUTPUT)) {
-			char out[128];
+			char out[192];
 
-			sprintf(out, "# uptime_cs; %llu; ust_time; %llu; extra_next; %u; record_type; %d; HH:MM:SS; %02d:%02d:%02d\n",
+			sprintf(out, "# uptime_cs; %llu; ust_time; %llu; extra_next; %u; record_type; %d; HH:MM:SS; %02d:%02d:%02d; skew_ns; %llu; skipped_nr; %u\n",
 			       record_hdr->uptime_cs, record_hdr->ust_time,
 			       record_hdr->extra_next, record_hdr->record_type,
-			       record_hdr->hour, record_hdr->minute, record_hdr->second);
+			       record_hdr->hour, record_hdr->minute, record_hdr->second,
+			       record_hdr->skew_ns, record_hdr->skipped_nr);
 			cprintf_s(IS_COMMENT, "%s", out);
 		}
 
@@ -3457,6 +3630,53 @@ unsigned long long get_global_cpu_statistics(struct activity *a, int prev, int c
 	return deltot_jiffies;
 }
 
+/*
+ ***************************************************************************
+ * Compute CPU percentages for the CPU (including CPU "all") whose
+ * statistics are saved in activity buffers and which are to be displayed.
+ * get_global_cpu_statistics() must have been called before on SMP machines.
+ *
+ * IN:
+ * @a		Activity structure with statistics.
+ * @prev	Index in array where stats used as reference are.
+ * @curr	Index in array for current sample statistics.
+ * @deltot_jiffies
+ *		Interval for CPU "all" as returned by
+ *		get_global_cpu_statistics() (unused on UP machines).
+ * @offline_cpu_bitmap
+ *		CPU bitmap for offline CPU.
+ *
+ * RETURNS:
+ * Pointer on a structure containing the interval and the percentages
+ * for each CPU. It is overwritten at each call.
+ ***************************************************************************
+ */
+struct cpu_pc_values *get_cpu_pc_statistics(struct activity *a, int prev, int curr,
+					    unsigned long long deltot_jiffies,
+					    unsigned char offline_cpu_bitmap[])
+{
+	static struct cpu_pc_values cpc;
+
+	if (a->nr_ini == 1) {
+		/*
+		 * This is a UP machine. In this case
+		 * interval has still not been calculated.
+		 */
+		deltot_jiffies = get_per_cpu_interval((struct stats_cpu *) a->buf[curr],
+						      (struct stats_cpu *) a->buf[prev]);
+	}
+	if (!deltot_jiffies) {
+		/* CPU "all" cannot be tickless */
+		deltot_jiffies = 1;
+	}
+
+	compute_cpu_pc_values(&cpc, a->buf[curr], a->buf[prev], a->msize,
+			      MINIMUM(a->nr_ini, a->bitmap->b_size + 1), deltot_jiffies,
+			      a->bitmap->b_array, offline_cpu_bitmap);
+
+	return &cpc;
+}
+
 /*
  ***************************************************************************
  * Compute softnet statistics for CPU "all" as the sum of individual CPU
@@ -3600,6 +3820,68 @@ void get_global_int_statistics(struct activity *a, int prev, int curr,
 	}
 }
 
+/*
+ ***************************************************************************
+ * Compute the number of interrupts per second for every CPU (including CPU
+ * "all") and every interrupt.
+ * Interrupts statistics are saved CPU by CPU in activity buffers (all the
+ * interrupts for CPU "all", then all the interrupts for CPU 0, etc.)
+ * whereas they are displayed interrupt by interrupt. So counters are read
+ * once in the order they are saved, and results are saved interrupt by
+ * interrupt, so that the values displayed on a line of the report are
+ * consecutive in memory.
+ * get_global_int_statistics() must have been called before.
+ *
+ * IN:
+ * @a		Activity structure with statistics.
+ * @prev	Index in array where stats used as reference are.
+ * @curr	Index in array for current sample statistics.
+ * @itv		Interval of time in 1/100th of a second.
+ * @nr		Number of CPU (including CPU "all") to compute.
+ *
+ * RETURNS:
+ * Pointer on an array of @a->nr2 x @nr values. The value for interrupt #i
+ * and CPU #c is at position (i * @nr + c). The array is overwritten at
+ * each call.
+ ***************************************************************************
+ */
+double *get_irq_rates(struct activity *a, int prev, int curr, unsigned long long itv,
+		      int nr)
+{
+	static double *rates = NULL;
+	static size_t rates_sz = 0;
+	int c, i;
+	struct stats_irq *stc_cpu_irq, *stp_cpu_irq;
+
+	if ((size_t) a->nr2 * nr > rates_sz) {
+		rates_sz = (size_t) a->nr2 * nr;
+		SREALLOC(rates, double, sizeof(double) * rates_sz);
+	}
+
+	for (c = 0; c < nr; c++) {
+		stc_cpu_irq = (struct stats_irq *) ((char *) a->buf[curr] + c * a->msize * a->nr2);
+		stp_cpu_irq = (struct stats_irq *) ((char *) a->buf[prev] + c * a->msize * a->nr2);
+
+		for (i = 0; i < a->nr2; i++) {
+			if (!c && (stc_cpu_irq->irq_nr < stp_cpu_irq->irq_nr)) {
+				/*
+				 * Total number among all CPU for a given interrupt may decrease if
+				 * a CPU has gone offline. In this case we display "0.00" instead of
+				 * the huge number that would appear otherwise.
+				 */
+				rates[i * nr + c] = 0.0;
+			}
+			else {
+				rates[i * nr + c] = S_VALUE(stp_cpu_irq->irq_nr, stc_cpu_irq->irq_nr, itv);
+			}
+			stc_cpu_irq = (struct stats_irq *) ((char *) stc_cpu_irq + a->msize);
+			stp_cpu_irq = (struct stats_irq *) ((char *) stp_cpu_irq + a->msize);
+		}
+	}
+
+	return rates;
+}
+
 /*
  ***************************************************************************
  * Get filesystem name to display. This may be either the persistent name
@@ -3832,4 +4114,244 @@ void print_minmax(int ismax)
 			      : _("Minimum:"));
 }
 
+/*
+ ***************************************************************************
+ * Map the shared memory object of a live feed (again if it has grown).
+ *
+ * IN:
+ * @feed	Live feed structure.
+ *
+ * OUT:
+ * @feed	Live feed structure with new mapping.
+ *
+ * RETURNS:
+ * 0 on success, -1 otherwise.
+ ***************************************************************************
+ */
+int shm_map_feed(struct shm_feed *feed)
+{
+	struct stat st;
+	void *base;
+
+	if (fstat(feed->fd, &st) < 0)
+		return -1;
+
+	if ((size_t) st.st_size < SHM_FEED_HEADER_SIZE) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if ((base = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_SHARED,
+			 feed->fd, 0)) == MAP_FAILED)
+		return -1;
+
+	if (feed->base) {
+		munmap(feed->base, feed->map_len);
+	}
+	feed->base = base;
+	feed->map_len = (size_t) st.st_size;
+
+	if (((struct shm_feed_header *) base)->shm_magic != SHM_FEED_MAGIC) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	return 0;
+}
+
+/*
+ ***************************************************************************
+ * Attach to the shared memory live feed published by sadc.
+ *
+ * IN:
+ * @feed	Live feed structure.
+ * @name	Name of the shared memory object.
+ *
+ * OUT:
+ * @feed	Live feed structure, ready to be used by shm_fetch_record().
+ *
+ * RETURNS:
+ * 0 on success, -1 otherwise (errno is then set).
+ ***************************************************************************
+ */
+int shm_attach_feed(struct shm_feed *feed, const char *name)
+{
+	memset(feed, 0, sizeof(struct shm_feed));
+
+	if ((feed->fd = shm_open(name, O_RDONLY, 0)) < 0)
+		return -1;
+
+	return shm_map_feed(feed);
+}
+
+/*
+ ***************************************************************************
+ * Detach from the shared memory live feed and free the related buffers.
+ *
+ * IN:
+ * @feed	Live feed structure.
+ ***************************************************************************
+ */
+void shm_detach_feed(struct shm_feed *feed)
+{
+	if (feed->base) {
+		munmap(feed->base, feed->map_len);
+	}
+	if (feed->fd >= 0) {
+		close(feed->fd);
+	}
+	free(feed->hdr);
+	free(feed->buf);
+	memset(feed, 0, sizeof(struct shm_feed));
+	feed->fd = -1;
+}
+
+/*
+ ***************************************************************************
+ * Copy the latest record published in the live feed, if it is newer than
+ * the last one fetched. No system calls are needed, unless sadc has made
+ * the shared memory object grow.
+ * The record is saved in the feed buffer, preceded by the stream header if
+ * the latter has changed (or if this is the first record fetched).
+ *
+ * IN:
+ * @feed	Live feed structure.
+ *
+ * OUT:
+ * @feed	Live feed structure, with data ready to be read using
+ *		shm_read_feed().
+ *
+ * RETURNS:
+ * SHM_NO_RECORD if no new record is available, SHM_NEW_RECORD if a new
+ * record has been fetched, SHM_NEW_HEADER if the stream header has changed
+ * and precedes the new record, and -1 if the feed is inconsistent.
+ ***************************************************************************
+ */
+int shm_fetch_record(struct shm_feed *feed)
+{
+	struct shm_feed_header *fh;
+	struct shm_slot *slot;
+	uint64_t gen, last, seq;
+	size_t hdr_len, slot_size, rec_len, off;
+	unsigned int slot_nr;
+	int new_hdr;
+
+	for (;;) {
+		fh = (struct shm_feed_header *) feed->base;
+
+		gen = __atomic_load_n(&fh->gen, __ATOMIC_ACQUIRE);
+		if (gen & 1) {
+			/* sadc is currently rebuilding the layout */
+			sched_yield();
+			continue;
+		}
+
+		if (__atomic_load_n(&fh->shm_size, __ATOMIC_RELAXED) > feed->map_len) {
+			/* Object has grown */
+			if (shm_map_feed(feed) < 0)
+				return -1;
+			continue;
+		}
+
+		last = __atomic_load_n(&fh->last_seq, __ATOMIC_ACQUIRE);
+		if (!last || (last <= feed->rec_seq))
+			return SHM_NO_RECORD;
+
+		hdr_len   = fh->hdr_len;
+		slot_size = fh->slot_size;
+		slot_nr   = fh->slot_nr;
+
+		if (!slot_nr || (slot_size <= SHM_SLOT_SIZE) ||
+		    (SHM_FEED_HEADER_SIZE + SHM_ALIGN(hdr_len) + slot_nr * slot_size > feed->map_len)) {
+			if (__atomic_load_n(&fh->gen, __ATOMIC_ACQUIRE) == gen)
+				/* Layout is stable and yet inconsistent */
+				return -1;
+			continue;
+		}
+
+		slot = (struct shm_slot *) ((char *) feed->base + SHM_FEED_HEADER_SIZE +
+					    SHM_ALIGN(hdr_len) + ((last - 1) % slot_nr) * slot_size);
+
+		seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+		if (seq & 1) {
+			/* Slot is being written: Try again */
+			sched_yield();
+			continue;
+		}
+
+		rec_len = slot->rec_len;
+		if ((slot->rec_seq != last) || (rec_len > slot_size - SHM_SLOT_SIZE))
+			/* Slot has been recycled in the meantime */
+			continue;
+
+		new_hdr = (gen != feed->gen);
+		off = new_hdr ? hdr_len : 0;
+
+		if (off + rec_len > feed->buf_alloc) {
+			SREALLOC(feed->buf, char, off + rec_len);
+			feed->buf_alloc = off + rec_len;
+		}
+		if (new_hdr) {
+			memcpy(feed->buf, (char *) feed->base + SHM_FEED_HEADER_SIZE, hdr_len);
+		}
+		memcpy(feed->buf + off, (char *) slot + SHM_SLOT_SIZE, rec_len);
+
+		/* Check that data have not been modified while they were copied */
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if ((__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == seq) &&
+		    (__atomic_load_n(&fh->gen, __ATOMIC_RELAXED) == gen))
+			break;
+	}
+
+	feed->gen = gen;
+	feed->rec_seq = last;
+	feed->len = off + rec_len;
+	feed->pos = 0;
+
+	if (!new_hdr)
+		return SHM_NEW_RECORD;
+
+	if ((hdr_len == feed->hdr_len) && !memcmp(feed->hdr, feed->buf, hdr_len)) {
+		/* Object has only been resized: Stream header is unchanged */
+		feed->pos = hdr_len;
+		return SHM_NEW_RECORD;
+	}
+
+	/* Save a copy of the new stream header */
+	SREALLOC(feed->hdr, char, hdr_len);
+	memcpy(feed->hdr, feed->buf, hdr_len);
+	feed->hdr_len = hdr_len;
+
+	return SHM_NEW_HEADER;
+}
+
+/*
+ ***************************************************************************
+ * Read data fetched from the live feed.
+ *
+ * IN:
+ * @feed	Live feed structure.
+ * @size	Number of bytes of data to read.
+ *
+ * OUT:
+ * @buffer	Buffer where data will be saved.
+ *
+ * RETURNS:
+ * 0 if all the data have been successfully read.
+ * Otherwise, return the number of bytes left to be read.
+ ***************************************************************************
+ */
+size_t shm_read_feed(struct shm_feed *feed, void *buffer, size_t size)
+{
+	size_t n = feed->len - feed->pos;
+
+	if (n > size) {
+		n = size;
+	}
+	memcpy(buffer, feed->buf + feed->pos, n);
+	feed->pos += n;
+
+	return size - n;
+}
+
 #endif /* SOURCE_SADC undefined */
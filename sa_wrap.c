@@ -1091,6 +1091,72 @@ __read_funct_t wrap_read_bat(struct activity *a)
 	return;
 }
 
+/*
+ ***************************************************************************
+ * Read cgroups statistics.
+ *
+ * IN:
+ * @a	Activity structure.
+ *
+ * OUT:
+ * @a	Activity structure with statistics.
+ ***************************************************************************
+ */
+__read_funct_t wrap_read_cgroup(struct activity *a)
+{
+	struct stats_cgroup *st_cg
+		= (struct stats_cgroup *) a->_buf0;
+	__nr_t nr_read = 0;
+
+	/* Read cgroups statistics */
+	do {
+		nr_read = read_cgroup(st_cg, a->nr_allocated, CG_DEPTH(a->opt_flags));
+
+		if (nr_read < 0) {
+			/* Buffer needs to be reallocated */
+			st_cg = (struct stats_cgroup *) reallocate_buffer(a);
+		}
+	}
+	while (nr_read < 0);
+
+	a->_nr0 = nr_read;
+
+	return;
+}
+
+/*
+ ***************************************************************************
+ * Read pressure-stall statistics for cgroups.
+ *
+ * IN:
+ * @a	Activity structure.
+ *
+ * OUT:
+ * @a	Activity structure with statistics.
+ ***************************************************************************
+ */
+__read_funct_t wrap_read_psi_cgroup(struct activity *a)
+{
+	struct stats_psi_cgroup *st_psi_cg
+		= (struct stats_psi_cgroup *) a->_buf0;
+	__nr_t nr_read = 0;
+
+	/* Read cgroups pressure-stall statistics */
+	do {
+		nr_read = read_psi_cgroup(st_psi_cg, a->nr_allocated, CG_DEPTH(a->opt_flags));
+
+		if (nr_read < 0) {
+			/* Buffer needs to be reallocated */
+			st_psi_cg = (struct stats_psi_cgroup *) reallocate_buffer(a);
+		}
+	}
+	while (nr_read < 0);
+
+	a->_nr0 = nr_read;
+
+	return;
+}
+
 /*
  ***************************************************************************
  * Look for online CPU and fill corresponding bitmap.
@@ -1591,3 +1657,49 @@ __nr_t wrap_get_bat_nr(struct activity *a)
 
 	return 0;
 }
+
+/*
+ ***************************************************************************
+ * Get number of cgroups up to the max depth entered with option -S CGROUP.
+ *
+ * IN:
+ * @a  Activity structure.
+ *
+ * RETURNS:
+ * Number of cgroups. Number cannot exceed MAX_NR_CGROUPS.
+ ***************************************************************************
+ */
+__nr_t wrap_get_cgroup_nr(struct activity *a)
+{
+	__nr_t n = 0;
+
+	if ((n = get_cgroup_nr(CG_DEPTH(a->opt_flags))) > 0) {
+		if (n > MAX_NR_CGROUPS)
+			return MAX_NR_CGROUPS;
+		else
+			return n;
+	}
+
+	return 0;
+}
+
+/*
+ ***************************************************************************
+ * Get number of cgroups for which pressure-stall statistics may be read
+ * (up to the max depth entered with option -S CGROUP).
+ *
+ * IN:
+ * @a  Activity structure.
+ *
+ * RETURNS:
+ * Number of cgroups, or 0 if pressure-stall information is not available.
+ * Number cannot exceed MAX_NR_CGROUPS.
+ ***************************************************************************
+ */
+__nr_t wrap_get_psi_cgroup_nr(struct activity *a)
+{
+	if (!check_dir(PRESSURE))
+		return 0;
+
+	return wrap_get_cgroup_nr(a);
+}
@@ -30,6 +30,10 @@
 #include <signal.h>
 #include <dirent.h>
 #include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
 #include <sys/stat.h>
 #include <sys/utsname.h>
 
@@ -61,7 +65,8 @@ extern int __env;
 
 extern char *tzname[2];
 
-long interval = -1;
+long interval = -1;	/* Interval in seconds (rounded up) */
+long interval_ms = 0;	/* Interval in milliseconds */
 uint64_t flags = 0;
 
 int optz = 0;
@@ -81,9 +86,24 @@ extern unsigned int rec_types_nr[];
 extern struct activity *act[];
 extern __nr_t (*f_count[]) (struct activity *);
 
-struct sigaction alrm_act, int_act;
+struct sigaction int_act;
 int sigint_caught = 0;
 
+/* Shared memory live feed */
+char shm_name[MAX_FILE_LEN];
+int shm_fd = -1;
+size_t shm_len = 0;
+struct shm_feed_header *shm_fh = NULL;
+uint64_t shm_rec_seq = 0;
+
+/* Broadcast socket */
+char sock_path[MAX_FILE_LEN];
+int sock_fd = -1;
+struct sock_client sock_clients[MAX_SOCK_CLIENTS];
+int sock_client_nr = 0;
+char *sock_hdr = NULL, *sock_buf = NULL;
+size_t sock_hdr_len = 0, sock_buf_alloc = 0;
+
 /*
  ***************************************************************************
  * Print usage and exit.
@@ -99,7 +119,9 @@ void usage(char *progname)
 
 	fprintf(stderr, _("Options are:\n"
 			  "[ -C <comment> ] [ -D ] [ -F ] [ -f ] [ -L ] [ -V ]\n"
-			  "[ -S { INT | DISK | IPV6 | POWER | SNMP | XDISK | ALL | XALL } ]\n"));
+			  "[ --shm[=<name>] ] [ --socket[=<path>] ]\n"
+			  "[ -S { INT | DISK | IPV6 | POWER | SNMP | XDISK | CGROUP[=<depth>] |\n"
+			  "       ALL | XALL } ]\n"));
 	exit(1);
 }
 
@@ -138,7 +160,7 @@ void collect_group_activities(unsigned int group_id, unsigned int opt_f)
 void parse_sadc_S_option(char *argv[], int opt)
 {
 	char *p;
-	int i;
+	int i, depth;
 
 	for (p = strtok(argv[opt], ","); p; p = strtok(NULL, ",")) {
 		if (!strcmp(p, K_INT)) {
@@ -165,13 +187,28 @@ void parse_sadc_S_option(char *argv[], int opt)
 			/* Select group of activities related to power management */
 			collect_group_activities(G_POWER, AO_F_NULL);
 		}
+		else if (!strncmp(p, K_CGROUP, strlen(K_CGROUP))) {
+			/* Select cgroups activity, possibly with the max depth of cgroups */
+			depth = 1;
+			if (p[strlen(K_CGROUP)] == '=') {
+				p += strlen(K_CGROUP) + 1;
+				if (!*p || (strspn(p, DIGITS) != strlen(p)) ||
+				    ((depth = atoi(p)) < 1) || (depth > MAX_CG_DEPTH)) {
+					usage(argv[0]);
+				}
+			}
+			else if (p[strlen(K_CGROUP)] != '\0') {
+				usage(argv[0]);
+			}
+			collect_group_activities(G_CGROUP, depth);
+		}
 		else if (!strcmp(p, K_ALL) || !strcmp(p, K_XALL)) {
 			/* Select all activities */
 			for (i = 0; i < NR_ACT; i++) {
 
-				if (!strcmp(p, K_ALL) && (act[i]->group & G_XDISK))
+				if (!strcmp(p, K_ALL) && (act[i]->group & (G_XDISK + G_CGROUP)))
 					/*
-					 * Don't select G_XDISK activities
+					 * Don't select G_XDISK and G_CGROUP activities
 					 * when option -S ALL is used.
 					 */
 					continue;
@@ -219,19 +256,6 @@ void parse_sadc_S_option(char *argv[], int opt)
 	}
 }
 
-/*
- ***************************************************************************
- * SIGALRM signal handler. No need to reset handler here.
- *
- * IN:
- * @sig	Signal number.
- ***************************************************************************
- */
-void alarm_handler(int sig)
-{
-	__alarm(interval);
-}
-
 /*
  ***************************************************************************
  * SIGINT and SIGTERM signal handler.
@@ -480,47 +504,38 @@ void fill_magic_header(struct file_magic *file_magic)
 
 /*
  ***************************************************************************
- * Fill system activity file header, then write it (or print it if stdout).
+ * Fill system activity file header.
  *
- * IN:
- * @fd	Output file descriptor. May be stdout.
+ * OUT:
+ * @fh	System activity file header.
  ***************************************************************************
  */
-void setup_file_hdr(int fd)
+void fill_file_hdr(struct file_header *fh)
 {
-	int i, j, p;
+	int i;
 	struct tm rectime;
 	struct utsname header;
-	struct file_magic file_magic;
-	struct file_activity file_act;
-
-	/* Fill then write file magic header */
-	fill_magic_header(&file_magic);
-
-	if (write_all(fd, &file_magic, FILE_MAGIC_SIZE) != FILE_MAGIC_SIZE) {
-		p_write_error();
-	}
 
 	/* First reset the structure */
-	memset(&file_hdr, 0, FILE_HEADER_SIZE);
+	memset(fh, 0, FILE_HEADER_SIZE);
 
 	/* Then get current date */
-	file_hdr.sa_ust_time = (unsigned long long) get_time(&rectime, 0);
+	fh->sa_ust_time = (unsigned long long) get_time(&rectime, 0);
 
 	/* OK, now fill the header */
-	file_hdr.sa_act_nr      = get_activity_nr(act, AO_COLLECTED, COUNT_ACTIVITIES);
-	file_hdr.sa_day         = rectime.tm_mday;
-	file_hdr.sa_month       = rectime.tm_mon;
-	file_hdr.sa_year        = rectime.tm_year;
-	file_hdr.sa_sizeof_long = sizeof(long);
-	file_hdr.sa_hz		= HZ;
+	fh->sa_act_nr      = get_activity_nr(act, AO_COLLECTED, COUNT_ACTIVITIES);
+	fh->sa_day         = rectime.tm_mday;
+	fh->sa_month       = rectime.tm_mon;
+	fh->sa_year        = rectime.tm_year;
+	fh->sa_sizeof_long = sizeof(long);
+	fh->sa_hz	   = HZ;
 
 	for (i = 0; i < 3; i++) {
-		file_hdr.act_types_nr[i] = act_types_nr[i];
-		file_hdr.rec_types_nr[i] = rec_types_nr[i];
+		fh->act_types_nr[i] = act_types_nr[i];
+		fh->rec_types_nr[i] = rec_types_nr[i];
 	}
-	file_hdr.act_size = FILE_ACTIVITY_SIZE;
-	file_hdr.rec_size = RECORD_HEADER_SIZE;
+	fh->act_size = FILE_ACTIVITY_SIZE;
+	fh->rec_size = RECORD_HEADER_SIZE;
 
 	/*
 	 * This is a new file (or stdout): Set sa_cpu_nr field to the number
@@ -528,30 +543,81 @@ void setup_file_hdr(int fd)
 	 * online or offline, when sadc was started.
 	 * A_CPU activity is always counted in sa_sys_init(), even if it's not collected.
 	 */
-	file_hdr.sa_cpu_nr = act[get_activity_position(act, A_CPU, EXIT_IF_NOT_FOUND)]->nr_ini;
+	fh->sa_cpu_nr = act[get_activity_position(act, A_CPU, EXIT_IF_NOT_FOUND)]->nr_ini;
 
 	/* Get system name, release number, hostname and machine architecture */
 	__uname(&header);
-	snprintf(file_hdr.sa_sysname, sizeof(file_hdr.sa_sysname), "%s",
+	snprintf(fh->sa_sysname, sizeof(fh->sa_sysname), "%s",
 		 header.sysname);
-	snprintf(file_hdr.sa_nodename, sizeof(file_hdr.sa_nodename), "%s",
+	snprintf(fh->sa_nodename, sizeof(fh->sa_nodename), "%s",
 		 header.nodename);
-	snprintf(file_hdr.sa_release, sizeof(file_hdr.sa_release), "%s",
+	snprintf(fh->sa_release, sizeof(fh->sa_release), "%s",
 		 header.release);
-	snprintf(file_hdr.sa_machine, sizeof(file_hdr.sa_machine), "%s",
+	snprintf(fh->sa_machine, sizeof(fh->sa_machine), "%s",
 		 header.machine);
 
 	/* Get timezone value and save it */
 	tzset();
-	snprintf(file_hdr.sa_tzname, sizeof(file_hdr.sa_tzname), "%s", tzname[0]);
+	snprintf(fh->sa_tzname, sizeof(fh->sa_tzname), "%s", tzname[0]);
+}
 
-	/* Write file header */
-	if (write_all(fd, &file_hdr, FILE_HEADER_SIZE) != FILE_HEADER_SIZE) {
+/*
+ ***************************************************************************
+ * Fill the file_activity structure describing an activity.
+ *
+ * IN:
+ * @a		Activity structure.
+ *
+ * OUT:
+ * @file_act	file_activity structure.
+ ***************************************************************************
+ */
+void fill_file_activity(struct activity *a, struct file_activity *file_act)
+{
+	int j;
+
+	/* Reset file_activity structure (in case some unknown extra fields exist) */
+	memset(file_act, 0, FILE_ACTIVITY_SIZE);
+
+	file_act->id    = a->id;
+	file_act->magic = a->magic;
+	file_act->nr    = a->nr_ini;
+	file_act->nr2   = a->nr2;
+	file_act->size  = a->fsize;
+	for (j = 0; j < 3; j++) {
+		file_act->types_nr[j] = a->gtypes_nr[j];
+	}
+
+	file_act->has_nr = HAS_COUNT_FUNCTION(a->options);
+}
+
+/*
+ ***************************************************************************
+ * Fill system activity file header, then write it (or print it if stdout).
+ *
+ * IN:
+ * @fd	Output file descriptor. May be stdout.
+ ***************************************************************************
+ */
+void setup_file_hdr(int fd)
+{
+	int i, p;
+	struct file_magic file_magic;
+	struct file_activity file_act;
+
+	/* Fill then write file magic header */
+	fill_magic_header(&file_magic);
+
+	if (write_all(fd, &file_magic, FILE_MAGIC_SIZE) != FILE_MAGIC_SIZE) {
 		p_write_error();
 	}
 
-	/* Reset file_activity structure (in case some unknown extra fields exist) */
-	memset(&file_act, 0, FILE_ACTIVITY_SIZE);
+	/* Fill then write file header */
+	fill_file_hdr(&file_hdr);
+
+	if (write_all(fd, &file_hdr, FILE_HEADER_SIZE) != FILE_HEADER_SIZE) {
+		p_write_error();
+	}
 
 	/* Write activity list */
 	for (i = 0; i < NR_ACT; i++) {
@@ -566,16 +632,7 @@ void setup_file_hdr(int fd)
 			continue;
 
 		if (IS_COLLECTED(act[p]->options)) {
-			file_act.id    = act[p]->id;
-			file_act.magic = act[p]->magic;
-			file_act.nr    = act[p]->nr_ini;
-			file_act.nr2   = act[p]->nr2;
-			file_act.size  = act[p]->fsize;
-			for (j = 0; j < 3; j++) {
-				file_act.types_nr[j] = act[p]->gtypes_nr[j];
-			}
-
-			file_act.has_nr = HAS_COUNT_FUNCTION(act[p]->options);
+			fill_file_activity(act[p], &file_act);
 
 			if (write_all(fd, &file_act, FILE_ACTIVITY_SIZE) != FILE_ACTIVITY_SIZE) {
 				p_write_error();
@@ -605,6 +662,33 @@ void write_new_cpu_nr(int ofd)
 	}
 }
 
+/*
+ ***************************************************************************
+ * Save current date and time in record header.
+ *
+ * OUT:
+ * @rectime	Current date and time.
+ ***************************************************************************
+ */
+void save_record_time(struct tm *rectime)
+{
+	struct timespec ts;
+
+	/*
+	 * Read the high resolution timestamp first, so that it can't be
+	 * later than the time in seconds saved below.
+	 */
+	if (!__clock_gettime(CLOCK_REALTIME, &ts)) {
+		record_hdr.ust_time_ns = (unsigned long long) ts.tv_sec * 1000000000ULL +
+					 (unsigned long long) ts.tv_nsec;
+	}
+
+	record_hdr.ust_time = (unsigned long long) get_time(rectime, 0);
+	record_hdr.hour     = rectime->tm_hour;
+	record_hdr.minute   = rectime->tm_min;
+	record_hdr.second   = rectime->tm_sec;
+}
+
 /*
  ***************************************************************************
  * sadc called with interval and count parameters not set:
@@ -634,11 +718,7 @@ void write_special_record(int ofd, int rtype)
 	record_hdr.record_type = rtype;
 
 	/* Save time */
-	record_hdr.ust_time = (unsigned long long) get_time(&rectime, 0);
-
-	record_hdr.hour   = rectime.tm_hour;
-	record_hdr.minute = rectime.tm_min;
-	record_hdr.second = rectime.tm_sec;
+	save_record_time(&rectime);
 
 	/* Write record now */
 	if (write_all(ofd, &record_hdr, RECORD_HEADER_SIZE) != RECORD_HEADER_SIZE) {
@@ -706,6 +786,686 @@ void write_stats(int ofd)
 	}
 }
 
+/*
+ ***************************************************************************
+ * Compute the size of a record as written by write_stats().
+ *
+ * IN:
+ * @max_len	TRUE if the size should be computed for the maximum number
+ *		of items that can be saved in the activities buffers.
+ *
+ * RETURNS:
+ * Size of the record.
+ ***************************************************************************
+ */
+size_t get_record_len(int max_len)
+{
+	int i, p;
+	size_t len = RECORD_HEADER_SIZE;
+
+	for (i = 0; i < NR_ACT; i++) {
+
+		if (!id_seq[i])
+			continue;
+		if ((p = get_activity_position(act, id_seq[i], RESUME_IF_NOT_FOUND)) < 0)
+			continue;
+
+		if (IS_COLLECTED(act[p]->options)) {
+			if (HAS_COUNT_FUNCTION(act[p]->options) && (act[p]->f_count_index >= 0)) {
+				len += sizeof(__nr_t);
+			}
+			len += (size_t) act[p]->fsize * (size_t) act[p]->nr2 *
+			       (size_t) (max_len ? act[p]->nr_allocated : act[p]->_nr0);
+		}
+	}
+
+	return len;
+}
+
+/*
+ ***************************************************************************
+ * Compute the size of the stream header (file magic header, file header
+ * and activity list) as written by setup_file_hdr().
+ *
+ * RETURNS:
+ * Size of the stream header.
+ ***************************************************************************
+ */
+size_t get_stream_hdr_len(void)
+{
+	return FILE_MAGIC_SIZE + FILE_HEADER_SIZE +
+	       FILE_ACTIVITY_SIZE * get_activity_nr(act, AO_COLLECTED, COUNT_ACTIVITIES);
+}
+
+/*
+ ***************************************************************************
+ * Save the stream header in a buffer. Contents are the same as those
+ * written by setup_file_hdr().
+ *
+ * OUT:
+ * @buf	Buffer where the stream header is saved. Must be at least
+ *	get_stream_hdr_len() bytes long.
+ ***************************************************************************
+ */
+void fill_stream_hdr(char *buf)
+{
+	int i, p;
+	struct file_magic file_magic;
+	struct file_header fh;
+	struct file_activity file_act;
+
+	fill_magic_header(&file_magic);
+	memcpy(buf, &file_magic, FILE_MAGIC_SIZE);
+	buf += FILE_MAGIC_SIZE;
+
+	fill_file_hdr(&fh);
+	memcpy(buf, &fh, FILE_HEADER_SIZE);
+	buf += FILE_HEADER_SIZE;
+
+	for (i = 0; i < NR_ACT; i++) {
+
+		if (!id_seq[i])
+			continue;
+		if ((p = get_activity_position(act, id_seq[i], RESUME_IF_NOT_FOUND)) < 0)
+			continue;
+
+		if (IS_COLLECTED(act[p]->options)) {
+			fill_file_activity(act[p], &file_act);
+			memcpy(buf, &file_act, FILE_ACTIVITY_SIZE);
+			buf += FILE_ACTIVITY_SIZE;
+		}
+	}
+}
+
+/*
+ ***************************************************************************
+ * Save current record in a buffer. Layout is the same as that written by
+ * write_stats().
+ *
+ * OUT:
+ * @buf	Buffer where the record is saved. Must be at least
+ *	get_record_len(FALSE) bytes long.
+ ***************************************************************************
+ */
+void fill_record(char *buf)
+{
+	int i, p;
+	size_t len;
+
+	memcpy(buf, &record_hdr, RECORD_HEADER_SIZE);
+	buf += RECORD_HEADER_SIZE;
+
+	for (i = 0; i < NR_ACT; i++) {
+
+		if (!id_seq[i])
+			continue;
+		if ((p = get_activity_position(act, id_seq[i], RESUME_IF_NOT_FOUND)) < 0)
+			continue;
+
+		if (IS_COLLECTED(act[p]->options)) {
+			if (HAS_COUNT_FUNCTION(act[p]->options) && (act[p]->f_count_index >= 0)) {
+				memcpy(buf, &(act[p]->_nr0), sizeof(__nr_t));
+				buf += sizeof(__nr_t);
+			}
+			len = (size_t) act[p]->fsize * (size_t) act[p]->_nr0 * (size_t) act[p]->nr2;
+			memcpy(buf, act[p]->_buf0, len);
+			buf += len;
+		}
+	}
+}
+
+/*
+ ***************************************************************************
+ * Remove the shared memory live feed. Registered with atexit() so that
+ * readers don't attach to a stale object once sadc has exited.
+ * In test mode, samples are not spaced in time: The object is then kept
+ * so that the records published can be read back once sadc has completed.
+ ***************************************************************************
+ */
+void close_shm_feed(void)
+{
+	if (shm_fh) {
+		munmap(shm_fh, shm_len);
+		shm_fh = NULL;
+	}
+	if (shm_fd >= 0) {
+		close(shm_fd);
+		shm_fd = -1;
+#ifndef TEST
+		shm_unlink(shm_name);
+#endif
+	}
+}
+
+/*
+ ***************************************************************************
+ * Create the shared memory live feed, or rebuild its layout when the
+ * activity list has changed or when a record no longer fits in a slot.
+ * The object can only grow, so that readers can keep using their current
+ * mapping until they notice the new size.
+ *
+ * IN:
+ * @rec_len	Size of the largest record the slots should hold.
+ * @new_hdr	TRUE if the stream header should be (re)written. When FALSE,
+ *		the feed is only resized and the stream header already saved
+ *		is kept unchanged, so that readers don't have to read it again.
+ ***************************************************************************
+ */
+void setup_shm_feed(size_t rec_len, int new_hdr)
+{
+	uint64_t gen;
+	size_t hdr_len, slot_size, shm_size;
+	void *base;
+
+	if (!shm_fh) {
+		new_hdr = TRUE;
+	}
+	hdr_len = new_hdr ? get_stream_hdr_len() : shm_fh->hdr_len;
+	slot_size = SHM_ALIGN(SHM_SLOT_SIZE + rec_len);
+	shm_size = SHM_FEED_HEADER_SIZE + SHM_ALIGN(hdr_len) + SHM_SLOT_NR * slot_size;
+
+	if (shm_fd < 0) {
+		/* Remove an object that a previous instance may have left behind */
+		shm_unlink(shm_name);
+		if ((shm_fd = shm_open(shm_name, O_CREAT | O_EXCL | O_RDWR,
+				       S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH)) < 0) {
+			fprintf(stderr, _("Cannot create shared memory object %s: %s\n"),
+				shm_name, strerror(errno));
+			exit(2);
+		}
+		atexit(close_shm_feed);
+	}
+	else {
+		/* Tell readers that the layout is being rebuilt */
+		__atomic_store_n(&shm_fh->gen, shm_fh->gen + 1, __ATOMIC_RELAXED);
+		__atomic_thread_fence(__ATOMIC_RELEASE);
+	}
+
+	if (shm_size > shm_len) {
+		if (ftruncate(shm_fd, shm_size) < 0) {
+			perror("ftruncate");
+			exit(4);
+		}
+		if ((base = mmap(NULL, shm_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+				 shm_fd, 0)) == MAP_FAILED) {
+			perror("mmap");
+			exit(4);
+		}
+		if (shm_fh) {
+			munmap(shm_fh, shm_len);
+		}
+		shm_fh = (struct shm_feed_header *) base;
+		shm_len = shm_size;
+	}
+
+	/* Layout generation is odd until the layout is complete */
+	gen = shm_fh->gen | 1;
+	__atomic_store_n(&shm_fh->gen, gen, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	shm_fh->shm_magic = SHM_FEED_MAGIC;
+	shm_fh->slot_nr   = SHM_SLOT_NR;
+	shm_fh->hdr_len   = hdr_len;
+	shm_fh->slot_size = slot_size;
+	shm_fh->last_seq  = 0;
+
+	if (new_hdr) {
+		/* Save stream header */
+		fill_stream_hdr((char *) shm_fh + SHM_FEED_HEADER_SIZE);
+	}
+
+	/* Empty all the slots */
+	memset((char *) shm_fh + SHM_FEED_HEADER_SIZE + SHM_ALIGN(hdr_len), 0,
+	       SHM_SLOT_NR * slot_size);
+
+	__atomic_store_n(&shm_fh->shm_size, (uint64_t) shm_len, __ATOMIC_RELAXED);
+	__atomic_store_n(&shm_fh->gen, gen + 1, __ATOMIC_RELEASE);
+}
+
+/*
+ ***************************************************************************
+ * Publish current record in the shared memory live feed.
+ * The record is written to the next slot of the ring buffer. The slot's
+ * seqlock counter is odd while the record is being copied, so that readers
+ * can detect (and retry) a torn read without ever blocking sadc.
+ ***************************************************************************
+ */
+void shm_write_stats(void)
+{
+	uint64_t seq;
+	size_t rec_len;
+	struct shm_slot *slot;
+
+	rec_len = get_record_len(FALSE);
+	if (rec_len > shm_fh->slot_size - SHM_SLOT_SIZE) {
+		/* Record doesn't fit: Make slots large enough for the biggest one */
+		setup_shm_feed(get_record_len(TRUE), FALSE);
+	}
+
+	shm_rec_seq++;
+	slot = (struct shm_slot *) ((char *) shm_fh + SHM_FEED_HEADER_SIZE +
+				    SHM_ALIGN(shm_fh->hdr_len) +
+				    ((shm_rec_seq - 1) % SHM_SLOT_NR) * shm_fh->slot_size);
+
+	seq = slot->seq;
+	__atomic_store_n(&slot->seq, seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	slot->rec_seq = shm_rec_seq;
+	slot->rec_len = rec_len;
+
+	/* Copy record */
+	fill_record((char *) slot + SHM_SLOT_SIZE);
+
+	__atomic_store_n(&slot->seq, seq + 2, __ATOMIC_RELEASE);
+	__atomic_store_n(&shm_fh->last_seq, shm_rec_seq, __ATOMIC_RELEASE);
+}
+
+/*
+ ***************************************************************************
+ * Disconnect a client of the broadcast socket.
+ *
+ * IN:
+ * @i	Client index in the list of clients. The last client of the list
+ *	takes its place.
+ ***************************************************************************
+ */
+void sock_drop_client(int i)
+{
+	close(sock_clients[i].fd);
+	free(sock_clients[i].queue);
+
+	sock_clients[i] = sock_clients[--sock_client_nr];
+}
+
+/*
+ ***************************************************************************
+ * Close the broadcast socket and the connections with its clients.
+ * Registered with atexit() so that the socket file is removed once sadc
+ * has exited.
+ ***************************************************************************
+ */
+void close_socket(void)
+{
+	while (sock_client_nr) {
+		sock_drop_client(sock_client_nr - 1);
+	}
+
+	if (sock_fd >= 0) {
+		close(sock_fd);
+		sock_fd = -1;
+		unlink(sock_path);
+	}
+}
+
+/*
+ ***************************************************************************
+ * Save the stream header that will be sent to the clients of the broadcast
+ * socket. Done when the socket is created and when a file is rotated.
+ ***************************************************************************
+ */
+void setup_socket_hdr(void)
+{
+	sock_hdr_len = get_stream_hdr_len();
+	SREALLOC(sock_hdr, char, sock_hdr_len);
+	fill_stream_hdr(sock_hdr);
+}
+
+/*
+ ***************************************************************************
+ * Create the broadcast socket, on which clients (e.g. sar) may connect to
+ * receive the records collected by sadc.
+ ***************************************************************************
+ */
+void setup_socket(void)
+{
+	struct sockaddr_un addr;
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	if (strlen(sock_path) >= sizeof(addr.sun_path)) {
+		fprintf(stderr, _("Socket path too long: %s\n"), sock_path);
+		exit(1);
+	}
+	strcpy(addr.sun_path, sock_path);
+
+	if ((sock_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0)) < 0) {
+		perror("socket");
+		exit(4);
+	}
+
+	/* Remove a socket that a previous instance may have left behind */
+	unlink(sock_path);
+
+	if ((bind(sock_fd, (struct sockaddr *) &addr, sizeof(addr)) < 0) ||
+	    (listen(sock_fd, MAX_SOCK_CLIENTS) < 0)) {
+		fprintf(stderr, _("Cannot create socket %s: %s\n"),
+			sock_path, strerror(errno));
+		exit(2);
+	}
+	atexit(close_socket);
+
+	setup_socket_hdr();
+}
+
+/*
+ ***************************************************************************
+ * Send as much queued data as possible to a client of the broadcast socket,
+ * without blocking.
+ *
+ * IN:
+ * @i	Client index in the list of clients.
+ *
+ * RETURNS:
+ * 0 on success, -1 if the client has been disconnected.
+ ***************************************************************************
+ */
+int sock_flush(int i)
+{
+	ssize_t n;
+	struct sock_client *c = &sock_clients[i];
+
+	while (c->pos < c->len) {
+		if ((n = send(c->fd, c->queue + c->pos, c->len - c->pos,
+			      MSG_DONTWAIT | MSG_NOSIGNAL)) < 0) {
+			if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+				return 0;
+			if (errno == EINTR)
+				continue;
+			sock_drop_client(i);
+			return -1;
+		}
+		c->pos += n;
+	}
+
+	/* Queue is now empty */
+	c->pos = c->len = 0;
+
+	return 0;
+}
+
+/*
+ ***************************************************************************
+ * Queue data for a client of the broadcast socket, then try to send them.
+ * The queue of a client is bounded: A record which doesn't fit into it is
+ * dropped (the client will get the next one), so that a slow consumer
+ * never makes memory grow nor stalls collection. Data already partially
+ * sent, hello message and stream headers are never dropped, so that the
+ * stream remains consistent.
+ *
+ * IN:
+ * @i		Client index in the list of clients.
+ * @buf		Data to send.
+ * @len		Size of data.
+ * @may_drop	TRUE if data may be dropped when the queue is full.
+ *
+ * RETURNS:
+ * 0 on success, -1 if the client has been disconnected.
+ ***************************************************************************
+ */
+int sock_queue(int i, const void *buf, size_t len, int may_drop)
+{
+	size_t qsize;
+	struct sock_client *c = &sock_clients[i];
+
+	if (c->pos) {
+		/* Move data not sent yet at the beginning of the queue */
+		memmove(c->queue, c->queue + c->pos, c->len - c->pos);
+		c->len -= c->pos;
+		c->pos = 0;
+	}
+
+	if (may_drop && c->len && (c->len + len > MAX_SOCK_QUEUE_SIZE)) {
+		/* Queue is full: Drop this record */
+		return 0;
+	}
+
+	if (c->len + len > c->q_alloc) {
+		qsize = c->len + len;
+		SREALLOC(c->queue, char, qsize);
+		c->q_alloc = qsize;
+	}
+	memcpy(c->queue + c->len, buf, len);
+	c->len += len;
+
+	return sock_flush(i);
+}
+
+/*
+ ***************************************************************************
+ * Accept pending connections on the broadcast socket. Each new client
+ * receives the hello message followed by the stream header.
+ ***************************************************************************
+ */
+void accept_socket_clients(void)
+{
+	int fd;
+	struct sadc_hello hello;
+
+	memset(&hello, 0, SADC_HELLO_SIZE);
+	hello.hello_magic = SADC_HELLO_MAGIC;
+	hello.interval_ms = (unsigned int) interval_ms;
+
+	while ((fd = accept(sock_fd, NULL, NULL)) >= 0) {
+
+		if (sock_client_nr >= MAX_SOCK_CLIENTS) {
+			/* Too many clients */
+			close(fd);
+			continue;
+		}
+		memset(&sock_clients[sock_client_nr], 0, sizeof(struct sock_client));
+		sock_clients[sock_client_nr++].fd = fd;
+
+		if (!sock_queue(sock_client_nr - 1, &hello, SADC_HELLO_SIZE, FALSE)) {
+			sock_queue(sock_client_nr - 1, sock_hdr, sock_hdr_len, FALSE);
+		}
+	}
+}
+
+#ifdef TEST
+/*
+ ***************************************************************************
+ * Wait for a first client to connect to the broadcast socket. In test
+ * mode, samples are not spaced in time: This ensures that the client
+ * receives all the records.
+ ***************************************************************************
+ */
+void sock_wait_client(void)
+{
+	struct pollfd pfd;
+
+	pfd.fd = sock_fd;
+	pfd.events = POLLIN;
+
+	while (!sock_client_nr) {
+		if ((poll(&pfd, 1, -1) < 0) && (errno != EINTR)) {
+			perror("poll");
+			exit(4);
+		}
+		accept_socket_clients();
+	}
+}
+#endif
+
+/*
+ ***************************************************************************
+ * Send the stream header to all the clients of the broadcast socket.
+ * Used when a file has been rotated, since the number of items may have
+ * changed.
+ ***************************************************************************
+ */
+void sock_write_hdr(void)
+{
+	int i;
+
+	setup_socket_hdr();
+
+	/* Browse list backwards since disconnected clients are replaced by the last one */
+	for (i = sock_client_nr - 1; i >= 0; i--) {
+		sock_queue(i, sock_hdr, sock_hdr_len, FALSE);
+	}
+}
+
+/*
+ ***************************************************************************
+ * Accept new clients on the broadcast socket, then send them current
+ * record.
+ ***************************************************************************
+ */
+void sock_write_stats(void)
+{
+	int i;
+	size_t rec_len;
+
+	accept_socket_clients();
+
+	if (!sock_client_nr)
+		return;
+
+	rec_len = get_record_len(FALSE);
+	if (rec_len > sock_buf_alloc) {
+		SREALLOC(sock_buf, char, rec_len);
+		sock_buf_alloc = rec_len;
+	}
+	fill_record(sock_buf);
+
+	for (i = sock_client_nr - 1; i >= 0; i--) {
+		/* R_LAST_STATS records are followed by a new header: Don't drop them */
+		sock_queue(i, sock_buf, rec_len,
+			   record_hdr.record_type != R_LAST_STATS);
+	}
+}
+
+/*
+ ***************************************************************************
+ * Wait until next sampling deadline (or a SIGINT or SIGTERM signal), while
+ * serving the broadcast socket: Accept new clients right away, and send
+ * queued data to the clients as soon as they can take them.
+ *
+ * IN:
+ * @deadline	Sampling deadline.
+ ***************************************************************************
+ */
+void sock_pause(const struct timespec *deadline)
+{
+	int i, n, timeout;
+	long long left_ns;
+	struct pollfd pfd[MAX_SOCK_CLIENTS + 1];
+
+	for (;;) {
+		if ((left_ns = -get_deadline_delay(deadline)) <= 0)
+			/* Deadline reached */
+			return;
+		/* Round up so that we never wake up before the deadline */
+		timeout = (int) ((left_ns + 999999) / 1000000);
+
+		pfd[0].fd = sock_fd;
+		pfd[0].events = POLLIN;
+
+		for (i = 0; i < sock_client_nr; i++) {
+			pfd[i + 1].fd = sock_clients[i].fd;
+			/* Also watch clients with nothing to send, to detect they have gone */
+			pfd[i + 1].events = (sock_clients[i].pos < sock_clients[i].len) ? POLLOUT : 0;
+		}
+		n = sock_client_nr + 1;
+
+		if (poll(pfd, n, timeout) < 0)
+			/* Most likely interrupted by a signal */
+			return;
+
+		/* Browse list backwards since disconnected clients are replaced by the last one */
+		for (i = n - 2; i >= 0; i--) {
+			if (pfd[i + 1].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+				sock_drop_client(i);
+			}
+			else if (pfd[i + 1].revents & POLLOUT) {
+				sock_flush(i);
+			}
+		}
+
+		if (pfd[0].revents & POLLIN) {
+			accept_socket_clients();
+		}
+	}
+}
+
+/*
+ ***************************************************************************
+ * Set the first sampling deadline. Deadlines are aligned on wall-clock
+ * boundaries which are multiples of the interval (e.g. :00, :10, :20...
+ * with a 10 second interval), so that samples collected by different
+ * sadc instances or on different machines line up. The first sample is
+ * collected immediately, so the first interval may be up to half an
+ * interval shorter or longer than the others.
+ *
+ * OUT:
+ * @deadline	Deadline preceding the first aligned one, so that
+ *		next_deadline() returns the first aligned deadline.
+ ***************************************************************************
+ */
+void init_sample_deadline(struct timespec *deadline)
+{
+	struct timespec now;
+	unsigned long long mono_ns, real_ns, itv_ns = (unsigned long long) interval_ms * 1000000ULL;
+
+	if ((__clock_gettime(CLOCK_MONOTONIC, deadline) < 0) ||
+	    (__clock_gettime(CLOCK_REALTIME, &now) < 0))
+		return;
+
+	real_ns = (unsigned long long) now.tv_sec * 1000000000ULL + now.tv_nsec;
+	mono_ns = (unsigned long long) deadline->tv_sec * 1000000000ULL + deadline->tv_nsec;
+
+	/* Move the deadline back to the last wall-clock boundary */
+	mono_ns -= real_ns % itv_ns;
+	if (real_ns % itv_ns > itv_ns / 2) {
+		/* Don't make the first interval shorter than half an interval */
+		mono_ns += itv_ns;
+	}
+	deadline->tv_sec = mono_ns / 1000000000ULL;
+	deadline->tv_nsec = mono_ns % 1000000000ULL;
+}
+
+/*
+ ***************************************************************************
+ * Wait until next sampling deadline, or until a SIGINT or SIGTERM signal
+ * is caught.
+ *
+ * IN:
+ * @deadline	Previous sampling deadline.
+ *
+ * OUT:
+ * @deadline	Next sampling deadline.
+ * @skew_ns	Time elapsed between the deadline and the moment we woke up
+ *		(in nanoseconds).
+ *
+ * RETURNS:
+ * Number of deadlines that have been skipped because they had already
+ * expired.
+ ***************************************************************************
+ */
+unsigned int wait_sample_deadline(struct timespec *deadline, unsigned long long *skew_ns)
+{
+	unsigned int skipped;
+	long long delay;
+
+	skipped = next_deadline(deadline, interval_ms);
+
+#ifdef TEST
+	__pause();
+#else
+	if (sock_fd >= 0) {
+		sock_pause(deadline);
+	}
+	else {
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, deadline, NULL);
+	}
+#endif
+	delay = get_deadline_delay(deadline);
+	*skew_ns = delay > 0 ? (unsigned long long) delay : 0;
+
+	return skipped;
+}
+
 /*
  ***************************************************************************
  * Create a system activity daily data file.
@@ -1038,8 +1798,9 @@ void read_stats(void)
 {
 	int i;
 
-	/* Read system uptime in 1/100th of a second */
-	read_uptime(&(record_hdr.uptime_cs));
+	/* Read system uptime in nanoseconds and in 1/100th of a second */
+	read_uptime_ns(&(record_hdr.uptime_ns));
+	record_hdr.uptime_cs = record_hdr.uptime_ns / NSEC_PER_CS;
 
 	/* Take a snapshot of /proc/stat, shared by all activities below */
 	refresh_proc_stat();
@@ -1069,9 +1830,12 @@ void rw_sa_stat_loop(long count, int stdfd, int ofd, char ofile[],
 		     char sa_dir[])
 {
 	int do_sa_rotat = 0;
+	unsigned int skipped = 0;
+	unsigned long long skew_ns = 0;
 	uint64_t save_flags;
 	char new_ofile[MAX_FILE_LEN] = "";
 	struct tm rectime = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, NULL};
+	struct timespec deadline;
 
 	/* Set a handler for SIGINT and SIGTERM */
 	memset(&int_act, 0, sizeof(int_act));
@@ -1079,17 +1843,19 @@ void rw_sa_stat_loop(long count, int stdfd, int ofd, char ofile[],
 	sigaction(SIGINT, &int_act, NULL);
 	sigaction(SIGTERM, &int_act, NULL);
 
+	/* First sample is collected now, next ones on aligned deadlines */
+	init_sample_deadline(&deadline);
+
 	/* Main loop */
 	do {
 		/* Init all structures */
 		reset_stats();
 		memset(&record_hdr, 0, RECORD_HEADER_SIZE);
 
-		/* Save time */
-		record_hdr.ust_time = (unsigned long long) get_time(&rectime, 0);
-		record_hdr.hour     = rectime.tm_hour;
-		record_hdr.minute   = rectime.tm_min;
-		record_hdr.second   = rectime.tm_sec;
+		/* Save time, and how late we are compared to the sampling deadline */
+		save_record_time(&rectime);
+		record_hdr.skew_ns = skew_ns;
+		record_hdr.skipped_nr = skipped;
 
 		/* Set record type */
 		if (do_sa_rotat) {
@@ -1109,12 +1875,22 @@ void rw_sa_stat_loop(long count, int stdfd, int ofd, char ofile[],
 			flags = save_flags;
 		}
 
+		if (sock_fd >= 0) {
+			/* Send record to the clients of the broadcast socket */
+			sock_write_stats();
+		}
+
 		/* If the record type was R_LAST_STATS, tag it R_STATS before writing it */
 		record_hdr.record_type = R_STATS;
 		if (ofile[0]) {
 			write_stats(ofd);
 		}
 
+		if (shm_name[0]) {
+			/* Publish record in the shared memory live feed */
+			shm_write_stats();
+		}
+
 		if (do_sa_rotat) {
 			/*
 			 * Stats are written at the end of previous file *and* at the
@@ -1148,6 +1924,12 @@ void rw_sa_stat_loop(long count, int stdfd, int ofd, char ofile[],
 			if (stdfd >= 0) {
 				setup_file_hdr(stdfd);
 			}
+			if (shm_name[0]) {
+				setup_shm_feed(get_record_len(TRUE), TRUE);
+			}
+			if (sock_fd >= 0) {
+				sock_write_hdr();
+			}
 
 			/* Write stats to file again */
 			write_stats(ofd);
@@ -1168,11 +1950,8 @@ void rw_sa_stat_loop(long count, int stdfd, int ofd, char ofile[],
 		}
 
 		if (count) {
-			/*
-			 * Wait for a signal
-			 * (probably SIGALRM or SIGINT or even SIGTERM).
-			 */
-			__pause();
+			/* Wait for next sampling deadline (or SIGINT or SIGTERM) */
+			skipped = wait_sample_deadline(&deadline, &skew_ns);
 		}
 
 		if (sigint_caught)
@@ -1280,6 +2059,36 @@ int main(int argc, char **argv)
 			}
 		}
 
+		else if (!strncmp(argv[opt], "--shm", 5)) {
+			if (argv[opt][5] == '=') {
+				if (!argv[opt][6]) {
+					usage(argv[0]);
+				}
+				snprintf(shm_name, sizeof(shm_name), "%s", argv[opt] + 6);
+			}
+			else if (!argv[opt][5]) {
+				strcpy(shm_name, SHM_DEFAULT_NAME);
+			}
+			else {
+				usage(argv[0]);
+			}
+		}
+
+		else if (!strncmp(argv[opt], "--socket", 8)) {
+			if (argv[opt][8] == '=') {
+				if (!argv[opt][9]) {
+					usage(argv[0]);
+				}
+				snprintf(sock_path, sizeof(sock_path), "%s", argv[opt] + 9);
+			}
+			else if (!argv[opt][8]) {
+				strcpy(sock_path, SADC_SOCKET);
+			}
+			else {
+				usage(argv[0]);
+			}
+		}
+
 #ifdef TEST
 		else if (!strncmp(argv[opt], "--getenv", 8)) {
 			__env = TRUE;
@@ -1293,7 +2102,9 @@ int main(int argc, char **argv)
 		}
 #endif
 
-		else if (strspn(argv[opt], DIGITS) != strlen(argv[opt])) {
+		else if ((strspn(argv[opt], DIGITS) != strlen(argv[opt])) &&
+			 /* A decimal value is accepted for the interval */
+			 ((interval >= 0) || (parse_interval(argv[opt]) < 0))) {
 			if (ofile[0] || WANT_SA_ROTAT(flags)) {
 				/* Outfile already specified */
 				usage(argv[0]);
@@ -1315,10 +2126,11 @@ int main(int argc, char **argv)
 
 		else if (interval < 0) {
 			/* Get interval */
-			interval = atol(argv[opt]);
-			if (interval < 1) {
+			interval_ms = parse_interval(argv[opt]);
+			if (interval_ms < 1) {
 				usage(argv[0]);
 			}
+			interval = (interval_ms + 999) / 1000;
 			count = -1;
 		}
 
@@ -1370,6 +2182,10 @@ int main(int argc, char **argv)
 	if (optz) {
 		stdfd = 0;
 	}
+	else if ((sock_path[0] || shm_name[0]) && !ofile[0]) {
+		/* No output file: Live feeds are then the only outputs */
+		stdfd = -1;
+	}
 
 	if (!ofile[0]) {
 		/* -L option ignored when writing to STDOUT */
@@ -1430,11 +2246,18 @@ int main(int argc, char **argv)
 		exit(0);
 	}
 
-	/* Set a handler for SIGALRM */
-	memset(&alrm_act, 0, sizeof(alrm_act));
-	alrm_act.sa_handler = alarm_handler;
-	sigaction(SIGALRM, &alrm_act, NULL);
-	__alarm(interval);
+	if (shm_name[0]) {
+		/* Create shared memory live feed */
+		setup_shm_feed(get_record_len(TRUE), TRUE);
+	}
+
+	if (sock_path[0]) {
+		/* Create broadcast socket */
+		setup_socket();
+#ifdef TEST
+		sock_wait_client();
+#endif
+	}
 
 	/* Main loop */
 	rw_sa_stat_loop(count, stdfd, ofd, ofile, sa_dir);
@@ -119,9 +119,10 @@ void usage(char *progname)
 		progname);
 
 	fprintf(stderr, _("Options are:\n"
-			  "[ -C ] [ -c | -d | -g | -j | -l | -p | -r | -x ] [ -H ] [ -h ] [ -T | -t | -U ] [ -V ]\n"
+			  "[ -C ] [ -c | -d | -g | -j | -l | -m | -p | -r | -x ] [ -H ] [ -h ] [ -T | -t | -U ] [ -V ]\n"
 			  "[ -O <opts> [,...] ] [ -P { <cpu> [,...] | ALL } ]\n"
 			  "[ --dev=<dev_list> ] [ --fs=<fs_list> ] [ --iface=<iface_list> ] [ --int=<int_list> ]\n"
+			  "[ --cgroup[=<cgroup_list>] ] [ --cgroup-psi[=<cgroup_list>] ]\n"
 			  "[ -s [ <start_time> ] ] [ -e [ <end_time> ] ]\n"
 			  "[ -- <sar_options> ]\n"));
 	exit(1);
@@ -793,8 +794,8 @@ int generic_write_stats(int curr, enum time_mode use_tm_start, enum time_mode us
 				}
 			}
 
-			else if (format == F_PCP_OUTPUT) {
-				/* PCP archive */
+			else if ((format == F_PCP_OUTPUT) || (format == F_OM_OUTPUT)) {
+				/* PCP archive or OpenMetrics output */
 				if (*act[i]->f_pcp_print) {
 					(*act[i]->f_pcp_print)(act[i], curr);
 				}
@@ -1722,6 +1723,32 @@ int main(int argc, char **argv)
 			act[q]->options |= AO_LIST_ON_CMDLINE;
 		}
 
+		else if (!strncmp(argv[opt], "--cgroup-psi", 12) &&
+			 ((argv[opt][12] == '\0') || (argv[opt][12] == '='))) {
+			/* Select cgroups pressure-stall activity, possibly for a list of cgroups */
+			SELECT_ACTIVITY(A_PSI_CGROUP);
+			if (argv[opt][12] == '=') {
+				p = get_activity_position(act, A_PSI_CGROUP, EXIT_IF_NOT_FOUND);
+				parse_sa_devices(argv[opt], act[p], MAX_CG_LEN, &opt, 13, NO_RANGE);
+			}
+			else {
+				opt++;
+			}
+		}
+
+		else if (!strncmp(argv[opt], "--cgroup", 8) &&
+			 ((argv[opt][8] == '\0') || (argv[opt][8] == '='))) {
+			/* Select cgroups activity, possibly for a list of cgroups */
+			SELECT_ACTIVITY(A_CGROUP);
+			if (argv[opt][8] == '=') {
+				p = get_activity_position(act, A_CGROUP, EXIT_IF_NOT_FOUND);
+				parse_sa_devices(argv[opt], act[p], MAX_CG_LEN, &opt, 9, NO_RANGE);
+			}
+			else {
+				opt++;
+			}
+		}
+
 		else if (!strncmp(argv[opt], "--int=", 6)) {
 			/* Parse interrupts names entered on the command line */
 			p = get_activity_position(act, A_IRQ, EXIT_IF_NOT_FOUND);
@@ -1827,11 +1854,11 @@ int main(int argc, char **argv)
 			opt++;
 		}
 
-		else if (!strcmp(argv[opt], "-m")) {
-			if (!argv[++opt] || !sar_options) {
+		else if (!strcmp(argv[opt], "-m") && sar_options) {
+			if (!argv[++opt]) {
 				usage(argv[0]);
 			}
-			/* Parse sar's option -m */
+			/* Parse sar's option -m (sadf's own option -m is tested below) */
 			if (parse_sar_m_opt(argv, &opt, act)) {
 				usage(argv[0]);
 			}
@@ -1924,6 +1951,13 @@ int main(int argc, char **argv)
 						format = F_PCP_OUTPUT;
 						break;
 
+					case 'm':
+						if (format) {
+							usage(argv[0]);
+						}
+						format = F_OM_OUTPUT;
+						break;
+
 					case 'p':
 						if (format) {
 							usage(argv[0]);
@@ -102,6 +102,56 @@ enum {
 #define CREATE_ITEM_LIST(m)		(((m) & FO_ITEM_LIST)		== FO_ITEM_LIST)
 #define ORDER_ALL_RECORDS(m)		(((m) & FO_FULL_ORDER)		== FO_FULL_ORDER)
 
+/*
+ ***************************************************************************
+ * OpenMetrics output.
+ ***************************************************************************
+ */
+
+/* Prefix added to metric names */
+#define OM_PREFIX		"sysstat_"
+/* Number of hash buckets for metric families */
+#define OM_FAM_HASH_SIZE	1024
+/* Initial number of hash buckets for samples (doubled as needed) */
+#define OM_SMP_HASH_SIZE	1024
+#define OM_VALUE_LEN		64
+#define OM_NAME_LEN		128
+
+/*
+ * Structure for one sample (one instance of a metric family).
+ * Only its latest value is kept.
+ */
+struct om_sample {
+	/* Next sample in hash chain */
+	struct om_sample *hnext;
+	/* Next sample belonging to the same family */
+	struct om_sample *next;
+	struct om_family *family;
+	/* Instance name, NULL for metrics without instances */
+	char *inst;
+	/* Record the value belongs to. 0 means the file header. */
+	unsigned long long gen;
+	unsigned int hash;
+	char value[OM_VALUE_LEN];
+};
+
+/* Structure for one metric family (one PCP metric) */
+struct om_family {
+	/* Next family in hash chain */
+	struct om_family *hnext;
+	/* Next family in definition order */
+	struct om_family *next;
+	struct om_sample *first;
+	struct om_sample *last;
+	/* PCP metric name */
+	char *name;
+	/* Name of the label used for instances */
+	char *label;
+	/* PCP semantics (counter, instant, discrete) */
+	int sem;
+	char om_name[OM_NAME_LEN];
+};
+
 
 /*
  ***************************************************************************
@@ -175,6 +225,9 @@ __tm_funct_t print_raw_timestamp
 __tm_funct_t print_pcp_timestamp
 	(void *, int, char *, char *, char *, unsigned long long,
 	 struct record_header *, struct file_header *, unsigned int);
+__tm_funct_t print_om_timestamp
+	(void *, int, char *, char *, char *, unsigned long long,
+	 struct record_header *, struct file_header *, unsigned int);
 
 /*
  * Prototypes used to display the report header
@@ -194,6 +247,9 @@ __printf_funct_t print_svg_header
 __printf_funct_t print_pcp_header
 	(void *, int, char *, char *, struct file_magic *, struct file_header *,
 	 struct activity * [], unsigned int [], struct file_activity *);
+__printf_funct_t print_om_header
+	(void *, int, char *, char *, struct file_magic *, struct file_header *,
+	 struct activity * [], unsigned int [], struct file_activity *);
 
 /*
  * Main display functions
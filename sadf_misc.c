@@ -20,11 +20,12 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 #include <time.h>
 
 #include "sadf.h"
-#include "pcp_def_metrics.h"
 
 #ifdef USE_NLS
 #include <locale.h>
@@ -39,7 +40,10 @@
 #include <pcp/import.h>
 #endif
 
+#include "pcp_def_metrics.h"
+
 extern uint64_t flags;
+extern unsigned int format;
 extern char *seps[];
 
 extern int palette;
@@ -68,6 +72,382 @@ void pcp_write_data(struct record_header *record_hdr, unsigned int flags)
 #endif
 }
 
+/*
+ ***************************************************************************
+ * OpenMetrics families and samples. Samples are looked up with hash
+ * tables since the same values are updated for every record in file.
+ ***************************************************************************
+ */
+struct om_family *om_fam_hash[OM_FAM_HASH_SIZE];
+struct om_family *om_fam_first = NULL, *om_fam_last = NULL;
+struct om_sample **om_smp_hash = NULL;
+unsigned int om_smp_hash_sz = 0, om_smp_nr = 0;
+unsigned long long om_gen = 0;
+
+/*
+ * Name of the label used for instances, depending on the beginning
+ * of the PCP metric name. The first matching entry is used.
+ */
+struct om_label {
+	char *prefix;
+	char *label;
+} om_labels[] = {
+	{"kernel.percpu.interrupts",	"interrupt"},
+	{"kernel.all.interrupts",	"interrupt"},
+	{"kernel.all.load",		"period"},
+	{"kernel.all.pressure",		"period"},
+	{"kernel.percpu",		"cpu"},
+	{"hinv.cpu",			"cpu"},
+	{"network.softnet.percpu",	"cpu"},
+	{"network.interface",		"iface"},
+	{"disk.dev",			"device"},
+	{"filesys",			"fs"},
+	{"fchost",			"fchost"},
+	{"tty.serial",			"serial"},
+	{"nfs",				"request"},
+	{"power.bat",			"battery"},
+	{"power.usb",			"usb"},
+	{"power",			"sensor"},
+	{"cgroup",			"cgroup"},
+	{NULL,				"instance"}
+};
+
+/*
+ ***************************************************************************
+ * Compute hash value of a string (FNV-1a).
+ *
+ * IN:
+ * @str		String to hash.
+ * @hash	Initial hash value. Used to chain several strings.
+ *
+ * RETURNS:
+ * Hash value.
+ ***************************************************************************
+ */
+unsigned int om_hash(const char *str, unsigned int hash)
+{
+	while (*str) {
+		hash ^= (unsigned char) *str++;
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+/*
+ ***************************************************************************
+ * Look for an OpenMetrics family.
+ *
+ * IN:
+ * @name	PCP metric name.
+ *
+ * RETURNS:
+ * Pointer on the family, or NULL if not found.
+ ***************************************************************************
+ */
+struct om_family *om_get_family(const char *name)
+{
+	struct om_family *f;
+
+	for (f = om_fam_hash[om_hash(name, 2166136261U) % OM_FAM_HASH_SIZE];
+	     f != NULL; f = f->hnext) {
+		if (!strcmp(f->name, name))
+			return f;
+	}
+
+	return NULL;
+}
+
+/*
+ ***************************************************************************
+ * Create a new OpenMetrics family for a PCP metric. Its name is the PCP
+ * one with OM_PREFIX added and dots replaced with underscores.
+ *
+ * IN:
+ * @name	PCP metric name.
+ * @type	PCP metric type.
+ * @sem		PCP metric semantics.
+ ***************************************************************************
+ */
+void om_add_family(const char *name, int type, int sem)
+{
+	struct om_family *f;
+	struct om_label *l;
+	unsigned int h;
+	char *c;
+	size_t len;
+
+	/* String metrics cannot be exposed as samples */
+	if ((type == PM_TYPE_STRING) || om_get_family(name))
+		return;
+
+	f = NULL;
+	SREALLOC(f, struct om_family, sizeof(struct om_family));
+	memset(f, 0, sizeof(struct om_family));
+	if ((f->name = strdup(name)) == NULL) {
+		perror("strdup");
+		exit(4);
+	}
+	f->sem = sem;
+
+	snprintf(f->om_name, sizeof(f->om_name), "%s%s", OM_PREFIX, name);
+	for (c = f->om_name; *c; c++) {
+		if (!isalnum((unsigned char) *c) && (*c != '_') && (*c != ':')) {
+			*c = '_';
+		}
+	}
+	/* Counter samples are displayed with a "_total" suffix */
+	len = strlen(f->om_name);
+	if ((sem == PM_SEM_COUNTER) && (len > 6) &&
+	    !strcmp(f->om_name + len - 6, "_total")) {
+		f->om_name[len - 6] = '\0';
+	}
+
+	for (l = om_labels; l->prefix != NULL; l++) {
+		if (!strncmp(name, l->prefix, strlen(l->prefix)))
+			break;
+	}
+	f->label = l->label;
+
+	h = om_hash(name, 2166136261U) % OM_FAM_HASH_SIZE;
+	f->hnext = om_fam_hash[h];
+	om_fam_hash[h] = f;
+
+	if (om_fam_last) {
+		om_fam_last->next = f;
+	}
+	else {
+		om_fam_first = f;
+	}
+	om_fam_last = f;
+}
+
+/*
+ ***************************************************************************
+ * Save the value of an OpenMetrics sample for current record.
+ *
+ * IN:
+ * @name	PCP metric name.
+ * @inst	Instance name (may be NULL).
+ * @value	Value of the sample.
+ ***************************************************************************
+ */
+void om_put_value(const char *name, const char *inst, const char *value)
+{
+	struct om_family *f;
+	struct om_sample *s, **tab;
+	unsigned int h, i, sz;
+
+	if ((f = om_get_family(name)) == NULL)
+		/* Metric not defined (e.g. string metric) */
+		return;
+
+	h = om_hash(inst ? inst : "", om_hash(name, 2166136261U));
+
+	if (om_smp_hash) {
+		for (s = om_smp_hash[h & (om_smp_hash_sz - 1)]; s != NULL; s = s->hnext) {
+			if ((s->hash == h) && (s->family == f) &&
+			    ((!s->inst && !inst) ||
+			     (s->inst && inst && !strcmp(s->inst, inst))))
+				goto save_value;
+		}
+	}
+
+	if (om_smp_nr >= om_smp_hash_sz * 2) {
+		/* Double the size of the hash table */
+		sz = om_smp_hash_sz ? om_smp_hash_sz * 2 : OM_SMP_HASH_SIZE;
+		tab = NULL;
+		SREALLOC(tab, struct om_sample *, sizeof(struct om_sample *) * sz);
+		memset(tab, 0, sizeof(struct om_sample *) * sz);
+
+		for (i = 0; i < om_smp_hash_sz; i++) {
+			while ((s = om_smp_hash[i]) != NULL) {
+				om_smp_hash[i] = s->hnext;
+				s->hnext = tab[s->hash & (sz - 1)];
+				tab[s->hash & (sz - 1)] = s;
+			}
+		}
+		free(om_smp_hash);
+		om_smp_hash = tab;
+		om_smp_hash_sz = sz;
+	}
+
+	/* New sample */
+	s = NULL;
+	SREALLOC(s, struct om_sample, sizeof(struct om_sample));
+	memset(s, 0, sizeof(struct om_sample));
+	if (inst && ((s->inst = strdup(inst)) == NULL)) {
+		perror("strdup");
+		exit(4);
+	}
+	s->family = f;
+	s->hash = h;
+	s->hnext = om_smp_hash[h & (om_smp_hash_sz - 1)];
+	om_smp_hash[h & (om_smp_hash_sz - 1)] = s;
+	om_smp_nr++;
+
+	if (f->last) {
+		f->last->next = s;
+	}
+	else {
+		f->first = s;
+	}
+	f->last = s;
+
+save_value:
+	strncpy(s->value, value, sizeof(s->value) - 1);
+	s->gen = om_gen;
+}
+
+/*
+ ***************************************************************************
+ * Display a label value, escaping characters as needed.
+ *
+ * IN:
+ * @str		Label value.
+ ***************************************************************************
+ */
+void om_print_label_value(const char *str)
+{
+	for (; *str; str++) {
+		switch (*str) {
+
+			case '\\':
+			case '"':
+				printf("\\%c", *str);
+				break;
+
+			case '\n':
+				printf("\\n");
+				break;
+
+			default:
+				putchar(*str);
+		}
+	}
+}
+
+/*
+ ***************************************************************************
+ * Display OpenMetrics families with the values of the latest record,
+ * then free them.
+ ***************************************************************************
+ */
+void om_print_families(void)
+{
+	struct om_family *f, *fn;
+	struct om_sample *s, *sn;
+	int hdr;
+
+	for (f = om_fam_first; f != NULL; f = fn) {
+		hdr = FALSE;
+
+		for (s = f->first; s != NULL; s = sn) {
+			sn = s->next;
+
+			/* Display only values from file header or from latest record */
+			if (!s->gen || (s->gen == om_gen)) {
+				if (!hdr) {
+					printf("# TYPE %s %s\n", f->om_name,
+					       f->sem == PM_SEM_COUNTER ? "counter" : "gauge");
+					hdr = TRUE;
+				}
+				printf("%s%s", f->om_name,
+				       f->sem == PM_SEM_COUNTER ? "_total" : "");
+				if (s->inst) {
+					printf("{%s=\"", f->label);
+					om_print_label_value(s->inst);
+					printf("\"}");
+				}
+				printf(" %s\n", s->value);
+			}
+
+			free(s->inst);
+			free(s);
+		}
+
+		fn = f->next;
+		free(f->name);
+		free(f);
+	}
+
+	free(om_smp_hash);
+	om_smp_hash = NULL;
+	om_smp_hash_sz = om_smp_nr = 0;
+	memset(om_fam_hash, 0, sizeof(om_fam_hash));
+	om_fam_first = om_fam_last = NULL;
+}
+
+/*
+ ***************************************************************************
+ * Define a metric for PCP or OpenMetrics output.
+ *
+ * IN:
+ * @name	Metric name.
+ * @pmid	PCP metric identifier.
+ * @type	Metric type.
+ * @indom	Instance domain.
+ * @sem		Metric semantics.
+ * @units	Metric units.
+ ***************************************************************************
+ */
+void pcp_add_metric(const char *name, pmID pmid, int type, pmInDom indom,
+		    int sem, pmUnits units)
+{
+#ifdef HAVE_PCP
+	if (format == F_PCP_OUTPUT) {
+		pmiAddMetric(name, pmid, type, indom, sem, units);
+		return;
+	}
+#endif
+	if (format == F_OM_OUTPUT) {
+		om_add_family(name, type, sem);
+	}
+}
+
+/*
+ ***************************************************************************
+ * Define an instance for PCP output. Nothing needs to be done for
+ * OpenMetrics output: Instances are created along with their values.
+ *
+ * IN:
+ * @indom	Instance domain.
+ * @name	Instance name.
+ * @inst	Instance identifier.
+ ***************************************************************************
+ */
+void pcp_add_instance(pmInDom indom, const char *name, int inst)
+{
+#ifdef HAVE_PCP
+	if (format == F_PCP_OUTPUT) {
+		pmiAddInstance(indom, name, inst);
+	}
+#endif
+}
+
+/*
+ ***************************************************************************
+ * Save the value of a metric for PCP or OpenMetrics output.
+ *
+ * IN:
+ * @name	Metric name.
+ * @inst	Instance name (may be NULL).
+ * @value	Metric value.
+ ***************************************************************************
+ */
+void pcp_put_value(const char *name, const char *inst, const char *value)
+{
+#ifdef HAVE_PCP
+	if (format == F_PCP_OUTPUT) {
+		pmiPutValue(name, inst, value);
+		return;
+	}
+#endif
+	if (format == F_OM_OUTPUT) {
+		om_put_value(name, inst, value);
+	}
+}
+
 /*
  ***************************************************************************
  * Display restart messages (database and ppc formats).
@@ -619,7 +999,7 @@ __printf_funct_t print_json_statistics(int *tab, int action, struct activity *ac
 
 /*
  ***************************************************************************
- * Display the "statistics" part of the report (PCP format).
+ * Display the "statistics" part of the report (PCP and OpenMetrics formats).
  *
  * IN:
  * @tab		Number of tabulations (unused here).
@@ -631,7 +1011,6 @@ __printf_funct_t print_json_statistics(int *tab, int action, struct activity *ac
 __printf_funct_t print_pcp_statistics(int *tab, int action, struct activity *act[],
 				      unsigned int id_seq[])
 {
-#ifdef HAVE_PCP
 	if (action & F_BEGIN) {
 		int i, p;
 
@@ -798,10 +1177,17 @@ __printf_funct_t print_pcp_statistics(int *tab, int action, struct activity *act
 				case A_PSI_MEM:
 					pcp_def_psi_metrics(act[p]);
 					break;
+
+				case A_CGROUP:
+					pcp_def_cgroup_metrics(act[p]);
+					break;
+
+				case A_PSI_CGROUP:
+					pcp_def_psi_cgroup_metrics(act[p]);
+					break;
 			}
 		}
 	}
-#endif /* HAVE_PCP */
 }
 
 /*
@@ -1080,6 +1466,40 @@ __tm_funct_t print_pcp_timestamp(void *parm, int action, char *cur_date,
 	return NULL;
 }
 
+/*
+ ***************************************************************************
+ * Display the "timestamp" part of the report (OpenMetrics format).
+ * Only the values of the latest record are displayed, hence nothing is
+ * printed here.
+ *
+ * IN:
+ * @parm	Pointer on specific parameters (unused here).
+ * @action	Action expected from current function.
+ * @cur_date	Date string of current record (unused here).
+ * @cur_time	Time string of current record (unused here).
+ * @my_tz	Current timezone (unused here).
+ * @itv		Interval of time with preceding record (unused here).
+ * @record_hdr	Record header for current sample (unused here).
+ * @file_hdr	System activity file standard header (unused here).
+ * @flags	Flags for common options (unused here).
+ *
+ * RETURNS:
+ * Pointer on the "timestamp" string.
+ ***************************************************************************
+ */
+__tm_funct_t print_om_timestamp(void *parm, int action, char *cur_date,
+				char *cur_time, char *my_tz, unsigned long long itv,
+				struct record_header *record_hdr,
+				struct file_header *file_hdr, unsigned int flags)
+{
+	if (action & F_BEGIN) {
+		/* Values saved from now on belong to a new record */
+		om_gen++;
+	}
+
+	return NULL;
+}
+
 /*
  ***************************************************************************
  * Display the header of the report (XML format).
@@ -1503,6 +1923,60 @@ __printf_funct_t print_pcp_header(void *parm, int action, char *dfile, char *my_
 #endif
 }
 
+/*
+ ***************************************************************************
+ * OpenMetrics header function. Metrics are displayed once all the records
+ * have been read, with the values of the latest one.
+ *
+ * IN:
+ * @parm	Specific parameter (unused here).
+ * @action	Action expected from current function.
+ * @dfile	Name of system activity data file (unused here).
+ * @my_tz	Current timezone (unused here).
+ * @file_magic	System activity file magic header (unused here).
+ * @file_hdr	System activity file standard header.
+ * @act		Array of activities (unused here).
+ * @id_seq	Activity sequence (unused here).
+ * @file_actlst	List of (known or unknown) activities in file (unused here).
+ ***************************************************************************
+ */
+__printf_funct_t print_om_header(void *parm, int action, char *dfile, char *my_tz,
+				 struct file_magic *file_magic,
+				 struct file_header *file_hdr,
+				 struct activity *act[], unsigned int id_seq[],
+				 struct file_activity *file_actlst)
+{
+	char buf[64];
+
+	if (action & F_BEGIN) {
+		/* Save number of CPU */
+		pcp_add_metric("hinv.ncpu",
+			       pmiID(60, 0, 32), PM_TYPE_U32, PM_INDOM_NULL,
+			       PM_SEM_DISCRETE, pmiUnits(0, 0, 0, 0, 0, 0));
+		snprintf(buf, sizeof(buf), "%u",
+			 file_hdr->sa_cpu_nr > 1 ? file_hdr->sa_cpu_nr - 1 : 1);
+		pcp_put_value("hinv.ncpu", NULL, buf);
+	}
+
+	if (action & F_END) {
+		om_print_families();
+
+		/* Display uname(2) information */
+		printf("# TYPE %skernel_uname_info gauge\n", OM_PREFIX);
+		printf("%skernel_uname_info{nodename=\"", OM_PREFIX);
+		om_print_label_value(file_hdr->sa_nodename);
+		printf("\",release=\"");
+		om_print_label_value(file_hdr->sa_release);
+		printf("\",sysname=\"");
+		om_print_label_value(file_hdr->sa_sysname);
+		printf("\",machine=\"");
+		om_print_label_value(file_hdr->sa_machine);
+		printf("\"} 1\n");
+
+		printf("# EOF\n");
+	}
+}
+
 /*
  ***************************************************************************
  * Count the number of new network interfaces in current sample. If a new
@@ -1725,6 +2199,63 @@ __nr_t count_new_bat(struct activity *a, int curr)
 	return nr;
 }
 
+/*
+ ***************************************************************************
+ * Count the number of new cgroups in current sample. If a new cgroup
+ * is found then add it to the linked list starting at @a->item_list.
+ *
+ * IN:
+ * @a		Activity structure with statistics.
+ * @curr	Index in array for current sample statistics.
+ *
+ * RETURNS:
+ * Number of new cgroups identified in current sample that were not
+ * previously in the list.
+ ***************************************************************************
+ */
+__nr_t count_new_cgroup(struct activity *a, int curr)
+{
+	int i, nr = 0;
+	struct stats_cgroup *scc;
+
+	for (i = 0; i < a->nr[curr]; i++) {
+		scc = (struct stats_cgroup *) ((char *) a->buf[curr] + i * a->msize);
+
+		nr += add_list_item(&(a->item_list), scc->cgroup_name, MAX_CG_LEN, NULL);
+	}
+
+	return nr;
+}
+
+/*
+ ***************************************************************************
+ * Count the number of new cgroups in current sample for cgroups
+ * pressure-stall statistics. If a new cgroup is found then add it to the
+ * linked list starting at @a->item_list.
+ *
+ * IN:
+ * @a		Activity structure with statistics.
+ * @curr	Index in array for current sample statistics.
+ *
+ * RETURNS:
+ * Number of new cgroups identified in current sample that were not
+ * previously in the list.
+ ***************************************************************************
+ */
+__nr_t count_new_psi_cgroup(struct activity *a, int curr)
+{
+	int i, nr = 0;
+	struct stats_psi_cgroup *spcc;
+
+	for (i = 0; i < a->nr[curr]; i++) {
+		spcc = (struct stats_psi_cgroup *) ((char *) a->buf[curr] + i * a->msize);
+
+		nr += add_list_item(&(a->item_list), spcc->cgroup_name, MAX_CG_LEN, NULL);
+	}
+
+	return nr;
+}
+
 /*
  ***************************************************************************
  * Init custom color palette used to draw graphs (sadf -g).
@@ -27,6 +27,8 @@
 #include <errno.h>
 #include <signal.h>
 #include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 #include <ctype.h>
 
 #include "version.h"
@@ -100,6 +102,18 @@ extern struct report_format sar_fmt;
 struct sigaction int_act;
 int sigint_caught = 0;
 
+/* Shared memory live feed published by sadc (option --shm) */
+char shm_name[MAX_FILE_LEN];
+struct shm_feed feed;
+
+/* Descriptor from which data sent by sadc are read */
+int sadc_fd = STDIN_FILENO;
+/* Stream header already received from sadc broadcast socket */
+char *sock_hdr = NULL;
+size_t sock_hdr_len = 0, sock_hdr_pos = 0;
+/* Number of records sent by sadc on its broadcast socket for each record displayed */
+long rec_ratio = 1;
+
 /*
  ***************************************************************************
  * Print usage title message.
@@ -134,7 +148,9 @@ void usage(char *progname)
 			  "[ -q [ <keyword> [,...] | ALL ] ]\n"
 			  "[ --dev=<dev_list> ] [ --fs=<fs_list> ] [ --iface=<iface_list> ] "
 			  "[ --int=<int_list> ]\n"
+			  "[ --cgroup[=<cgroup_list>] ] [ --cgroup-psi[=<cgroup_list>] ]\n"
 			  "[ --dec={ 0 | 1 | 2 } ] [ --help ] [ --human ] [ --pretty ] [ --sadc ]\n"
+			  "[ --shm[=<name>] ]\n"
 			  "[ -j { SID | ID | LABEL | PATH | UUID | ... } ]\n"
 			  "[ -f [ <filename> ] | -o [ <filename> ] | -[0-9]+ ]\n"
 			  "[ -i <interval> ] [ -s [ <start_time> ] ] [ -e [ <end_time> ] ]\n"));
@@ -210,6 +226,10 @@ void display_help(char *progname)
 	printf(_("\t-W\tSwapping statistics [A_SWAP]\n"));
 	printf(_("\t-w\tTask creation and system switching statistics [A_PCSW]\n"));
 	printf(_("\t-y\tTTY devices statistics [A_SERIAL]\n"));
+	printf(_("\t--cgroup[=<cgroup_list>]\n"
+		 "\t\tCgroups statistics [A_CGROUP]\n"));
+	printf(_("\t--cgroup-psi[=<cgroup_list>]\n"
+		 "\t\tCgroups pressure-stall statistics [A_PSI_CGROUP]\n"));
 	exit(0);
 }
 
@@ -588,9 +608,25 @@ size_t sa_read(void *buffer, size_t size)
 {
 	ssize_t n;
 
+	if (shm_name[0])
+		/* Data have been fetched from the shared memory live feed */
+		return shm_read_feed(&feed, buffer, size);
+
+	if (sock_hdr_pos < sock_hdr_len) {
+		/* Stream header already received from sadc broadcast socket */
+		n = MINIMUM(size, sock_hdr_len - sock_hdr_pos);
+		memcpy(buffer, sock_hdr + sock_hdr_pos, n);
+		sock_hdr_pos += n;
+		size -= n;
+		buffer = (char *) buffer + n;
+	}
+
 	while (size) {
 
-		if ((n = read(STDIN_FILENO, buffer, size)) < 0) {
+		if ((n = read(sadc_fd, buffer, size)) < 0) {
+			if ((errno == EINTR) && sigint_caught)
+				/* SIGINT or SIGTERM received while waiting for sadc */
+				return size;
 			perror("read");
 			exit(2);
 		}
@@ -1193,6 +1229,146 @@ void read_stats_from_file(char from_file[])
 	free(file_actlst);
 }
 
+/*
+ ***************************************************************************
+ * Wait for a new record to be published by sadc in the shared memory live
+ * feed, then fetch it.
+ *
+ * IN:
+ * @wait_itv	TRUE if we should first wait for @interval seconds.
+ *
+ * RETURNS:
+ * SHM_NEW_RECORD or SHM_NEW_HEADER (see shm_fetch_record()), or
+ * SHM_NO_RECORD if SIGINT or SIGTERM has been received meanwhile.
+ ***************************************************************************
+ */
+int wait_shm_record(int wait_itv)
+{
+	int rc;
+	struct timespec ts = {0, SHM_POLL_DELAY};
+
+	if (wait_itv) {
+		sleep(interval);
+	}
+
+	while (!sigint_caught) {
+
+		if ((rc = shm_fetch_record(&feed)) < 0) {
+			fprintf(stderr, _("Invalid shared memory live feed (%s)\n"), shm_name);
+			exit(2);
+		}
+		if (rc != SHM_NO_RECORD)
+			return rc;
+
+		/* sadc hasn't published a new record yet */
+		nanosleep(&ts, NULL);
+	}
+
+	return SHM_NO_RECORD;
+}
+
+/*
+ ***************************************************************************
+ * Try to subscribe to the broadcast socket of a running sadc instead of
+ * starting a new data collector. The subscription is kept only if sadc
+ * comes from the same sysstat version, sends all the activities selected
+ * and if its interval is a divisor of ours.
+ * The stream header received is saved so that it can be read again
+ * by read_header_data().
+ *
+ * RETURNS:
+ * TRUE if sar has subscribed to sadc's broadcast socket.
+ ***************************************************************************
+ */
+int subscribe_sadc(void)
+{
+	int fd, i, j;
+	char *path;
+	size_t off;
+	struct sockaddr_un addr;
+	struct sadc_hello hello;
+	struct file_magic file_magic, fm;
+	struct file_header fh;
+	struct file_activity file_act;
+
+	if ((path = getenv(ENV_SADC_SOCKET)) == NULL) {
+#ifdef TEST
+		/* Don't subscribe to a sadc which may be running on the test machine */
+		return FALSE;
+#else
+		path = SADC_SOCKET;
+#endif
+	}
+	if (!path[0] || (strlen(path) >= sizeof(addr.sun_path)))
+		return FALSE;
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, path);
+
+	if ((fd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0)
+		return FALSE;
+
+	if (connect(fd, (struct sockaddr *) &addr, sizeof(addr)) < 0)
+		goto fallback;
+	sadc_fd = fd;
+
+	/* Read hello message and check sadc interval */
+	if (sa_read(&hello, SADC_HELLO_SIZE) || (hello.hello_magic != SADC_HELLO_MAGIC) ||
+	    !hello.interval_ms || ((interval * 1000) % hello.interval_ms))
+		goto fallback;
+
+	/* Read magic header and check version */
+	enum_version_nr(&fm);
+	if (sa_read(&file_magic, FILE_MAGIC_SIZE) ||
+	    (file_magic.sysstat_magic != SYSSTAT_MAGIC) ||
+	    (file_magic.format_magic != FORMAT_MAGIC) ||
+	    (file_magic.sysstat_version != fm.sysstat_version) ||
+	    (file_magic.sysstat_patchlevel != fm.sysstat_patchlevel) ||
+	    (file_magic.sysstat_sublevel != fm.sysstat_sublevel) ||
+	    (file_magic.sysstat_extraversion != fm.sysstat_extraversion))
+		goto fallback;
+
+	if (sa_read(&fh, FILE_HEADER_SIZE) || (fh.sa_act_nr > NR_ACT) ||
+	    (fh.act_size != FILE_ACTIVITY_SIZE))
+		goto fallback;
+
+	off = FILE_MAGIC_SIZE + FILE_HEADER_SIZE;
+	SREALLOC(sock_hdr, char, off + FILE_ACTIVITY_SIZE * fh.sa_act_nr);
+	memcpy(sock_hdr, &file_magic, FILE_MAGIC_SIZE);
+	memcpy(sock_hdr + FILE_MAGIC_SIZE, &fh, FILE_HEADER_SIZE);
+
+	if (sa_read(sock_hdr + off, FILE_ACTIVITY_SIZE * fh.sa_act_nr))
+		goto fallback;
+
+	/* Check that all selected activities are sent by sadc */
+	for (i = 0; i < NR_ACT; i++) {
+
+		if (!IS_SELECTED(act[i]->options))
+			continue;
+
+		for (j = 0; j < fh.sa_act_nr; j++) {
+			memcpy(&file_act, sock_hdr + off + FILE_ACTIVITY_SIZE * j, FILE_ACTIVITY_SIZE);
+			if (file_act.id == act[i]->id)
+				break;
+		}
+		if (j == fh.sa_act_nr)
+			goto fallback;
+	}
+
+	sock_hdr_len = off + FILE_ACTIVITY_SIZE * fh.sa_act_nr;
+	sock_hdr_pos = 0;
+	rec_ratio = interval * 1000 / hello.interval_ms;
+
+	return TRUE;
+
+fallback:
+	close(fd);
+	sadc_fd = STDIN_FILENO;
+
+	return FALSE;
+}
+
 /*
  ***************************************************************************
  * Read statistics sent by sadc, the data collector.
@@ -1201,6 +1377,7 @@ void read_stats_from_file(char from_file[])
 void read_stats(void)
 {
 	int curr = 1;
+	long i;
 	unsigned long lines;
 	unsigned int rows;
 	int dis_hdr = 0;
@@ -1208,6 +1385,11 @@ void read_stats(void)
 	/* Don't buffer data if redirected to a pipe... */
 	setbuf(stdout, NULL);
 
+	if (shm_name[0]) {
+		/* Fetch stream header and first record from the live feed */
+		wait_shm_record(FALSE);
+	}
+
 	/* Read stats header */
 	read_header_data();
 
@@ -1244,7 +1426,13 @@ void read_stats(void)
 	/* Set a handler for SIGINT and SIGTERM */
 	memset(&int_act, 0, sizeof(int_act));
 	int_act.sa_handler = int_handler;
-	int_act.sa_flags = SA_RESTART;
+	if (sadc_fd == STDIN_FILENO) {
+		/*
+		 * The signal is forwarded by sadc, which then terminates,
+		 * so that sa_read() will see EOF. Else it has to be interrupted.
+		 */
+		int_act.sa_flags = SA_RESTART;
+	}
 	sigaction(SIGINT, &int_act, NULL);
 	sigaction(SIGTERM, &int_act, NULL);
 
@@ -1252,6 +1440,19 @@ void read_stats(void)
 	do {
 
 		/* Get stats */
+		if (shm_name[0] && (wait_shm_record(TRUE) == SHM_NEW_HEADER)) {
+			/* sadc has rebuilt the feed: Re-read header data */
+			read_header_data();
+			allocate_structures(act, flags);
+		}
+		for (i = 1; (i < rec_ratio) && !sigint_caught; i++) {
+			/* Skip records sent by a sadc with a shorter interval than ours */
+			read_sadc_stat_bunch(curr);
+			if (record_hdr[curr].record_type == R_LAST_STATS) {
+				read_header_data();
+				allocate_structures(act, flags);
+			}
+		}
 		read_sadc_stat_bunch(curr);
 		if (sigint_caught) {
 			/*
@@ -1350,6 +1551,23 @@ int main(int argc, char **argv)
 			which_sadc();
 		}
 
+		else if (!strncmp(argv[opt], "--shm", 5)) {
+			/* Read stats from the shared memory live feed published by sadc */
+			if (argv[opt][5] == '=') {
+				if (!argv[opt][6]) {
+					usage(argv[0]);
+				}
+				snprintf(shm_name, sizeof(shm_name), "%s", argv[opt] + 6);
+			}
+			else if (!argv[opt][5]) {
+				strcpy(shm_name, SHM_DEFAULT_NAME);
+			}
+			else {
+				usage(argv[0]);
+			}
+			opt++;
+		}
+
 		else if (!strncmp(argv[opt], "--dev=", 6)) {
 			/* Parse devices entered on the command line */
 			p = get_activity_position(act, A_DISK, EXIT_IF_NOT_FOUND);
@@ -1372,6 +1590,32 @@ int main(int argc, char **argv)
 			act[q]->options |= AO_LIST_ON_CMDLINE;
 		}
 
+		else if (!strncmp(argv[opt], "--cgroup-psi", 12) &&
+			 ((argv[opt][12] == '\0') || (argv[opt][12] == '='))) {
+			/* Select cgroups pressure-stall activity, possibly for a list of cgroups */
+			SELECT_ACTIVITY(A_PSI_CGROUP);
+			if (argv[opt][12] == '=') {
+				p = get_activity_position(act, A_PSI_CGROUP, EXIT_IF_NOT_FOUND);
+				parse_sa_devices(argv[opt], act[p], MAX_CG_LEN, &opt, 13, NO_RANGE);
+			}
+			else {
+				opt++;
+			}
+		}
+
+		else if (!strncmp(argv[opt], "--cgroup", 8) &&
+			 ((argv[opt][8] == '\0') || (argv[opt][8] == '='))) {
+			/* Select cgroups activity, possibly for a list of cgroups */
+			SELECT_ACTIVITY(A_CGROUP);
+			if (argv[opt][8] == '=') {
+				p = get_activity_position(act, A_CGROUP, EXIT_IF_NOT_FOUND);
+				parse_sa_devices(argv[opt], act[p], MAX_CG_LEN, &opt, 9, NO_RANGE);
+			}
+			else {
+				opt++;
+			}
+		}
+
 		else if (!strncmp(argv[opt], "--int=", 6)) {
 			/* Parse interrupts names entered on the command line */
 			p = get_activity_position(act, A_IRQ, EXIT_IF_NOT_FOUND);
@@ -1426,9 +1670,10 @@ int main(int argc, char **argv)
 			const char *sar_env[] = {ENV_COLORS,
 						 ENV_COLORS_SGR,
 						 ENV_REPEAT_HEADER,
+						 ENV_SADC_SOCKET,
 						 ENV_TIME_DEFTM,
 						 ENV_TIME_FMT};
-#define SAR_ENV_NR	5
+#define SAR_ENV_NR	6
 			print_version(sar_env, SAR_ENV_NR);
 		}
 
@@ -1623,6 +1868,11 @@ int main(int argc, char **argv)
 		usage(argv[0]);
 	}
 
+	/* Live feed is only used to display stats: No -f or -o option */
+	if (shm_name[0] && (from_file[0] || to_file[0])) {
+		usage(argv[0]);
+	}
+
 	if (!count) {
 		/*
 		 * count parameter not set: Display all the contents of the file
@@ -1654,6 +1904,42 @@ int main(int argc, char **argv)
 		return 0;
 	}
 
+	/* Reading stats from the shared memory live feed published by sadc: */
+	if (shm_name[0]) {
+		if (shm_attach_feed(&feed, shm_name) < 0) {
+			fprintf(stderr, _("Cannot open shared memory live feed %s: %s\n"),
+				shm_name, strerror(errno));
+			exit(2);
+		}
+
+		/* Get now the statistics */
+		read_stats();
+
+		shm_detach_feed(&feed);
+
+		/* Free structures and activity bitmaps */
+		free_bitmaps(act);
+		free_structures(act);
+
+		return 0;
+	}
+
+	/* Subscribe to a running sadc if possible, instead of starting a new one */
+	if (!to_file[0] && (interval > 0) && subscribe_sadc()) {
+
+		/* Get now the statistics */
+		read_stats();
+
+		close(sadc_fd);
+		free(sock_hdr);
+
+		/* Free structures and activity bitmaps */
+		free_bitmaps(act);
+		free_structures(act);
+
+		return 0;
+	}
+
 	/* Reading stats from sadc: */
 
 	/* Create anonymous pipe */
@@ -1057,7 +1057,7 @@ int draw_activity_graphs(int g_nr, int g_type[], char *title[], char *g_title[],
 __print_funct_t svg_print_cpu_stats(struct activity *a, int curr, int action, struct svg_parm *svg_p,
 				    unsigned long long itv, struct record_header *record_hdr)
 {
-	struct stats_cpu *scc, *scp;
+	struct cpu_pc_values *cpc;
 	unsigned char offline_cpu_bitmap[BITMAP_SIZE(NR_CPUS)] = {0};
 	int group1[] = {5};
 	int group2[] = {9};
@@ -1093,6 +1093,10 @@ __print_funct_t svg_print_cpu_stats(struct activity *a, int curr, int action, st
 								   flags, offline_cpu_bitmap);
 		}
 
+		/* Compute interval and percentages for every CPU to display */
+		cpc = get_cpu_pc_statistics(a, !curr, curr, deltot_jiffies,
+					    offline_cpu_bitmap);
+
 		/* For each CPU */
 		for (i = 0; (i < a->nr_ini) && (i < a->bitmap->b_size + 1); i++) {
 
@@ -1102,34 +1106,11 @@ __print_funct_t svg_print_cpu_stats(struct activity *a, int curr, int action, st
 				/* Don't display CPU */
 				continue;
 
-			scc = (struct stats_cpu *) ((char *) a->buf[curr]  + i * a->msize);
-			scp = (struct stats_cpu *) ((char *) a->buf[!curr] + i * a->msize);
-
 			pos = i * CPU_ARRAY_SZ;
 			offset = 0.0;
 
-			if (i == 0) {
-				/* This is CPU "all" */
-				if (a->nr_ini == 1) {
-					/*
-					 * This is a UP machine. In this case
-					 * interval has still not been calculated.
-					 */
-					deltot_jiffies = get_per_cpu_interval(scc, scp);
-				}
-				if (!deltot_jiffies) {
-					/* CPU "all" cannot be tickless */
-					deltot_jiffies = 1;
-				}
-			}
-			else {
-				/*
-				 * Recalculate interval for current proc.
-				 * If result is 0 then current CPU is a tickless one.
-				 */
-				deltot_jiffies = get_per_cpu_interval(scc, scp);
-
-				if (!deltot_jiffies) {	/* Current CPU is tickless */
+			if (i) {
+				if (!cpc->itv[i]) {	/* Current CPU is tickless */
 
 					double val = 100.0;	/* Tickless CPU: %idle = 100% */
 
@@ -1157,22 +1138,20 @@ __print_funct_t svg_print_cpu_stats(struct activity *a, int curr, int action, st
 			if (DISPLAY_CPU_DEF(a->opt_flags)) {
 				/* %user */
 				cpuappend(record_hdr->ust_time - svg_p->ust_time_ref,
-					  &offset, ll_sp_value(scp->cpu_user, scc->cpu_user, deltot_jiffies),
+					  &offset, CPU_PC(cpc, CPU_PC_USER, i),
 					  out + pos, outsize + pos, svg_p->dt,
 					  a->spmin + pos, a->spmax + pos);
 
 				/* %nice */
 				cpuappend(record_hdr->ust_time - svg_p->ust_time_ref,
-					  &offset, ll_sp_value(scp->cpu_nice, scc->cpu_nice, deltot_jiffies),
+					  &offset, CPU_PC(cpc, CPU_PC_NICE_TOT, i),
 					  out + pos + 1, outsize + pos + 1, svg_p->dt,
 					  a->spmin + pos + 1, a->spmax + pos + 1);
 
 				/* %system */
 				cpuappend(record_hdr->ust_time - svg_p->ust_time_ref,
 					  &offset,
-					  ll_sp_value(scp->cpu_sys + scp->cpu_hardirq + scp->cpu_softirq,
-						      scc->cpu_sys + scc->cpu_hardirq + scc->cpu_softirq,
-						      deltot_jiffies),
+					  CPU_PC(cpc, CPU_PC_SYS_TOT, i),
 					 out + pos + 2, outsize + pos + 2, svg_p->dt,
 					 a->spmin + pos + 2, a->spmax + pos + 2);
 			}
@@ -1180,61 +1159,54 @@ __print_funct_t svg_print_cpu_stats(struct activity *a, int curr, int action, st
 				/* %usr */
 				cpuappend(record_hdr->ust_time - svg_p->ust_time_ref,
 					  &offset,
-					  (scc->cpu_user - scc->cpu_guest) < (scp->cpu_user - scp->cpu_guest) ?
-					   0.0 :
-					   ll_sp_value(scp->cpu_user - scp->cpu_guest,
-						       scc->cpu_user - scc->cpu_guest, deltot_jiffies),
+					  CPU_PC(cpc, CPU_PC_USR, i),
 					  out + pos, outsize + pos, svg_p->dt,
 					  a->spmin + pos, a->spmax + pos);
 
 				/* %nice */
 				cpuappend(record_hdr->ust_time - svg_p->ust_time_ref,
 					  &offset,
-					  (scc->cpu_nice - scc->cpu_guest_nice) < (scp->cpu_nice - scp->cpu_guest_nice) ?
-					  0.0 :
-					  ll_sp_value(scp->cpu_nice - scp->cpu_guest_nice,
-						      scc->cpu_nice - scc->cpu_guest_nice, deltot_jiffies),
+					  CPU_PC(cpc, CPU_PC_NICE, i),
 					  out + pos + 1, outsize + pos + 1, svg_p->dt,
 					  a->spmin + pos + 1, a->spmax + pos + 1);
 
 				/* %sys */
 				cpuappend(record_hdr->ust_time - svg_p->ust_time_ref,
-					  &offset, ll_sp_value(scp->cpu_sys,
-							       scc->cpu_sys, deltot_jiffies),
+					  &offset, CPU_PC(cpc, CPU_PC_SYS, i),
 					  out + pos + 2, outsize + pos + 2, svg_p->dt,
 					  a->spmin + pos + 2, a->spmax + pos + 2);
 			}
 
 			/* %iowait */
 			cpuappend(record_hdr->ust_time - svg_p->ust_time_ref,
-				  &offset, ll_sp_value(scp->cpu_iowait, scc->cpu_iowait, deltot_jiffies),
+				  &offset, CPU_PC(cpc, CPU_PC_IOWAIT, i),
 				  out + pos + 3, outsize + pos + 3, svg_p->dt,
 				  a->spmin + pos + 3, a->spmax + pos + 3);
 			/* %steal */
 			cpuappend(record_hdr->ust_time - svg_p->ust_time_ref,
-				  &offset, ll_sp_value(scp->cpu_steal, scc->cpu_steal, deltot_jiffies),
+				  &offset, CPU_PC(cpc, CPU_PC_STEAL, i),
 				  out + pos + 4, outsize + pos + 4, svg_p->dt,
 				  a->spmin + pos + 4, a->spmax + pos + 4);
 
 			if (DISPLAY_CPU_ALL(a->opt_flags)) {
 				/* %irq */
 				cpuappend(record_hdr->ust_time - svg_p->ust_time_ref,
-					  &offset, ll_sp_value(scp->cpu_hardirq, scc->cpu_hardirq, deltot_jiffies),
+					  &offset, CPU_PC(cpc, CPU_PC_IRQ, i),
 					  out + pos + 5, outsize + pos + 5, svg_p->dt,
 					  a->spmin + pos + 5, a->spmax + pos + 5);
 				/* %soft */
 				cpuappend(record_hdr->ust_time - svg_p->ust_time_ref,
-					  &offset, ll_sp_value(scp->cpu_softirq, scc->cpu_softirq, deltot_jiffies),
+					  &offset, CPU_PC(cpc, CPU_PC_SOFT, i),
 					  out + pos + 6, outsize + pos + 6, svg_p->dt,
 					  a->spmin + pos + 6, a->spmax + pos + 6);
 				/* %guest */
 				cpuappend(record_hdr->ust_time - svg_p->ust_time_ref,
-					  &offset, ll_sp_value(scp->cpu_guest, scc->cpu_guest, deltot_jiffies),
+					  &offset, CPU_PC(cpc, CPU_PC_GUEST, i),
 					  out + pos + 7, outsize + pos + 7, svg_p->dt,
 					  a->spmin + pos + 7, a->spmax + pos + 7);
 				/* %gnice */
 				cpuappend(record_hdr->ust_time - svg_p->ust_time_ref,
-					  &offset, ll_sp_value(scp->cpu_guest_nice, scc->cpu_guest_nice, deltot_jiffies),
+					  &offset, CPU_PC(cpc, CPU_PC_GNICE, i),
 					  out + pos + 8, outsize + pos + 8, svg_p->dt,
 					  a->spmin + pos + 8, a->spmax + pos + 8);
 
@@ -1247,8 +1219,7 @@ __print_funct_t svg_print_cpu_stats(struct activity *a, int curr, int action, st
 			/* %idle */
 			cpuappend(record_hdr->ust_time - svg_p->ust_time_ref,
 				  &offset,
-				  (scc->cpu_idle < scp->cpu_idle ? 0.0 :
-				   ll_sp_value(scp->cpu_idle, scc->cpu_idle, deltot_jiffies)),
+				  CPU_PC(cpc, CPU_PC_IDLE, i),
 				  out + pos + j, outsize + pos + j, svg_p->dt,
 				  a->spmin + pos + j, a->spmax + pos + j);
 		}
@@ -5480,3 +5451,420 @@ __print_funct_t svg_print_psimem_stats(struct activity *a, int curr, int action,
 		free_graphs(out, outsize);
 	}
 }
+
+/*
+ ***************************************************************************
+ * Display cgroups statistics in SVG.
+ *
+ * IN:
+ * @a		Activity structure with statistics.
+ * @curr	Index in array for current sample statistics.
+ * @action	Action expected from current function.
+ * @svg_p	SVG specific parameters: Current graph number (.@graph_no),
+ * 		flag indicating that a restart record has been previously
+ * 		found (.@restart) and time used for the X axis origin
+ * 		(@ust_time_ref).
+ * @itv		Interval of time in 1/100th of a second (only with F_MAIN action).
+ * @record_hdr	Pointer on record header of current stats sample.
+ ***************************************************************************
+ */
+#define CGROUP_ARRAY_SZ	10
+__print_funct_t svg_print_cgroup_stats(struct activity *a, int curr, int action, struct svg_parm *svg_p,
+				       unsigned long long itv, struct record_header *record_hdr)
+{
+	struct stats_cgroup *scc, *scp, sczero;
+	int group[] = {4, 1, 2, 2};
+	int g_type[] = {SVG_LINE_GRAPH, SVG_LINE_GRAPH, SVG_LINE_GRAPH, SVG_LINE_GRAPH};
+	char *title[] = {"Cgroups statistics (1)", "Cgroups statistics (2)",
+			 "Cgroups statistics (3)", "Cgroups statistics (4)"};
+	char *g_title[] = {"%usr", "%system", "%cpu", "%throttled",
+			   "kbmem",
+			   "rkB/s", "wkB/s",
+			   "rd/s", "wr/s"};
+	int g_fields[] = {2, 0, 1, 3, -1, 5, 6, 7, 8};
+	unsigned int local_types_nr[] = {9, 0, 0};
+	static char **out;
+	static int *outsize;
+	char *item_name;
+	int i, j, k, pos, posp, restart, *unregistered;
+
+	if (action & F_BEGIN) {
+		/*
+		 * Allocate arrays (#0..8) that will contain the graphs data
+		 * Also allocate one additional array (#9) for each cgroup:
+		 * out + 9 will contain the cgroup name,
+		 * outsize + 9 will contain a positive value (TRUE) if the cgroup
+		 * has either still not been created, or has been removed.
+		 */
+		out = allocate_graph_lines(a, CGROUP_ARRAY_SZ * a->item_list_sz, &outsize);
+	}
+
+	if (action & F_MAIN) {
+		memset(&sczero, 0, STATS_CGROUP_SIZE);
+		/*
+		 * Mark previously created cgroups as now
+		 * possibly removed for all graphs.
+		 */
+		for (k = 0; k < a->item_list_sz; k++) {
+			unregistered = outsize + k * CGROUP_ARRAY_SZ + 9;
+			if (*unregistered == FALSE) {
+				*unregistered = MAYBE;
+			}
+		}
+
+		/* For each cgroup structure */
+		for (i = 0; i < a->nr[curr]; i++) {
+			scc = (struct stats_cgroup *) ((char *) a->buf[curr] + i * a->msize);
+			restart = svg_p->restart;
+
+			if (a->item_list != NULL) {
+				/* A list of cgroups has been entered on the command line */
+				if (!search_list_item(a->item_list, scc->cgroup_name))
+					/* Cgroup not found */
+					continue;
+			}
+
+			/* Look for corresponding graph */
+			for (k = 0; k < a->item_list_sz; k++) {
+				item_name = *(out + k * CGROUP_ARRAY_SZ + 9);
+				if (!strcmp(scc->cgroup_name, item_name))
+					/* Graph found! */
+					break;
+			}
+			if (k == a->item_list_sz) {
+				/* Graph not found: Look for first free entry */
+				for (k = 0; k < a->item_list_sz; k++) {
+					item_name = *(out + k * CGROUP_ARRAY_SZ + 9);
+					if (!strcmp(item_name, ""))
+						break;
+				}
+				if (k == a->item_list_sz) {
+					/* No free graph entry: Ignore it (should never happen) */
+#ifdef DEBUG
+					fprintf(stderr, "%s: Name=%s\n",
+						__FUNCTION__, scc->cgroup_name);
+#endif
+					continue;
+				}
+			}
+			pos = k * CGROUP_ARRAY_SZ;
+			posp = k * a->xnr;
+			unregistered = outsize + pos + 9;
+
+			j = check_cgroup_reg(a, curr, !curr, i);
+			if (j < 0) {
+				/* This is a newly created cgroup. Previous stats are zero */
+				scp = &sczero;
+				restart = TRUE;
+			}
+			else {
+				scp = (struct stats_cgroup *) ((char *) a->buf[!curr] + j * a->msize);
+			}
+
+			/*
+			 * If current cgroup was marked as previously removed,
+			 * then set restart variable to TRUE so that the graph will be
+			 * discontinuous, and mark it as now created.
+			 */
+			if (*unregistered == TRUE) {
+				restart = TRUE;
+			}
+			*unregistered = FALSE;
+
+			item_name = *(out + pos + 9);
+			if (!item_name[0]) {
+				/* Save cgroup name (if not already done) */
+				strncpy(item_name, scc->cgroup_name, CHUNKSIZE);
+				item_name[CHUNKSIZE - 1] = '\0';
+			}
+
+			/* Check for min/max values */
+			save_extrema(local_types_nr, (void *) scc, (void *) scp,
+				     itv, a->spmin + posp, a->spmax + posp, g_fields);
+			save_minmax(a, posp + 4, (double) scc->mem_current);
+
+			/* %usr */
+			lnappend(record_hdr->ust_time - svg_p->ust_time_ref,
+				 S_VALUE(scp->user_usec, scc->user_usec, itv) / 10000,
+				 out + pos, outsize + pos, restart);
+			/* %system */
+			lnappend(record_hdr->ust_time - svg_p->ust_time_ref,
+				 S_VALUE(scp->system_usec, scc->system_usec, itv) / 10000,
+				 out + pos + 1, outsize + pos + 1, restart);
+			/* %cpu */
+			lnappend(record_hdr->ust_time - svg_p->ust_time_ref,
+				 S_VALUE(scp->usage_usec, scc->usage_usec, itv) / 10000,
+				 out + pos + 2, outsize + pos + 2, restart);
+			/* %throttled */
+			lnappend(record_hdr->ust_time - svg_p->ust_time_ref,
+				 S_VALUE(scp->throttled_usec, scc->throttled_usec, itv) / 10000,
+				 out + pos + 3, outsize + pos + 3, restart);
+			/* kbmem */
+			lnappend(record_hdr->ust_time - svg_p->ust_time_ref,
+				 (double) scc->mem_current,
+				 out + pos + 4, outsize + pos + 4, restart);
+			/* rkB/s */
+			lnappend(record_hdr->ust_time - svg_p->ust_time_ref,
+				 S_VALUE(scp->rbytes, scc->rbytes, itv) / 1024,
+				 out + pos + 5, outsize + pos + 5, restart);
+			/* wkB/s */
+			lnappend(record_hdr->ust_time - svg_p->ust_time_ref,
+				 S_VALUE(scp->wbytes, scc->wbytes, itv) / 1024,
+				 out + pos + 6, outsize + pos + 6, restart);
+			/* rd/s */
+			lnappend(record_hdr->ust_time - svg_p->ust_time_ref,
+				 S_VALUE(scp->rios, scc->rios, itv),
+				 out + pos + 7, outsize + pos + 7, restart);
+			/* wr/s */
+			lnappend(record_hdr->ust_time - svg_p->ust_time_ref,
+				 S_VALUE(scp->wios, scc->wios, itv),
+				 out + pos + 8, outsize + pos + 8, restart);
+		}
+
+		/* Mark cgroups not seen here as now removed */
+		for (k = 0; k < a->item_list_sz; k++) {
+			unregistered = outsize + k * CGROUP_ARRAY_SZ + 9;
+			if (*unregistered != FALSE) {
+				*unregistered = TRUE;
+			}
+		}
+	}
+
+	if (action & F_END) {
+		int xid = 0;
+
+		for (i = 0; i < a->item_list_sz; i++) {
+			/*
+			 * Check if there is something to display.
+			 * Don't test scc->cgroup_name because maybe the cgroup
+			 * has been created later.
+			 */
+			pos = i * CGROUP_ARRAY_SZ;
+			if (!**(out + pos))
+				continue;
+			posp = i * a->xnr;
+
+			/* Recalculate min and max values in percent, not in usec */
+			for (j = 0; j < 4; j++) {
+				*(a->spmin + posp + j) /= 10000;
+				*(a->spmax + posp + j) /= 10000;
+			}
+			/* Recalculate min and max values in kB, not in B */
+			for (j = 5; j < 7; j++) {
+				*(a->spmin + posp + j) /= 1024;
+				*(a->spmax + posp + j) /= 1024;
+			}
+
+			item_name = *(out + pos + 9);
+			if (draw_activity_graphs(a->g_nr, g_type,
+						 title, g_title, item_name, group,
+						 a->spmin + posp, a->spmax + posp,
+						 out + pos, outsize + pos,
+						 svg_p, record_hdr, FALSE, a, xid)) {
+				xid++;
+			}
+		}
+
+		/* Free remaining structures */
+		free_graphs(out, outsize);
+	}
+}
+
+/*
+ ***************************************************************************
+ * Display cgroups pressure-stall statistics in SVG.
+ *
+ * IN:
+ * @a		Activity structure with statistics.
+ * @curr	Index in array for current sample statistics.
+ * @action	Action expected from current function.
+ * @svg_p	SVG specific parameters: Current graph number (.@graph_no),
+ * 		flag indicating that a restart record has been previously
+ * 		found (.@restart) and time used for the X axis origin
+ * 		(@ust_time_ref).
+ * @itv		Interval of time in 1/100th of a second (only with F_MAIN action).
+ * @record_hdr	Pointer on record header of current stats sample.
+ ***************************************************************************
+ */
+#define PSI_CGROUP_ARRAY_SZ	7
+__print_funct_t svg_print_psi_cgroup_stats(struct activity *a, int curr, int action, struct svg_parm *svg_p,
+					   unsigned long long itv, struct record_header *record_hdr)
+{
+	struct stats_psi_cgroup *spcc, *spcp, spczero;
+	int group[] = {2, 2, 2};
+	int g_type[] = {SVG_LINE_GRAPH, SVG_LINE_GRAPH, SVG_LINE_GRAPH};
+	char *title[] = {"Cgroups CPU stall time", "Cgroups I/O stall time",
+			 "Cgroups memory stall time"};
+	char *g_title[] = {"%scpu", "%fcpu",
+			   "%sio", "%fio",
+			   "%smem", "%fmem"};
+	int g_fields[] = {0, 1, 2, 3, 4, 5};
+	unsigned int local_types_nr[] = {6, 0, 0};
+	static char **out;
+	static int *outsize;
+	char *item_name;
+	int i, j, k, pos, posp, restart, *unregistered;
+
+	if (action & F_BEGIN) {
+		/*
+		 * Allocate arrays (#0..5) that will contain the graphs data
+		 * Also allocate one additional array (#6) for each cgroup:
+		 * out + 6 will contain the cgroup name,
+		 * outsize + 6 will contain a positive value (TRUE) if the cgroup
+		 * has either still not been created, or has been removed.
+		 */
+		out = allocate_graph_lines(a, PSI_CGROUP_ARRAY_SZ * a->item_list_sz, &outsize);
+	}
+
+	if (action & F_MAIN) {
+		memset(&spczero, 0, STATS_PSI_CGROUP_SIZE);
+		/*
+		 * Mark previously created cgroups as now
+		 * possibly removed for all graphs.
+		 */
+		for (k = 0; k < a->item_list_sz; k++) {
+			unregistered = outsize + k * PSI_CGROUP_ARRAY_SZ + 6;
+			if (*unregistered == FALSE) {
+				*unregistered = MAYBE;
+			}
+		}
+
+		/* For each cgroup structure */
+		for (i = 0; i < a->nr[curr]; i++) {
+			spcc = (struct stats_psi_cgroup *) ((char *) a->buf[curr] + i * a->msize);
+			restart = svg_p->restart;
+
+			if (a->item_list != NULL) {
+				/* A list of cgroups has been entered on the command line */
+				if (!search_list_item(a->item_list, spcc->cgroup_name))
+					/* Cgroup not found */
+					continue;
+			}
+
+			/* Look for corresponding graph */
+			for (k = 0; k < a->item_list_sz; k++) {
+				item_name = *(out + k * PSI_CGROUP_ARRAY_SZ + 6);
+				if (!strcmp(spcc->cgroup_name, item_name))
+					/* Graph found! */
+					break;
+			}
+			if (k == a->item_list_sz) {
+				/* Graph not found: Look for first free entry */
+				for (k = 0; k < a->item_list_sz; k++) {
+					item_name = *(out + k * PSI_CGROUP_ARRAY_SZ + 6);
+					if (!strcmp(item_name, ""))
+						break;
+				}
+				if (k == a->item_list_sz) {
+					/* No free graph entry: Ignore it (should never happen) */
+#ifdef DEBUG
+					fprintf(stderr, "%s: Name=%s\n",
+						__FUNCTION__, spcc->cgroup_name);
+#endif
+					continue;
+				}
+			}
+			pos = k * PSI_CGROUP_ARRAY_SZ;
+			posp = k * a->xnr;
+			unregistered = outsize + pos + 6;
+
+			j = check_psi_cgroup_reg(a, curr, !curr, i);
+			if (j < 0) {
+				/* This is a newly created cgroup. Previous stats are zero */
+				spcp = &spczero;
+				restart = TRUE;
+			}
+			else {
+				spcp = (struct stats_psi_cgroup *) ((char *) a->buf[!curr] + j * a->msize);
+			}
+
+			/*
+			 * If current cgroup was marked as previously removed,
+			 * then set restart variable to TRUE so that the graph will be
+			 * discontinuous, and mark it as now created.
+			 */
+			if (*unregistered == TRUE) {
+				restart = TRUE;
+			}
+			*unregistered = FALSE;
+
+			item_name = *(out + pos + 6);
+			if (!item_name[0]) {
+				/* Save cgroup name (if not already done) */
+				strncpy(item_name, spcc->cgroup_name, CHUNKSIZE);
+				item_name[CHUNKSIZE - 1] = '\0';
+			}
+
+			/* Check for min/max values */
+			save_extrema(local_types_nr, (void *) spcc, (void *) spcp,
+				     itv, a->spmin + posp, a->spmax + posp, g_fields);
+
+			/* %scpu */
+			lnappend(record_hdr->ust_time - svg_p->ust_time_ref,
+				 S_VALUE(spcp->some_cpu_total, spcc->some_cpu_total, itv) / 10000,
+				 out + pos, outsize + pos, restart);
+			/* %fcpu */
+			lnappend(record_hdr->ust_time - svg_p->ust_time_ref,
+				 S_VALUE(spcp->full_cpu_total, spcc->full_cpu_total, itv) / 10000,
+				 out + pos + 1, outsize + pos + 1, restart);
+			/* %sio */
+			lnappend(record_hdr->ust_time - svg_p->ust_time_ref,
+				 S_VALUE(spcp->some_io_total, spcc->some_io_total, itv) / 10000,
+				 out + pos + 2, outsize + pos + 2, restart);
+			/* %fio */
+			lnappend(record_hdr->ust_time - svg_p->ust_time_ref,
+				 S_VALUE(spcp->full_io_total, spcc->full_io_total, itv) / 10000,
+				 out + pos + 3, outsize + pos + 3, restart);
+			/* %smem */
+			lnappend(record_hdr->ust_time - svg_p->ust_time_ref,
+				 S_VALUE(spcp->some_mem_total, spcc->some_mem_total, itv) / 10000,
+				 out + pos + 4, outsize + pos + 4, restart);
+			/* %fmem */
+			lnappend(record_hdr->ust_time - svg_p->ust_time_ref,
+				 S_VALUE(spcp->full_mem_total, spcc->full_mem_total, itv) / 10000,
+				 out + pos + 5, outsize + pos + 5, restart);
+		}
+
+		/* Mark cgroups not seen here as now removed */
+		for (k = 0; k < a->item_list_sz; k++) {
+			unregistered = outsize + k * PSI_CGROUP_ARRAY_SZ + 6;
+			if (*unregistered != FALSE) {
+				*unregistered = TRUE;
+			}
+		}
+	}
+
+	if (action & F_END) {
+		int xid = 0;
+
+		for (i = 0; i < a->item_list_sz; i++) {
+			/*
+			 * Check if there is something to display.
+			 * Don't test spcc->cgroup_name because maybe the cgroup
+			 * has been created later.
+			 */
+			pos = i * PSI_CGROUP_ARRAY_SZ;
+			if (!**(out + pos))
+				continue;
+			posp = i * a->xnr;
+
+			/* Recalculate min and max values in percent, not in usec */
+			for (j = 0; j < 6; j++) {
+				*(a->spmin + posp + j) /= 10000;
+				*(a->spmax + posp + j) /= 10000;
+			}
+
+			item_name = *(out + pos + 6);
+			if (draw_activity_graphs(a->g_nr, g_type,
+						 title, g_title, item_name, group,
+						 a->spmin + posp, a->spmax + posp,
+						 out + pos, outsize + pos,
+						 svg_p, record_hdr, FALSE, a, xid)) {
+				xid++;
+			}
+		}
+
+		/* Free remaining structures */
+		free_graphs(out, outsize);
+	}
+}
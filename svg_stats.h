@@ -130,5 +130,11 @@ __print_funct_t svg_print_psimem_stats
 __print_funct_t svg_print_pwr_bat_stats
 	(struct activity *, int, int, struct svg_parm *, unsigned long long,
 	 struct record_header *);
+__print_funct_t svg_print_cgroup_stats
+	(struct activity *, int, int, struct svg_parm *, unsigned long long,
+	 struct record_header *);
+__print_funct_t svg_print_psi_cgroup_stats
+	(struct activity *, int, int, struct svg_parm *, unsigned long long,
+	 struct record_header *);
 
 #endif /* _SVG_STATS_H */
@@ -36,6 +36,15 @@
 #include <sys/time.h>
 #include <sys/types.h>
 
+#ifdef HAVE_LINUX_TASKSTATS_H
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/genetlink.h>
+#include <linux/taskstats.h>
+#endif
+
 #include "systest.h"
 
 time_t __unix_time = 1591016000;	/* Mon Jun  1 12:53:20 2020 UTC */
@@ -58,6 +67,33 @@ time_t get_unix_time(time_t *t)
 	return __unix_time;
 }
 
+/*
+ ***************************************************************************
+ * Test mode: Read a clock. Only CLOCK_REALTIME is simulated, using
+ * __unix_time variable contents. Other clocks are reported as unavailable,
+ * so that the caller falls back to the files from the test root directory.
+ *
+ * IN:
+ * @clk_id	Clock identifier.
+ *
+ * OUT:
+ * @tp		Time read from the clock.
+ *
+ * RETURNS:
+ * 0 on success, -1 if the clock is not available.
+ ***************************************************************************
+ */
+int get_clock_time(clockid_t clk_id, struct timespec *tp)
+{
+	if (clk_id != CLOCK_REALTIME)
+		return -1;
+
+	tp->tv_sec = __unix_time;
+	tp->tv_nsec = 0;
+
+	return 0;
+}
+
 /*
  ***************************************************************************
  * Test mode: Get time of the day using __unix_time variable contents.
@@ -273,6 +309,8 @@ struct dirent *read_list(DIR *dir)
 		(strlen(line) < sizeof(drd.d_name))) {
 		strcpy(drd.d_name, line);
 		drd.d_name[strlen(line) - 1] = '\0';
+		/* Same name gives same (non-zero) inode number from one sample to the next */
+		drd.d_ino = strtoul(drd.d_name, NULL, 10) + 1;
 		return &drd;
 	}
 
@@ -362,5 +400,335 @@ pid_t get_known_pid(void)
 	return 8741;
 }
 
+#ifdef HAVE_LINUX_TASKSTATS_H
+/* Simulated netlink sockets */
+static struct nl_test_sock {
+	int fd;			/* File descriptor returned to the caller + 1 (0 if unused) */
+	int pending;		/* TRUE if a request is waiting for its reply */
+	int exits;		/* TRUE if registered for stats of exiting tasks */
+	unsigned short type;	/* Netlink message type of last request */
+	unsigned short attr;	/* Type of first attribute of last request */
+	uint32_t pid;		/* PID sent with TASKSTATS_CMD_ATTR_PID */
+	int exit_nr;		/* Number of exit notifications already sent */
+	char exit_root[1024];	/* Root directory where they have been read */
+} nl_sock[NL_TEST_SOCK_NR];
+
+/*
+ ***************************************************************************
+ * Find the simulated netlink socket using given file descriptor.
+ *
+ * IN:
+ * @fd		File descriptor.
+ *
+ * RETURNS:
+ * Pointer on the socket structure, or NULL if not found.
+ ***************************************************************************
+ */
+static struct nl_test_sock *get_netlink_sock(int fd)
+{
+	int i;
+
+	for (i = 0; i < NL_TEST_SOCK_NR; i++) {
+		if (nl_sock[i].fd == fd + 1)
+			return &nl_sock[i];
+	}
+
+	return NULL;
+}
+
+/*
+ ***************************************************************************
+ * Replacement function for socket() system call. Only generic netlink
+ * sockets are simulated. A real file descriptor is returned so that the
+ * caller can close it.
+ *
+ * IN:
+ * @domain	Communication domain.
+ * @type	Socket type.
+ * @protocol	Protocol.
+ *
+ * RETURNS:
+ * File descriptor, or -1 on failure.
+ ***************************************************************************
+ */
+int get_netlink_socket(int domain, int type, int protocol)
+{
+	struct nl_test_sock *nls;
+	int fd;
+
+	if ((domain != AF_NETLINK) || (protocol != NETLINK_GENERIC)) {
+		errno = EAFNOSUPPORT;
+		return -1;
+	}
+
+	if ((fd = open("/dev/null", O_RDONLY | O_CLOEXEC)) < 0)
+		return -1;
+
+	/* A previous socket may have been closed: Reuse its slot */
+	if ((nls = get_netlink_sock(fd)) == NULL) {
+		if ((nls = get_netlink_sock(-1)) == NULL) {
+			close(fd);
+			errno = EMFILE;
+			return -1;
+		}
+	}
+	memset(nls, 0, sizeof(struct nl_test_sock));
+	nls->fd = fd + 1;
+
+	return fd;
+}
+
+/*
+ ***************************************************************************
+ * Replacement function for bind() system call. Do nothing here.
+ *
+ * IN:
+ * @fd		Socket descriptor.
+ * @addr	Unused here.
+ * @len		Unused here.
+ *
+ * RETURNS:
+ * 0 if socket is a simulated netlink socket, -1 otherwise.
+ ***************************************************************************
+ */
+int bind_netlink_socket(int fd, const struct sockaddr *addr, socklen_t len)
+{
+	return (get_netlink_sock(fd) != NULL ? 0 : -1);
+}
+
+/*
+ ***************************************************************************
+ * Replacement function for sendto() system call. Save the request sent on
+ * a simulated netlink socket so that the next call to recv_netlink_msg()
+ * returns the corresponding reply.
+ *
+ * IN:
+ * @fd		Socket descriptor.
+ * @buf		Netlink message.
+ * @len		Length of netlink message.
+ *
+ * RETURNS:
+ * Number of bytes sent, or -1 on failure.
+ ***************************************************************************
+ */
+ssize_t send_netlink_msg(int fd, const void *buf, size_t len)
+{
+	struct nl_test_sock *nls;
+	const struct nlmsghdr *n = buf;
+	const struct nlattr *na;
+
+	if (((nls = get_netlink_sock(fd)) == NULL) ||
+	    (len < NLMSG_LENGTH(GENL_HDRLEN) + NLA_HDRLEN)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	na = (const struct nlattr *) ((const char *) NLMSG_DATA(n) + GENL_HDRLEN);
+	nls->type = n->nlmsg_type;
+	nls->attr = na->nla_type;
+	if ((na->nla_type == TASKSTATS_CMD_ATTR_PID) &&
+	    (na->nla_len >= NLA_HDRLEN + sizeof(uint32_t))) {
+		memcpy(&nls->pid, (const char *) na + NLA_HDRLEN, sizeof(uint32_t));
+	}
+	nls->pending = 1;
+
+	return len;
+}
+
+/*
+ ***************************************************************************
+ * Read simulated taskstats for a task. The file contains the following
+ * fields on a single line: pid, tgid, uid, utime, stime (in microseconds),
+ * minflt, majflt, nvcsw, nivcsw, read_bytes, write_bytes,
+ * cancelled_write_bytes and cpu_delay_total (in nanoseconds).
+ *
+ * IN:
+ * @line	Line read from the file.
+ *
+ * OUT:
+ * @ts		Taskstats structure.
+ *
+ * RETURNS:
+ * 0 on success, and -1 otherwise.
+ ***************************************************************************
+ */
+static int parse_taskstats(const char *line, struct taskstats *ts)
+{
+	unsigned long long v[13];
+
+	if (sscanf(line, "%llu %llu %llu %llu %llu %llu %llu %llu %llu %llu %llu %llu %llu",
+		   &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6], &v[7], &v[8],
+		   &v[9], &v[10], &v[11], &v[12]) != 13)
+		return -1;
+
+	memset(ts, 0, sizeof(struct taskstats));
+	ts->version = TASKSTATS_VERSION;
+	ts->ac_pid = v[0];
+	ts->ac_tgid = v[1];
+	ts->ac_uid = v[2];
+	ts->ac_utime = v[3];
+	ts->ac_stime = v[4];
+	ts->ac_minflt = v[5];
+	ts->ac_majflt = v[6];
+	ts->nvcsw = v[7];
+	ts->nivcsw = v[8];
+	ts->read_bytes = v[9];
+	ts->write_bytes = v[10];
+	ts->cancelled_write_bytes = v[11];
+	ts->cpu_delay_total = v[12];
+
+	return 0;
+}
+
+/*
+ ***************************************************************************
+ * Append an attribute to a netlink message.
+ *
+ * IN:
+ * @n		Netlink message.
+ * @type	Attribute type.
+ * @data	Attribute value (may be NULL for a nested attribute).
+ * @len		Length of attribute value.
+ *
+ * RETURNS:
+ * Pointer on the attribute.
+ ***************************************************************************
+ */
+static struct nlattr *add_netlink_attr(struct nlmsghdr *n, unsigned short type,
+				       const void *data, int len)
+{
+	struct nlattr *na = (struct nlattr *) ((char *) n + NLMSG_ALIGN(n->nlmsg_len));
+
+	na->nla_type = type;
+	na->nla_len = NLA_HDRLEN + len;
+	if (data) {
+		memcpy((char *) na + NLA_HDRLEN, data, len);
+	}
+	n->nlmsg_len = NLMSG_ALIGN(n->nlmsg_len) + NLA_ALIGN(na->nla_len);
+
+	return na;
+}
+
+/*
+ ***************************************************************************
+ * Replacement function for recv() system call. Build the reply to the last
+ * request sent on a simulated netlink socket, or the next notification for
+ * a task that has exited if the socket has been registered for them.
+ * Replies are built from the files contained in the "taskstats" directory
+ * of current root directory: One file named after each PID whose stats can
+ * be read, and an "exits" file containing one task per line.
+ *
+ * IN:
+ * @fd		Socket descriptor.
+ * @size	Size of buffer.
+ * @flags	Unused here.
+ *
+ * OUT:
+ * @buf		Buffer where the message has been saved.
+ *
+ * RETURNS:
+ * Length of the message, or -1 if no message is available.
+ ***************************************************************************
+ */
+ssize_t recv_netlink_msg(int fd, void *buf, size_t size, int flags)
+{
+	struct nl_test_sock *nls;
+	struct nlmsghdr *n = buf;
+	struct nlattr *na;
+	struct taskstats ts;
+	FILE *fp;
+	char filename[1024], line[1024], *root;
+	unsigned short family = NL_TEST_FAMILY;
+	int i, err = 0;
+
+	if (((nls = get_netlink_sock(fd)) == NULL) ||
+	    (size < NLMSG_SPACE(GENL_HDRLEN) + 2 * NLA_HDRLEN + sizeof(uint32_t) +
+		    NLA_HDRLEN + sizeof(struct taskstats))) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	memset(buf, 0, size);
+	n->nlmsg_len = NLMSG_LENGTH(GENL_HDRLEN);
+
+	if (!nls->pending) {
+		if (!nls->exits) {
+			errno = EAGAIN;
+			return -1;
+		}
+
+		/* Send notifications for tasks listed in "exits" file once per sample */
+		root = realpath(ROOTDIR, NULL);
+		if (!root || strcmp(root, nls->exit_root)) {
+			nls->exit_nr = 0;
+			snprintf(nls->exit_root, sizeof(nls->exit_root), "%s", root ? root : "");
+		}
+		free(root);
+
+		snprintf(filename, sizeof(filename), "%s/exits", TASKSTATS_DIR);
+		if ((fp = fopen(filename, "r")) == NULL) {
+			errno = EAGAIN;
+			return -1;
+		}
+		for (i = 0; (i <= nls->exit_nr) && (fgets(line, sizeof(line), fp) != NULL); i++);
+		fclose(fp);
+
+		if ((i <= nls->exit_nr) || parse_taskstats(line, &ts)) {
+			errno = EAGAIN;
+			return -1;
+		}
+		nls->exit_nr++;
+	}
+
+	else {
+		nls->pending = 0;
+
+		if (nls->type == GENL_ID_CTRL) {
+			/* Taskstats family exists only if the directory exists */
+			if (access(TASKSTATS_DIR, F_OK) < 0) {
+				err = -ENOENT;
+			}
+			else {
+				add_netlink_attr(n, CTRL_ATTR_FAMILY_ID, &family, sizeof(family));
+				return n->nlmsg_len;
+			}
+		}
+		else if (nls->attr == TASKSTATS_CMD_ATTR_REGISTER_CPUMASK) {
+			/* Acknowledge registration */
+			nls->exits = 1;
+		}
+		else {
+			snprintf(filename, sizeof(filename), "%s/%u", TASKSTATS_DIR, nls->pid);
+			if ((fp = fopen(filename, "r")) == NULL) {
+				err = -ESRCH;
+			}
+			else {
+				if ((fgets(line, sizeof(line), fp) == NULL) ||
+				    parse_taskstats(line, &ts)) {
+					err = -EINVAL;
+				}
+				fclose(fp);
+			}
+		}
+
+		if (err || (nls->attr == TASKSTATS_CMD_ATTR_REGISTER_CPUMASK)) {
+			n->nlmsg_type = NLMSG_ERROR;
+			n->nlmsg_len = NLMSG_LENGTH(sizeof(struct nlmsgerr));
+			((struct nlmsgerr *) NLMSG_DATA(n))->error = err;
+			return n->nlmsg_len;
+		}
+	}
+
+	/* Stats for a single task */
+	n->nlmsg_type = family;
+	na = add_netlink_attr(n, TASKSTATS_TYPE_AGGR_PID, NULL, 0);
+	add_netlink_attr(n, TASKSTATS_TYPE_PID, &ts.ac_pid, sizeof(uint32_t));
+	add_netlink_attr(n, TASKSTATS_TYPE_STATS, &ts, sizeof(struct taskstats));
+	na->nla_len = (char *) n + n->nlmsg_len - (char *) na;
+
+	return n->nlmsg_len;
+}
+#endif
+
 #endif	/* TEST */
 
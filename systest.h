@@ -11,6 +11,7 @@
 #include <sys/utsname.h>
 #include <sys/statvfs.h>
 #include <sys/stat.h>
+#include <sys/socket.h>
 
 #ifndef MINORBITS
 #define MINORBITS	20
@@ -28,14 +29,21 @@
 #define __getenv(m)		get_env_value(m)
 #define __alarm(m)
 #define __pause()		next_time_step()
+#define __wait_deadline(m,n)	next_time_step()
 #define __stat(m,n)		virtual_stat(m,n)
 #define __opendir(m)		open_list(m)
 #define __readdir(m)		read_list(m)
 #define __closedir(m)		close_list(m)
 #define __realpath(m,n)		get_realname(m,n)
 #define __gettimeofday(m,n)	get_day_time(m)
+#define __clock_gettime(m,n)	get_clock_time(m,n)
 #define __getpwuid(m)		get_usrname(m)
 #define __fork(m)		get_known_pid(m)
+#define __getpid()		get_known_pid()
+#define __socket(m,n,o)		get_netlink_socket(m,n,o)
+#define __bind(m,n,o)		bind_netlink_socket(m,n,o)
+#define __sendto(m,n,o,p,q,r)	send_netlink_msg(m,n,o)
+#define __recv(m,n,o,p)		recv_netlink_msg(m,n,o,p)
 #define __major(m)		(m >> MINORBITS)
 #define __minor(m)		(m & S_MAXMINOR)
 
@@ -43,8 +51,13 @@
 #define ROOTFILE	"root"
 #define TESTDIR		PRE_TESTDIR "/tests"
 #define VIRTUALHD	"./tests/root/dev/mapper/virtualhd"
+#define TASKSTATS_DIR	"./tests/root/taskstats"
 #define _LIST		"_list"
 
+/* Max number of simulated netlink sockets and taskstats family ID */
+#define NL_TEST_SOCK_NR	16
+#define NL_TEST_FAMILY	0x17
+
 #else
 
 #define PRE	""
@@ -55,14 +68,21 @@
 #define __getenv(m)		getenv(m)
 #define __alarm(m)		alarm(m)
 #define __pause()		pause()
+#define __wait_deadline(m,n)	wait_deadline(m,n)
 #define __stat(m,n)		stat(m,n)
 #define __opendir(m)		opendir(m)
 #define __readdir(m)		readdir(m)
 #define __closedir(m)		closedir(m)
 #define __realpath(m,n)		realpath(m,n)
 #define __gettimeofday(m,n)	gettimeofday(m,n)
+#define __clock_gettime(m,n)	clock_gettime(m,n)
 #define __getpwuid(m)		getpwuid(m)
 #define __fork(m)		fork(m)
+#define __getpid()		getpid()
+#define __socket(m,n,o)		socket(m,n,o)
+#define __bind(m,n,o)		bind(m,n,o)
+#define __sendto(m,n,o,p,q,r)	sendto(m,n,o,p,q,r)
+#define __recv(m,n,o,p)		recv(m,n,o,p)
 #define __major(m)		major(m)
 #define __minor(m)		minor(m)
 
@@ -74,8 +94,12 @@
  ***************************************************************************
  */
 #ifdef TEST
+int bind_netlink_socket
+	(int, const struct sockaddr *, socklen_t);
 void close_list
 	(DIR *);
+int get_clock_time
+	(clockid_t, struct timespec *);
 void get_day_time
 	(struct timeval *);
 char *get_env_value
@@ -84,6 +108,8 @@ int get_fs_stat
 	(char *, struct statvfs *);
 pid_t get_known_pid
 	(void);
+int get_netlink_socket
+	(int, int, int);
 char *get_realname
 	(char *, char *);
 void get_uname
@@ -98,6 +124,10 @@ DIR *open_list
 	(const char *);
 struct dirent *read_list
 	(DIR *);
+ssize_t recv_netlink_msg
+	(int, void *, size_t, int);
+ssize_t send_netlink_msg
+	(int, const void *, size_t);
 int virtual_stat
 	(const char *, struct stat *);
 